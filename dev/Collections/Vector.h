@@ -295,6 +295,41 @@ public:
         }
     }
 
+    // Inserts all the values at index in a single move and raises one Reset instead of one ItemInserted per value.
+    void InsertRange(uint32_t const index, winrt::array_view<T_type const> values)
+    {
+        if (index <= static_cast<uint32_t>(m_vector.size()))
+        {
+            std::vector<T_Storage> storage;
+            storage.reserve(values.size());
+            for (auto const& value : values)
+            {
+                storage.push_back(wrap(value));
+            }
+
+            m_vector.insert(m_vector.begin() + index, std::make_move_iterator(storage.begin()), std::make_move_iterator(storage.end()));
+            RaiseChildrenChanged(winrt::CollectionChange::Reset, 0u);
+        }
+        else
+        {
+            throw winrt::hresult_out_of_bounds();
+        }
+    }
+
+    // Removes count values starting at index in a single move and raises one Reset instead of one ItemRemoved per value.
+    void RemoveRange(uint32_t const index, uint32_t const count)
+    {
+        if (index <= static_cast<uint32_t>(m_vector.size()) && count <= static_cast<uint32_t>(m_vector.size()) - index)
+        {
+            m_vector.erase(m_vector.begin() + index, m_vector.begin() + index + count);
+            RaiseChildrenChanged(winrt::CollectionChange::Reset, 0u);
+        }
+        else
+        {
+            throw winrt::hresult_out_of_bounds();
+        }
+    }
+
     virtual void RaiseChildrenChanged(winrt::CollectionChange collectionChange, unsigned int index) {};
 
     void reserve(unsigned int n) { m_vector.reserve(n); }
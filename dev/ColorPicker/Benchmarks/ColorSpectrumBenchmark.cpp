@@ -0,0 +1,436 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+// Headless micro-benchmark for ColorSpectrum's bitmap generation. Generates the bitmaps and HSV
+// map for every shape and set of components, once the way ColorSpectrum used to (a pixel at a
+// time, appending to the buffers) and once with ColorSpectrumBitmapGenerator on one and on
+// several threads. Returns a non zero exit code if the outputs differ in any byte or HSV value,
+// or if ColorSpectrumBitmapCache doesn't evict its least recently used entries first.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "ColorSpectrumBitmapCache.h"
+#include "ColorSpectrumBitmapGenerator.h"
+
+namespace
+{
+    struct Rgb
+    {
+        double r;
+        double g;
+        double b;
+    };
+
+    struct Hsv
+    {
+        Hsv() = default;
+        Hsv(double h, double s, double v) : h(h), s(s), v(v) {}
+
+        bool operator==(const Hsv& other) const { return h == other.h && s == other.s && v == other.v; }
+
+        double h{};
+        double s{};
+        double v{};
+    };
+
+    enum class ColorSpectrumComponents
+    {
+        HueValue,
+        ValueHue,
+        HueSaturation,
+        SaturationHue,
+        SaturationValue,
+        ValueSaturation,
+    };
+
+    const char* ToString(ColorSpectrumComponents components)
+    {
+        switch (components)
+        {
+        case ColorSpectrumComponents::HueValue: return "HueValue";
+        case ColorSpectrumComponents::ValueHue: return "ValueHue";
+        case ColorSpectrumComponents::HueSaturation: return "HueSaturation";
+        case ColorSpectrumComponents::SaturationHue: return "SaturationHue";
+        case ColorSpectrumComponents::SaturationValue: return "SaturationValue";
+        case ColorSpectrumComponents::ValueSaturation: return "ValueSaturation";
+        }
+        return "";
+    }
+
+    using Generator = ColorSpectrumBitmapGenerator<Hsv, ColorSpectrumComponents>;
+    using Cache = ColorSpectrumBitmapCache<Hsv, ColorSpectrumComponents>;
+
+    struct Output
+    {
+        std::vector<uint8_t> pixelData[Generator::BitmapCount];
+        std::vector<Hsv> hsvValues;
+    };
+
+    // Copy of HsvToRgb from ColorConversion.cpp.
+    Rgb HsvToRgb(const Hsv& hsv)
+    {
+        double hue = hsv.h;
+        double saturation = hsv.s;
+        double value = hsv.v;
+
+        while (hue >= 360.0)
+        {
+            hue -= 360.0;
+        }
+
+        while (hue < 0.0)
+        {
+            hue += 360.0;
+        }
+
+        saturation = saturation < 0.0 ? 0.0 : saturation;
+        saturation = saturation > 1.0 ? 1.0 : saturation;
+
+        value = value < 0.0 ? 0.0 : value;
+        value = value > 1.0 ? 1.0 : value;
+
+        double chroma = saturation * value;
+        double min = value - chroma;
+
+        if (chroma == 0)
+        {
+            return Rgb{ min, min, min };
+        }
+
+        int sextant = static_cast<int>(hue / 60);
+        double intermediateColorPercentage = hue / 60 - sextant;
+        double max = chroma + min;
+
+        double r = 0;
+        double g = 0;
+        double b = 0;
+
+        switch (sextant)
+        {
+        case 0: r = max; g = min + chroma * intermediateColorPercentage; b = min; break;
+        case 1: r = min + chroma * (1 - intermediateColorPercentage); g = max; b = min; break;
+        case 2: r = min; g = max; b = min + chroma * intermediateColorPercentage; break;
+        case 3: r = min; g = min + chroma * (1 - intermediateColorPercentage); b = max; break;
+        case 4: r = min + chroma * intermediateColorPercentage; g = min; b = max; break;
+        case 5: r = max; g = min; b = min + chroma * (1 - intermediateColorPercentage); break;
+        }
+
+        return Rgb{ r, g, b };
+    }
+
+    void PushPixel(std::vector<uint8_t>& pixelData, const Hsv& hsv)
+    {
+        const Rgb rgb = HsvToRgb(hsv);
+        pixelData.push_back(static_cast<uint8_t>(round(rgb.b * 255)));
+        pixelData.push_back(static_cast<uint8_t>(round(rgb.g * 255)));
+        pixelData.push_back(static_cast<uint8_t>(round(rgb.r * 255)));
+        pixelData.push_back(255);
+    }
+
+    // What ColorSpectrum::FillPixelForBox and FillPixelForRing used to do for one pixel, given
+    // the percentages along the two axes.
+    void FillPixel(double first, double second, const Generator::Parameters& p, const std::vector<std::shared_ptr<std::vector<uint8_t>>>& pixelData, const std::shared_ptr<std::vector<Hsv>>& hsvValues)
+    {
+        const double hMin = p.MinHue;
+        const double hMax = p.MaxHue;
+        const double sMin = p.MinSaturation / 100.0;
+        const double sMax = p.MaxSaturation / 100.0;
+        const double vMin = p.MinValue / 100.0;
+        const double vMax = p.MaxValue / 100.0;
+
+        Hsv hsv[Generator::BitmapCount];
+        for (int i = 0; i < Generator::BitmapCount; i++)
+        {
+            switch (p.Components)
+            {
+            case ColorSpectrumComponents::HueValue:
+                hsv[i] = Hsv(hMin + first * (hMax - hMin), i == 0 ? 0 : 1, vMin + second * (vMax - vMin));
+                break;
+            case ColorSpectrumComponents::HueSaturation:
+                hsv[i] = Hsv(hMin + first * (hMax - hMin), sMin + second * (sMax - sMin), i == 0 ? 0 : 1);
+                break;
+            case ColorSpectrumComponents::ValueHue:
+                hsv[i] = Hsv(hMin + second * (hMax - hMin), i == 0 ? 0 : 1, vMin + first * (vMax - vMin));
+                break;
+            case ColorSpectrumComponents::ValueSaturation:
+                hsv[i] = Hsv(i * 60.0, sMin + second * (sMax - sMin), vMin + first * (vMax - vMin));
+                break;
+            case ColorSpectrumComponents::SaturationHue:
+                hsv[i] = Hsv(hMin + second * (hMax - hMin), sMin + first * (sMax - sMin), i == 0 ? 0 : 1);
+                break;
+            case ColorSpectrumComponents::SaturationValue:
+                hsv[i] = Hsv(i * 60.0, sMin + first * (sMax - sMin), vMin + second * (vMax - vMin));
+                break;
+            }
+
+            if (p.Components == ColorSpectrumComponents::HueSaturation || p.Components == ColorSpectrumComponents::SaturationHue)
+            {
+                hsv[i].s = sMax - hsv[i].s + sMin;
+            }
+            else
+            {
+                hsv[i].v = vMax - hsv[i].v + vMin;
+            }
+        }
+
+        hsvValues->push_back(hsv[0]);
+        for (int i = 0; i < Generator::BitmapCount; i++)
+        {
+            if (i == 0 || i == Generator::MaxBitmap || Generator::UsesMiddleBitmaps(p.Components))
+            {
+                PushPixel(*pixelData[i], hsv[i]);
+            }
+        }
+    }
+
+    Output GenerateOld(const Generator::Parameters& p)
+    {
+        std::vector<std::shared_ptr<std::vector<uint8_t>>> pixelData;
+        for (int i = 0; i < Generator::BitmapCount; i++)
+        {
+            pixelData.push_back(std::make_shared<std::vector<uint8_t>>());
+        }
+        auto hsvValues = std::make_shared<std::vector<Hsv>>();
+
+        const double minDimension = p.Size;
+        if (!p.IsRing)
+        {
+            for (int x = p.Size - 1; x >= 0; --x)
+            {
+                for (int y = p.Size - 1; y >= 0; --y)
+                {
+                    const double xPercent = (minDimension - 1 - x) / (minDimension - 1);
+                    const double yPercent = (minDimension - 1 - y) / (minDimension - 1);
+                    FillPixel(yPercent, xPercent, p, pixelData, hsvValues);
+                }
+            }
+        }
+        else
+        {
+            const double radius = p.Size / 2.0;
+            for (int y = 0; y < p.Size; ++y)
+            {
+                for (int x = 0; x < p.Size; ++x)
+                {
+                    double distanceFromRadius = sqrt(pow(x - radius, 2) + pow(y - radius, 2));
+                    double xToUse = x;
+                    double yToUse = y;
+                    if (distanceFromRadius > radius)
+                    {
+                        xToUse = (radius / distanceFromRadius) * (x - radius) + radius;
+                        yToUse = (radius / distanceFromRadius) * (y - radius) + radius;
+                        distanceFromRadius = radius;
+                    }
+
+                    double theta = atan2((radius - yToUse), (radius - xToUse)) * 180.0 / 3.14159265358979323846;
+                    theta += 180.0;
+                    theta = floor(theta);
+                    while (theta > 360)
+                    {
+                        theta -= 360;
+                    }
+
+                    FillPixel(theta / 360, 1 - distanceFromRadius / radius, p, pixelData, hsvValues);
+                }
+            }
+        }
+
+        Output output;
+        for (int i = 0; i < Generator::BitmapCount; i++)
+        {
+            output.pixelData[i] = std::move(*pixelData[i]);
+        }
+        output.hsvValues = std::move(*hsvValues);
+        return output;
+    }
+
+    Output GenerateNew(const Generator::Parameters& p, int threadCount)
+    {
+        const size_t pixelCount = static_cast<size_t>(p.Size) * p.Size;
+        Output output;
+        uint8_t* pixelData[Generator::BitmapCount]{};
+        for (int i = 0; i < Generator::BitmapCount; i++)
+        {
+            if (i == 0 || i == Generator::MaxBitmap || Generator::UsesMiddleBitmaps(p.Components))
+            {
+                output.pixelData[i].resize(pixelCount * 4);
+                pixelData[i] = output.pixelData[i].data();
+            }
+        }
+        output.hsvValues.resize(pixelCount);
+
+        const Generator generator(p, pixelData, output.hsvValues.data());
+
+        // Same tiling as ColorSpectrum::CreateBitmapsAndColorMap.
+        constexpr int rowsPerTile = 32;
+        const int tileCount = (p.Size + rowsPerTile - 1) / rowsPerTile;
+        std::atomic<int> nextTile{ 0 };
+        const auto fillTiles = [&]()
+        {
+            for (int tile = nextTile++; tile < tileCount; tile = nextTile++)
+            {
+                generator.FillRows(tile * rowsPerTile, std::min((tile + 1) * rowsPerTile, p.Size));
+            }
+        };
+
+        std::vector<std::thread> helpers;
+        for (int i = 1; i < threadCount; i++)
+        {
+            helpers.emplace_back(fillTiles);
+        }
+        fillTiles();
+        for (auto& helper : helpers)
+        {
+            helper.join();
+        }
+
+        return output;
+    }
+
+    bool AreEqual(const Output& lhs, const Output& rhs)
+    {
+        for (int i = 0; i < Generator::BitmapCount; i++)
+        {
+            if (lhs.pixelData[i] != rhs.pixelData[i])
+            {
+                return false;
+            }
+        }
+        return lhs.hsvValues == rhs.hsvValues;
+    }
+
+    Cache::Bitmaps ToBitmaps(Output&& output)
+    {
+        Cache::Bitmaps bitmaps;
+        for (int i = 0; i < Generator::BitmapCount; i++)
+        {
+            bitmaps.PixelData[i] = std::make_shared<std::vector<uint8_t>>(std::move(output.pixelData[i]));
+        }
+        bitmaps.HsvValues = std::make_shared<std::vector<Hsv>>(std::move(output.hsvValues));
+        return bitmaps;
+    }
+
+    // Fills a cache that has room for two spectra with three and checks which ones are kept.
+    bool ValidateCache()
+    {
+        const Generator::Parameters first{ 64, false, ColorSpectrumComponents::HueSaturation, 0, 359, 0, 100, 0, 100 };
+        Generator::Parameters second = first;
+        second.IsRing = true;
+        Generator::Parameters third = first;
+        third.MaxValue = 50;
+
+        const auto firstBitmaps = ToBitmaps(GenerateNew(first, 1));
+        Cache cache(firstBitmaps.SizeInBytes() * 2);
+        cache.Add(first, firstBitmaps);
+        cache.Add(second, ToBitmaps(GenerateNew(second, 1)));
+
+        // Touch the first one, so that the second one is the least recently used.
+        Cache::Bitmaps bitmaps;
+        bool passed = cache.TryGet(first, bitmaps) && bitmaps.HsvValues == firstBitmaps.HsvValues;
+        cache.Add(third, ToBitmaps(GenerateNew(third, 1)));
+
+        passed = passed && cache.Count() == 2 && cache.SizeInBytes() <= cache.CapacityInBytes();
+        passed = passed && cache.TryGet(first, bitmaps) && !cache.TryGet(second, bitmaps) && cache.TryGet(third, bitmaps);
+        passed = passed && *bitmaps.HsvValues == GenerateNew(third, 1).hsvValues;
+
+        // Entries that don't fit at all are not kept.
+        cache.SetCapacityInBytes(firstBitmaps.SizeInBytes() - 1);
+        passed = passed && cache.Count() == 0 && cache.SizeInBytes() == 0;
+        cache.Add(first, firstBitmaps);
+        passed = passed && cache.Count() == 0 && cache.HitCount() == 3 && cache.MissCount() == 1;
+
+        printf("cache: %s\n", passed ? "evicts least recently used entries first" : "FAILED");
+        return passed;
+    }
+
+    template <typename Func>
+    double TimeInMilliseconds(int iterations, const Func& func)
+    {
+        double best = 0.0;
+        for (int i = 0; i < iterations; i++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            func();
+            const auto end = std::chrono::steady_clock::now();
+            const double duration = std::chrono::duration<double, std::milli>(end - start).count();
+            best = i == 0 ? duration : std::min(best, duration);
+        }
+        return best;
+    }
+
+    struct Options
+    {
+        int size{ 2160 };
+        int iterations{ 3 };
+        int threads{ static_cast<int>(std::max(1u, std::min(8u, std::thread::hardware_concurrency()))) };
+    };
+
+    Options ParseOptions(int argc, char* argv[])
+    {
+        Options options;
+        for (int i = 1; i < argc; i++)
+        {
+            if (strcmp(argv[i], "--quick") == 0)
+            {
+                options.size = 400;
+                options.iterations = 1;
+            }
+            else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc)
+            {
+                options.size = std::max(2, atoi(argv[++i]));
+            }
+            else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+            {
+                options.iterations = std::max(1, atoi(argv[++i]));
+            }
+            else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            {
+                options.threads = std::max(1, atoi(argv[++i]));
+            }
+        }
+        return options;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const auto options = ParseOptions(argc, argv);
+    bool passed = true;
+
+    printf("%dx%d pixels, best of %d, %d threads\n", options.size, options.size, options.iterations, options.threads);
+    printf("%-6s %-16s %12s %12s %12s\n", "shape", "components", "old(ms)", "new(ms)", "tiled(ms)");
+    for (bool isRing : { false, true })
+    {
+        for (auto components : { ColorSpectrumComponents::HueValue, ColorSpectrumComponents::ValueHue, ColorSpectrumComponents::HueSaturation,
+            ColorSpectrumComponents::SaturationHue, ColorSpectrumComponents::SaturationValue, ColorSpectrumComponents::ValueSaturation })
+        {
+            // Restricted ranges on purpose, so that every interpolation is exercised.
+            const Generator::Parameters parameters{ options.size, isRing, components, 10, 350, 5, 95, 15, 100 };
+
+            Output old;
+            Output single;
+            Output tiled;
+            const double oldTime = TimeInMilliseconds(options.iterations, [&]() { old = GenerateOld(parameters); });
+            const double singleTime = TimeInMilliseconds(options.iterations, [&]() { single = GenerateNew(parameters, 1); });
+            const double tiledTime = TimeInMilliseconds(options.iterations, [&]() { tiled = GenerateNew(parameters, options.threads); });
+
+            const bool matches = AreEqual(old, single) && AreEqual(old, tiled);
+            printf("%-6s %-16s %12.2f %12.2f %12.2f%s\n", isRing ? "ring" : "box", ToString(components), oldTime, singleTime, tiledTime, matches ? "" : "  OUTPUT DIFFERS");
+            passed = passed && matches;
+        }
+    }
+
+    passed = ValidateCache() && passed;
+
+    return passed ? 0 : 1;
+}
@@ -4,12 +4,17 @@
 #include "pch.h"
 #include "common.h"
 #include "ColorSpectrum.h"
+#include "ColorSpectrumBitmapGenerator.h"
 
 #include "ColorSpectrumAutomationPeer.h"
 #include "SpectrumBrush.h"
 
+#include <thread>
+
 using namespace std;
 
+using SpectrumBitmapGenerator = ColorSpectrumBitmapGenerator<Hsv, winrt::ColorSpectrumComponents>;
+
 ColorSpectrum::ColorSpectrum()
 {
     SetDefaultStyleKey(this);
@@ -86,7 +91,7 @@ void ColorSpectrum::OnApplyTemplate()
     }
 
     // If we haven't yet created our bitmaps, do so now.
-    if (m_hsvValues.size() == 0)
+    if (!m_hsvValues)
     {
         CreateBitmapsAndColorMap();
     }
@@ -502,7 +507,7 @@ void ColorSpectrum::UpdateColorFromPoint(const winrt::PointerPoint& point)
 {
     // If we haven't initialized our HSV value array yet, then we should just ignore any user input -
     // we don't yet know what to do with it.
-    if (m_hsvValues.size() == 0)
+    if (!m_hsvValues)
     {
         return;
     }
@@ -546,7 +551,7 @@ void ColorSpectrum::UpdateColorFromPoint(const winrt::PointerPoint& point)
 
     // The gradient image contains two dimensions of HSL information, but not the third.
     // We should keep the third where it already was.
-    Hsv hsvAtPoint = m_hsvValues[y * width + x];
+    Hsv hsvAtPoint = (*m_hsvValues)[y * width + x];
 
     auto components = Components();
     auto hsvColor = HsvColor();
@@ -874,7 +879,6 @@ void ColorSpectrum::CreateBitmapsAndColorMap()
     spectrumOverlayEllipse.Width(minDimension);
     spectrumOverlayEllipse.Height(minDimension);
 
-    winrt::float4 hsvColor = HsvColor();
     int minHue = MinHue();
     int maxHue = MaxHue();
     int minSaturation = MinSaturation();
@@ -900,102 +904,92 @@ void ColorSpectrum::CreateBitmapsAndColorMap()
         maxValue = minValue;
     }
 
-    Hsv hsv = { hsv::GetHue(hsvColor), hsv::GetSaturation(hsvColor), hsv::GetValue(hsvColor) };
+    const int minDimensionInt = static_cast<int>(round(minDimension));
+    const SpectrumBitmapGenerator::Parameters parameters{ minDimensionInt, shape == winrt::ColorSpectrumShape::Ring, components, minHue, maxHue, minSaturation, maxSaturation, minValue, maxValue };
+
+    // The bitmaps only depend on the parameters, so if this or another spectrum has generated
+    // them recently we can show them right away.
+    SpectrumBitmapCache::Bitmaps cachedBitmaps;
+    if (GetBitmapCache().TryGet(parameters, cachedBitmaps))
+    {
+        if (m_createImageBitmapAction)
+        {
+            m_createImageBitmapAction.Cancel();
+            m_createImageBitmapAction = nullptr;
+        }
+
+        ApplyBitmaps(minDimension, cachedBitmaps);
+        return;
+    }
 
     // The middle 4 are only needed and used in the case of hue as the third dimension.
     // Saturation and luminosity need only a min and max.
-    shared_ptr<vector<::byte>> bgraMinPixelData = make_shared<vector<::byte>>();
-    shared_ptr<vector<::byte>> bgraMiddle1PixelData = make_shared<vector<::byte>>();
-    shared_ptr<vector<::byte>> bgraMiddle2PixelData = make_shared<vector<::byte>>();
-    shared_ptr<vector<::byte>> bgraMiddle3PixelData = make_shared<vector<::byte>>();
-    shared_ptr<vector<::byte>> bgraMiddle4PixelData = make_shared<vector<::byte>>();
-    shared_ptr<vector<::byte>> bgraMaxPixelData = make_shared<vector<::byte>>();
-    shared_ptr<vector<Hsv>> newHsvValues = make_shared<vector<Hsv>>();
-
-    auto pixelCount = static_cast<size_t>(round(minDimension) * round(minDimension));
+    auto bitmaps = make_shared<SpectrumBitmapCache::Bitmaps>();
+    for (auto& pixelData : bitmaps->PixelData)
+    {
+        pixelData = make_shared<vector<::byte>>();
+    }
+    bitmaps->HsvValues = make_shared<vector<Hsv>>();
+
+    auto pixelCount = static_cast<size_t>(minDimensionInt) * minDimensionInt;
     size_t pixelDataSize = pixelCount * 4;
-    bgraMinPixelData->reserve(pixelDataSize);
 
     // We'll only save pixel data for the middle bitmaps if our third dimension is hue.
-    if (components == winrt::ColorSpectrumComponents::ValueSaturation ||
-        components == winrt::ColorSpectrumComponents::SaturationValue)
+    const bool usesMiddleBitmaps = SpectrumBitmapGenerator::UsesMiddleBitmaps(components);
+    ::byte* pixelData[SpectrumBitmapGenerator::BitmapCount]{};
+    for (int i = 0; i < SpectrumBitmapGenerator::BitmapCount; ++i)
     {
-        bgraMiddle1PixelData->reserve(pixelDataSize);
-        bgraMiddle2PixelData->reserve(pixelDataSize);
-        bgraMiddle3PixelData->reserve(pixelDataSize);
-        bgraMiddle4PixelData->reserve(pixelDataSize);
+        if (i == SpectrumBitmapGenerator::MinBitmap || i == SpectrumBitmapGenerator::MaxBitmap || usesMiddleBitmaps)
+        {
+            bitmaps->PixelData[i]->resize(pixelDataSize);
+            pixelData[i] = bitmaps->PixelData[i]->data();
+        }
     }
 
-    bgraMaxPixelData->reserve(pixelDataSize);
-    newHsvValues->reserve(pixelCount);
-
-    int minDimensionInt = static_cast<int>(round(minDimension));
-    winrt::WorkItemHandler workItemHandler(
-        [minDimensionInt, hsv, minHue, maxHue, minSaturation, maxSaturation, minValue, maxValue, shape, components,
-        bgraMinPixelData, bgraMiddle1PixelData, bgraMiddle2PixelData, bgraMiddle3PixelData, bgraMiddle4PixelData, bgraMaxPixelData, newHsvValues]
-    (winrt::IAsyncAction workItem)
+    bitmaps->HsvValues->resize(pixelCount);
+
+    // As the user perceives it, every time the third dimension not represented in the ColorSpectrum changes,
+    // the ColorSpectrum will visually change to accommodate that value.  For example, if the ColorSpectrum handles hue and luminosity,
+    // and the saturation externally goes from 1.0 to 0.5, then the ColorSpectrum will visually change to look more washed out
+    // to represent that third dimension's new value.
+    // Internally, however, we don't want to regenerate the ColorSpectrum bitmap every single time this happens, since that's very expensive.
+    // In order to make it so that we don't have to, we implement an optimization where, rather than having only one bitmap,
+    // we instead have multiple that we blend together using opacity to create the effect that we want.
+    // In the case where the third dimension is saturation or luminosity, we only need two: one bitmap at the minimum value
+    // of the third dimension, and one bitmap at the maximum.  Then we set the second's opacity at whatever the value of
+    // the third dimension is - e.g., a saturation of 0.5 implies an opacity of 50%.
+    // In the case where the third dimension is hue, we need six: one bitmap corresponding to red, yellow, green, cyan, blue, and purple.
+    // We'll then blend between whichever colors our hue exists between - e.g., an orange color would use red and yellow with an opacity of 50%.
+    // This optimization does incur slightly more startup time initially since we have to generate multiple bitmaps at once instead of only one,
+    // but the running time savings after that are *huge* when we can just set an opacity instead of generating a brand new bitmap.
+    auto generator = make_shared<SpectrumBitmapGenerator>(parameters, pixelData, bitmaps->HsvValues->data());
+
+    // The rows are split into tiles that the work item and a few helper work items take turns
+    // picking up, so that a large spectrum gets generated on several cores. Cancellation is
+    // checked before every tile. The tiles hold on to the bitmaps, since helpers can still be
+    // finishing a tile after the generation has been canceled.
+    constexpr int rowsPerTile = 32;
+    const int tileCount = (minDimensionInt + rowsPerTile - 1) / rowsPerTile;
+    const int helperCount = std::min({ tileCount, static_cast<int>(std::thread::hardware_concurrency()), 8 }) - 1;
+    auto nextTile = make_shared<std::atomic<int>>(0);
+    auto isCanceled = make_shared<std::atomic<bool>>(false);
+    auto fillTiles = [generator, bitmaps, nextTile, tileCount, isCanceled]()
+    {
+        for (int tile = (*nextTile)++; tile < tileCount && !*isCanceled; tile = (*nextTile)++)
         {
-            // As the user perceives it, every time the third dimension not represented in the ColorSpectrum changes,
-            // the ColorSpectrum will visually change to accommodate that value.  For example, if the ColorSpectrum handles hue and luminosity,
-            // and the saturation externally goes from 1.0 to 0.5, then the ColorSpectrum will visually change to look more washed out
-            // to represent that third dimension's new value.
-            // Internally, however, we don't want to regenerate the ColorSpectrum bitmap every single time this happens, since that's very expensive.
-            // In order to make it so that we don't have to, we implement an optimization where, rather than having only one bitmap,
-            // we instead have multiple that we blend together using opacity to create the effect that we want.
-            // In the case where the third dimension is saturation or luminosity, we only need two: one bitmap at the minimum value
-            // of the third dimension, and one bitmap at the maximum.  Then we set the second's opacity at whatever the value of
-            // the third dimension is - e.g., a saturation of 0.5 implies an opacity of 50%.
-            // In the case where the third dimension is hue, we need six: one bitmap corresponding to red, yellow, green, cyan, blue, and purple.
-            // We'll then blend between whichever colors our hue exists between - e.g., an orange color would use red and yellow with an opacity of 50%.
-            // This optimization does incur slightly more startup time initially since we have to generate multiple bitmaps at once instead of only one,
-            // but the running time savings after that are *huge* when we can just set an opacity instead of generating a brand new bitmap.
-            if (shape == winrt::ColorSpectrumShape::Box)
-            {
-                for (int x = minDimensionInt - 1; x >= 0; --x)
-                {
-                    for (int y = minDimensionInt - 1; y >= 0; --y)
-                    {
-                        if (workItem.Status() == winrt::AsyncStatus::Canceled)
-                        {
-                            break;
-                        }
-
-                        ColorSpectrum::FillPixelForBox(
-                            x, y, hsv, minDimensionInt, components, minHue, maxHue, minSaturation, maxSaturation, minValue, maxValue,
-                            bgraMinPixelData, bgraMiddle1PixelData, bgraMiddle2PixelData, bgraMiddle3PixelData, bgraMiddle4PixelData, bgraMaxPixelData,
-                            newHsvValues);
-                    }
-                }
-            }
-            else
-            {
-                for (int y = 0; y < minDimensionInt; ++y)
-                {
-                    for (int x = 0; x < minDimensionInt; ++x)
-                    {
-                        if (workItem.Status() == winrt::AsyncStatus::Canceled)
-                        {
-                            break;
-                        }
-
-                        ColorSpectrum::FillPixelForRing(
-                            x, y, minDimensionInt / 2.0, hsv, components, minHue, maxHue, minSaturation, maxSaturation, minValue, maxValue,
-                            bgraMinPixelData, bgraMiddle1PixelData, bgraMiddle2PixelData, bgraMiddle3PixelData, bgraMiddle4PixelData, bgraMaxPixelData,
-                            newHsvValues);
-                    }
-                }
-            }
-        });
+            generator->FillRows(tile * rowsPerTile, std::min((tile + 1) * rowsPerTile, generator->RowCount()));
+        }
+    };
 
     if (m_createImageBitmapAction)
     {
         m_createImageBitmapAction.Cancel();
     }
 
-    m_createImageBitmapAction = winrt::ThreadPool::RunAsync(workItemHandler);
+    m_createImageBitmapAction = FillTilesAsync(fillTiles, helperCount, isCanceled);
     auto strongThis = get_strong();
     m_createImageBitmapAction.Completed(winrt::AsyncActionCompletedHandler(
-        [strongThis, minDimension, components, bgraMinPixelData, bgraMiddle1PixelData, bgraMiddle2PixelData, bgraMiddle3PixelData, bgraMiddle4PixelData, bgraMaxPixelData, newHsvValues]
+        [strongThis, minDimension, parameters, bitmaps]
     (winrt::IAsyncAction asyncInfo, winrt::AsyncStatus asyncStatus)
     {
         if (asyncStatus != winrt::AsyncStatus::Completed)
@@ -1003,434 +997,135 @@ void ColorSpectrum::CreateBitmapsAndColorMap()
             return;
         }
 
+        // Only bitmaps that were generated all the way make it into the cache.
+        GetBitmapCache().Add(parameters, *bitmaps);
+
         strongThis->m_createImageBitmapAction = nullptr;
 
         strongThis->m_dispatcherHelper.RunAsync(
-            [strongThis, minDimension, bgraMinPixelData, bgraMiddle1PixelData, bgraMiddle2PixelData, bgraMiddle3PixelData, bgraMiddle4PixelData, bgraMaxPixelData, newHsvValues]()
+            [strongThis, minDimension, bitmaps]()
         {
-            int pixelWidth = static_cast<int>(round(minDimension));
-            int pixelHeight = static_cast<int>(round(minDimension));
-
-            winrt::ColorSpectrumComponents components = strongThis->Components();
-
-            if (SharedHelpers::IsRS2OrHigher())
-            {
-                winrt::LoadedImageSurface minSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMinPixelData);
-                winrt::LoadedImageSurface maxSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMaxPixelData);
-
-                switch (components)
-                {
-                case winrt::ColorSpectrumComponents::HueValue:
-                case winrt::ColorSpectrumComponents::ValueHue:
-                    strongThis->m_saturationMinimumSurface = minSurface;
-                    strongThis->m_saturationMaximumSurface = maxSurface;
-                    break;
-                case winrt::ColorSpectrumComponents::HueSaturation:
-                case winrt::ColorSpectrumComponents::SaturationHue:
-                    strongThis->m_valueSurface = maxSurface;
-                    break;
-                case winrt::ColorSpectrumComponents::ValueSaturation:
-                case winrt::ColorSpectrumComponents::SaturationValue:
-                    strongThis->m_hueRedSurface = minSurface;
-                    strongThis->m_hueYellowSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMiddle1PixelData);
-                    strongThis->m_hueGreenSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMiddle2PixelData);
-                    strongThis->m_hueCyanSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMiddle3PixelData);
-                    strongThis->m_hueBlueSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMiddle4PixelData);
-                    strongThis->m_huePurpleSurface = maxSurface;
-                    break;
-                }
-            }
-            else
-            {
-                winrt::WriteableBitmap minBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMinPixelData);
-                winrt::WriteableBitmap maxBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMaxPixelData);
-
-                switch (components)
-                {
-                case winrt::ColorSpectrumComponents::HueValue:
-                case winrt::ColorSpectrumComponents::ValueHue:
-                    strongThis->m_saturationMinimumBitmap = minBitmap;
-                    strongThis->m_saturationMaximumBitmap = maxBitmap;
-                    break;
-                case winrt::ColorSpectrumComponents::HueSaturation:
-                case winrt::ColorSpectrumComponents::SaturationHue:
-                    strongThis->m_valueBitmap = maxBitmap;
-                    break;
-                case winrt::ColorSpectrumComponents::ValueSaturation:
-                case winrt::ColorSpectrumComponents::SaturationValue:
-                    strongThis->m_hueRedBitmap = minBitmap;
-                    strongThis->m_hueYellowBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMiddle1PixelData);
-                    strongThis->m_hueGreenBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMiddle2PixelData);
-                    strongThis->m_hueCyanBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMiddle3PixelData);
-                    strongThis->m_hueBlueBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMiddle4PixelData);
-                    strongThis->m_huePurpleBitmap = maxBitmap;
-                    break;
-                }
-            }
-
-            strongThis->m_shapeFromLastBitmapCreation = strongThis->Shape();
-            strongThis->m_componentsFromLastBitmapCreation = strongThis->Components();
-            strongThis->m_imageWidthFromLastBitmapCreation = minDimension;
-            strongThis->m_imageHeightFromLastBitmapCreation = minDimension;
-            strongThis->m_minHueFromLastBitmapCreation = strongThis->MinHue();
-            strongThis->m_maxHueFromLastBitmapCreation = strongThis->MaxHue();
-            strongThis->m_minSaturationFromLastBitmapCreation = strongThis->MinSaturation();
-            strongThis->m_maxSaturationFromLastBitmapCreation = strongThis->MaxSaturation();
-            strongThis->m_minValueFromLastBitmapCreation = strongThis->MinValue();
-            strongThis->m_maxValueFromLastBitmapCreation = strongThis->MaxValue();
-
-            strongThis->m_hsvValues = *newHsvValues;
-
-            strongThis->UpdateBitmapSources();
-            strongThis->UpdateEllipse();
+            strongThis->ApplyBitmaps(minDimension, *bitmaps);
         });
     }));
 }
 
-void ColorSpectrum::FillPixelForBox(
-    double x,
-    double y,
-    const Hsv &baseHsv,
-    double minDimension,
-    winrt::ColorSpectrumComponents components,
-    double minHue,
-    double maxHue,
-    double minSaturation,
-    double maxSaturation,
-    double minValue,
-    double maxValue,
-    shared_ptr<vector<::byte>> bgraMinPixelData,
-    shared_ptr<vector<::byte>> bgraMiddle1PixelData,
-    shared_ptr<vector<::byte>> bgraMiddle2PixelData,
-    shared_ptr<vector<::byte>> bgraMiddle3PixelData,
-    shared_ptr<vector<::byte>> bgraMiddle4PixelData,
-    shared_ptr<vector<::byte>> bgraMaxPixelData,
-    shared_ptr<vector<Hsv>> newHsvValues)
+/* static */
+winrt::IAsyncAction ColorSpectrum::FillTilesAsync(std::function<void()> fillTiles, int helperCount, std::shared_ptr<std::atomic<bool>> isCanceled)
 {
-    double hMin = minHue;
-    double hMax = maxHue;
-    double sMin = minSaturation / 100.0;
-    double sMax = maxSaturation / 100.0;
-    double vMin = minValue / 100.0;
-    double vMax = maxValue / 100.0;
-
-    Hsv hsvMin = baseHsv;
-    Hsv hsvMiddle1 = baseHsv;
-    Hsv hsvMiddle2 = baseHsv;
-    Hsv hsvMiddle3 = baseHsv;
-    Hsv hsvMiddle4 = baseHsv;
-    Hsv hsvMax = baseHsv;
-
-    double xPercent = (minDimension - 1 - x) / (minDimension - 1);
-    double yPercent = (minDimension - 1 - y) / (minDimension - 1);
+    auto cancellation = co_await winrt::get_cancellation_token();
+    cancellation.callback([isCanceled]() { *isCanceled = true; });
 
-    switch (components)
-    {
-    case winrt::ColorSpectrumComponents::HueValue:
-        hsvMin.h = hsvMiddle1.h = hsvMiddle2.h = hsvMiddle3.h = hsvMiddle4.h = hsvMax.h = hMin + yPercent * (hMax - hMin);
-        hsvMin.v = hsvMiddle1.v = hsvMiddle2.v = hsvMiddle3.v = hsvMiddle4.v = hsvMax.v = vMin + xPercent * (vMax - vMin);
-        hsvMin.s = 0;
-        hsvMax.s = 1;
-        break;
-
-    case winrt::ColorSpectrumComponents::HueSaturation:
-        hsvMin.h = hsvMiddle1.h = hsvMiddle2.h = hsvMiddle3.h = hsvMiddle4.h = hsvMax.h = hMin + yPercent * (hMax - hMin);
-        hsvMin.s = hsvMiddle1.s = hsvMiddle2.s = hsvMiddle3.s = hsvMiddle4.s = hsvMax.s = sMin + xPercent * (sMax - sMin);
-        hsvMin.v = 0;
-        hsvMax.v = 1;
-        break;
-
-    case winrt::ColorSpectrumComponents::ValueHue:
-        hsvMin.v = hsvMiddle1.v = hsvMiddle2.v = hsvMiddle3.v = hsvMiddle4.v = hsvMax.v = vMin + yPercent * (vMax - vMin);
-        hsvMin.h = hsvMiddle1.h = hsvMiddle2.h = hsvMiddle3.h = hsvMiddle4.h = hsvMax.h = hMin + xPercent * (hMax - hMin);
-        hsvMin.s = 0;
-        hsvMax.s = 1;
-        break;
-
-    case winrt::ColorSpectrumComponents::ValueSaturation:
-        hsvMin.v = hsvMiddle1.v = hsvMiddle2.v = hsvMiddle3.v = hsvMiddle4.v = hsvMax.v = vMin + yPercent * (vMax - vMin);
-        hsvMin.s = hsvMiddle1.s = hsvMiddle2.s = hsvMiddle3.s = hsvMiddle4.s = hsvMax.s = sMin + xPercent * (sMax - sMin);
-        hsvMin.h = 0;
-        hsvMiddle1.h = 60;
-        hsvMiddle2.h = 120;
-        hsvMiddle3.h = 180;
-        hsvMiddle4.h = 240;
-        hsvMax.h = 300;
-        break;
-
-    case winrt::ColorSpectrumComponents::SaturationHue:
-        hsvMin.s = hsvMiddle1.s = hsvMiddle2.s = hsvMiddle3.s = hsvMiddle4.s = hsvMax.s = sMin + yPercent * (sMax - sMin);
-        hsvMin.h = hsvMiddle1.h = hsvMiddle2.h = hsvMiddle3.h = hsvMiddle4.h = hsvMax.h = hMin + xPercent * (hMax - hMin);
-        hsvMin.v = 0;
-        hsvMax.v = 1;
-        break;
+    co_await winrt::resume_background();
 
-    case winrt::ColorSpectrumComponents::SaturationValue:
-        hsvMin.s = hsvMiddle1.s = hsvMiddle2.s = hsvMiddle3.s = hsvMiddle4.s = hsvMax.s = sMin + yPercent * (sMax - sMin);
-        hsvMin.v = hsvMiddle1.v = hsvMiddle2.v = hsvMiddle3.v = hsvMiddle4.v = hsvMax.v = vMin + xPercent * (vMax - vMin);
-        hsvMin.h = 0;
-        hsvMiddle1.h = 60;
-        hsvMiddle2.h = 120;
-        hsvMiddle3.h = 180;
-        hsvMiddle4.h = 240;
-        hsvMax.h = 300;
-        break;
-    }
-
-    // If saturation is an axis in the spectrum with hue, or value is an axis, then we want
-    // that axis to go from maximum at the top to minimum at the bottom,
-    // or maximum at the outside to minimum at the inside in the case of the ring configuration,
-    // so we'll invert the number before assigning the HSL value to the array.
-    // Otherwise, we'll have a very narrow section in the middle that actually has meaningful hue
-    // in the case of the ring configuration.
-    if (components == winrt::ColorSpectrumComponents::HueSaturation ||
-        components == winrt::ColorSpectrumComponents::SaturationHue)
+    std::vector<winrt::IAsyncAction> helpers;
+    for (int i = 0; i < helperCount; ++i)
     {
-        hsvMin.s = sMax - hsvMin.s + sMin;
-        hsvMiddle1.s = sMax - hsvMiddle1.s + sMin;
-        hsvMiddle2.s = sMax - hsvMiddle2.s + sMin;
-        hsvMiddle3.s = sMax - hsvMiddle3.s + sMin;
-        hsvMiddle4.s = sMax - hsvMiddle4.s + sMin;
-        hsvMax.s = sMax - hsvMax.s + sMin;
+        helpers.push_back(winrt::ThreadPool::RunAsync([fillTiles](winrt::IAsyncAction const&) { fillTiles(); }));
     }
-    else
-    {
-        hsvMin.v = vMax - hsvMin.v + vMin;
-        hsvMiddle1.v = vMax - hsvMiddle1.v + vMin;
-        hsvMiddle2.v = vMax - hsvMiddle2.v + vMin;
-        hsvMiddle3.v = vMax - hsvMiddle3.v + vMin;
-        hsvMiddle4.v = vMax - hsvMiddle4.v + vMin;
-        hsvMax.v = vMax - hsvMax.v + vMin;
-    }
-
-    newHsvValues->push_back(hsvMin);
-
-    Rgb rgbMin = HsvToRgb(hsvMin);
-    bgraMinPixelData->push_back(static_cast<::byte>(round(rgbMin.b * 255))); // b
-    bgraMinPixelData->push_back(static_cast<::byte>(round(rgbMin.g * 255))); // g
-    bgraMinPixelData->push_back(static_cast<::byte>(round(rgbMin.r * 255))); // r
-    bgraMinPixelData->push_back(255); // a - ignored
-
-    // We'll only save pixel data for the middle bitmaps if our third dimension is hue.
-    if (components == winrt::ColorSpectrumComponents::ValueSaturation ||
-        components == winrt::ColorSpectrumComponents::SaturationValue)
-    {
-        Rgb rgbMiddle1 = HsvToRgb(hsvMiddle1);
-        bgraMiddle1PixelData->push_back(static_cast<::byte>(round(rgbMiddle1.b * 255))); // b
-        bgraMiddle1PixelData->push_back(static_cast<::byte>(round(rgbMiddle1.g * 255))); // g
-        bgraMiddle1PixelData->push_back(static_cast<::byte>(round(rgbMiddle1.r * 255))); // r
-        bgraMiddle1PixelData->push_back(255); // a - ignored
-
-        Rgb rgbMiddle2 = HsvToRgb(hsvMiddle2);
-        bgraMiddle2PixelData->push_back(static_cast<::byte>(round(rgbMiddle2.b * 255))); // b
-        bgraMiddle2PixelData->push_back(static_cast<::byte>(round(rgbMiddle2.g * 255))); // g
-        bgraMiddle2PixelData->push_back(static_cast<::byte>(round(rgbMiddle2.r * 255))); // r
-        bgraMiddle2PixelData->push_back(255); // a - ignored
-
-        Rgb rgbMiddle3 = HsvToRgb(hsvMiddle3);
-        bgraMiddle3PixelData->push_back(static_cast<::byte>(round(rgbMiddle3.b * 255))); // b
-        bgraMiddle3PixelData->push_back(static_cast<::byte>(round(rgbMiddle3.g * 255))); // g
-        bgraMiddle3PixelData->push_back(static_cast<::byte>(round(rgbMiddle3.r * 255))); // r
-        bgraMiddle3PixelData->push_back(255); // a - ignored
-
-        Rgb rgbMiddle4 = HsvToRgb(hsvMiddle4);
-        bgraMiddle4PixelData->push_back(static_cast<::byte>(round(rgbMiddle4.b * 255))); // b
-        bgraMiddle4PixelData->push_back(static_cast<::byte>(round(rgbMiddle4.g * 255))); // g
-        bgraMiddle4PixelData->push_back(static_cast<::byte>(round(rgbMiddle4.r * 255))); // r
-        bgraMiddle4PixelData->push_back(255); // a - ignored
-    }
-
-    Rgb rgbMax = HsvToRgb(hsvMax);
-    bgraMaxPixelData->push_back(static_cast<::byte>(round(rgbMax.b * 255))); // b
-    bgraMaxPixelData->push_back(static_cast<::byte>(round(rgbMax.g * 255))); // g
-    bgraMaxPixelData->push_back(static_cast<::byte>(round(rgbMax.r * 255))); // r
-    bgraMaxPixelData->push_back(255); // a - ignored
-}
-
-void ColorSpectrum::FillPixelForRing(
-    double x,
-    double y,
-    double radius,
-    const Hsv &baseHsv,
-    winrt::ColorSpectrumComponents components,
-    double minHue,
-    double maxHue,
-    double minSaturation,
-    double maxSaturation,
-    double minValue,
-    double maxValue,
-    shared_ptr<vector<::byte>> bgraMinPixelData,
-    shared_ptr<vector<::byte>> bgraMiddle1PixelData,
-    shared_ptr<vector<::byte>> bgraMiddle2PixelData,
-    shared_ptr<vector<::byte>> bgraMiddle3PixelData,
-    shared_ptr<vector<::byte>> bgraMiddle4PixelData,
-    shared_ptr<vector<::byte>> bgraMaxPixelData,
-    shared_ptr<vector<Hsv>> newHsvValues)
-{
-    double hMin = minHue;
-    double hMax = maxHue;
-    double sMin = minSaturation / 100.0;
-    double sMax = maxSaturation / 100.0;
-    double vMin = minValue / 100.0;
-    double vMax = maxValue / 100.0;
-
-    double distanceFromRadius = sqrt(pow(x - radius, 2) + pow(y - radius, 2));
 
-    double xToUse = x;
-    double yToUse = y;
+    fillTiles();
 
-    // If we're outside the ring, then we want the pixel to appear as blank.
-    // However, to avoid issues with rounding errors, we'll act as though this point
-    // is on the edge of the ring for the purposes of returning an HSL value.
-    // That way, hittesting on the edges will always return the correct value.
-    if (distanceFromRadius > radius)
+    // Helpers that start after all the tiles have been picked up return right away. Awaiting
+    // them doesn't hold on to a thread pool thread while they finish.
+    for (auto& helper : helpers)
     {
-        xToUse = (radius / distanceFromRadius) * (x - radius) + radius;
-        yToUse = (radius / distanceFromRadius) * (y - radius) + radius;
-        distanceFromRadius = radius;
+        co_await helper;
     }
+}
 
-    Hsv hsvMin = baseHsv;
-    Hsv hsvMiddle1 = baseHsv;
-    Hsv hsvMiddle2 = baseHsv;
-    Hsv hsvMiddle3 = baseHsv;
-    Hsv hsvMiddle4 = baseHsv;
-    Hsv hsvMax = baseHsv;
-
-    double r = 1 - distanceFromRadius / radius;
+ColorSpectrum::SpectrumBitmapCache& ColorSpectrum::GetBitmapCache()
+{
+    // Shared by all the spectra in the process. That is enough for a few spectra of a typical
+    // size, with six bitmaps each, while keeping a bound on what sits around unused.
+    static SpectrumBitmapCache s_bitmapCache{ 32 * 1024 * 1024 };
+    return s_bitmapCache;
+}
 
-    double theta = atan2((radius - yToUse), (radius - xToUse)) * 180.0 / M_PI;
-    theta += 180.0;
-    theta = floor(theta);
+void ColorSpectrum::ApplyBitmaps(double minDimension, const SpectrumBitmapCache::Bitmaps& bitmaps)
+{
+    int pixelWidth = static_cast<int>(round(minDimension));
+    int pixelHeight = static_cast<int>(round(minDimension));
 
-    while (theta > 360)
-    {
-        theta -= 360;
-    }
+    const auto& bgraMinPixelData = bitmaps.PixelData[SpectrumBitmapGenerator::MinBitmap];
+    const auto& bgraMiddle1PixelData = bitmaps.PixelData[1];
+    const auto& bgraMiddle2PixelData = bitmaps.PixelData[2];
+    const auto& bgraMiddle3PixelData = bitmaps.PixelData[3];
+    const auto& bgraMiddle4PixelData = bitmaps.PixelData[4];
+    const auto& bgraMaxPixelData = bitmaps.PixelData[SpectrumBitmapGenerator::MaxBitmap];
 
-    double thetaPercent = theta / 360;
+    winrt::ColorSpectrumComponents components = Components();
 
-    switch (components)
+    if (SharedHelpers::IsRS2OrHigher())
     {
-    case winrt::ColorSpectrumComponents::HueValue:
-        hsvMin.h = hsvMiddle1.h = hsvMiddle2.h = hsvMiddle3.h = hsvMiddle4.h = hsvMax.h = hMin + thetaPercent * (hMax - hMin);
-        hsvMin.v = hsvMiddle1.v = hsvMiddle2.v = hsvMiddle3.v = hsvMiddle4.v = hsvMax.v = vMin + r * (vMax - vMin);
-        hsvMin.s = 0;
-        hsvMax.s = 1;
-        break;
-
-    case winrt::ColorSpectrumComponents::HueSaturation:
-        hsvMin.h = hsvMiddle1.h = hsvMiddle2.h = hsvMiddle3.h = hsvMiddle4.h = hsvMax.h = hMin + thetaPercent * (hMax - hMin);
-        hsvMin.s = hsvMiddle1.s = hsvMiddle2.s = hsvMiddle3.s = hsvMiddle4.s = hsvMax.s = sMin + r * (sMax - sMin);
-        hsvMin.v = 0;
-        hsvMax.v = 1;
-        break;
+        winrt::LoadedImageSurface minSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMinPixelData);
+        winrt::LoadedImageSurface maxSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMaxPixelData);
 
-    case winrt::ColorSpectrumComponents::ValueHue:
-        hsvMin.v = hsvMiddle1.v = hsvMiddle2.v = hsvMiddle3.v = hsvMiddle4.v = hsvMax.v = vMin + thetaPercent * (vMax - vMin);
-        hsvMin.h = hsvMiddle1.h = hsvMiddle2.h = hsvMiddle3.h = hsvMiddle4.h = hsvMax.h = hMin + r * (hMax - hMin);
-        hsvMin.s = 0;
-        hsvMax.s = 1;
-        break;
-
-    case winrt::ColorSpectrumComponents::ValueSaturation:
-        hsvMin.v = hsvMiddle1.v = hsvMiddle2.v = hsvMiddle3.v = hsvMiddle4.v = hsvMax.v = vMin + thetaPercent * (vMax - vMin);
-        hsvMin.s = hsvMiddle1.s = hsvMiddle2.s = hsvMiddle3.s = hsvMiddle4.s = hsvMax.s = sMin + r * (sMax - sMin);
-        hsvMin.h = 0;
-        hsvMiddle1.h = 60;
-        hsvMiddle2.h = 120;
-        hsvMiddle3.h = 180;
-        hsvMiddle4.h = 240;
-        hsvMax.h = 300;
-        break;
-
-    case winrt::ColorSpectrumComponents::SaturationHue:
-        hsvMin.s = hsvMiddle1.s = hsvMiddle2.s = hsvMiddle3.s = hsvMiddle4.s = hsvMax.s = sMin + thetaPercent * (sMax - sMin);
-        hsvMin.h = hsvMiddle1.h = hsvMiddle2.h = hsvMiddle3.h = hsvMiddle4.h = hsvMax.h = hMin + r * (hMax - hMin);
-        hsvMin.v = 0;
-        hsvMax.v = 1;
-        break;
-
-    case winrt::ColorSpectrumComponents::SaturationValue:
-        hsvMin.s = hsvMiddle1.s = hsvMiddle2.s = hsvMiddle3.s = hsvMiddle4.s = hsvMax.s = sMin + thetaPercent * (sMax - sMin);
-        hsvMin.v = hsvMiddle1.v = hsvMiddle2.v = hsvMiddle3.v = hsvMiddle4.v = hsvMax.v = vMin + r * (vMax - vMin);
-        hsvMin.h = 0;
-        hsvMiddle1.h = 60;
-        hsvMiddle2.h = 120;
-        hsvMiddle3.h = 180;
-        hsvMiddle4.h = 240;
-        hsvMax.h = 300;
-        break;
-    }
-
-    // If saturation is an axis in the spectrum with hue, or value is an axis, then we want
-    // that axis to go from maximum at the top to minimum at the bottom,
-    // or maximum at the outside to minimum at the inside in the case of the ring configuration,
-    // so we'll invert the number before assigning the HSL value to the array.
-    // Otherwise, we'll have a very narrow section in the middle that actually has meaningful hue
-    // in the case of the ring configuration.
-    if (components == winrt::ColorSpectrumComponents::HueSaturation ||
-        components == winrt::ColorSpectrumComponents::SaturationHue)
-    {
-        hsvMin.s = sMax - hsvMin.s + sMin;
-        hsvMiddle1.s = sMax - hsvMiddle1.s + sMin;
-        hsvMiddle2.s = sMax - hsvMiddle2.s + sMin;
-        hsvMiddle3.s = sMax - hsvMiddle3.s + sMin;
-        hsvMiddle4.s = sMax - hsvMiddle4.s + sMin;
-        hsvMax.s = sMax - hsvMax.s + sMin;
+        switch (components)
+        {
+        case winrt::ColorSpectrumComponents::HueValue:
+        case winrt::ColorSpectrumComponents::ValueHue:
+            m_saturationMinimumSurface = minSurface;
+            m_saturationMaximumSurface = maxSurface;
+            break;
+        case winrt::ColorSpectrumComponents::HueSaturation:
+        case winrt::ColorSpectrumComponents::SaturationHue:
+            m_valueSurface = maxSurface;
+            break;
+        case winrt::ColorSpectrumComponents::ValueSaturation:
+        case winrt::ColorSpectrumComponents::SaturationValue:
+            m_hueRedSurface = minSurface;
+            m_hueYellowSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMiddle1PixelData);
+            m_hueGreenSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMiddle2PixelData);
+            m_hueCyanSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMiddle3PixelData);
+            m_hueBlueSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMiddle4PixelData);
+            m_huePurpleSurface = maxSurface;
+            break;
+        }
     }
     else
     {
-        hsvMin.v = vMax - hsvMin.v + vMin;
-        hsvMiddle1.v = vMax - hsvMiddle1.v + vMin;
-        hsvMiddle2.v = vMax - hsvMiddle2.v + vMin;
-        hsvMiddle3.v = vMax - hsvMiddle3.v + vMin;
-        hsvMiddle4.v = vMax - hsvMiddle4.v + vMin;
-        hsvMax.v = vMax - hsvMax.v + vMin;
+        winrt::WriteableBitmap minBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMinPixelData);
+        winrt::WriteableBitmap maxBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMaxPixelData);
+
+        switch (components)
+        {
+        case winrt::ColorSpectrumComponents::HueValue:
+        case winrt::ColorSpectrumComponents::ValueHue:
+            m_saturationMinimumBitmap = minBitmap;
+            m_saturationMaximumBitmap = maxBitmap;
+            break;
+        case winrt::ColorSpectrumComponents::HueSaturation:
+        case winrt::ColorSpectrumComponents::SaturationHue:
+            m_valueBitmap = maxBitmap;
+            break;
+        case winrt::ColorSpectrumComponents::ValueSaturation:
+        case winrt::ColorSpectrumComponents::SaturationValue:
+            m_hueRedBitmap = minBitmap;
+            m_hueYellowBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMiddle1PixelData);
+            m_hueGreenBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMiddle2PixelData);
+            m_hueCyanBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMiddle3PixelData);
+            m_hueBlueBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMiddle4PixelData);
+            m_huePurpleBitmap = maxBitmap;
+            break;
+        }
     }
 
-    newHsvValues->push_back(hsvMin);
+    m_shapeFromLastBitmapCreation = Shape();
+    m_componentsFromLastBitmapCreation = Components();
+    m_imageWidthFromLastBitmapCreation = minDimension;
+    m_imageHeightFromLastBitmapCreation = minDimension;
+    m_minHueFromLastBitmapCreation = MinHue();
+    m_maxHueFromLastBitmapCreation = MaxHue();
+    m_minSaturationFromLastBitmapCreation = MinSaturation();
+    m_maxSaturationFromLastBitmapCreation = MaxSaturation();
+    m_minValueFromLastBitmapCreation = MinValue();
+    m_maxValueFromLastBitmapCreation = MaxValue();
 
-    Rgb rgbMin = HsvToRgb(hsvMin);
-    bgraMinPixelData->push_back(static_cast<::byte>(round(rgbMin.b * 255))); // b
-    bgraMinPixelData->push_back(static_cast<::byte>(round(rgbMin.g * 255))); // g
-    bgraMinPixelData->push_back(static_cast<::byte>(round(rgbMin.r * 255))); // r
-    bgraMinPixelData->push_back(255); // a
+    m_hsvValues = bitmaps.HsvValues;
 
-    // We'll only save pixel data for the middle bitmaps if our third dimension is hue.
-    if (components == winrt::ColorSpectrumComponents::ValueSaturation ||
-        components == winrt::ColorSpectrumComponents::SaturationValue)
-    {
-        Rgb rgbMiddle1 = HsvToRgb(hsvMiddle1);
-        bgraMiddle1PixelData->push_back(static_cast<::byte>(round(rgbMiddle1.b * 255))); // b
-        bgraMiddle1PixelData->push_back(static_cast<::byte>(round(rgbMiddle1.g * 255))); // g
-        bgraMiddle1PixelData->push_back(static_cast<::byte>(round(rgbMiddle1.r * 255))); // r
-        bgraMiddle1PixelData->push_back(255); // a
-
-        Rgb rgbMiddle2 = HsvToRgb(hsvMiddle2);
-        bgraMiddle2PixelData->push_back(static_cast<::byte>(round(rgbMiddle2.b * 255))); // b
-        bgraMiddle2PixelData->push_back(static_cast<::byte>(round(rgbMiddle2.g * 255))); // g
-        bgraMiddle2PixelData->push_back(static_cast<::byte>(round(rgbMiddle2.r * 255))); // r
-        bgraMiddle2PixelData->push_back(255); // a
-
-        Rgb rgbMiddle3 = HsvToRgb(hsvMiddle3);
-        bgraMiddle3PixelData->push_back(static_cast<::byte>(round(rgbMiddle3.b * 255))); // b
-        bgraMiddle3PixelData->push_back(static_cast<::byte>(round(rgbMiddle3.g * 255))); // g
-        bgraMiddle3PixelData->push_back(static_cast<::byte>(round(rgbMiddle3.r * 255))); // r
-        bgraMiddle3PixelData->push_back(255); // a
-
-        Rgb rgbMiddle4 = HsvToRgb(hsvMiddle4);
-        bgraMiddle4PixelData->push_back(static_cast<::byte>(round(rgbMiddle4.b * 255))); // b
-        bgraMiddle4PixelData->push_back(static_cast<::byte>(round(rgbMiddle4.g * 255))); // g
-        bgraMiddle4PixelData->push_back(static_cast<::byte>(round(rgbMiddle4.r * 255))); // r
-        bgraMiddle4PixelData->push_back(255); // a
-    }
-
-    Rgb rgbMax = HsvToRgb(hsvMax);
-    bgraMaxPixelData->push_back(static_cast<::byte>(round(rgbMax.b * 255))); // b
-    bgraMaxPixelData->push_back(static_cast<::byte>(round(rgbMax.g * 255))); // g
-    bgraMaxPixelData->push_back(static_cast<::byte>(round(rgbMax.r * 255))); // r
-    bgraMaxPixelData->push_back(255); // a
+    UpdateBitmapSources();
+    UpdateEllipse();
 }
 
 void ColorSpectrum::UpdateBitmapSources()
@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "ColorHelpers.h"
 #include "ColorChangedEventArgs.h"
 #include "DispatcherHelper.h"
+#include "ColorSpectrumBitmapCache.h"
 
 #include "ColorSpectrum.g.h"
 #include "ColorSpectrum.properties.h"
@@ -65,57 +68,25 @@ private:
     void UpdateColorFromPoint(const winrt::PointerPoint& point);
     void UpdateEllipse();
 
+    using SpectrumBitmapCache = ColorSpectrumBitmapCache<Hsv, winrt::ColorSpectrumComponents>;
+
+    static SpectrumBitmapCache& GetBitmapCache();
+
     void CreateBitmapsAndColorMap();
+    // Runs fillTiles on a thread pool thread and on helperCount more of them, and completes
+    // once they all return.
+    static winrt::IAsyncAction FillTilesAsync(std::function<void()> fillTiles, int helperCount, std::shared_ptr<std::atomic<bool>> isCanceled);
+    void ApplyBitmaps(double minDimension, const SpectrumBitmapCache::Bitmaps& bitmaps);
     void UpdateBitmapSources();
 
     bool SelectionEllipseShouldBeLight();
 
-    // Helpers used by CreateBitmapsAndColorMap() to fill pixel data and create bitmaps from that data.
-    static void FillPixelForBox(
-        double x,
-        double y,
-        const Hsv &baseHsv,
-        double minDimension,
-        winrt::ColorSpectrumComponents components,
-        double minHue,
-        double maxHue,
-        double minSaturation,
-        double maxSaturation,
-        double minValue,
-        double maxValue,
-        std::shared_ptr<std::vector<byte>> bgraMinPixelData,
-        std::shared_ptr<std::vector<byte>> bgraMiddle1PixelData,
-        std::shared_ptr<std::vector<byte>> bgraMiddle2PixelData,
-        std::shared_ptr<std::vector<byte>> bgraMiddle3PixelData,
-        std::shared_ptr<std::vector<byte>> bgraMiddle4PixelData,
-        std::shared_ptr<std::vector<byte>> bgraMaxPixelData,
-        std::shared_ptr<std::vector<Hsv>> newHsvValues);
-    static void FillPixelForRing(
-        double x,
-        double y,
-        double radius,
-        const Hsv &baseHsv,
-        winrt::ColorSpectrumComponents components,
-        double minHue,
-        double maxHue,
-        double minSaturation,
-        double maxSaturation,
-        double minValue,
-        double maxValue,
-        std::shared_ptr<std::vector<byte>> bgraMinPixelData,
-        std::shared_ptr<std::vector<byte>> bgraMiddle1PixelData,
-        std::shared_ptr<std::vector<byte>> bgraMiddle2PixelData,
-        std::shared_ptr<std::vector<byte>> bgraMiddle3PixelData,
-        std::shared_ptr<std::vector<byte>> bgraMiddle4PixelData,
-        std::shared_ptr<std::vector<byte>> bgraMaxPixelData,
-        std::shared_ptr<std::vector<Hsv>> newHsvValues);
-
     bool m_updatingColor;
     bool m_updatingHsvColor;
     bool m_isPointerOver;
     bool m_isPointerPressed;
     bool m_shouldShowLargeSelection;
-    std::vector<Hsv> m_hsvValues;
+    std::shared_ptr<std::vector<Hsv>> m_hsvValues;
 
     // XAML elements
     tracker_ref<winrt::Grid> m_layoutRoot{ this };
@@ -0,0 +1,182 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "ColorSpectrumBitmapGenerator.h"
+
+// Least recently used cache of the bitmaps and HSV maps that ColorSpectrum generates. What
+// gets generated only depends on the generator's parameters (size, shape, components and
+// the HSV ranges), so spectra that are laid out again, or several spectra with the same
+// parameters, can share one copy instead of generating their own.
+//
+// The cache holds on to at most CapacityInBytes() bytes, evicting the least recently used
+// entries first; entries bigger than that are not kept at all. Cached buffers are shared
+// with the callers and must not be modified. All the methods can be called from any thread.
+template <typename THsv, typename TComponents>
+class ColorSpectrumBitmapCache final
+{
+public:
+    using Generator = ColorSpectrumBitmapGenerator<THsv, TComponents>;
+    using Parameters = typename Generator::Parameters;
+
+    struct Bitmaps
+    {
+        // PixelData[1] to [4] are empty unless Generator::UsesMiddleBitmaps.
+        std::shared_ptr<std::vector<uint8_t>> PixelData[Generator::BitmapCount];
+        std::shared_ptr<std::vector<THsv>> HsvValues;
+
+        size_t SizeInBytes() const
+        {
+            size_t size = HsvValues ? HsvValues->size() * sizeof(THsv) : 0;
+            for (const auto& pixelData : PixelData)
+            {
+                size += pixelData ? pixelData->size() : 0;
+            }
+            return size;
+        }
+    };
+
+    explicit ColorSpectrumBitmapCache(size_t capacityInBytes) :
+        m_capacityInBytes(capacityInBytes)
+    {
+    }
+
+    bool TryGet(const Parameters& parameters, Bitmaps& bitmaps)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto it = m_index.find(parameters);
+        if (it == m_index.end())
+        {
+            ++m_missCount;
+            return false;
+        }
+
+        // Move the entry to the front so that it gets evicted last.
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        bitmaps = it->second->Value;
+        ++m_hitCount;
+        return true;
+    }
+
+    void Add(const Parameters& parameters, const Bitmaps& bitmaps)
+    {
+        const size_t sizeInBytes = bitmaps.SizeInBytes();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto it = m_index.find(parameters);
+        if (it != m_index.end())
+        {
+            // Another spectrum generated the same bitmaps in the meantime.
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return;
+        }
+
+        if (sizeInBytes > m_capacityInBytes)
+        {
+            return;
+        }
+
+        m_entries.push_front(Entry{ parameters, bitmaps, sizeInBytes });
+        m_index.emplace(parameters, m_entries.begin());
+        m_sizeInBytes += sizeInBytes;
+        TrimTo(m_capacityInBytes);
+    }
+
+    void SetCapacityInBytes(size_t capacityInBytes)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_capacityInBytes = capacityInBytes;
+        TrimTo(m_capacityInBytes);
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        TrimTo(0);
+    }
+
+    size_t CapacityInBytes() const { std::lock_guard<std::mutex> lock(m_mutex); return m_capacityInBytes; }
+    size_t SizeInBytes() const { std::lock_guard<std::mutex> lock(m_mutex); return m_sizeInBytes; }
+    int Count() const { std::lock_guard<std::mutex> lock(m_mutex); return static_cast<int>(m_entries.size()); }
+    int HitCount() const { std::lock_guard<std::mutex> lock(m_mutex); return m_hitCount; }
+    int MissCount() const { std::lock_guard<std::mutex> lock(m_mutex); return m_missCount; }
+
+private:
+    struct Entry
+    {
+        Parameters Key;
+        Bitmaps Value;
+        size_t SizeInBytes;
+    };
+
+    struct ParametersHash
+    {
+        size_t operator()(const Parameters& parameters) const
+        {
+            size_t hash = std::hash<int>()(parameters.Size);
+            const int fields[] =
+            {
+                parameters.IsRing ? 1 : 0,
+                static_cast<int>(parameters.Components),
+                parameters.MinHue,
+                parameters.MaxHue,
+                parameters.MinSaturation,
+                parameters.MaxSaturation,
+                parameters.MinValue,
+                parameters.MaxValue,
+            };
+
+            for (const int field : fields)
+            {
+                hash = hash * 31 + std::hash<int>()(field);
+            }
+            return hash;
+        }
+    };
+
+    struct ParametersEqual
+    {
+        bool operator()(const Parameters& lhs, const Parameters& rhs) const
+        {
+            return
+                lhs.Size == rhs.Size &&
+                lhs.IsRing == rhs.IsRing &&
+                lhs.Components == rhs.Components &&
+                lhs.MinHue == rhs.MinHue &&
+                lhs.MaxHue == rhs.MaxHue &&
+                lhs.MinSaturation == rhs.MinSaturation &&
+                lhs.MaxSaturation == rhs.MaxSaturation &&
+                lhs.MinValue == rhs.MinValue &&
+                lhs.MaxValue == rhs.MaxValue;
+        }
+    };
+
+    // Evicts the least recently used entries until at most capacityInBytes are in use.
+    // Spectra that still show an evicted entry keep their own reference to its buffers.
+    void TrimTo(size_t capacityInBytes)
+    {
+        while (m_sizeInBytes > capacityInBytes)
+        {
+            const Entry& last = m_entries.back();
+            m_sizeInBytes -= last.SizeInBytes;
+            m_index.erase(last.Key);
+            m_entries.pop_back();
+        }
+    }
+
+    mutable std::mutex m_mutex;
+    std::list<Entry> m_entries;
+    std::unordered_map<Parameters, typename std::list<Entry>::iterator, ParametersHash, ParametersEqual> m_index;
+    size_t m_capacityInBytes{};
+    size_t m_sizeInBytes{};
+    int m_hitCount{};
+    int m_missCount{};
+};
@@ -0,0 +1,429 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SPECTRUM_BITMAP_SSE2 1
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define SPECTRUM_BITMAP_NEON 1
+#endif
+
+// Fills the BGRA pixel data and the HSV map behind ColorSpectrum's bitmaps. See
+// ColorSpectrum::CreateBitmapsAndColorMap for why there are up to six bitmaps.
+//
+// Callers hand in preallocated buffers (Size * Size * 4 bytes per bitmap and Size * Size
+// HSV values) and fill them a range of rows at a time. Ranges don't share any state, so
+// disjoint ranges can be filled on different threads. The HSV to RGB conversion runs two
+// pixels at a time with SSE2 or NEON and is bit for bit the same as HsvToRgb.
+//
+// THsv is constructible from (h, s, v) and TComponents has the enumerators of
+// ColorSpectrumComponents, so that this can run outside of a XAML context.
+template <typename THsv, typename TComponents>
+class ColorSpectrumBitmapGenerator final
+{
+public:
+    // The bitmaps with the third dimension at its minimum, at the four stops in between
+    // (only used when hue is the third dimension) and at its maximum.
+    static constexpr int BitmapCount = 6;
+    static constexpr int MinBitmap = 0;
+    static constexpr int MaxBitmap = 5;
+
+    struct Parameters
+    {
+        int Size;
+        bool IsRing;
+        TComponents Components;
+        int MinHue;
+        int MaxHue;
+        int MinSaturation;
+        int MaxSaturation;
+        int MinValue;
+        int MaxValue;
+    };
+
+    // bgraPixelData[1] to [4] can be null unless UsesMiddleBitmaps(parameters.Components).
+    ColorSpectrumBitmapGenerator(const Parameters& parameters, uint8_t* const (&bgraPixelData)[BitmapCount], THsv* hsvValues) :
+        m_parameters(parameters),
+        m_hsvValues(hsvValues),
+        m_sMin(parameters.MinSaturation / 100.0),
+        m_sMax(parameters.MaxSaturation / 100.0),
+        m_vMin(parameters.MinValue / 100.0),
+        m_vMax(parameters.MaxValue / 100.0)
+    {
+        std::copy(std::begin(bgraPixelData), std::end(bgraPixelData), std::begin(m_bgraPixelData));
+    }
+
+    static bool UsesMiddleBitmaps(TComponents components)
+    {
+        return components == TComponents::ValueSaturation || components == TComponents::SaturationValue;
+    }
+
+    int RowCount() const { return m_parameters.Size; }
+
+    // Fills the pixels of rows [rowBegin, rowEnd) in every bitmap and in the HSV map.
+    void FillRows(int rowBegin, int rowEnd) const
+    {
+        const int size = m_parameters.Size;
+        std::vector<double> hues(size);
+        std::vector<double> saturations(size);
+        std::vector<double> values(size);
+
+        for (int row = rowBegin; row < rowEnd; ++row)
+        {
+            for (int column = 0; column < size; ++column)
+            {
+                double first = 0;
+                double second = 0;
+                if (m_parameters.IsRing)
+                {
+                    GetRingPercentages(column, row, first, second);
+                }
+                else
+                {
+                    GetBoxPercentages(column, row, first, second);
+                }
+
+                SetAxes(first, second, hues[column], saturations[column], values[column]);
+            }
+
+            const size_t rowOffset = static_cast<size_t>(row) * size;
+            for (int bitmap = 0; bitmap < BitmapCount; ++bitmap)
+            {
+                if (!m_bgraPixelData[bitmap])
+                {
+                    continue;
+                }
+
+                SetThirdDimension(bitmap, hues.data(), saturations.data(), values.data());
+                if (bitmap == MinBitmap)
+                {
+                    for (int column = 0; column < size; ++column)
+                    {
+                        m_hsvValues[rowOffset + column] = THsv(hues[column], saturations[column], values[column]);
+                    }
+                }
+
+                HsvToBgra(hues.data(), saturations.data(), values.data(), size, m_bgraPixelData[bitmap] + rowOffset * 4);
+            }
+        }
+    }
+
+    // Same as HsvToRgb followed by rounding each channel to a byte. Alpha is always 255.
+    static void HsvToBgra(const double* hues, const double* saturations, const double* values, int count, uint8_t* bgra)
+    {
+        int i = 0;
+#if defined(SPECTRUM_BITMAP_SSE2)
+        for (; i + 1 < count; i += 2)
+        {
+            HsvToBgraSse2(hues + i, saturations + i, values + i, bgra + i * 4);
+        }
+#elif defined(SPECTRUM_BITMAP_NEON)
+        for (; i + 1 < count; i += 2)
+        {
+            HsvToBgraNeon(hues + i, saturations + i, values + i, bgra + i * 4);
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            HsvToBgraScalar(hues[i], saturations[i], values[i], bgra + i * 4);
+        }
+    }
+
+private:
+    // Box: the first axis runs along the columns and the second along the rows.
+    void GetBoxPercentages(int column, int row, double& first, double& second) const
+    {
+        const double extent = m_parameters.Size - 1;
+        first = extent > 0 ? column / extent : 0.0;
+        second = extent > 0 ? row / extent : 0.0;
+    }
+
+    // Ring: the first axis is the angle and the second the distance from the edge.
+    void GetRingPercentages(int column, int row, double& first, double& second) const
+    {
+        const double radius = m_parameters.Size / 2.0;
+        const double dx = column - radius;
+        const double dy = row - radius;
+        double distanceFromRadius = std::sqrt(dx * dx + dy * dy);
+
+        double xToUse = column;
+        double yToUse = row;
+
+        // If we're outside the ring, then we want the pixel to appear as blank.
+        // However, to avoid issues with rounding errors, we'll act as though this point
+        // is on the edge of the ring for the purposes of returning an HSL value.
+        // That way, hittesting on the edges will always return the correct value.
+        if (distanceFromRadius > radius)
+        {
+            xToUse = (radius / distanceFromRadius) * dx + radius;
+            yToUse = (radius / distanceFromRadius) * dy + radius;
+            distanceFromRadius = radius;
+        }
+
+        double theta = std::atan2((radius - yToUse), (radius - xToUse)) * 180.0 / 3.14159265358979323846;
+        theta += 180.0;
+        theta = std::floor(theta);
+
+        while (theta > 360)
+        {
+            theta -= 360;
+        }
+
+        first = theta / 360;
+        second = 1 - distanceFromRadius / radius;
+    }
+
+    void SetAxes(double first, double second, double& h, double& s, double& v) const
+    {
+        const double hMin = m_parameters.MinHue;
+        const double hMax = m_parameters.MaxHue;
+
+        switch (m_parameters.Components)
+        {
+        case TComponents::HueValue:
+            h = hMin + first * (hMax - hMin);
+            v = m_vMin + second * (m_vMax - m_vMin);
+            break;
+        case TComponents::HueSaturation:
+            h = hMin + first * (hMax - hMin);
+            s = m_sMin + second * (m_sMax - m_sMin);
+            break;
+        case TComponents::ValueHue:
+            v = m_vMin + first * (m_vMax - m_vMin);
+            h = hMin + second * (hMax - hMin);
+            break;
+        case TComponents::ValueSaturation:
+            v = m_vMin + first * (m_vMax - m_vMin);
+            s = m_sMin + second * (m_sMax - m_sMin);
+            break;
+        case TComponents::SaturationHue:
+            s = m_sMin + first * (m_sMax - m_sMin);
+            h = hMin + second * (hMax - hMin);
+            break;
+        case TComponents::SaturationValue:
+            s = m_sMin + first * (m_sMax - m_sMin);
+            v = m_vMin + second * (m_vMax - m_vMin);
+            break;
+        }
+
+        // If saturation is an axis in the spectrum with hue, or value is an axis, then we want
+        // that axis to go from maximum at the top to minimum at the bottom,
+        // or maximum at the outside to minimum at the inside in the case of the ring configuration,
+        // so we'll invert the number before assigning the HSL value to the array.
+        if (m_parameters.Components == TComponents::HueSaturation ||
+            m_parameters.Components == TComponents::SaturationHue)
+        {
+            s = m_sMax - s + m_sMin;
+        }
+        else
+        {
+            v = m_vMax - v + m_vMin;
+        }
+    }
+
+    void SetThirdDimension(int bitmap, double* hues, double* saturations, double* values) const
+    {
+        const int size = m_parameters.Size;
+        switch (m_parameters.Components)
+        {
+        case TComponents::HueValue:
+        case TComponents::ValueHue:
+            std::fill(saturations, saturations + size, bitmap == MinBitmap ? 0.0 : 1.0);
+            break;
+        case TComponents::HueSaturation:
+        case TComponents::SaturationHue:
+            std::fill(values, values + size, bitmap == MinBitmap ? 0.0 : 1.0);
+            break;
+        case TComponents::ValueSaturation:
+        case TComponents::SaturationValue:
+            // Red, yellow, green, cyan, blue and purple.
+            std::fill(hues, hues + size, bitmap * 60.0);
+            break;
+        }
+    }
+
+    static uint8_t ToByte(double channel)
+    {
+        return static_cast<uint8_t>(std::round(channel * 255));
+    }
+
+    static void HsvToBgraScalar(double hue, double saturation, double value, uint8_t* bgra)
+    {
+        while (hue >= 360.0)
+        {
+            hue -= 360.0;
+        }
+
+        while (hue < 0.0)
+        {
+            hue += 360.0;
+        }
+
+        saturation = std::min(std::max(saturation, 0.0), 1.0);
+        value = std::min(std::max(value, 0.0), 1.0);
+
+        const double chroma = saturation * value;
+        const double min = value - chroma;
+        const double max = chroma + min;
+        const int sextant = static_cast<int>(hue / 60);
+        const double intermediateColorPercentage = hue / 60 - sextant;
+        const double rising = min + chroma * intermediateColorPercentage;
+        const double falling = min + chroma * (1 - intermediateColorPercentage);
+
+        double r = min;
+        double g = min;
+        double b = min;
+        if (chroma != 0)
+        {
+            switch (sextant)
+            {
+            case 0: r = max; g = rising; break;
+            case 1: r = falling; g = max; break;
+            case 2: g = max; b = rising; break;
+            case 3: g = falling; b = max; break;
+            case 4: r = rising; b = max; break;
+            case 5: r = max; b = falling; break;
+            }
+        }
+
+        bgra[0] = ToByte(b);
+        bgra[1] = ToByte(g);
+        bgra[2] = ToByte(r);
+        bgra[3] = 255;
+    }
+
+    // Hues outside of [0, 360) are rare (the spectrum never produces them), so the
+    // vector paths hand those pairs to the scalar path rather than wrapping them.
+    static bool IsHueInRange(double hue) { return hue >= 0.0 && hue < 360.0; }
+
+#if defined(SPECTRUM_BITMAP_SSE2)
+    static void HsvToBgraSse2(const double* hues, const double* saturations, const double* values, uint8_t* bgra)
+    {
+        if (!IsHueInRange(hues[0]) || !IsHueInRange(hues[1]))
+        {
+            HsvToBgraScalar(hues[0], saturations[0], values[0], bgra);
+            HsvToBgraScalar(hues[1], saturations[1], values[1], bgra + 4);
+            return;
+        }
+
+        const __m128d zero = _mm_setzero_pd();
+        const __m128d one = _mm_set1_pd(1.0);
+        const __m128d saturation = _mm_min_pd(_mm_max_pd(_mm_loadu_pd(saturations), zero), one);
+        const __m128d value = _mm_min_pd(_mm_max_pd(_mm_loadu_pd(values), zero), one);
+        const __m128d sixtieth = _mm_div_pd(_mm_loadu_pd(hues), _mm_set1_pd(60.0));
+
+        const __m128d chroma = _mm_mul_pd(saturation, value);
+        const __m128d min = _mm_sub_pd(value, chroma);
+        const __m128d max = _mm_add_pd(chroma, min);
+        const __m128d sextant = _mm_cvtepi32_pd(_mm_cvttpd_epi32(sixtieth));
+        const __m128d percentage = _mm_sub_pd(sixtieth, sextant);
+        const __m128d rising = _mm_add_pd(min, _mm_mul_pd(chroma, percentage));
+        const __m128d falling = _mm_add_pd(min, _mm_mul_pd(chroma, _mm_sub_pd(one, percentage)));
+
+        const auto isSextant = [&sextant](double s) { return _mm_cmpeq_pd(sextant, _mm_set1_pd(s)); };
+        const auto select = [](__m128d mask, __m128d ifTrue, __m128d ifFalse) { return _mm_or_pd(_mm_and_pd(mask, ifTrue), _mm_andnot_pd(mask, ifFalse)); };
+        const __m128d s0 = isSextant(0);
+        const __m128d s1 = isSextant(1);
+        const __m128d s2 = isSextant(2);
+        const __m128d s3 = isSextant(3);
+        const __m128d s4 = isSextant(4);
+        const __m128d s5 = isSextant(5);
+
+        // When chroma is 0, max, rising and falling are all equal to min.
+        __m128d r = select(_mm_or_pd(s0, s5), max, select(s1, falling, select(s4, rising, min)));
+        __m128d g = select(_mm_or_pd(s1, s2), max, select(s0, rising, select(s3, falling, min)));
+        __m128d b = select(_mm_or_pd(s3, s4), max, select(s2, rising, select(s5, falling, min)));
+
+        alignas(16) int32_t channels[3][4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(channels[0]), RoundToInt(b));
+        _mm_store_si128(reinterpret_cast<__m128i*>(channels[1]), RoundToInt(g));
+        _mm_store_si128(reinterpret_cast<__m128i*>(channels[2]), RoundToInt(r));
+        for (int pixel = 0; pixel < 2; ++pixel)
+        {
+            bgra[pixel * 4 + 0] = static_cast<uint8_t>(channels[0][pixel]);
+            bgra[pixel * 4 + 1] = static_cast<uint8_t>(channels[1][pixel]);
+            bgra[pixel * 4 + 2] = static_cast<uint8_t>(channels[2][pixel]);
+            bgra[pixel * 4 + 3] = 255;
+        }
+    }
+
+    // round(channel * 255) for channels in [0, 1]: truncate, then add one if the
+    // fraction is at least a half (std::round rounds halfway cases up).
+    static __m128i RoundToInt(__m128d channel)
+    {
+        const __m128d scaled = _mm_mul_pd(channel, _mm_set1_pd(255.0));
+        const __m128i truncated = _mm_cvttpd_epi32(scaled);
+        const __m128d roundUp = _mm_cmpge_pd(_mm_sub_pd(scaled, _mm_cvtepi32_pd(truncated)), _mm_set1_pd(0.5));
+        // The compare produces all ones (-1) per lane; only the low 32 bits of each lane are kept.
+        const __m128i roundUpMask = _mm_shuffle_epi32(_mm_castpd_si128(roundUp), _MM_SHUFFLE(3, 3, 2, 0));
+        return _mm_sub_epi32(truncated, _mm_and_si128(roundUpMask, _mm_set_epi32(0, 0, -1, -1)));
+    }
+#elif defined(SPECTRUM_BITMAP_NEON)
+    static void HsvToBgraNeon(const double* hues, const double* saturations, const double* values, uint8_t* bgra)
+    {
+        if (!IsHueInRange(hues[0]) || !IsHueInRange(hues[1]))
+        {
+            HsvToBgraScalar(hues[0], saturations[0], values[0], bgra);
+            HsvToBgraScalar(hues[1], saturations[1], values[1], bgra + 4);
+            return;
+        }
+
+        const float64x2_t zero = vdupq_n_f64(0.0);
+        const float64x2_t one = vdupq_n_f64(1.0);
+        const float64x2_t saturation = vminq_f64(vmaxq_f64(vld1q_f64(saturations), zero), one);
+        const float64x2_t value = vminq_f64(vmaxq_f64(vld1q_f64(values), zero), one);
+        const float64x2_t sixtieth = vdivq_f64(vld1q_f64(hues), vdupq_n_f64(60.0));
+
+        const float64x2_t chroma = vmulq_f64(saturation, value);
+        const float64x2_t min = vsubq_f64(value, chroma);
+        const float64x2_t max = vaddq_f64(chroma, min);
+        const float64x2_t sextant = vcvtq_f64_s64(vcvtq_s64_f64(sixtieth));
+        const float64x2_t percentage = vsubq_f64(sixtieth, sextant);
+        const float64x2_t rising = vaddq_f64(min, vmulq_f64(chroma, percentage));
+        const float64x2_t falling = vaddq_f64(min, vmulq_f64(chroma, vsubq_f64(one, percentage)));
+
+        const auto isSextant = [&sextant](double s) { return vceqq_f64(sextant, vdupq_n_f64(s)); };
+        const uint64x2_t s0 = isSextant(0);
+        const uint64x2_t s1 = isSextant(1);
+        const uint64x2_t s2 = isSextant(2);
+        const uint64x2_t s3 = isSextant(3);
+        const uint64x2_t s4 = isSextant(4);
+        const uint64x2_t s5 = isSextant(5);
+
+        // When chroma is 0, max, rising and falling are all equal to min.
+        const float64x2_t r = vbslq_f64(vorrq_u64(s0, s5), max, vbslq_f64(s1, falling, vbslq_f64(s4, rising, min)));
+        const float64x2_t g = vbslq_f64(vorrq_u64(s1, s2), max, vbslq_f64(s0, rising, vbslq_f64(s3, falling, min)));
+        const float64x2_t b = vbslq_f64(vorrq_u64(s3, s4), max, vbslq_f64(s2, rising, vbslq_f64(s5, falling, min)));
+
+        // vcvtaq rounds halfway cases away from zero, like std::round.
+        const float64x2_t scale = vdupq_n_f64(255.0);
+        int64_t channels[3][2];
+        vst1q_s64(channels[0], vcvtaq_s64_f64(vmulq_f64(b, scale)));
+        vst1q_s64(channels[1], vcvtaq_s64_f64(vmulq_f64(g, scale)));
+        vst1q_s64(channels[2], vcvtaq_s64_f64(vmulq_f64(r, scale)));
+        for (int pixel = 0; pixel < 2; ++pixel)
+        {
+            bgra[pixel * 4 + 0] = static_cast<uint8_t>(channels[0][pixel]);
+            bgra[pixel * 4 + 1] = static_cast<uint8_t>(channels[1][pixel]);
+            bgra[pixel * 4 + 2] = static_cast<uint8_t>(channels[2][pixel]);
+            bgra[pixel * 4 + 3] = 255;
+        }
+    }
+#endif
+
+    Parameters m_parameters;
+    uint8_t* m_bgraPixelData[BitmapCount]{};
+    THsv* m_hsvValues;
+    double m_sMin;
+    double m_sMax;
+    double m_vMin;
+    double m_vMax;
+};
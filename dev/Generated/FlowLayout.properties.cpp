@@ -13,6 +13,7 @@ namespace winrt::Microsoft::UI::Xaml::Controls
 
 #include "FlowLayout.g.cpp"
 
+GlobalDependencyProperty FlowLayoutProperties::s_IsMeasuredSizeIndexEnabledProperty{ nullptr };
 GlobalDependencyProperty FlowLayoutProperties::s_LineAlignmentProperty{ nullptr };
 GlobalDependencyProperty FlowLayoutProperties::s_MinColumnSpacingProperty{ nullptr };
 GlobalDependencyProperty FlowLayoutProperties::s_MinRowSpacingProperty{ nullptr };
@@ -25,6 +26,17 @@ FlowLayoutProperties::FlowLayoutProperties()
 
 void FlowLayoutProperties::EnsureProperties()
 {
+    if (!s_IsMeasuredSizeIndexEnabledProperty)
+    {
+        s_IsMeasuredSizeIndexEnabledProperty =
+            InitializeDependencyProperty(
+                L"IsMeasuredSizeIndexEnabled",
+                winrt::name_of<bool>(),
+                winrt::name_of<winrt::FlowLayout>(),
+                false /* isAttached */,
+                ValueHelper<bool>::BoxValueIfNecessary(false),
+                winrt::PropertyChangedCallback(&OnIsMeasuredSizeIndexEnabledPropertyChanged));
+    }
     if (!s_LineAlignmentProperty)
     {
         s_LineAlignmentProperty =
@@ -73,12 +85,21 @@ void FlowLayoutProperties::EnsureProperties()
 
 void FlowLayoutProperties::ClearProperties()
 {
+    s_IsMeasuredSizeIndexEnabledProperty = nullptr;
     s_LineAlignmentProperty = nullptr;
     s_MinColumnSpacingProperty = nullptr;
     s_MinRowSpacingProperty = nullptr;
     s_OrientationProperty = nullptr;
 }
 
+void FlowLayoutProperties::OnIsMeasuredSizeIndexEnabledPropertyChanged(
+    winrt::DependencyObject const& sender,
+    winrt::DependencyPropertyChangedEventArgs const& args)
+{
+    auto owner = sender.as<winrt::FlowLayout>();
+    winrt::get_self<FlowLayout>(owner)->OnPropertyChanged(args);
+}
+
 void FlowLayoutProperties::OnLineAlignmentPropertyChanged(
     winrt::DependencyObject const& sender,
     winrt::DependencyPropertyChangedEventArgs const& args)
@@ -111,6 +132,16 @@ void FlowLayoutProperties::OnOrientationPropertyChanged(
     winrt::get_self<FlowLayout>(owner)->OnPropertyChanged(args);
 }
 
+void FlowLayoutProperties::IsMeasuredSizeIndexEnabled(bool value)
+{
+    static_cast<FlowLayout*>(this)->SetValue(s_IsMeasuredSizeIndexEnabledProperty, ValueHelper<bool>::BoxValueIfNecessary(value));
+}
+
+bool FlowLayoutProperties::IsMeasuredSizeIndexEnabled()
+{
+    return ValueHelper<bool>::CastOrUnbox(static_cast<FlowLayout*>(this)->GetValue(s_IsMeasuredSizeIndexEnabledProperty));
+}
+
 void FlowLayoutProperties::LineAlignment(winrt::FlowLayoutLineAlignment const& value)
 {
     static_cast<FlowLayout*>(this)->SetValue(s_LineAlignmentProperty, ValueHelper<winrt::FlowLayoutLineAlignment>::BoxValueIfNecessary(value));
@@ -9,6 +9,9 @@ class FlowLayoutProperties
 public:
     FlowLayoutProperties();
 
+    void IsMeasuredSizeIndexEnabled(bool value);
+    bool IsMeasuredSizeIndexEnabled();
+
     void LineAlignment(winrt::FlowLayoutLineAlignment const& value);
     winrt::FlowLayoutLineAlignment LineAlignment();
 
@@ -21,11 +24,13 @@ public:
     void Orientation(winrt::Orientation const& value);
     winrt::Orientation Orientation();
 
+    static winrt::DependencyProperty IsMeasuredSizeIndexEnabledProperty() { return s_IsMeasuredSizeIndexEnabledProperty; }
     static winrt::DependencyProperty LineAlignmentProperty() { return s_LineAlignmentProperty; }
     static winrt::DependencyProperty MinColumnSpacingProperty() { return s_MinColumnSpacingProperty; }
     static winrt::DependencyProperty MinRowSpacingProperty() { return s_MinRowSpacingProperty; }
     static winrt::DependencyProperty OrientationProperty() { return s_OrientationProperty; }
 
+    static GlobalDependencyProperty s_IsMeasuredSizeIndexEnabledProperty;
     static GlobalDependencyProperty s_LineAlignmentProperty;
     static GlobalDependencyProperty s_MinColumnSpacingProperty;
     static GlobalDependencyProperty s_MinRowSpacingProperty;
@@ -34,6 +39,10 @@ public:
     static void EnsureProperties();
     static void ClearProperties();
 
+    static void OnIsMeasuredSizeIndexEnabledPropertyChanged(
+        winrt::DependencyObject const& sender,
+        winrt::DependencyPropertyChangedEventArgs const& args);
+
     static void OnLineAlignmentPropertyChanged(
         winrt::DependencyObject const& sender,
         winrt::DependencyPropertyChangedEventArgs const& args);
@@ -14,6 +14,7 @@ namespace winrt::Microsoft::UI::Xaml::Controls
 #include "StackLayout.g.cpp"
 
 GlobalDependencyProperty StackLayoutProperties::s_DisableVirtualizationProperty{ nullptr };
+GlobalDependencyProperty StackLayoutProperties::s_IsMeasuredSizeIndexEnabledProperty{ nullptr };
 GlobalDependencyProperty StackLayoutProperties::s_OrientationProperty{ nullptr };
 GlobalDependencyProperty StackLayoutProperties::s_SpacingProperty{ nullptr };
 
@@ -35,6 +36,17 @@ void StackLayoutProperties::EnsureProperties()
                 ValueHelper<bool>::BoxedDefaultValue(),
                 winrt::PropertyChangedCallback(&OnDisableVirtualizationPropertyChanged));
     }
+    if (!s_IsMeasuredSizeIndexEnabledProperty)
+    {
+        s_IsMeasuredSizeIndexEnabledProperty =
+            InitializeDependencyProperty(
+                L"IsMeasuredSizeIndexEnabled",
+                winrt::name_of<bool>(),
+                winrt::name_of<winrt::StackLayout>(),
+                false /* isAttached */,
+                ValueHelper<bool>::BoxValueIfNecessary(false),
+                winrt::PropertyChangedCallback(&OnIsMeasuredSizeIndexEnabledPropertyChanged));
+    }
     if (!s_OrientationProperty)
     {
         s_OrientationProperty =
@@ -62,6 +74,7 @@ void StackLayoutProperties::EnsureProperties()
 void StackLayoutProperties::ClearProperties()
 {
     s_DisableVirtualizationProperty = nullptr;
+    s_IsMeasuredSizeIndexEnabledProperty = nullptr;
     s_OrientationProperty = nullptr;
     s_SpacingProperty = nullptr;
 }
@@ -74,6 +87,14 @@ void StackLayoutProperties::OnDisableVirtualizationPropertyChanged(
     winrt::get_self<StackLayout>(owner)->OnPropertyChanged(args);
 }
 
+void StackLayoutProperties::OnIsMeasuredSizeIndexEnabledPropertyChanged(
+    winrt::DependencyObject const& sender,
+    winrt::DependencyPropertyChangedEventArgs const& args)
+{
+    auto owner = sender.as<winrt::StackLayout>();
+    winrt::get_self<StackLayout>(owner)->OnPropertyChanged(args);
+}
+
 void StackLayoutProperties::OnOrientationPropertyChanged(
     winrt::DependencyObject const& sender,
     winrt::DependencyPropertyChangedEventArgs const& args)
@@ -100,6 +121,16 @@ bool StackLayoutProperties::DisableVirtualization()
     return ValueHelper<bool>::CastOrUnbox(static_cast<StackLayout*>(this)->GetValue(s_DisableVirtualizationProperty));
 }
 
+void StackLayoutProperties::IsMeasuredSizeIndexEnabled(bool value)
+{
+    static_cast<StackLayout*>(this)->SetValue(s_IsMeasuredSizeIndexEnabledProperty, ValueHelper<bool>::BoxValueIfNecessary(value));
+}
+
+bool StackLayoutProperties::IsMeasuredSizeIndexEnabled()
+{
+    return ValueHelper<bool>::CastOrUnbox(static_cast<StackLayout*>(this)->GetValue(s_IsMeasuredSizeIndexEnabledProperty));
+}
+
 void StackLayoutProperties::Orientation(winrt::Orientation const& value)
 {
     static_cast<StackLayout*>(this)->SetValue(s_OrientationProperty, ValueHelper<winrt::Orientation>::BoxValueIfNecessary(value));
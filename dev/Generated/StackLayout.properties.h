@@ -12,6 +12,9 @@ public:
     void DisableVirtualization(bool value);
     bool DisableVirtualization();
 
+    void IsMeasuredSizeIndexEnabled(bool value);
+    bool IsMeasuredSizeIndexEnabled();
+
     void Orientation(winrt::Orientation const& value);
     winrt::Orientation Orientation();
 
@@ -19,10 +22,12 @@ public:
     double Spacing();
 
     static winrt::DependencyProperty DisableVirtualizationProperty() { return s_DisableVirtualizationProperty; }
+    static winrt::DependencyProperty IsMeasuredSizeIndexEnabledProperty() { return s_IsMeasuredSizeIndexEnabledProperty; }
     static winrt::DependencyProperty OrientationProperty() { return s_OrientationProperty; }
     static winrt::DependencyProperty SpacingProperty() { return s_SpacingProperty; }
 
     static GlobalDependencyProperty s_DisableVirtualizationProperty;
+    static GlobalDependencyProperty s_IsMeasuredSizeIndexEnabledProperty;
     static GlobalDependencyProperty s_OrientationProperty;
     static GlobalDependencyProperty s_SpacingProperty;
 
@@ -33,6 +38,10 @@ public:
         winrt::DependencyObject const& sender,
         winrt::DependencyPropertyChangedEventArgs const& args);
 
+    static void OnIsMeasuredSizeIndexEnabledPropertyChanged(
+        winrt::DependencyObject const& sender,
+        winrt::DependencyPropertyChangedEventArgs const& args);
+
     static void OnOrientationPropertyChanged(
         winrt::DependencyObject const& sender,
         winrt::DependencyPropertyChangedEventArgs const& args);
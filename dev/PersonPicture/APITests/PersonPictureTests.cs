@@ -190,5 +190,37 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
                 Verify.AreEqual(initialsTextBlock.Text, "\xE716");
             });
         }
+
+        [TestMethod]
+        public void VerifyInitialsFromDisplayName()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var expectedInitials = new[]
+                {
+                    Tuple.Create("Jane Smith", "JS"),
+                    Tuple.Create("jane", "J"),
+                    Tuple.Create("  Jane   van der Smith  ", "JS"),
+                    Tuple.Create("John Smith (OSG)", "JS"),
+                    Tuple.Create("'Jane' -Smith", "JS"),
+                    Tuple.Create("E\u0301lodie Dupont", "E\u0301D"),
+                    Tuple.Create("\u674E\u5C0F\u9F99", ""),
+                    Tuple.Create("\u0645\u062D\u0645\u062F", ""),
+                    Tuple.Create("   ", ""),
+                };
+
+                // Go through the names twice, so that the second time around the initials come
+                // from the cache of recently used names, on a different PersonPicture.
+                for (int pass = 0; pass < 2; pass++)
+                {
+                    var personPicture = new PersonPicture();
+                    foreach (var nameAndInitials in expectedInitials)
+                    {
+                        personPicture.DisplayName = nameAndInitials.Item1;
+                        Verify.AreEqual(nameAndInitials.Item2, personPicture.TemplateSettings.ActualInitials, "Initials of '" + nameAndInitials.Item1 + "'");
+                    }
+                }
+            });
+        }
     }
 }
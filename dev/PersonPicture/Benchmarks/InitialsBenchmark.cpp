@@ -0,0 +1,330 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+// Headless micro-benchmark for the initials of display names. Computes the initials of a corpus
+// of mixed script names (Latin, Cyrillic, Greek, CJK, Arabic, Devanagari and names with
+// surrogate pairs) once the way InitialsGenerator used to (copying the name and splitting it
+// with a wistringstream) and once with InitialsTokenizer. Returns a non zero exit code if any
+// initials differ, or if InitialsTokenizer allocates.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwctype>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "InitialsTokenizer.h"
+
+namespace
+{
+    size_t s_allocationCount = 0;
+}
+
+void* operator new(size_t size)
+{
+    ++s_allocationCount;
+    if (void* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace
+{
+    // Copy of what InitialsGenerator::InitialsFromDisplayName used to do.
+    namespace Old
+    {
+        std::wstring GetFirstFullCharacter(const std::wstring& str)
+        {
+            unsigned int start = 0;
+
+            while (start < str.size())
+            {
+                wchar_t character = str.at(start);
+
+                if ((character >= 0x0021) && (character <= 0x002F))
+                {
+                    start++;
+                    continue;
+                }
+
+                if ((character >= 0x003A) && (character <= 0x0040))
+                {
+                    start++;
+                    continue;
+                }
+
+                if ((character >= 0x007B) && (character <= 0x007E))
+                {
+                    start++;
+                    continue;
+                }
+
+                break;
+            }
+
+            if (start >= str.size())
+            {
+                start = 0;
+            }
+
+            unsigned int index = start + 1;
+
+            while (index < str.size())
+            {
+                wchar_t character = str.at(index);
+
+                if ((character < 0x0300) || (character > 0x036F))
+                {
+                    break;
+                }
+
+                index++;
+            }
+
+            unsigned int strLength = index - start;
+
+            std::wstring result(&str.at(start), strLength);
+            return result;
+        }
+
+        std::vector<std::wstring> Split(const std::wstring& source, wchar_t delim, int maxIterations = 25)
+        {
+            std::vector<std::wstring> result;
+
+            std::wistringstream buffer(source);
+
+            int i = 0;
+
+            for (std::wstring token; std::getline(buffer, token, delim);)
+            {
+                if (!token.empty())
+                {
+                    result.push_back(token);
+                }
+                if (++i >= maxIterations)
+                {
+                    break;
+                }
+            }
+
+            return result;
+        }
+
+        void StripTrailingBrackets(std::wstring& source)
+        {
+            std::wstring_view delimiters[] = { L"{}", L"()", L"[]" };
+
+            if (source.empty())
+            {
+                return;
+            }
+
+            for (auto delimiter : delimiters)
+            {
+                if (source[source.length() - 1] != delimiter[1])
+                {
+                    continue;
+                }
+
+                auto start = source.find_last_of(delimiter[0]);
+                if (start == std::string::npos)
+                {
+                    continue;
+                }
+
+                source.erase(start);
+                return;
+            }
+        }
+
+        std::wstring InitialsFromDisplayName(const std::wstring_view& contactDisplayName)
+        {
+            if (InitialsTokenizer::GetCharacterType(contactDisplayName) != CharacterType::Standard)
+            {
+                return L"";
+            }
+
+            std::wstring displayName(contactDisplayName.data());
+
+            StripTrailingBrackets(displayName);
+
+            std::vector<std::wstring> words = Split(displayName, L' ');
+
+            std::wstring result;
+            if (words.size() == 1)
+            {
+                result = GetFirstFullCharacter(words.front());
+            }
+            else if (words.size() > 1)
+            {
+                result = GetFirstFullCharacter(words.front());
+                result.append(GetFirstFullCharacter(words.back()));
+            }
+
+            std::transform(result.begin(), result.end(), result.begin(), ::towupper);
+            return result;
+        }
+    }
+
+    // What InitialsGenerator::InitialsFromDisplayName does now, minus creating the hstring.
+    size_t InitialsFromDisplayName(std::wstring_view displayName, wchar_t (&result)[16])
+    {
+        std::wstring_view first;
+        std::wstring_view last;
+        if (!InitialsTokenizer::TryGetInitials(displayName, first, last) || first.size() + last.size() > 16)
+        {
+            return 0;
+        }
+
+        std::transform(first.begin(), first.end(), result, ::towupper);
+        std::transform(last.begin(), last.end(), result + first.size(), ::towupper);
+        return first.size() + last.size();
+    }
+
+    // UTF-16 code units are spelled out so that the corpus is the same where wchar_t is 32 bits.
+    const wchar_t* const c_givenNames[] =
+    {
+        L"Jane", L"john", L"Mar\x00EDa", L"E\x0301lodie", L"\x00C5sa", L"\x0141ukasz", L"O'Brien", L"-Dash", L"Zo\x00EB",
+        L"\x0410\x043D\x043D\x0430", L"\x0414\x043C\x0438\x0442\x0440\x0438\x0439",
+        L"\x0391\x03BB\x03AD\x03BE\x03B7\x03C2",
+        L"\x674E", L"\x738B\x5C0F\x660E", L"\x4F50\x85E4",
+        L"\x0645\x062D\x0645\x062F", L"\x0641\x0627\x0637\x0645\x0629",
+        L"\x0905\x092E\x093F\x0924",
+        L"\xD835\xDC9C\x006C\x0069\x0063\x0065", L"\xD83D\xDE00", L"\xD840\xDC0B\x4E00",
+    };
+
+    const wchar_t* const c_familyNames[] =
+    {
+        L"Smith", L"van der Berg", L"M\x00FCller", L"\x00D8stergaard", L"de la Cruz", L"-Smith",
+        L"\x0418\x0432\x0430\x043D\x043E\x0432\x0430", L"\x03A0\x03B1\x03C0\x03B1\x03B4\x03CC\x03C0\x03BF\x03C5\x03BB\x03BF\x03C2",
+        L"\x5F20", L"\x0627\x0644\x0639\x0644\x064A", L"\xD83D\xDC4D", L"",
+    };
+
+    const wchar_t* const c_suffixes[] = { L"", L"", L"", L" (OSG)", L" [Contractor]", L" {x}", L" III", L"  ", L" (unbalanced" };
+
+    std::vector<std::wstring> MakeCorpus(int count)
+    {
+        std::mt19937 random(42);
+        const auto pick = [&random](const auto& array) { return array[random() % (sizeof(array) / sizeof(array[0]))]; };
+
+        std::vector<std::wstring> corpus;
+        corpus.reserve(count);
+        for (int i = 0; i < count; i++)
+        {
+            std::wstring name = random() % 8 == 0 ? L"  " : L"";
+            name += pick(c_givenNames);
+            name += L" ";
+            name += pick(c_familyNames);
+            name += pick(c_suffixes);
+            corpus.push_back(std::move(name));
+        }
+
+        // A few names that only some of the paths handle specially.
+        corpus.push_back(L"");
+        corpus.push_back(L"     ");
+        corpus.push_back(L"!!!");
+        corpus.push_back(L"a b c d e f g h i j k l m n o p q r s t u v w x y z");
+        return corpus;
+    }
+
+    struct Options
+    {
+        int names{ 200000 };
+        int iterations{ 5 };
+    };
+
+    Options ParseOptions(int argc, char* argv[])
+    {
+        Options options;
+        for (int i = 1; i < argc; i++)
+        {
+            if (strcmp(argv[i], "--quick") == 0)
+            {
+                options.names = 10000;
+                options.iterations = 1;
+            }
+            else if (strcmp(argv[i], "--names") == 0 && i + 1 < argc)
+            {
+                options.names = std::max(1, atoi(argv[++i]));
+            }
+            else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+            {
+                options.iterations = std::max(1, atoi(argv[++i]));
+            }
+        }
+        return options;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const auto options = ParseOptions(argc, argv);
+    const auto corpus = MakeCorpus(options.names);
+    bool passed = true;
+
+    // Same results, name by name.
+    int mismatchCount = 0;
+    for (const auto& name : corpus)
+    {
+        wchar_t buffer[16];
+        const size_t length = InitialsFromDisplayName(name, buffer);
+        if (Old::InitialsFromDisplayName(name) != std::wstring(buffer, length))
+        {
+            ++mismatchCount;
+        }
+    }
+    passed = passed && mismatchCount == 0;
+
+    double oldTime = 0.0;
+    double newTime = 0.0;
+    size_t oldAllocations = 0;
+    size_t newAllocations = 0;
+    size_t checksum = 0;
+    for (int i = 0; i < options.iterations; i++)
+    {
+        size_t allocationsBefore = s_allocationCount;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& name : corpus)
+        {
+            checksum += Old::InitialsFromDisplayName(name).size();
+        }
+        auto end = std::chrono::steady_clock::now();
+        oldTime += std::chrono::duration<double, std::milli>(end - start).count();
+        oldAllocations += s_allocationCount - allocationsBefore;
+
+        allocationsBefore = s_allocationCount;
+        start = std::chrono::steady_clock::now();
+        for (const auto& name : corpus)
+        {
+            wchar_t buffer[16];
+            checksum += InitialsFromDisplayName(name, buffer);
+        }
+        end = std::chrono::steady_clock::now();
+        newTime += std::chrono::duration<double, std::milli>(end - start).count();
+        newAllocations += s_allocationCount - allocationsBefore;
+    }
+    passed = passed && newAllocations == 0;
+
+    const double nameCount = static_cast<double>(corpus.size()) * options.iterations;
+    printf("%zu names, %d iterations (checksum %zu)\n", corpus.size(), options.iterations, checksum);
+    printf("%-10s %14s %18s\n", "path", "ns/name", "allocations/name");
+    printf("%-10s %14.1f %18.2f\n", "old", oldTime * 1e6 / nameCount, oldAllocations / nameCount);
+    printf("%-10s %14.1f %18.2f\n", "tokenizer", newTime * 1e6 / nameCount, newAllocations / nameCount);
+    if (mismatchCount > 0)
+    {
+        printf("%d names got different initials\n", mismatchCount);
+    }
+
+    return passed ? 0 : 1;
+}
@@ -3,31 +3,7 @@
 
 #pragma once
 
-    /// <summary>
-    /// Value indicating the general character set for a given character.
-    /// </summary>
-enum class CharacterType
-{
-    /// <summary>
-    /// Indicates we could not match the character set.
-    /// </summary>
-    Other = 0,
-
-    /// <summary>
-    /// Member of the Latin character set.
-    /// </summary>
-    Standard = 1,
-
-    /// <summary>
-    /// Member of a symbolic character set.
-    /// </summary>
-    Symbolic = 2,
-
-    /// <summary>
-    /// Member of a character set which supports glyphs.
-    /// </summary>
-    Glyph = 3
-};
+#include "InitialsTokenizer.h"
 
 /// <summary>
 /// PersonPicture Control. Displays the Profile Picture, or in its absence Initials,
@@ -55,6 +31,13 @@ public:
     /// </returns>
     static winrt::hstring InitialsFromDisplayName(const wstring_view &contactDisplayName);
 
+    /// <summary>
+    /// Batch version of InitialsFromDisplayName, e.g. for all the people in a contact list.
+    /// </summary>
+    /// <param name="contactDisplayNames">The DisplayNames of the people.</param>
+    /// <param name="initials">Receives the initials of each DisplayName, must be as long as contactDisplayNames.</param>
+    static void InitialsFromDisplayNames(winrt::array_view<winrt::hstring const> contactDisplayNames, winrt::array_view<winrt::hstring> initials);
+
     /// <summary>
     /// Helper function which indicates the type of characters in a given string
     /// </summary>
@@ -75,25 +58,10 @@ public:
 
 private:
     /// <summary>
-    /// Helper function which takes in a string and returns a vector of pieces, separated by delimiter.
-    /// </summary>
-    /// <param name="source">String on which to perform the split operation.</param>
-    /// <param name="delim">String on which to perform the split operation.</param>
-    /// <param name="maxIterations">Maximum number of times to perform a <code>getline</code> loop.</param>
-    /// <returns>A vector of pieces from the source string, separated by delimiter</returns>
-    static std::vector<std::wstring> Split(const std::wstring &source, wchar_t delim, int maxIterations = 25);
-
-    /// <summary>
-    /// Helper function to remove bracket qualifier from the end of a display name if present.
-    /// </summary>
-    /// <param name="source">String on which to perform the operation.</param>
-    /// <returns>A string with the content within brackets removed.</returns>
-    static void StripTrailingBrackets(std::wstring &source);
-
-    /// <summary>
-    /// Extracts the first full character from a given string, including any diacritics or combining characters.
+    /// Helper function which concatenates and upper cases the given initials.
     /// </summary>
-    /// <param name="str">String from which to extract the character.</param>
-    /// <returns>A wstring which represents a given character.</returns>
-    static std::wstring GetFirstFullCharacter(const std::wstring &str);
+    /// <param name="first">The first initial.</param>
+    /// <param name="last">The last initial, can be empty.</param>
+    /// <returns>String containing the initials.</returns>
+    static winrt::hstring ToUpperInitials(wstring_view first, wstring_view last);
 };
@@ -11,6 +11,9 @@
 #include "RuntimeProfiler.h"
 #include "PersonPictureTemplateSettings.h"
 
+thread_local std::list<std::pair<winrt::hstring, winrt::hstring>> PersonPicture::s_displayNameInitials;
+thread_local std::unordered_map<winrt::hstring, std::list<std::pair<winrt::hstring, winrt::hstring>>::iterator> PersonPicture::s_displayNameInitialsIndex;
+
 PersonPicture::PersonPicture()
 {
     __RP_Marker_ClassById(RuntimeProfiler::ProfId_PersonPicture);
@@ -133,6 +136,33 @@ winrt::ImageSource PersonPicture::GetImageSource()
     }
 }
 
+winrt::hstring PersonPicture::GetInitialsFromDisplayName(const winrt::hstring& displayName)
+{
+    auto it = s_displayNameInitialsIndex.find(displayName);
+    if (it != s_displayNameInitialsIndex.end())
+    {
+        s_displayNameInitials.splice(s_displayNameInitials.begin(), s_displayNameInitials, it->second);
+        return it->second->second;
+    }
+
+    winrt::hstring initials = InitialsGenerator::InitialsFromDisplayName(displayName);
+
+    if (s_displayNameInitials.size() < s_maxCachedDisplayNameInitials)
+    {
+        s_displayNameInitials.emplace_front(displayName, initials);
+    }
+    else
+    {
+        // Reuse the least recently used entry.
+        s_displayNameInitialsIndex.erase(s_displayNameInitials.back().first);
+        s_displayNameInitials.splice(s_displayNameInitials.begin(), s_displayNameInitials, std::prev(s_displayNameInitials.end()));
+        s_displayNameInitials.front() = { displayName, initials };
+    }
+
+    s_displayNameInitialsIndex.emplace(displayName, s_displayNameInitials.begin());
+    return initials;
+}
+
 void PersonPicture::UpdateIfReady()
 {
     winrt::hstring initials = GetInitials();
@@ -535,7 +565,7 @@ void PersonPicture::OnPropertyChanged(const winrt::DependencyPropertyChangedEven
 
 void PersonPicture::OnDisplayNameChanged(winrt::DependencyPropertyChangedEventArgs const& /* args */)
 {
-    m_displayNameInitials.set(InitialsGenerator::InitialsFromDisplayName(DisplayName()));
+    m_displayNameInitials.set(GetInitialsFromDisplayName(DisplayName()));
 
     UpdateIfReady();
 }
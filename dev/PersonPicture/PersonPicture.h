@@ -7,6 +7,9 @@
 #include "PersonPicture.properties.h"
 #include "DispatcherHelper.h"
 
+#include <list>
+#include <unordered_map>
+
 class PersonPicture :
     public ReferenceTracker<PersonPicture, winrt::implementation::PersonPictureT>,
     public PersonPictureProperties
@@ -64,6 +67,13 @@ private:
     /// </summary>
     winrt::hstring GetInitials();
 
+    /// <summary>
+    /// Returns the initials of the given DisplayName, from a small per-thread cache of the
+    /// most recently used names when possible. Lists of people recycle their PersonPictures
+    /// while scrolling, so the same names keep coming back.
+    /// </summary>
+    static winrt::hstring GetInitialsFromDisplayName(const winrt::hstring& displayName);
+
     /// <summary>
     /// Helper to determine the image source that should be shown.
     /// </summary>
@@ -135,4 +145,11 @@ private:
     tracker_ref<winrt::ImageSource> m_contactImageSource{ this };
 
     DispatcherHelper m_dispatcherHelper{ *this };
+
+    /// <summary>
+    /// Most recently used DisplayNames and their initials, most recent first.
+    /// </summary>
+    static constexpr size_t s_maxCachedDisplayNameInitials = 256;
+    static thread_local std::list<std::pair<winrt::hstring /* displayName */, winrt::hstring /* initials */>> s_displayNameInitials;
+    static thread_local std::unordered_map<winrt::hstring, std::list<std::pair<winrt::hstring, winrt::hstring>>::iterator> s_displayNameInitialsIndex;
 };
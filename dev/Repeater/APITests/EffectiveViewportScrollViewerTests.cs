@@ -19,6 +19,8 @@ using System.Runtime.InteropServices.WindowsRuntime;
 using Windows.UI.Xaml.Markup;
 using Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests.Common;
 
+using Task = System.Threading.Tasks.Task;
+
 #if USING_TAEF
 using WEX.TestExecution;
 using WEX.TestExecution.Markup;
@@ -32,12 +34,14 @@ using VirtualizingLayout = Microsoft.UI.Xaml.Controls.VirtualizingLayout;
 using ItemsRepeater = Microsoft.UI.Xaml.Controls.ItemsRepeater;
 using VirtualizingLayoutContext = Microsoft.UI.Xaml.Controls.VirtualizingLayoutContext;
 using RecyclingElementFactory = Microsoft.UI.Xaml.Controls.RecyclingElementFactory;
+using RecyclePool = Microsoft.UI.Xaml.Controls.RecyclePool;
 using StackLayout = Microsoft.UI.Xaml.Controls.StackLayout;
 using UniformGridLayout = Microsoft.UI.Xaml.Controls.UniformGridLayout;
 using IRepeaterScrollingSurface = Microsoft.UI.Private.Controls.IRepeaterScrollingSurface;
 using ConfigurationChangedEventHandler = Microsoft.UI.Private.Controls.ConfigurationChangedEventHandler;
 using PostArrangeEventHandler = Microsoft.UI.Private.Controls.PostArrangeEventHandler;
 using ViewportChangedEventHandler = Microsoft.UI.Private.Controls.ViewportChangedEventHandler;
+using RepeaterTestHooks = Microsoft.UI.Private.Controls.RepeaterTestHooks;
 
 namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
 {
@@ -407,6 +411,104 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void CanBiasCacheBufferTowardScrollDirection()
+        {
+            if (!PlatformConfiguration.IsOsVersionGreaterThanOrEqual(OSVersion.Redstone5))
+            {
+                Log.Warning("Skipping since version is less than RS5 and effective viewport is not available below RS5");
+                return;
+            }
+
+            ScrollViewer scroller = null;
+            ItemsRepeater repeater = null;
+            var scrollCompletedEvent = new ManualResetEvent(initialState: false);
+            var biasedWindowSeen = false;
+
+            RunOnUIThread.Execute(() =>
+            {
+                var elementFactory = new RecyclingElementFactory();
+                elementFactory.RecyclePool = new RecyclePool();
+                elementFactory.Templates["Item"] = (DataTemplate)XamlReader.Load(
+                    @"<DataTemplate xmlns='http://schemas.microsoft.com/winfx/2006/xaml/presentation'><TextBlock Text='{Binding}' Height='50' /></DataTemplate>");
+
+                repeater = new ItemsRepeater()
+                {
+                    ItemsSource = Enumerable.Range(0, 2000).Select(i => string.Format("Item #{0}", i)),
+                    ItemTemplate = elementFactory,
+                    Layout = new StackLayout()
+                };
+
+                scroller = new ScrollViewer
+                {
+                    Width = 400,
+                    Height = 400,
+                    Content = repeater
+                };
+
+                Content = scroller;
+            });
+
+            IdleSynchronizer.Wait();
+
+            RunOnUIThread.Execute(() =>
+            {
+                var visibleWindow = RepeaterTestHooks.GetVisibleWindow(repeater);
+                var realizationWindow = RepeaterTestHooks.GetRealizationWindow(repeater);
+                var restingBuffer = repeater.VerticalCacheLength / 2 * scroller.Height;
+                Log.Comment("At rest, the cache buffer is the same on both sides.");
+                Verify.AreEqual(restingBuffer, visibleWindow.Top - realizationWindow.Top);
+                Verify.AreEqual(restingBuffer, realizationWindow.Bottom - visibleWindow.Bottom);
+
+                RepeaterTestHooks.ResetRealizedElementCounters(repeater);
+
+                Log.Comment("Scroll down a bit on every frame.");
+                int frame = 0;
+                EventHandler<object> renderingHandler = null;
+                renderingHandler = (sender, args) =>
+                {
+                    visibleWindow = RepeaterTestHooks.GetVisibleWindow(repeater);
+                    realizationWindow = RepeaterTestHooks.GetRealizationWindow(repeater);
+                    biasedWindowSeen |= realizationWindow.Bottom - visibleWindow.Bottom > visibleWindow.Top - realizationWindow.Top;
+
+                    if (++frame < 30)
+                    {
+                        scroller.ChangeView(null, frame * 60.0, null, disableAnimation: true);
+                    }
+                    else
+                    {
+                        CompositionTarget.Rendering -= renderingHandler;
+                        scrollCompletedEvent.Set();
+                    }
+                };
+                CompositionTarget.Rendering += renderingHandler;
+            });
+
+            Verify.IsTrue(scrollCompletedEvent.WaitOne(DefaultWaitTimeInMS), "Waiting for scrolling to complete.");
+
+            // Let the repeater notice that scrolling stopped.
+            Task.Delay(500).Wait();
+            IdleSynchronizer.Wait();
+
+            RunOnUIThread.Execute(() =>
+            {
+                Log.Comment("While scrolling down, most of the cache buffer was below the viewport.");
+                Verify.IsTrue(biasedWindowSeen);
+
+                var hitCount = RepeaterTestHooks.GetRealizedElementHitCount(repeater);
+                var missCount = RepeaterTestHooks.GetRealizedElementMissCount(repeater);
+                Log.Comment(string.Format("Realized element hits: {0}, misses: {1}", hitCount, missCount));
+                Verify.IsGreaterThan(hitCount, 0);
+
+                var visibleWindow = RepeaterTestHooks.GetVisibleWindow(repeater);
+                var realizationWindow = RepeaterTestHooks.GetRealizationWindow(repeater);
+                var restingBuffer = repeater.VerticalCacheLength / 2 * scroller.Height;
+                Log.Comment("Once idle, the cache buffer shrinks back to its resting size.");
+                Verify.AreEqual(restingBuffer, visibleWindow.Top - realizationWindow.Top);
+                Verify.AreEqual(restingBuffer, realizationWindow.Bottom - visibleWindow.Bottom);
+            });
+        }
+
         [TestMethod]
         public void CanBringIntoViewElements()
         {
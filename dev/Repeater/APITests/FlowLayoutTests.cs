@@ -1354,6 +1354,84 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             }
         }
 
+        // UniformGridLayout computes the realized range and the element bounds directly from
+        // the scroll offset, so scrolling by a line should only prepare the elements of that
+        // line and jumping far away should land on the right elements without walking there.
+        [TestMethod]
+        public void ValidateGridLayoutRealizesOnlyEnteringLinesWhenScrolling()
+        {
+            const int itemSize = 100;
+            const int itemsPerLine = 4;
+            ScrollViewer scrollViewer = null;
+            ItemsRepeater repeater = null;
+            var preparedIndices = new List<int>();
+            RunOnUIThread.Execute(() =>
+            {
+                repeater = new ItemsRepeater()
+                {
+                    ItemsSource = Enumerable.Range(0, 100000),
+                    ItemTemplate = GetDataTemplate(@"<Button Content='{Binding}' Width='100' Height='100'/>"),
+                    Layout = new UniformGridLayout(),
+                    HorizontalCacheLength = 0,
+                    VerticalCacheLength = 0,
+                };
+
+                repeater.ElementPrepared += (sender, args) =>
+                {
+                    preparedIndices.Add(args.Index);
+                };
+
+                scrollViewer = new ScrollViewer()
+                {
+                    Content = repeater,
+                    Width = itemSize * itemsPerLine,
+                    Height = 400,
+                };
+
+                Content = new ItemsRepeaterScrollHost()
+                {
+                    ScrollViewer = scrollViewer
+                };
+
+                Content.UpdateLayout();
+            });
+
+            foreach (var verticalOffset in new double[] { 100, 200, 500000, 500100, 250 })
+            {
+                RunOnUIThread.Execute(() =>
+                {
+                    preparedIndices.Clear();
+                    scrollViewer.ChangeView(horizontalOffset: null, verticalOffset: verticalOffset, zoomFactor: null, disableAnimation: true);
+                });
+
+                IdleSynchronizer.Wait();
+
+                RunOnUIThread.Execute(() =>
+                {
+                    Log.Comment("VerticalOffset: " + scrollViewer.VerticalOffset);
+                    Verify.AreEqual(verticalOffset, scrollViewer.VerticalOffset);
+
+                    var firstVisibleLine = (int)Math.Floor(scrollViewer.VerticalOffset / itemSize);
+                    var lastVisibleLine = (int)Math.Ceiling((scrollViewer.VerticalOffset + scrollViewer.ViewportHeight) / itemSize) - 1;
+                    for (int i = firstVisibleLine * itemsPerLine; i < (lastVisibleLine + 1) * itemsPerLine; i++)
+                    {
+                        var element = (FrameworkElement)repeater.TryGetElement(i);
+                        Verify.IsNotNull(element, "Element " + i + " should be realized");
+                        Verify.AreEqual(
+                            new Rect((i % itemsPerLine) * itemSize, (i / itemsPerLine) * itemSize, itemSize, itemSize),
+                            LayoutInformation.GetLayoutSlot(element));
+                    }
+
+                    if (verticalOffset == 200 || verticalOffset == 500100)
+                    {
+                        // Scrolled by exactly one line.
+                        Verify.AreEqual(itemsPerLine, preparedIndices.Count);
+                        Verify.AreEqual(lastVisibleLine * itemsPerLine, preparedIndices.Min());
+                    }
+                });
+            }
+        }
+
         [TestMethod]
         public void VerifyItemsGetFullSpaceInMajorDirectionWhenSmallerThanLineSize()
         {
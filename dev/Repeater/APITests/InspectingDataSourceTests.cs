@@ -101,6 +101,43 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void CanCreateFromIVectorView()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var items = Enumerable.Range(0, 100).Select(i => (object)string.Format("Item #{0}", i)).ToList();
+                var dataSource = new ItemsSourceView(new ReadOnlyItems(items));
+                Verify.AreEqual(100, dataSource.Count);
+                Verify.AreEqual("Item #4", (string)dataSource.GetAt(4));
+                Verify.IsFalse(dataSource.HasKeyIndexMapping);
+
+                // The view does not tell us when it changes, so it is copied like any iterable.
+                items[4] = "Replaced Item";
+                Verify.AreEqual("Item #4", (string)dataSource.GetAt(4));
+            });
+        }
+
+        [TestMethod]
+        public void CanCreateFromObservableIVectorView()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var items = Enumerable.Range(0, 100).Select(i => (object)string.Format("Item #{0}", i)).ToList();
+                var view = new ObservableReadOnlyItems(items);
+                var dataSource = new ItemsSourceView(view);
+                var recorder = new CollectionChangeRecorder(dataSource);
+                Verify.AreEqual(100, dataSource.Count);
+                Verify.AreEqual("Item #4", (string)dataSource.GetAt(4));
+
+                // The view raises change notifications, so it is used as is rather than copied.
+                view.Replace(4, "Replaced Item");
+                Verify.AreEqual("Replaced Item", (string)dataSource.GetAt(4));
+                Verify.AreEqual(1, recorder.RecordedArgs.Count);
+                Verify.AreEqual(NotifyCollectionChangedAction.Replace, recorder.RecordedArgs[0].Action);
+            });
+        }
+
         [TestMethod]
         public void VerifyUniqueIdMappingInterface()
         {
@@ -115,6 +152,120 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void VerifyBatchedCollectionChangesAreCoalesced()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var data = new ObservableCollection<int>(Enumerable.Range(0, 100));
+                var dataSource = new ItemsSourceView(data);
+                dataSource.IsCollectionChangeBatchingEnabled = true;
+                var recorder = new CollectionChangeRecorder(dataSource);
+
+                for (int i = 0; i < 500; i++)
+                {
+                    data.Insert(10 + i, 1000 + i);
+                }
+
+                data.RemoveAt(590);
+
+                // Nothing is raised until the batch is flushed, but Count matches the data.
+                Verify.AreEqual(0, recorder.RecordedArgs.Count);
+                Verify.AreEqual(599, dataSource.Count);
+                Verify.AreEqual(1000, dataSource.GetAt(10));
+
+                dataSource.IsCollectionChangeBatchingEnabled = false;
+
+                VerifyRecordedCollectionChanges(
+                    expected: new NotifyCollectionChangedEventArgs[]
+                    {
+                        CollectionChangeEventArgsConverters.CreateNotifyArgs(NotifyCollectionChangedAction.Remove, 90, 1, -1, 0),
+                        CollectionChangeEventArgsConverters.CreateNotifyArgs(NotifyCollectionChangedAction.Add, -1, 0, 10, 500),
+                    },
+                    actual: recorder.RecordedArgs);
+                Verify.AreEqual(599, dataSource.Count);
+            });
+        }
+
+        [TestMethod]
+        public void VerifyBatchedReplacesAreRaisedAsReplaces()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var data = new ObservableCollection<int>(Enumerable.Range(0, 10));
+                var dataSource = new ItemsSourceView(data);
+                dataSource.IsCollectionChangeBatchingEnabled = true;
+                var recorder = new CollectionChangeRecorder(dataSource);
+
+                data[3] = 103;
+                data[4] = 104;
+                data[3] = 203;
+                data.Insert(8, 1008);
+                data.RemoveAt(9);
+
+                dataSource.IsCollectionChangeBatchingEnabled = false;
+
+                // The insert and the remove that overlap are raised as a remove and an add.
+                VerifyRecordedCollectionChanges(
+                    expected: new NotifyCollectionChangedEventArgs[]
+                    {
+                        CollectionChangeEventArgsConverters.CreateNotifyArgs(NotifyCollectionChangedAction.Remove, 8, 1, -1, 0),
+                        CollectionChangeEventArgsConverters.CreateNotifyArgs(NotifyCollectionChangedAction.Add, -1, 0, 8, 1),
+                        CollectionChangeEventArgsConverters.CreateNotifyArgs(NotifyCollectionChangedAction.Replace, 4, 1, 4, 1),
+                        CollectionChangeEventArgsConverters.CreateNotifyArgs(NotifyCollectionChangedAction.Replace, 3, 1, 3, 1),
+                    },
+                    actual: recorder.RecordedArgs);
+                Verify.AreEqual(10, dataSource.Count);
+            });
+        }
+
+        [TestMethod]
+        public void VerifyBatchedCollectionChangesUpdateRealizedElements()
+        {
+            var data = new ObservableCollection<string>(Enumerable.Range(0, 10).Select(i => string.Format("Item #{0}", i)));
+            ItemsRepeater repeater = null;
+
+            RunOnUIThread.Execute(() =>
+            {
+                repeater = new ItemsRepeater()
+                {
+                    ItemsSource = data
+                };
+
+                Content = new Windows.UI.Xaml.Controls.ScrollViewer()
+                {
+                    Width = 400,
+                    Height = 400,
+                    Content = repeater
+                };
+                Content.UpdateLayout();
+
+                repeater.ItemsSourceView.IsCollectionChangeBatchingEnabled = true;
+                data.Insert(0, "Inserted #0");
+                data.Insert(5, "Inserted #5");
+                data.RemoveAt(8);
+                data.Add("Appended");
+                data[2] = "Replaced #2";
+
+                Verify.AreEqual(data.Count, repeater.ItemsSourceView.Count);
+            });
+
+            // The batch is raised on the next tick.
+            IdleSynchronizer.Wait();
+
+            RunOnUIThread.Execute(() =>
+            {
+                Verify.AreEqual(data.Count, repeater.ItemsSourceView.Count);
+                for (int i = 0; i < data.Count; i++)
+                {
+                    var element = (TextBlock)repeater.TryGetElement(i);
+                    Verify.IsNotNull(element);
+                    Verify.AreEqual(data[i], element.Text);
+                    Verify.AreEqual(i, repeater.GetElementIndex(element));
+                }
+            });
+        }
+
         // Calling Reset multiple times before layout runs causes a crash
         // in unique ids. We end up thinking we have multiple elements with the same id.
         [TestMethod]
@@ -364,6 +515,50 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             }
         }
 
+        // Only implements IReadOnlyList, which is projected as IVectorView.
+        class ReadOnlyItems : IReadOnlyList<object>
+        {
+            private readonly List<object> _items;
+
+            public ReadOnlyItems(List<object> items)
+            {
+                _items = items;
+            }
+
+            public object this[int index] { get { return _items[index]; } }
+
+            public int Count { get { return _items.Count; } }
+
+            public IEnumerator<object> GetEnumerator()
+            {
+                return _items.GetEnumerator();
+            }
+
+            IEnumerator IEnumerable.GetEnumerator()
+            {
+                return _items.GetEnumerator();
+            }
+        }
+
+        class ObservableReadOnlyItems : ReadOnlyItems, INotifyCollectionChanged
+        {
+            private readonly List<object> _items;
+
+            public ObservableReadOnlyItems(List<object> items) : base(items)
+            {
+                _items = items;
+            }
+
+            public event NotifyCollectionChangedEventHandler CollectionChanged;
+
+            public void Replace(int index, object item)
+            {
+                var oldItem = _items[index];
+                _items[index] = item;
+                CollectionChanged?.Invoke(this, new NotifyCollectionChangedEventArgs(NotifyCollectionChangedAction.Replace, item, oldItem, index));
+            }
+        }
+
         class ObservableVectorWithUniqueIds : ObservableCollection<int>, IKeyIndexMapping
         {
             public ObservableVectorWithUniqueIds(IEnumerable<int> data) : base(data) { }
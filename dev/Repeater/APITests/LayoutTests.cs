@@ -253,6 +253,88 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void ValidateStackLayoutExtentWithMeasuredSizeIndex()
+        {
+            ItemsRepeater repeater = null;
+            ScrollViewer scrollViewer = null;
+            var data = new ObservableCollection<int>(Enumerable.Range(0, 100));
+            RunOnUIThread.Execute(() =>
+            {
+                var stackLayout = new StackLayout() { IsMeasuredSizeIndexEnabled = true };
+                Content = CreateAndInitializeRepeater(
+                    data,
+                    stackLayout,
+                    GetDataTemplate("<Button Content='{Binding}' Height='100' />"),
+                    ref repeater,
+                    ref scrollViewer);
+                Content.UpdateLayout();
+
+                Verify.AreEqual(100 * 100, repeater.DesiredSize.Height);
+            });
+
+            IdleSynchronizer.Wait();
+
+            RunOnUIThread.Execute(() =>
+            {
+                scrollViewer.ChangeView(null, 5000, null, true);
+                Content.UpdateLayout();
+                Verify.IsNotNull(repeater.TryGetElement(50));
+
+                // Measurements have to follow the items around.
+                data.RemoveAt(0);
+                data.Insert(0, -1);
+                data.RemoveAt(99);
+                Content.UpdateLayout();
+                Verify.AreEqual(99 * 100, repeater.DesiredSize.Height);
+                Verify.IsNotNull(repeater.TryGetElement(50));
+            });
+        }
+
+        [TestMethod]
+        public void ValidateStackLayoutExtentWithMeasuredSizeIndexAndVaryingSizes()
+        {
+            ItemsRepeater repeater = null;
+            ScrollViewer scrollViewer = null;
+            // One tall item every ten: 10 * 300 + 90 * 30 = 5700.
+            var data = new ObservableCollection<double>(Enumerable.Range(0, 100).Select(i => i % 10 == 0 ? 300.0 : 30.0));
+            RunOnUIThread.Execute(() =>
+            {
+                var stackLayout = new StackLayout() { IsMeasuredSizeIndexEnabled = true };
+                Content = CreateAndInitializeRepeater(
+                    data,
+                    stackLayout,
+                    GetDataTemplate("<Border Height='{Binding}' />"),
+                    ref repeater,
+                    ref scrollViewer);
+                Content.UpdateLayout();
+            });
+
+            IdleSynchronizer.Wait();
+
+            RunOnUIThread.Execute(() =>
+            {
+                // Measure every item once, then go back to the top.
+                for (double offset = 0; offset <= 5700; offset += 200)
+                {
+                    scrollViewer.ChangeView(null, offset, null, true);
+                    Content.UpdateLayout();
+                }
+
+                scrollViewer.ChangeView(null, 0, null, true);
+                Content.UpdateLayout();
+
+                // An average of the measured sizes cannot give the exact extent, the index does.
+                Verify.AreEqual(5700, repeater.DesiredSize.Height);
+
+                // Removing an item that is not realized takes its own size out of the extent.
+                Verify.IsNull(repeater.TryGetElement(90));
+                data.RemoveAt(90);
+                Content.UpdateLayout();
+                Verify.AreEqual(5400, repeater.DesiredSize.Height);
+            });
+        }
+
         private ItemsRepeaterScrollHost CreateAndInitializeRepeater(
            object itemsSource,
            VirtualizingLayout layout,
@@ -116,6 +116,149 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             }
         }
 
+        [TestMethod]
+        public void ValidateBuildTreeSchedulerCounters()
+        {
+            if (!PlatformConfiguration.IsOsVersionGreaterThan(OSVersion.Redstone2))
+            {
+                Log.Warning("Skipping: GetAvailableSize API is only available in RS3 and above.");
+                return;
+            }
+
+            ManualResetEvent buildTreeCompleted = new ManualResetEvent(false);
+
+            RunOnUIThread.Execute(() =>
+            {
+                RepeaterTestHooks.ResetBuildTreeSchedulerCounters();
+                RepeaterTestHooks.BuildTreeCompleted += (sender, args) =>
+                {
+                    buildTreeCompleted.Set();
+                };
+
+                // Two repeaters with phased work share the scheduler queue.
+                var panel = new StackPanel();
+                for (int i = 0; i < 2; i++)
+                {
+                    panel.Children.Add(new ItemsRepeater()
+                    {
+                        ItemsSource = Enumerable.Range(0, 10),
+                        ItemTemplate = new CustomElementFactory(6),
+                        Layout = new StackLayout(),
+                    });
+                }
+
+                Content = new ItemsRepeaterScrollHost()
+                {
+                    Width = 400,
+                    Height = 400,
+                    ScrollViewer = new ScrollViewer
+                    {
+                        Content = panel
+                    }
+                };
+            });
+
+            if (buildTreeCompleted.WaitOne(TimeSpan.FromMilliseconds(2000)))
+            {
+                RunOnUIThread.Execute(() =>
+                {
+                    Log.Comment("Deferred: {0}, Coalesced: {1}, Frames over budget: {2}",
+                        RepeaterTestHooks.GetBuildTreeSchedulerDeferredWorkCount(),
+                        RepeaterTestHooks.GetBuildTreeSchedulerCoalescedWorkCount(),
+                        RepeaterTestHooks.GetBuildTreeSchedulerFramesOverBudgetCount());
+
+                    Verify.AreEqual(0, RepeaterTestHooks.GetBuildTreeSchedulerQueueDepth());
+                    Verify.IsGreaterThanOrEqual(RepeaterTestHooks.GetBuildTreeSchedulerPeakQueueDepth(), 1);
+                    Verify.IsLessThanOrEqual(RepeaterTestHooks.GetBuildTreeSchedulerPeakQueueDepth(), 2);
+
+                    var budget = RepeaterTestHooks.GetBuildTreeSchedulerBudgetInMs();
+                    Verify.IsTrue(budget >= 20.0 && budget <= 40.0);
+
+                    ElementPhasingManager.ProcessedCalls.Clear();
+                });
+            }
+            else
+            {
+                Verify.Fail("Failed on waiting on build tree.");
+            }
+        }
+
+        [TestMethod]
+        public void ValidateOffscreenRepeaterPhasesAfterVisibleRepeater()
+        {
+            if (!PlatformConfiguration.IsOsVersionGreaterThan(OSVersion.Redstone2))
+            {
+                Log.Warning("Skipping: GetAvailableSize API is only available in RS3 and above.");
+                return;
+            }
+
+            ManualResetEvent buildTreeCompleted = new ManualResetEvent(false);
+
+            RunOnUIThread.Execute(() =>
+            {
+                ElementPhasingManager.PhasedItems = new List<int>();
+                RepeaterTestHooks.BuildTreeCompleted += (sender, args) =>
+                {
+                    buildTreeCompleted.Set();
+                };
+
+                // The repeater below the viewport comes first in the grid, so it is measured
+                // and registers its phased work before the visible one does.
+                var offscreenRepeater = new ItemsRepeater()
+                {
+                    ItemsSource = Enumerable.Range(100, 10),
+                    ItemTemplate = new CustomElementFactory(3),
+                    Layout = new StackLayout(),
+                };
+
+                var visibleRepeater = new ItemsRepeater()
+                {
+                    ItemsSource = Enumerable.Range(0, 10),
+                    ItemTemplate = new CustomElementFactory(3),
+                    Layout = new StackLayout(),
+                };
+
+                var grid = new Grid();
+                grid.RowDefinitions.Add(new RowDefinition() { Height = new GridLength(500) });
+                grid.RowDefinitions.Add(new RowDefinition() { Height = GridLength.Auto });
+                Grid.SetRow(offscreenRepeater, 1);
+                grid.Children.Add(offscreenRepeater);
+                grid.Children.Add(visibleRepeater);
+
+                Content = new ItemsRepeaterScrollHost()
+                {
+                    Width = 400,
+                    Height = 400,
+                    ScrollViewer = new ScrollViewer
+                    {
+                        Content = grid
+                    }
+                };
+            });
+
+            if (buildTreeCompleted.WaitOne(TimeSpan.FromMilliseconds(2000)))
+            {
+                RunOnUIThread.Execute(() =>
+                {
+                    var phasedItems = ElementPhasingManager.PhasedItems;
+                    int lastVisibleRepeaterItem = phasedItems.FindLastIndex(item => item < 100);
+                    int firstOffscreenRepeaterItem = phasedItems.FindIndex(item => item >= 100);
+                    Log.Comment("Phased items: {0}", string.Join(", ", phasedItems));
+
+                    Verify.IsGreaterThanOrEqual(lastVisibleRepeaterItem, 0);
+                    Verify.IsGreaterThanOrEqual(firstOffscreenRepeaterItem, 0);
+                    Verify.IsGreaterThan(firstOffscreenRepeaterItem, lastVisibleRepeaterItem);
+
+                    ElementPhasingManager.PhasedItems = null;
+                    ElementPhasingManager.ProcessedCalls.Clear();
+                });
+            }
+            else
+            {
+                Verify.Fail("Failed on waiting on build tree.");
+            }
+        }
+
         [TestMethod]
         public void ValidateXBindWithoutPhasing()
         {
@@ -221,6 +364,9 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             // data index -> list<phases>
             public static Dictionary<int, List<int>> ProcessedCalls { get; set; }
 
+            // When set, the data of each call for a phase past 0, in the order of the calls.
+            public static List<int> PhasedItems { get; set; }
+
             public ElementPhasingManager(int numPhases)
             {
                 _numPhases = numPhases;
@@ -252,6 +398,10 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
                 }
 
                 ProcessedCalls[_data].Add(phase);
+                if (phase > 0 && PhasedItems != null)
+                {
+                    PhasedItems.Add(_data);
+                }
 
                 nextPhase = phase >= _numPhases -1 ? -1 : phase + 1;
                 Log.Comment(string.Format("Index:{0}  Phase:{1}  NextPhase:{2}", item.ToString(), phase, nextPhase));
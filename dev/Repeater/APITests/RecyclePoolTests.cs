@@ -4,6 +4,7 @@
 using Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests.Common;
 using Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests.Common.Mocks;
 using MUXControlsTestApp.Utilities;
+using System;
 using System.Collections.ObjectModel;
 using System.Linq;
 using System.Runtime.InteropServices;
@@ -26,6 +27,7 @@ using ItemsRepeater = Microsoft.UI.Xaml.Controls.ItemsRepeater;
 using RecyclePool = Microsoft.UI.Xaml.Controls.RecyclePool;
 using StackLayout = Microsoft.UI.Xaml.Controls.StackLayout;
 using ItemsRepeaterScrollHost = Microsoft.UI.Xaml.Controls.ItemsRepeaterScrollHost;
+using RepeaterTestHooks = Microsoft.UI.Private.Controls.RepeaterTestHooks;
 
 namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
 {
@@ -209,5 +211,89 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
                 Verify.IsNull(recycled2.Parent);
             });
         }
+
+        [TestMethod]
+        public void ValidateMaxElementsPerKeyEvictsOldestElements()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                const string key = "Key";
+                RecyclePool pool = new RecyclePool();
+                var owner = new StackPanel();
+                var children = Enumerable.Range(0, 5).Select(i => new Button()).ToList();
+
+                foreach (var child in children)
+                {
+                    owner.Children.Add(child);
+                    pool.PutElement(child, key, owner);
+                }
+
+                Verify.AreEqual(5, RepeaterTestHooks.GetRecyclePoolSize(pool));
+                Verify.AreEqual(5, RepeaterTestHooks.GetRecyclePoolPeakSize(pool));
+
+                // Lowering the cap drops the elements that have been in the pool
+                // the longest and takes them out of their owner.
+                pool.MaxElementsPerKey = 3;
+                Verify.AreEqual(3, RepeaterTestHooks.GetRecyclePoolSize(pool));
+                Verify.AreEqual(2, RepeaterTestHooks.GetRecyclePoolEvictionCount(pool));
+                Verify.IsNull(children[0].Parent);
+                Verify.IsNull(children[1].Parent);
+                Verify.AreEqual(3, owner.Children.Count);
+
+                // Putting more elements keeps the key at the cap.
+                var extra = new Button();
+                pool.PutElement(extra, key);
+                Verify.AreEqual(3, RepeaterTestHooks.GetRecyclePoolSize(pool));
+                Verify.AreEqual(3, RepeaterTestHooks.GetRecyclePoolEvictionCount(pool));
+                Verify.IsNull(children[2].Parent);
+
+                // Elements come back most recently recycled first, preferring the requested owner.
+                Verify.AreSame(children[4], pool.TryGetElement(key, owner));
+                Verify.AreSame(children[3], pool.TryGetElement(key, owner));
+                Verify.AreSame(extra, pool.TryGetElement(key, owner));
+                Verify.IsNull(pool.TryGetElement(key, owner));
+
+                Verify.AreEqual(3, RepeaterTestHooks.GetRecyclePoolHitCount(pool));
+                Verify.AreEqual(1, RepeaterTestHooks.GetRecyclePoolMissCount(pool));
+                Verify.AreEqual(5, RepeaterTestHooks.GetRecyclePoolPeakSize(pool));
+
+                RepeaterTestHooks.ResetRecyclePoolCounters(pool);
+                Verify.AreEqual(0, RepeaterTestHooks.GetRecyclePoolHitCount(pool));
+                Verify.AreEqual(0, RepeaterTestHooks.GetRecyclePoolPeakSize(pool));
+
+                Verify.Throws<ArgumentException>(() => pool.MaxElementsPerKey = -1);
+            });
+        }
+
+        [TestMethod]
+        public void ValidateEvictingElementAlreadyRemovedFromOwner()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                const string key = "Key";
+                RecyclePool pool = new RecyclePool() { MaxElementsPerKey = 1 };
+                var owner = new StackPanel();
+                var first = new Button();
+                var second = new Button();
+                owner.Children.Add(first);
+                owner.Children.Add(second);
+
+                pool.PutElement(first, key, owner);
+                // The owner gave up the element while it was in the pool.
+                owner.Children.Remove(first);
+
+                // Evicting it leaves the owner alone instead of failing.
+                pool.PutElement(second, key, owner);
+                Verify.AreEqual(1, RepeaterTestHooks.GetRecyclePoolEvictionCount(pool));
+                Verify.AreEqual(1, owner.Children.Count);
+                Verify.AreSame(second, pool.TryGetElement(key, owner));
+
+                // The bucket of the owner went away with its last element, so elements
+                // recycled later by the same owner start a new one.
+                pool.PutElement(second, key, owner);
+                Verify.AreSame(second, pool.TryGetElement(key, owner));
+                Verify.IsNull(pool.TryGetElement(key, owner));
+            });
+        }
     }
 }
@@ -140,6 +140,69 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void ValidateOneLevelLargeRangeSelection()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                const int count = 1000000;
+                var selectionModel = new SelectionModel();
+                selectionModel.Source = Enumerable.Range(0, count).ToList();
+
+                selectionModel.SelectAll();
+                Verify.AreEqual(count, selectionModel.SelectedIndices.Count);
+
+                selectionModel.SetAnchorIndex(1000);
+                selectionModel.DeselectRangeFromAnchor(count - 1001);
+                Verify.AreEqual(2000, selectionModel.SelectedIndices.Count);
+                Verify.IsTrue(selectionModel.IsSelected(999).Value);
+                Verify.IsFalse(selectionModel.IsSelected(1000).Value);
+                Verify.IsFalse(selectionModel.IsSelected(count - 1001).Value);
+                Verify.IsTrue(selectionModel.IsSelected(count - 1000).Value);
+                Verify.AreEqual(0, Path(count - 1000).CompareTo(selectionModel.SelectedIndices[1000]));
+
+                // Selecting an overlapping range only adds the items that were not selected yet.
+                selectionModel.SetAnchorIndex(500);
+                selectionModel.SelectRangeFromAnchor(1499);
+                Verify.AreEqual(2500, selectionModel.SelectedIndices.Count);
+                Verify.AreEqual(1499, selectionModel.SelectedIndices[1499].GetAt(0));
+            });
+        }
+
+        [TestMethod]
+        public void ValidateSelectedIndicesEnumerationMatchesGetAt()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var selectionModel = new SelectionModel();
+                selectionModel.Source = CreateNestedData(1 /* levels */ , 3 /* groupsAtLevel */, 1000 /* countAtLeaf */);
+
+                // Several ranges in several nodes, with an unselected group in the middle.
+                selectionModel.SelectRange(Path(0, 10), Path(0, 19));
+                selectionModel.SelectRange(Path(0, 500), Path(0, 999));
+                selectionModel.SelectRange(Path(2, 0), Path(2, 0));
+                selectionModel.SelectRange(Path(2, 998), Path(2, 999));
+
+                var indices = selectionModel.SelectedIndices;
+                var items = selectionModel.SelectedItems;
+                Verify.AreEqual(513, indices.Count);
+                Verify.AreEqual(513, items.Count);
+
+                int position = 0;
+                foreach (var index in indices)
+                {
+                    Verify.AreEqual(0, index.CompareTo(indices[position]));
+                    Verify.AreEqual(GetData(selectionModel, index), items[position]);
+                    position++;
+                }
+
+                Verify.AreEqual(513, position);
+                Verify.AreEqual(0, Path(0, 500).CompareTo(indices[10]));
+                Verify.AreEqual(0, Path(2, 0).CompareTo(indices[510]));
+                Verify.AreEqual(0, Path(2, 999).CompareTo(indices[512]));
+            });
+        }
+
         [TestMethod]
         public void ValidateTwoLevelSingleSelection()
         {
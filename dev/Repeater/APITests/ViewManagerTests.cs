@@ -186,6 +186,78 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void ValidatePinnedElementsFollowCollectionChanges()
+        {
+            var data = new ObservableCollection<string>(Enumerable.Range(0, 100).Select(i => string.Format("Item #{0}", i)));
+            VirtualizingLayout layout = null;
+            RunOnUIThread.Execute(() => layout = new StackLayout());
+            ScrollViewer scrollViewer = null;
+            var repeater = SetupRepeater(data, layout, out scrollViewer);
+            var viewChanged = new ManualResetEvent(false);
+            List<UIElement> pinnedElements = null;
+
+            RunOnUIThread.Execute(() =>
+            {
+                pinnedElements = Enumerable.Range(0, 2).Select(i => repeater.TryGetElement(i)).ToList();
+                foreach (var element in pinnedElements)
+                {
+                    Verify.IsNotNull(element);
+                    repeater.PinElement(element);
+                }
+
+                scrollViewer.ViewChanged += (sender, args) =>
+                {
+                    if (!args.IsIntermediate)
+                    {
+                        viewChanged.Set();
+                    }
+                };
+                scrollViewer.ChangeView(null, 5000.0, null, disableAnimation: true);
+            });
+
+            Verify.IsTrue(viewChanged.WaitOne(DefaultWaitTimeInMS), "Waiting for the view to change.");
+            IdleSynchronizer.Wait();
+
+            RunOnUIThread.Execute(() =>
+            {
+                Log.Comment("Pinned elements are out of the viewport but still realized.");
+                for (int i = 0; i < pinnedElements.Count; ++i)
+                {
+                    Verify.AreEqual(i, repeater.GetElementIndex(pinnedElements[i]));
+                    Verify.AreSame(pinnedElements[i], repeater.TryGetElement(i));
+                }
+
+                Log.Comment("Insert before the pinned elements and validate they moved with their data.");
+                data.Insert(0, "Inserted #0");
+                for (int i = 0; i < pinnedElements.Count; ++i)
+                {
+                    Verify.AreEqual(i + 1, repeater.GetElementIndex(pinnedElements[i]));
+                    Verify.AreSame(pinnedElements[i], repeater.TryGetElement(i + 1));
+                }
+                Verify.IsNull(repeater.TryGetElement(0));
+
+                Log.Comment("Remove the inserted item and scroll back.");
+                data.RemoveAt(0);
+                viewChanged.Reset();
+                scrollViewer.ChangeView(null, 0.0, null, disableAnimation: true);
+            });
+
+            Verify.IsTrue(viewChanged.WaitOne(DefaultWaitTimeInMS), "Waiting for the view to change.");
+            IdleSynchronizer.Wait();
+
+            RunOnUIThread.Execute(() =>
+            {
+                Log.Comment("Layout got the pinned elements back for their indices.");
+                for (int i = 0; i < pinnedElements.Count; ++i)
+                {
+                    Verify.AreSame(pinnedElements[i], repeater.TryGetElement(i));
+                    Verify.AreEqual(i, repeater.GetElementIndex(pinnedElements[i]));
+                    repeater.UnpinElement(pinnedElements[i]);
+                }
+            });
+        }
+
         // [TestMethod] Issue 1018
         public void CanReuseElementsDuringUniqueIdReset()
         {
@@ -586,6 +658,142 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void CanReuseElementsAcrossUniqueIdResets()
+        {
+            CustomItemsSource dataSource = null;
+            RunOnUIThread.Execute(() => dataSource = new CustomItemsSourceWithUniqueId(Enumerable.Range(0, 100).ToList()));
+            var repeater = SetupRepeater(dataSource, @"<Button Content='{Binding}' Height='10' />");
+
+            RunOnUIThread.Execute(() =>
+            {
+                var preparedIndices = new List<int>();
+                repeater.ElementPrepared += (sender, args) =>
+                {
+                    preparedIndices.Add(args.Index);
+                };
+
+                // The second reset reuses the pool that the first one emptied.
+                for (int i = 0; i < 2; i++)
+                {
+                    var elementsByKey = GetRealizedElementsByKey(repeater, dataSource);
+                    // More elements than the reset pool starts out with room for.
+                    Verify.IsGreaterThan(elementsByKey.Count, 16);
+
+                    Log.Comment("(UniqueId Reset) Move items around");
+                    preparedIndices.Clear();
+                    dataSource.Reset();
+                    repeater.UpdateLayout();
+
+                    int newElementsCount = 0;
+                    foreach (var pair in GetRealizedElementsByKey(repeater, dataSource))
+                    {
+                        if (elementsByKey.ContainsKey(pair.Key))
+                        {
+                            Verify.AreEqual(elementsByKey[pair.Key], pair.Value);
+                        }
+                        else
+                        {
+                            newElementsCount++;
+                        }
+                    }
+
+                    Verify.AreEqual(newElementsCount, preparedIndices.Count);
+                }
+            });
+        }
+
+        [TestMethod]
+        public void CanCreateElementsForNewIdsDuringUniqueIdReset()
+        {
+            CustomItemsSource dataSource = null;
+            RunOnUIThread.Execute(() => dataSource = new CustomItemsSourceWithUniqueId(Enumerable.Range(0, 100).ToList()));
+            var repeater = SetupRepeater(dataSource, @"<Button Content='{Binding}' Height='10' />");
+
+            RunOnUIThread.Execute(() =>
+            {
+                var preparedIndices = new List<int>();
+                var clearedElements = new List<UIElement>();
+                repeater.ElementPrepared += (sender, args) =>
+                {
+                    preparedIndices.Add(args.Index);
+                };
+
+                repeater.ElementClearing += (sender, args) =>
+                {
+                    clearedElements.Add(args.Element);
+                };
+
+                var elementsByKey = GetRealizedElementsByKey(repeater, dataSource);
+                var replacedElement = repeater.TryGetElement(0);
+
+                Log.Comment("(UniqueId Reset) Replace the item at index 0 with one that has a new id");
+                dataSource.Replace(index: 0, oldCount: 1, newCount: 1, reset: true);
+                repeater.UpdateLayout();
+
+                // The new id is not in the pool, so the element comes from the factory.
+                Verify.AreEqual(1, preparedIndices.Count);
+                Verify.AreEqual(0, preparedIndices[0]);
+                Verify.IsFalse(elementsByKey.ContainsValue(repeater.TryGetElement(0)));
+
+                // The element of the replaced item was not picked up and got cleared.
+                Verify.AreEqual(1, clearedElements.Count);
+                Verify.AreEqual(replacedElement, clearedElements[0]);
+
+                for (int i = 1; i < elementsByKey.Count; i++)
+                {
+                    Verify.AreEqual(elementsByKey[dataSource.Inner[i]], repeater.TryGetElement(i));
+                }
+            });
+        }
+
+        [TestMethod]
+        public void ValidateUniqueIdResetPoolIsClearedOnItemsSourceChange()
+        {
+            CustomItemsSource dataSource = null;
+            RunOnUIThread.Execute(() => dataSource = new CustomItemsSourceWithUniqueId(Enumerable.Range(0, 100).ToList()));
+            var repeater = SetupRepeater(dataSource, @"<Button Content='{Binding}' Height='10' />");
+
+            RunOnUIThread.Execute(() =>
+            {
+                var clearedElements = new List<UIElement>();
+                repeater.ElementClearing += (sender, args) =>
+                {
+                    clearedElements.Add(args.Element);
+                };
+
+                var oldElements = GetRealizedElementsByKey(repeater, dataSource).Values.ToList();
+
+                // The realized elements go to the unique id reset pool, then the source
+                // changes to one that has none of their ids before layout runs.
+                dataSource.Reset();
+                var newDataSource = new CustomItemsSourceWithUniqueId(Enumerable.Range(1000, 100).ToList());
+                repeater.ItemsSource = newDataSource;
+                repeater.UpdateLayout();
+
+                Verify.AreEqual(oldElements.Count, clearedElements.Count);
+                foreach (var element in oldElements)
+                {
+                    Verify.IsTrue(clearedElements.Contains(element));
+                }
+
+                // Nothing is left behind in the pool, so a reset of the new source can
+                // put the same ids back into it and take them out again.
+                var elementsByKey = GetRealizedElementsByKey(repeater, newDataSource);
+                Verify.IsGreaterThan(elementsByKey.Count, 0);
+                newDataSource.Reset();
+                repeater.UpdateLayout();
+
+                foreach (var pair in GetRealizedElementsByKey(repeater, newDataSource))
+                {
+                    if (elementsByKey.ContainsKey(pair.Key))
+                    {
+                        Verify.AreEqual(elementsByKey[pair.Key], pair.Value);
+                    }
+                }
+            });
+        }
+
         [TestMethod]
         public void ValidateDataContextDoesNotGetOverwritten()
         {
@@ -786,6 +994,21 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             return repeater;
         }
 
+        private static Dictionary<int, UIElement> GetRealizedElementsByKey(ItemsRepeater repeater, CustomItemsSource dataSource)
+        {
+            var elementsByKey = new Dictionary<int, UIElement>();
+            for (int i = 0; i < dataSource.Inner.Count; i++)
+            {
+                var element = repeater.TryGetElement(i);
+                if (element != null)
+                {
+                    elementsByKey.Add(dataSource.Inner[i], element);
+                }
+            }
+
+            return elementsByKey;
+        }
+
         private VirtualizingLayout CreateLayout(ItemsRepeater repeater)
         {
             var layout = new MockVirtualizingLayout();
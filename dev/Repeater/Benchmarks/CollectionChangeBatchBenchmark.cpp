@@ -0,0 +1,353 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+// Headless check and benchmark for CollectionChangeBatch. Replays random sequences of inserts,
+// removes and replaces both into a batch and into a plain vector, then verifies that applying the
+// edits of the batch to the original items gives the same items as the vector, that the edits are
+// sorted and separated the way the batch promises, and that MapIndex finds every original item
+// that survived. Then times bursts of changes against a realized range, shifting the realized
+// indices once per change the way ViewManager does without batching, and once through MapIndex
+// after the burst. Returns a non zero exit code if any check fails or if the two ways of moving
+// the realized indices disagree. The timings are only reported: a batch pays for every edit it
+// keeps apart, so changes scattered over a large collection can cost more batched than not.
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#define MUX_ASSERT(X) assert(X)
+
+#include "CollectionChangeBatch.h"
+
+namespace
+{
+    struct Options
+    {
+        int sequences{ 20000 };
+        int burstChanges{ 10000 };
+        int realizedCount{ 200 };
+    };
+
+    class Random
+    {
+    public:
+        explicit Random(uint32_t seed) : m_state(seed * 2654435761u + 1u) {}
+
+        // Returns a value in [0, bound).
+        int Next(int bound)
+        {
+            m_state = m_state * 1664525u + 1013904223u;
+            return static_cast<int>((m_state >> 8) % static_cast<uint32_t>(bound));
+        }
+
+    private:
+        uint32_t m_state;
+    };
+
+    std::vector<int> CreateItems(int first, int count)
+    {
+        std::vector<int> items(count);
+        for (int i = 0; i < count; i++)
+        {
+            items[i] = first + i;
+        }
+        return items;
+    }
+
+    // Applies the edits from last to first to the original items.
+    std::vector<int> ApplyEdits(std::vector<int> items, const CollectionChangeBatch<int>& batch, bool& removedMatch)
+    {
+        const auto& edits = batch.Edits();
+        for (auto edit = edits.rbegin(); edit != edits.rend(); ++edit)
+        {
+            const auto begin = items.begin() + edit->Index;
+            removedMatch = removedMatch && std::equal(edit->Removed.begin(), edit->Removed.end(), begin);
+            items.erase(begin, begin + edit->Removed.size());
+            items.insert(items.begin() + edit->Index, edit->Inserted.begin(), edit->Inserted.end());
+        }
+        return items;
+    }
+
+    bool AreEditsOrdered(const CollectionChangeBatch<int>& batch)
+    {
+        const auto& edits = batch.Edits();
+        for (size_t i = 1; i < edits.size(); i++)
+        {
+            const auto& previous = edits[i - 1];
+            const int previousEnd = previous.Index + static_cast<int>(previous.Removed.size());
+            // Edits never overlap, and only replaces can touch their neighbours.
+            if (edits[i].Index < previousEnd ||
+                (edits[i].Index == previousEnd && !previous.IsReplace && !edits[i].IsReplace))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool IsReplaced(const CollectionChangeBatch<int>& batch, int oldIndex)
+    {
+        for (const auto& edit : batch.Edits())
+        {
+            if (edit.IsReplace && oldIndex >= edit.Index && oldIndex < edit.Index + static_cast<int>(edit.Removed.size()))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Replays one random sequence of changes and returns an empty string if the batch agrees with
+    // the plain vector, or a description of the first disagreement.
+    const char* CheckSequence(uint32_t seed)
+    {
+        Random random(seed);
+        const int originalCount = 20;
+        const auto original = CreateItems(0, originalCount);
+        auto current = original;
+        int nextItem = 1000;
+        CollectionChangeBatch<int> batch;
+
+        const int changeCount = 1 + random.Next(8);
+        for (int change = 0; change < changeCount; change++)
+        {
+            const int kind = random.Next(3);
+            const int size = static_cast<int>(current.size());
+            if (kind == 0 || size <= 3)
+            {
+                const int index = random.Next(size + 1);
+                const auto inserted = CreateItems(nextItem, 1 + random.Next(3));
+                nextItem += static_cast<int>(inserted.size());
+                current.insert(current.begin() + index, inserted.begin(), inserted.end());
+                batch.Insert(index, inserted);
+            }
+            else if (kind == 1)
+            {
+                const int index = random.Next(size - 2);
+                const std::vector<int> removed(current.begin() + index, current.begin() + index + 1 + random.Next(2));
+                current.erase(current.begin() + index, current.begin() + index + removed.size());
+                batch.Remove(index, removed);
+            }
+            else
+            {
+                const int index = random.Next(size - 2);
+                const std::vector<int> removed(current.begin() + index, current.begin() + index + 1 + random.Next(2));
+                const auto inserted = CreateItems(nextItem, 1 + random.Next(2));
+                nextItem += static_cast<int>(inserted.size());
+                current.erase(current.begin() + index, current.begin() + index + removed.size());
+                current.insert(current.begin() + index, inserted.begin(), inserted.end());
+                batch.Replace(index, removed, inserted);
+            }
+        }
+
+        if (!AreEditsOrdered(batch))
+        {
+            return "edits out of order";
+        }
+
+        bool removedMatch = true;
+        if (ApplyEdits(original, batch, removedMatch) != current)
+        {
+            return "edits don't reproduce the changes";
+        }
+
+        if (!removedMatch)
+        {
+            return "edit removes other items";
+        }
+
+        int countChange = 0;
+        for (const auto& edit : batch.Edits())
+        {
+            countChange += edit.CountChange();
+        }
+
+        if (countChange != batch.CountChange() || static_cast<int>(current.size()) != originalCount + countChange)
+        {
+            return "wrong count change";
+        }
+
+        for (int oldIndex = 0; oldIndex < originalCount; oldIndex++)
+        {
+            const auto it = std::find(current.begin(), current.end(), original[oldIndex]);
+            const int expected = it != current.end() ? static_cast<int>(it - current.begin()) : -1;
+            const int mapped = batch.MapIndex(oldIndex);
+            // A replaced item is gone, but its index carries over to what replaced it.
+            if (expected >= 0 ? mapped != expected : (mapped >= 0 && !IsReplaced(batch, oldIndex)))
+            {
+                return "MapIndex disagrees";
+            }
+        }
+
+        return "";
+    }
+
+    // An insert or a remove, with the items it removes as the source would report them.
+    struct BurstChange
+    {
+        int Index;
+        int InsertedCount;
+        std::vector<int> Removed;
+    };
+
+    // A burst of inserts and removes at the first spread indices, e.g. a feed receiving new
+    // messages at the top, or anywhere in the collection if spread is 0. The items are their
+    // own original index, or -1 if a change of the burst inserted them.
+    std::vector<BurstChange> CreateBurst(int itemCount, int changeCount, int spread)
+    {
+        Random random(7);
+        auto items = CreateItems(0, itemCount);
+        std::vector<BurstChange> changes;
+        changes.reserve(changeCount);
+        for (int i = 0; i < changeCount; i++)
+        {
+            const int size = static_cast<int>(items.size());
+            const int count = 1 + random.Next(3);
+            const bool isInsert = random.Next(2) == 0 || size < 10;
+            const int range = isInsert ? size + 1 : size - count + 1;
+            const int index = random.Next(spread > 0 ? std::min(spread, range) : range);
+            if (isInsert)
+            {
+                items.insert(items.begin() + index, count, -1);
+                changes.push_back(BurstChange{ index, count, {} });
+            }
+            else
+            {
+                const auto begin = items.begin() + index;
+                changes.push_back(BurstChange{ index, 0, std::vector<int>(begin, begin + count) });
+                items.erase(begin, begin + count);
+            }
+        }
+        return changes;
+    }
+
+    // Moves every realized index once per change, -1 for the removed ones.
+    std::vector<int> ShiftPerChange(std::vector<int> realized, const std::vector<BurstChange>& changes)
+    {
+        for (const auto& change : changes)
+        {
+            const int removedCount = static_cast<int>(change.Removed.size());
+            for (auto& index : realized)
+            {
+                if (index < change.Index)
+                {
+                    continue;
+                }
+
+                if (change.InsertedCount > 0)
+                {
+                    index += change.InsertedCount;
+                }
+                else
+                {
+                    index = index < change.Index + removedCount ? -1 : index - removedCount;
+                }
+            }
+        }
+        return realized;
+    }
+
+    // Coalesces the changes and moves every realized index once.
+    std::vector<int> ShiftThroughBatch(std::vector<int> realized, const std::vector<BurstChange>& changes)
+    {
+        CollectionChangeBatch<int> batch;
+        for (const auto& change : changes)
+        {
+            if (change.InsertedCount > 0)
+            {
+                batch.Insert(change.Index, std::vector<int>(change.InsertedCount, -1));
+            }
+            else
+            {
+                batch.Remove(change.Index, change.Removed);
+            }
+        }
+
+        for (auto& index : realized)
+        {
+            index = index < 0 ? -1 : batch.MapIndex(index);
+        }
+        return realized;
+    }
+
+    template <typename F>
+    double TimeMicroseconds(F&& callback)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        callback();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count();
+    }
+
+    Options ParseOptions(int argc, char* argv[])
+    {
+        Options options;
+        for (int i = 1; i < argc; i++)
+        {
+            if (strcmp(argv[i], "--quick") == 0)
+            {
+                options.sequences = 5000;
+                options.burstChanges = 1000;
+            }
+            else if (strcmp(argv[i], "--sequences") == 0 && i + 1 < argc)
+            {
+                options.sequences = atoi(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--changes") == 0 && i + 1 < argc)
+            {
+                options.burstChanges = atoi(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--realized") == 0 && i + 1 < argc)
+            {
+                options.realizedCount = atoi(argv[++i]);
+            }
+        }
+        return options;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const auto options = ParseOptions(argc, argv);
+    bool passed = true;
+
+    int failures = 0;
+    for (int sequence = 0; sequence < options.sequences; sequence++)
+    {
+        const char* failure = CheckSequence(static_cast<uint32_t>(sequence));
+        if (*failure)
+        {
+            if (failures++ < 10)
+            {
+                printf("sequence %d: %s\n", sequence, failure);
+            }
+            passed = false;
+        }
+    }
+    printf("%d of %d random sequences agree with the plain vector\n", options.sequences - failures, options.sequences);
+
+    const int itemCount = 100000;
+    const auto realized = CreateItems(itemCount / 2, options.realizedCount);
+    printf("%-10s %-10s %8s %9s %12s\n", "burst", "shift", "changes", "realized", "total(us)");
+    for (const auto& burst : { std::make_pair("top", 50), std::make_pair("scattered", 0) })
+    {
+        const auto changes = CreateBurst(itemCount, options.burstChanges, burst.second);
+        std::vector<int> perChange;
+        std::vector<int> batched;
+        const double perChangeMicroseconds = TimeMicroseconds([&]() { perChange = ShiftPerChange(realized, changes); });
+        const double batchedMicroseconds = TimeMicroseconds([&]() { batched = ShiftThroughBatch(realized, changes); });
+        const bool consistent = perChange == batched;
+
+        printf("%-10s %-10s %8d %9d %12.0f\n", burst.first, "perchange", options.burstChanges, options.realizedCount, perChangeMicroseconds);
+        printf("%-10s %-10s %8d %9d %12.0f%s\n", burst.first, "batched", options.burstChanges, options.realizedCount, batchedMicroseconds, consistent ? "" : "  INCONSISTENT INDICES");
+        passed = passed && consistent;
+    }
+
+    return passed ? 0 : 1;
+}
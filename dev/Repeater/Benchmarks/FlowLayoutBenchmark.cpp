@@ -0,0 +1,377 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+// Headless throughput benchmark for the platform neutral FlowLayoutAlgorithmCore/ElementManagerCore.
+// Drives synthetic items through forward and backward scroll sweeps and reports the measure pass
+// time and the number of elements realized per frame. Returns a non zero exit code if the layout
+// produced inconsistent bounds or if the average measure pass exceeds --max-avg-us.
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#define MUX_ASSERT(X) assert(X)
+
+#include "ElementManagerCore.h"
+#include "FlowLayoutAlgorithmCore.h"
+
+namespace
+{
+    struct Rect
+    {
+        float X;
+        float Y;
+        float Width;
+        float Height;
+    };
+
+    struct Size
+    {
+        float Width;
+        float Height;
+    };
+
+    enum class ItemSizes
+    {
+        Fixed,
+        Variable,
+        Pathological
+    };
+
+    const char* ToString(ItemSizes sizes)
+    {
+        switch (sizes)
+        {
+        case ItemSizes::Fixed: return "fixed";
+        case ItemSizes::Variable: return "variable";
+        case ItemSizes::Pathological: return "pathological";
+        }
+        return "";
+    }
+
+    std::vector<Size> CreateItems(ItemSizes sizes, int count)
+    {
+        std::vector<Size> items;
+        items.reserve(count);
+        uint32_t seed = 0x12345678u;
+        auto next = [&seed]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+
+        for (int i = 0; i < count; i++)
+        {
+            switch (sizes)
+            {
+            case ItemSizes::Fixed:
+                items.push_back(Size{ 100.0f, 40.0f });
+                break;
+            case ItemSizes::Variable:
+                items.push_back(Size{ 60.0f + static_cast<float>(next() % 140), 20.0f + static_cast<float>(next() % 100) });
+                break;
+            case ItemSizes::Pathological:
+                // Mostly tiny items with the occasional huge one. This defeats
+                // estimation and produces very uneven lines.
+                items.push_back(i % 997 == 0 ? Size{ 1000.0f, 4000.0f } : Size{ 1.0f + static_cast<float>(next() % 4), 1.0f + static_cast<float>(next() % 4) });
+                break;
+            }
+        }
+
+        return items;
+    }
+
+    // Plays the role of ElementManager + VirtualizingLayoutContext for the benchmark.
+    // Elements are represented by their data index + 1 (0 is the sentinel).
+    class SyntheticLayoutPolicy
+    {
+    public:
+        using Rect = ::Rect;
+        using Size = ::Size;
+
+        SyntheticLayoutPolicy(const std::vector<Size>& items, bool isWrapping) :
+            m_items(items),
+            m_isWrapping(isWrapping)
+        { }
+
+        ElementManagerCore<int, Rect>& Realized() { return m_realized; }
+        void SetRealizationRect(const Rect& rect) { m_realizationRect = rect; }
+        int ElementsRealizedThisFrame() const { return m_elementsRealizedThisFrame; }
+        void ResetFrameCounters() { m_elementsRealizedThisFrame = 0; }
+        double AverageMeasuredMajorSize() const { return m_measuredCount > 0 ? m_measuredMajorSize / m_measuredCount : 0.0; }
+
+        bool IsVirtualizingContext() { return true; }
+        Rect RealizationRect() { return m_realizationRect; }
+        int ItemCount() { return static_cast<int>(m_items.size()); }
+
+        void EnsureElementRealized(bool forward, int dataIndex)
+        {
+            if (!m_realized.IsDataIndexRealized(dataIndex))
+            {
+                ++m_elementsRealizedThisFrame;
+                if (forward)
+                {
+                    m_realized.Add(dataIndex + 1, dataIndex);
+                }
+                else
+                {
+                    m_realized.Insert(0, dataIndex, dataIndex + 1);
+                }
+            }
+        }
+
+        Size MeasureElement(int dataIndex, const Size& availableSize)
+        {
+            auto size = m_items[dataIndex];
+            if (!m_isWrapping)
+            {
+                // StackLayout stretches elements in the non virtualizing direction.
+                size.Width = std::max(size.Width, availableSize.Width);
+            }
+
+            m_measuredMajorSize += size.Height;
+            ++m_measuredCount;
+            return size;
+        }
+
+        bool ShouldBreakLine(int /*dataIndex*/, double remainingSpace)
+        {
+            return !m_isWrapping || remainingSpace < 0;
+        }
+
+        Rect GetLayoutBoundsForDataIndex(int dataIndex) { return m_realized.BoundsAt(m_realized.GetRealizedRangeIndexFromDataIndex(dataIndex)); }
+        void SetLayoutBoundsForDataIndex(int dataIndex, const Rect& bounds) { m_realized.SetBoundsAt(m_realized.GetRealizedRangeIndexFromDataIndex(dataIndex), bounds); }
+
+        void DiscardElementsOutsideWindow(bool forward, int startIndex)
+        {
+            if (m_realized.IsDataIndexRealized(startIndex))
+            {
+                const int rangeIndex = m_realized.GetRealizedRangeIndexFromDataIndex(startIndex);
+                if (forward)
+                {
+                    m_realized.Erase(rangeIndex, m_realized.Count() - rangeIndex);
+                }
+                else
+                {
+                    m_realized.Erase(0, rangeIndex + 1);
+                }
+            }
+        }
+
+        void DiscardElementsOutsideWindow()
+        {
+            const int realizedRangeSize = m_realized.Count();
+            int frontCutoffIndex = -1;
+            int backCutoffIndex = realizedRangeSize;
+            m_realized.GetDiscardCutoffIndices(m_realizationRect, ScrollOrientation::Vertical, frontCutoffIndex, backCutoffIndex);
+
+            if (backCutoffIndex < realizedRangeSize - 1)
+            {
+                m_realized.Erase(backCutoffIndex + 1, realizedRangeSize - backCutoffIndex - 1);
+            }
+
+            if (frontCutoffIndex > 0)
+            {
+                m_realized.Erase(0, std::min(frontCutoffIndex, m_realized.Count()));
+            }
+        }
+
+        int GetRealizedElementCount() { return m_realized.Count(); }
+        Rect GetLayoutBoundsForRealizedIndex(int realizedIndex) { return m_realized.BoundsAt(realizedIndex); }
+        void ArrangeElement(int /*realizedIndex*/, const Rect& bounds) { m_arrangeChecksum += bounds.X + bounds.Y; }
+        void OnElementLaidOut(int /*dataIndex*/, const Rect& /*bounds*/, bool /*isCorrection*/) { }
+
+    private:
+        const std::vector<Size>& m_items;
+        bool m_isWrapping{};
+        ElementManagerCore<int, Rect> m_realized;
+        Rect m_realizationRect{};
+        int m_elementsRealizedThisFrame{};
+        double m_measuredMajorSize{};
+        int m_measuredCount{};
+        double m_arrangeChecksum{};
+    };
+
+    struct Options
+    {
+        int itemCount{ 100000 };
+        int frames{ 2000 };
+        double maxAverageMicroseconds{ 0.0 };
+    };
+
+    struct Result
+    {
+        double averageMicroseconds{};
+        double p95Microseconds{};
+        double maxMicroseconds{};
+        double averageRealizedPerFrame{};
+        int maxRealizedPerFrame{};
+        bool consistent{ true };
+    };
+
+    // Same flow as FlowLayoutAlgorithm::Measure: discard, pick an anchor (first realized element
+    // if the window is connected, an estimate otherwise), then generate in both directions.
+    void MeasurePass(SyntheticLayoutPolicy& policy, FlowLayoutAlgorithmCore<SyntheticLayoutPolicy>& algorithm, const Size& availableSize, bool isWrapping)
+    {
+        using GenerateDirection = FlowLayoutAlgorithmCore<SyntheticLayoutPolicy>::GenerateDirection;
+        auto& realized = policy.Realized();
+        const auto window = policy.RealizationRect();
+
+        policy.DiscardElementsOutsideWindow();
+
+        int anchorIndex = -1;
+        Rect anchorBounds{};
+        if (realized.Count() > 0 && realized.IsWindowConnected(window, ScrollOrientation::Vertical, false /* scrollOrientationSameAsFlow */))
+        {
+            anchorIndex = realized.FirstRealizedDataIndex();
+            anchorBounds = realized.BoundsAt(0);
+        }
+        else
+        {
+            realized.Erase(0, realized.Count());
+            const double averageSize = std::max(1.0, policy.AverageMeasuredMajorSize());
+            const int itemsPerLine = isWrapping ? std::max(1, static_cast<int>(availableSize.Width / 100.0f)) : 1;
+            anchorIndex = std::min(policy.ItemCount() - 1, static_cast<int>(std::max(0.0f, window.Y) / averageSize) * itemsPerLine);
+            anchorBounds = Rect{ 0.0f, window.Y, 0.0f, 0.0f };
+        }
+
+        policy.EnsureElementRealized(true /* forward */, anchorIndex);
+        const auto anchorSize = policy.MeasureElement(anchorIndex, availableSize);
+        policy.SetLayoutBoundsForDataIndex(anchorIndex, Rect{ anchorBounds.X, anchorBounds.Y, anchorSize.Width, anchorSize.Height });
+
+        algorithm.ResetRealizationWindowIndices(anchorIndex);
+        algorithm.Generate(GenerateDirection::Forward, anchorIndex, availableSize, 0.0 /* minItemSpacing */, 0.0 /* lineSpacing */, std::numeric_limits<unsigned int>::max(), false /* disableVirtualization */);
+        algorithm.Generate(GenerateDirection::Backward, anchorIndex, availableSize, 0.0 /* minItemSpacing */, 0.0 /* lineSpacing */, std::numeric_limits<unsigned int>::max(), false /* disableVirtualization */);
+    }
+
+    // Every realized element must have been laid out (no pending sentinel bounds) and the
+    // realized range must still be connected to the realization window.
+    bool ValidateRealizedRange(SyntheticLayoutPolicy& policy)
+    {
+        auto& realized = policy.Realized();
+        for (int i = 0; i < realized.Count(); i++)
+        {
+            const auto bounds = realized.BoundsAt(i);
+            if (bounds.Width < 0 || bounds.Height < 0)
+            {
+                return false;
+            }
+        }
+
+        return realized.Count() > 0 && realized.IsWindowConnected(policy.RealizationRect(), ScrollOrientation::Vertical, false /* scrollOrientationSameAsFlow */);
+    }
+
+    Result RunSweep(ItemSizes sizes, bool isWrapping, float velocity, const Options& options)
+    {
+        const auto items = CreateItems(sizes, options.itemCount);
+        SyntheticLayoutPolicy policy(items, isWrapping);
+        FlowLayoutAlgorithmCore<SyntheticLayoutPolicy> algorithm(policy);
+        algorithm.SetScrollOrientation(ScrollOrientation::Vertical);
+
+        const Size availableSize{ 1000.0f, std::numeric_limits<float>::infinity() };
+        const float viewportHeight = 1000.0f;
+        // Same default cache length as ItemsRepeater: one viewport on each side.
+        const float cacheLength = viewportHeight;
+
+        std::vector<double> durations;
+        durations.reserve(options.frames);
+        Result result;
+        int64_t totalRealized = 0;
+        float offset = 0.0f;
+
+        for (int frame = 0; frame < options.frames; frame++)
+        {
+            // First half scrolls forward, second half scrolls back.
+            offset = std::max(0.0f, offset + (frame < options.frames / 2 ? velocity : -velocity));
+            policy.SetRealizationRect(Rect{ 0.0f, offset - cacheLength, availableSize.Width, viewportHeight + 2 * cacheLength });
+            policy.ResetFrameCounters();
+
+            const auto start = std::chrono::steady_clock::now();
+            MeasurePass(policy, algorithm, availableSize, isWrapping);
+            algorithm.Arrange(Size{ availableSize.Width, viewportHeight }, FlowLayoutAlgorithmLineAlignment::Start, isWrapping, false /* scrollOrientationSameAsFlow */, 0.0f, 0.0f);
+            const auto end = std::chrono::steady_clock::now();
+
+            durations.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+            totalRealized += policy.ElementsRealizedThisFrame();
+            result.maxRealizedPerFrame = std::max(result.maxRealizedPerFrame, policy.ElementsRealizedThisFrame());
+            result.consistent = result.consistent && ValidateRealizedRange(policy);
+        }
+
+        double total = 0.0;
+        for (auto duration : durations)
+        {
+            total += duration;
+        }
+
+        result.averageMicroseconds = total / durations.size();
+        result.averageRealizedPerFrame = static_cast<double>(totalRealized) / durations.size();
+        std::sort(durations.begin(), durations.end());
+        result.p95Microseconds = durations[static_cast<size_t>(durations.size() * 0.95)];
+        result.maxMicroseconds = durations.back();
+        return result;
+    }
+
+    Options ParseOptions(int argc, char* argv[])
+    {
+        Options options;
+        for (int i = 1; i < argc; i++)
+        {
+            if (strcmp(argv[i], "--quick") == 0)
+            {
+                options.itemCount = 10000;
+                options.frames = 200;
+            }
+            else if (strcmp(argv[i], "--items") == 0 && i + 1 < argc)
+            {
+                options.itemCount = atoi(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            {
+                options.frames = atoi(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--max-avg-us") == 0 && i + 1 < argc)
+            {
+                options.maxAverageMicroseconds = atof(argv[++i]);
+            }
+        }
+        return options;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const auto options = ParseOptions(argc, argv);
+    bool passed = true;
+
+    printf("%-14s %-6s %9s %10s %10s %10s %14s %14s\n", "items", "mode", "velocity", "avg(us)", "p95(us)", "max(us)", "realized/frame", "max realized");
+    for (auto sizes : { ItemSizes::Fixed, ItemSizes::Variable, ItemSizes::Pathological })
+    {
+        for (bool isWrapping : { false, true })
+        {
+            for (float velocity : { 60.0f, 600.0f })
+            {
+                const auto result = RunSweep(sizes, isWrapping, velocity, options);
+                printf("%-14s %-6s %9.0f %10.2f %10.2f %10.2f %14.2f %14d%s\n",
+                    ToString(sizes),
+                    isWrapping ? "wrap" : "stack",
+                    velocity,
+                    result.averageMicroseconds,
+                    result.p95Microseconds,
+                    result.maxMicroseconds,
+                    result.averageRealizedPerFrame,
+                    result.maxRealizedPerFrame,
+                    result.consistent ? "" : "  INCONSISTENT LAYOUT");
+
+                passed = passed && result.consistent;
+                if (options.maxAverageMicroseconds > 0.0 && result.averageMicroseconds > options.maxAverageMicroseconds)
+                {
+                    passed = false;
+                }
+            }
+        }
+    }
+
+    return passed ? 0 : 1;
+}
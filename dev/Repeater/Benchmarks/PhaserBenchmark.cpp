@@ -0,0 +1,299 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+// Headless benchmark for the ordering of pending x:Phase work. A grid of items with pending phases
+// is driven through a scroll sweep while a fixed number of phases runs every frame, once with
+// PhaserCore and once with the re-sort on every callback that Phaser used to do. Reports the time
+// spent picking the next element per frame. Returns a non zero exit code if an element ran its
+// phases out of order, if the two orderings did a different amount of work, or if the average
+// frame with PhaserCore exceeds --max-avg-us.
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define MUX_ASSERT(X) assert(X)
+
+#include "PhaserCore.h"
+
+namespace
+{
+    struct Rect
+    {
+        float X;
+        float Y;
+        float Width;
+        float Height;
+    };
+
+    constexpr int Columns = 10;
+    constexpr float ItemSize = 100.0f;
+    constexpr int LastPhase = 3;
+
+    Rect BoundsOf(int index)
+    {
+        return Rect{ (index % Columns) * ItemSize, (index / Columns) * ItemSize, ItemSize, ItemSize };
+    }
+
+    struct Options
+    {
+        int itemCount{ 5000 };
+        int frames{ 600 };
+        int phasesPerFrame{ 32 };
+        float velocity{ 40.0f };
+        double maxAverageMicroseconds{ 0.0 };
+    };
+
+    struct Result
+    {
+        double averageMicroseconds{};
+        double p95Microseconds{};
+        double maxMicroseconds{};
+        int64_t phasesRun{};
+        bool consistent{ true };
+    };
+
+    // Stand-in for the data template components. Checks that every element
+    // runs its phases once each and in increasing order.
+    class PhaseTracker
+    {
+    public:
+        explicit PhaseTracker(int count) :
+            m_phases(count, 1)
+        {}
+
+        int Phase(int index) const { return m_phases[index]; }
+
+        // Runs the current phase of index and returns the next one, or -1 when done.
+        int Run(int index, int phase)
+        {
+            m_consistent = m_consistent && m_phases[index] == phase;
+            m_phasesRun++;
+            m_phases[index] = phase < LastPhase ? phase + 1 : -1;
+            return m_phases[index];
+        }
+
+        bool Consistent() const { return m_consistent; }
+        int64_t PhasesRun() const { return m_phasesRun; }
+
+    private:
+        std::vector<int> m_phases;
+        int64_t m_phasesRun{};
+        bool m_consistent{ true };
+    };
+
+    // What Phaser::DoPhasedWorkCallback used to do: sort all the pending elements by
+    // (visible, phase) and walk them from the end, going back to the visible elements
+    // whenever the walk leaves the visible window.
+    class SortingPhaser
+    {
+    public:
+        explicit SortingPhaser(PhaseTracker& tracker) :
+            m_tracker(tracker)
+        {}
+
+        void Add(int index) { m_pending.insert(m_pending.begin(), index); }
+        bool Empty() const { return m_pending.empty(); }
+        int RekeyCount() const { return 0; }
+
+        void DoPhasedWork(const Rect& visibleWindow, int budget)
+        {
+            if (m_pending.empty())
+            {
+                return;
+            }
+
+            std::sort(m_pending.begin(), m_pending.end(), [this, &visibleWindow](int lhs, int rhs)
+            {
+                const bool lhsIntersects = PhaserCore<int, int, Rect>::Intersects(BoundsOf(lhs), visibleWindow);
+                const bool rhsIntersects = PhaserCore<int, int, Rect>::Intersects(BoundsOf(rhs), visibleWindow);
+                if (lhsIntersects == rhsIntersects)
+                {
+                    return m_tracker.Phase(lhs) < m_tracker.Phase(rhs);
+                }
+                return !lhsIntersects;
+            });
+
+            int currentIndex = static_cast<int>(m_pending.size()) - 1;
+            do
+            {
+                const int index = m_pending[currentIndex];
+                const int nextPhase = m_tracker.Run(index, m_tracker.Phase(index));
+                if (nextPhase > 0)
+                {
+                    if (currentIndex == 0 || nextPhase > m_tracker.Phase(m_pending[currentIndex - 1]))
+                    {
+                        currentIndex--;
+                    }
+                }
+                else
+                {
+                    m_pending.erase(m_pending.begin() + currentIndex);
+                    currentIndex--;
+                }
+
+                const int pendingCount = static_cast<int>(m_pending.size());
+                if (currentIndex == -1)
+                {
+                    currentIndex = pendingCount - 1;
+                }
+                else if (currentIndex < pendingCount - 1 &&
+                    !PhaserCore<int, int, Rect>::Intersects(visibleWindow, BoundsOf(m_pending[currentIndex])) &&
+                    PhaserCore<int, int, Rect>::Intersects(visibleWindow, BoundsOf(m_pending[pendingCount - 1])))
+                {
+                    currentIndex = pendingCount - 1;
+                }
+            } while (!m_pending.empty() && --budget > 0);
+        }
+
+    private:
+        PhaseTracker& m_tracker;
+        std::vector<int> m_pending;
+    };
+
+    // Same flow as Phaser::DoPhasedWorkCallback on top of PhaserCore.
+    class IncrementalPhaser
+    {
+    public:
+        explicit IncrementalPhaser(PhaseTracker& tracker) :
+            m_tracker(tracker),
+            m_pending([](const int& index) { return BoundsOf(index); })
+        {}
+
+        void Add(int index) { m_pending.Push(index, index, m_tracker.Phase(index)); }
+        bool Empty() const { return m_pending.Empty(); }
+        int RekeyCount() const { return m_pending.RekeyCount(); }
+
+        void DoPhasedWork(const Rect& visibleWindow, int budget)
+        {
+            if (m_pending.Empty())
+            {
+                return;
+            }
+
+            m_pending.UpdateWindow(visibleWindow);
+            do
+            {
+                const auto entry = m_pending.Pop();
+                const int nextPhase = m_tracker.Run(entry.Value, entry.Phase);
+                if (nextPhase > 0)
+                {
+                    m_pending.Push(entry.Key, entry.Value, nextPhase);
+                }
+            } while (!m_pending.Empty() && --budget > 0);
+        }
+
+    private:
+        PhaseTracker& m_tracker;
+        PhaserCore<int, int, Rect> m_pending;
+    };
+
+    template <typename TPhaser>
+    Result RunSweep(const Options& options, int* rekeyCount = nullptr)
+    {
+        PhaseTracker tracker(options.itemCount);
+        TPhaser phaser(tracker);
+        for (int i = 0; i < options.itemCount; i++)
+        {
+            phaser.Add(i);
+        }
+
+        std::vector<double> durations;
+        durations.reserve(options.frames);
+        const float viewportHeight = 800.0f;
+        const float extent = (options.itemCount + Columns - 1) / Columns * ItemSize;
+        float offset = 0.0f;
+
+        for (int frame = 0; frame < options.frames && !phaser.Empty(); frame++)
+        {
+            offset = std::min(std::max(0.0f, extent - viewportHeight), offset + options.velocity);
+            const Rect visibleWindow{ 0.0f, offset, Columns * ItemSize, viewportHeight };
+
+            const auto start = std::chrono::steady_clock::now();
+            phaser.DoPhasedWork(visibleWindow, options.phasesPerFrame);
+            const auto end = std::chrono::steady_clock::now();
+            durations.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        }
+
+        Result result;
+        double total = 0.0;
+        for (auto duration : durations)
+        {
+            total += duration;
+        }
+
+        result.averageMicroseconds = durations.empty() ? 0.0 : total / durations.size();
+        std::sort(durations.begin(), durations.end());
+        result.p95Microseconds = durations.empty() ? 0.0 : durations[static_cast<size_t>(durations.size() * 0.95)];
+        result.maxMicroseconds = durations.empty() ? 0.0 : durations.back();
+        result.phasesRun = tracker.PhasesRun();
+        result.consistent = tracker.Consistent();
+        if (rekeyCount)
+        {
+            *rekeyCount = phaser.RekeyCount();
+        }
+        return result;
+    }
+
+    Options ParseOptions(int argc, char* argv[])
+    {
+        Options options;
+        for (int i = 1; i < argc; i++)
+        {
+            if (strcmp(argv[i], "--quick") == 0)
+            {
+                options.frames = 200;
+            }
+            else if (strcmp(argv[i], "--items") == 0 && i + 1 < argc)
+            {
+                options.itemCount = atoi(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            {
+                options.frames = atoi(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--phases-per-frame") == 0 && i + 1 < argc)
+            {
+                options.phasesPerFrame = std::max(1, atoi(argv[++i]));
+            }
+            else if (strcmp(argv[i], "--velocity") == 0 && i + 1 < argc)
+            {
+                options.velocity = static_cast<float>(atof(argv[++i]));
+            }
+            else if (strcmp(argv[i], "--max-avg-us") == 0 && i + 1 < argc)
+            {
+                options.maxAverageMicroseconds = atof(argv[++i]);
+            }
+        }
+        return options;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const auto options = ParseOptions(argc, argv);
+
+    int rekeyCount = 0;
+    const auto sorting = RunSweep<SortingPhaser>(options);
+    const auto incremental = RunSweep<IncrementalPhaser>(options, &rekeyCount);
+
+    printf("%d pending items, %d phases per frame, %.0f px per frame\n", options.itemCount, options.phasesPerFrame, options.velocity);
+    printf("%-12s %10s %10s %10s %12s\n", "ordering", "avg(us)", "p95(us)", "max(us)", "phases run");
+    printf("%-12s %10.2f %10.2f %10.2f %12lld%s\n", "sort", sorting.averageMicroseconds, sorting.p95Microseconds, sorting.maxMicroseconds,
+        static_cast<long long>(sorting.phasesRun), sorting.consistent ? "" : "  PHASES OUT OF ORDER");
+    printf("%-12s %10.2f %10.2f %10.2f %12lld%s (%d re-keys)\n", "incremental", incremental.averageMicroseconds, incremental.p95Microseconds, incremental.maxMicroseconds,
+        static_cast<long long>(incremental.phasesRun), incremental.consistent ? "" : "  PHASES OUT OF ORDER", rekeyCount);
+
+    bool passed = sorting.consistent && incremental.consistent && sorting.phasesRun == incremental.phasesRun;
+    if (options.maxAverageMicroseconds > 0.0 && incremental.averageMicroseconds > options.maxAverageMicroseconds)
+    {
+        passed = false;
+    }
+
+    return passed ? 0 : 1;
+}
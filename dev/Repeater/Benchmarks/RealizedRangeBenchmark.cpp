@@ -0,0 +1,385 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+// Headless benchmark for the realized range bookkeeping of ElementManagerCore. Scrolls a stack of
+// 1M items back and forth, discarding the elements that left the realization window and realizing
+// the ones that entered it at either end, the way ElementManager and FlowLayoutAlgorithm do every
+// measure pass. Compares ElementManagerCore with VectorRealizedRange, which stores the range the
+// way ElementManagerCore used to (a vector of elements and a vector of rects, erased and inserted
+// at the front). Returns a non zero exit code if the two disagree on the realized range, if the
+// average frame of ElementManagerCore exceeds --max-avg-us, or if the capacity of the bounds
+// buffer keeps growing while scrolling in one direction.
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define MUX_ASSERT(X) assert(X)
+
+#include "ElementManagerCore.h"
+
+namespace
+{
+    struct Rect
+    {
+        float X;
+        float Y;
+        float Width;
+        float Height;
+    };
+
+    // Stand-in for tracker_ref<UIElement>: moves go through user defined operations (swap
+    // based, with an owner, a handle and a value) instead of a memmove, so shifting a run
+    // of elements costs what it does in the control.
+    class TrackedElement
+    {
+    public:
+        explicit TrackedElement(int value) :
+            m_owner(this),
+            m_handle(reinterpret_cast<void*>(static_cast<intptr_t>(value))),
+            m_value(value)
+        { }
+
+        TrackedElement(TrackedElement&& other) noexcept :
+            m_owner(other.m_owner),
+            m_handle(other.m_handle),
+            m_value(other.m_value)
+        {
+            other.m_owner = nullptr;
+            other.m_handle = nullptr;
+            other.m_value = 0;
+        }
+
+        TrackedElement& operator=(TrackedElement&& other) noexcept
+        {
+            if (this != &other)
+            {
+                TrackedElement(std::move(other)).Swap(*this);
+            }
+            return *this;
+        }
+
+        ~TrackedElement()
+        {
+            if (m_owner)
+            {
+                m_handle = nullptr;
+            }
+        }
+
+        void Swap(TrackedElement& other)
+        {
+            std::swap(m_owner, other.m_owner);
+            std::swap(m_handle, other.m_handle);
+            std::swap(m_value, other.m_value);
+        }
+
+    private:
+        const void* m_owner;
+        void* m_handle;
+        int m_value;
+    };
+
+    // The previous storage of ElementManagerCore, kept as the baseline.
+    class VectorRealizedRange
+    {
+    public:
+        int Count() const { return static_cast<int>(m_elements.size()); }
+        int FirstRealizedDataIndex() const { return m_firstRealizedDataIndex; }
+        Rect BoundsAt(int realizedIndex) const { return m_bounds[realizedIndex]; }
+        void SetBoundsAt(int realizedIndex, const Rect& bounds) { m_bounds[realizedIndex] = bounds; }
+
+        void Add(TrackedElement&& element, int dataIndex)
+        {
+            if (m_elements.empty())
+            {
+                m_firstRealizedDataIndex = dataIndex;
+            }
+
+            m_elements.push_back(std::move(element));
+            m_bounds.push_back(Rect{});
+        }
+
+        void Insert(int realizedIndex, int dataIndex, TrackedElement&& element)
+        {
+            if (realizedIndex == 0)
+            {
+                m_firstRealizedDataIndex = dataIndex;
+            }
+
+            m_elements.insert(m_elements.begin() + realizedIndex, std::move(element));
+            m_bounds.insert(m_bounds.begin() + realizedIndex, Rect{ -1.f, -1.f, -1.f, -1.f });
+        }
+
+        void Erase(int realizedIndex, int count)
+        {
+            m_elements.erase(m_elements.begin() + realizedIndex, m_elements.begin() + realizedIndex + count);
+            m_bounds.erase(m_bounds.begin() + realizedIndex, m_bounds.begin() + realizedIndex + count);
+            if (realizedIndex == 0)
+            {
+                m_firstRealizedDataIndex = m_elements.empty() ? -1 : m_firstRealizedDataIndex + count;
+            }
+        }
+
+        bool IsWindowConnected(const Rect& window, const ScrollOrientation& /*orientation*/, bool /*scrollOrientationSameAsFlow*/) const
+        {
+            return
+                !m_bounds.empty() &&
+                m_bounds.front().Y <= window.Y + window.Height &&
+                m_bounds.back().Y + m_bounds.back().Height >= window.Y;
+        }
+
+        void GetDiscardCutoffIndices(const Rect& window, const ScrollOrientation& /*orientation*/, int& frontCutoffIndex, int& backCutoffIndex) const
+        {
+            const int realizedRangeSize = Count();
+            frontCutoffIndex = -1;
+            backCutoffIndex = realizedRangeSize;
+            for (int i = 0; i < realizedRangeSize && !Intersects(window, m_bounds[i]); ++i)
+            {
+                ++frontCutoffIndex;
+            }
+
+            for (int i = realizedRangeSize - 1; i >= 0 && !Intersects(window, m_bounds[i]); --i)
+            {
+                --backCutoffIndex;
+            }
+        }
+
+    private:
+        static bool Intersects(const Rect& lhs, const Rect& rhs)
+        {
+            return lhs.Y + lhs.Height >= rhs.Y && lhs.Y <= rhs.Y + rhs.Height;
+        }
+
+        std::vector<TrackedElement> m_elements;
+        std::vector<Rect> m_bounds;
+        int m_firstRealizedDataIndex{ -1 };
+    };
+
+    struct Options
+    {
+        int itemCount{ 1000000 };
+        int frames{ 5000 };
+        double maxAverageMicroseconds{ 0.0 };
+    };
+
+    struct Result
+    {
+        double averageMicroseconds{};
+        double p95Microseconds{};
+        double maxMicroseconds{};
+        double averageRealized{};
+        std::vector<int64_t> ranges;
+    };
+
+    // Dense rows of varying height, e.g. a log viewer. Offsets has one more entry than there are items.
+    std::vector<float> CreateItemOffsets(int count)
+    {
+        std::vector<float> offsets(count + 1);
+        uint32_t seed = 17;
+        for (int i = 0; i < count; i++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            offsets[i + 1] = offsets[i] + 16.0f + static_cast<float>((seed >> 24) % 17);
+        }
+        return offsets;
+    }
+
+    Rect ItemBounds(const std::vector<float>& offsets, int index)
+    {
+        return Rect{ 0.0f, offsets[index], 800.0f, offsets[index + 1] - offsets[index] };
+    }
+
+    // One measure pass worth of realized range maintenance.
+    template <typename TRange>
+    void UpdateRealizedRange(TRange& realized, const std::vector<float>& offsets, const Rect& window)
+    {
+        const int itemCount = static_cast<int>(offsets.size()) - 1;
+        const int realizedRangeSize = realized.Count();
+        int frontCutoffIndex = -1;
+        int backCutoffIndex = realizedRangeSize;
+        realized.GetDiscardCutoffIndices(window, ScrollOrientation::Vertical, frontCutoffIndex, backCutoffIndex);
+        if (backCutoffIndex < realizedRangeSize - 1)
+        {
+            realized.Erase(backCutoffIndex + 1, realizedRangeSize - backCutoffIndex - 1);
+        }
+
+        if (frontCutoffIndex > 0)
+        {
+            realized.Erase(0, std::min(frontCutoffIndex, realized.Count()));
+        }
+
+        if (realized.Count() == 0 || !realized.IsWindowConnected(window, ScrollOrientation::Vertical, false /* scrollOrientationSameAsFlow */))
+        {
+            realized.Erase(0, realized.Count());
+            const auto it = std::upper_bound(offsets.begin(), offsets.end(), std::max(0.0f, window.Y));
+            const int anchorIndex = std::min(itemCount - 1, std::max(0, static_cast<int>(it - offsets.begin()) - 1));
+            realized.Add(TrackedElement{ anchorIndex }, anchorIndex);
+            realized.SetBoundsAt(0, ItemBounds(offsets, anchorIndex));
+        }
+
+        const float windowEnd = window.Y + window.Height;
+        for (int next = realized.FirstRealizedDataIndex() + realized.Count();
+            next < itemCount && realized.BoundsAt(realized.Count() - 1).Y < windowEnd;
+            ++next)
+        {
+            realized.Add(TrackedElement{ next }, next);
+            realized.SetBoundsAt(realized.Count() - 1, ItemBounds(offsets, next));
+        }
+
+        for (int previous = realized.FirstRealizedDataIndex() - 1;
+            previous >= 0 && realized.BoundsAt(0).Y > window.Y;
+            --previous)
+        {
+            realized.Insert(0, previous, TrackedElement{ previous });
+            realized.SetBoundsAt(0, ItemBounds(offsets, previous));
+        }
+    }
+
+    template <typename TRange>
+    Result RunSweep(const std::vector<float>& offsets, float velocity, const Options& options)
+    {
+        TRange realized;
+        const float viewportHeight = 1000.0f;
+        // A cache length of 8 viewports, as used for kiosk style lists that must never show holes.
+        const float cacheLength = 4.0f * viewportHeight;
+        const float maxOffset = std::max(0.0f, offsets.back() - viewportHeight);
+
+        Result result;
+        result.ranges.reserve(options.frames);
+        std::vector<double> durations;
+        durations.reserve(options.frames);
+        int64_t totalRealized = 0;
+        float offset = 0.0f;
+        float direction = 1.0f;
+
+        for (int frame = 0; frame < options.frames; frame++)
+        {
+            offset += direction * velocity;
+            if (offset >= maxOffset || offset <= 0.0f)
+            {
+                offset = std::max(0.0f, std::min(offset, maxOffset));
+                direction = -direction;
+            }
+
+            const Rect window{ 0.0f, offset - cacheLength, 800.0f, viewportHeight + 2 * cacheLength };
+            const auto start = std::chrono::steady_clock::now();
+            UpdateRealizedRange(realized, offsets, window);
+            const auto end = std::chrono::steady_clock::now();
+
+            durations.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+            totalRealized += realized.Count();
+            result.ranges.push_back((static_cast<int64_t>(realized.FirstRealizedDataIndex()) << 32) | realized.Count());
+        }
+
+        double total = 0.0;
+        for (auto duration : durations)
+        {
+            total += duration;
+        }
+
+        result.averageMicroseconds = total / durations.size();
+        result.averageRealized = static_cast<double>(totalRealized) / durations.size();
+        std::sort(durations.begin(), durations.end());
+        result.p95Microseconds = durations[static_cast<size_t>(durations.size() * 0.95)];
+        result.maxMicroseconds = durations.back();
+        return result;
+    }
+
+    Options ParseOptions(int argc, char* argv[])
+    {
+        Options options;
+        for (int i = 1; i < argc; i++)
+        {
+            if (strcmp(argv[i], "--quick") == 0)
+            {
+                options.itemCount = 100000;
+                options.frames = 500;
+            }
+            else if (strcmp(argv[i], "--items") == 0 && i + 1 < argc)
+            {
+                options.itemCount = atoi(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            {
+                options.frames = atoi(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--max-avg-us") == 0 && i + 1 < argc)
+            {
+                options.maxAverageMicroseconds = atof(argv[++i]);
+            }
+        }
+        return options;
+    }
+
+    // Scrolls through every item in one direction and then back, keeping windowSize bounds
+    // realized, and returns whether the capacity of the buffer stayed bounded by the range.
+    bool CheckCapacityIsBounded(int itemCount, int windowSize)
+    {
+        RealizedBoundsBuffer<Rect> bounds;
+        int maxCapacity = 0;
+        for (int i = 0; i < itemCount; i++)
+        {
+            bounds.PushBack(Rect{ 0.0f, static_cast<float>(i), 800.0f, 1.0f });
+            if (bounds.Count() > windowSize)
+            {
+                bounds.Erase(0, 1);
+            }
+            maxCapacity = std::max(maxCapacity, bounds.Capacity());
+        }
+
+        for (int i = itemCount - windowSize - 1; i >= 0; i--)
+        {
+            bounds.PushFront(Rect{ 0.0f, static_cast<float>(i), 800.0f, 1.0f });
+            bounds.Erase(bounds.Count() - 1, 1);
+            maxCapacity = std::max(maxCapacity, bounds.Capacity());
+        }
+
+        const bool bounded = maxCapacity <= std::max(64, 4 * windowSize) && bounds.Count() == windowSize && bounds.At(0).Y == 0.0f;
+        printf("capacity %d for a range of %d over %d items%s\n", maxCapacity, windowSize, itemCount, bounded ? "" : "  UNBOUNDED CAPACITY");
+        return bounded;
+    }
+
+    void Print(const char* storage, float velocity, const Result& result, bool consistent)
+    {
+        printf("%-8s %9.0f %10.2f %10.2f %10.2f %14.2f%s\n",
+            storage,
+            velocity,
+            result.averageMicroseconds,
+            result.p95Microseconds,
+            result.maxMicroseconds,
+            result.averageRealized,
+            consistent ? "" : "  INCONSISTENT RANGE");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const auto options = ParseOptions(argc, argv);
+    const auto offsets = CreateItemOffsets(options.itemCount);
+    bool passed = true;
+
+    printf("%-8s %9s %10s %10s %10s %14s\n", "storage", "velocity", "avg(us)", "p95(us)", "max(us)", "realized");
+    for (float velocity : { 60.0f, 600.0f, 6000.0f, 60000.0f })
+    {
+        const auto baseline = RunSweep<VectorRealizedRange>(offsets, velocity, options);
+        const auto result = RunSweep<ElementManagerCore<TrackedElement, Rect>>(offsets, velocity, options);
+        const bool consistent = result.ranges == baseline.ranges;
+        Print("vector", velocity, baseline, true);
+        Print("soa", velocity, result, consistent);
+
+        passed = passed && consistent;
+        if (options.maxAverageMicroseconds > 0.0 && result.averageMicroseconds > options.maxAverageMicroseconds)
+        {
+            passed = false;
+        }
+    }
+
+    passed = CheckCapacityIsBounded(options.itemCount, 300) && passed;
+    return passed ? 0 : 1;
+}
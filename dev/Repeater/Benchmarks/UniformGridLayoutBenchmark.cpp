@@ -0,0 +1,386 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+// Headless benchmark comparing the closed form UniformGridLayoutCore with the generic
+// FlowLayoutAlgorithmCore path that UniformGridLayout used before, on long fling sweeps over
+// a large grid of fixed size items. Reports the measure pass time and the number of elements
+// measured and realized per frame. Returns a non zero exit code if the uniform path produced
+// bounds that differ from the closed form, did not cover the realization window, or if its
+// average measure pass exceeds --max-avg-us.
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#define MUX_ASSERT(X) assert(X)
+
+#include "ElementManagerCore.h"
+#include "FlowLayoutAlgorithmCore.h"
+#include "UniformGridLayoutCore.h"
+
+namespace
+{
+    struct Rect
+    {
+        float X;
+        float Y;
+        float Width;
+        float Height;
+    };
+
+    struct Size
+    {
+        float Width;
+        float Height;
+    };
+
+    // Thumbnails with a little spacing, as in a photo grid.
+    constexpr float ItemWidth = 96.0f;
+    constexpr float ItemHeight = 96.0f;
+    constexpr double ItemSpacing = 4.0;
+    constexpr double LineSpacing = 4.0;
+
+    // Plays the role of ElementManager + VirtualizingLayoutContext for the benchmark.
+    // Elements are represented by their data index + 1.
+    class SyntheticGridPolicy
+    {
+    public:
+        using Rect = ::Rect;
+        using Size = ::Size;
+
+        explicit SyntheticGridPolicy(int itemCount) : m_itemCount(itemCount) { }
+
+        ElementManagerCore<int, Rect>& Realized() { return m_realized; }
+        void SetRealizationRect(const Rect& rect) { m_realizationRect = rect; }
+        int ElementsRealizedThisFrame() const { return m_elementsRealizedThisFrame; }
+        int ElementsMeasuredThisFrame() const { return m_elementsMeasuredThisFrame; }
+        void ResetFrameCounters() { m_elementsRealizedThisFrame = 0; m_elementsMeasuredThisFrame = 0; }
+
+        bool IsVirtualizingContext() { return true; }
+        Rect RealizationRect() { return m_realizationRect; }
+        int ItemCount() { return m_itemCount; }
+
+        void EnsureElementRealized(bool forward, int dataIndex)
+        {
+            if (!m_realized.IsDataIndexRealized(dataIndex))
+            {
+                ++m_elementsRealizedThisFrame;
+                if (forward)
+                {
+                    m_realized.Add(dataIndex + 1, dataIndex);
+                }
+                else
+                {
+                    m_realized.Insert(0, dataIndex, dataIndex + 1);
+                }
+            }
+        }
+
+        Size MeasureElement(int /*dataIndex*/, const Size& /*availableSize*/)
+        {
+            ++m_elementsMeasuredThisFrame;
+            return Size{ ItemWidth, ItemHeight };
+        }
+
+        bool ShouldBreakLine(int /*dataIndex*/, double remainingSpace) { return remainingSpace < 0; }
+
+        Rect GetLayoutBoundsForDataIndex(int dataIndex) { return m_realized.BoundsAt(m_realized.GetRealizedRangeIndexFromDataIndex(dataIndex)); }
+        void SetLayoutBoundsForDataIndex(int dataIndex, const Rect& bounds) { m_realized.SetBoundsAt(m_realized.GetRealizedRangeIndexFromDataIndex(dataIndex), bounds); }
+
+        void DiscardElementsOutsideWindow(bool forward, int startIndex)
+        {
+            if (m_realized.IsDataIndexRealized(startIndex))
+            {
+                const int rangeIndex = m_realized.GetRealizedRangeIndexFromDataIndex(startIndex);
+                if (forward)
+                {
+                    m_realized.Erase(rangeIndex, m_realized.Count() - rangeIndex);
+                }
+                else
+                {
+                    m_realized.Erase(0, rangeIndex + 1);
+                }
+            }
+        }
+
+        // Same as ElementManager::OnBeginMeasure.
+        void DiscardElementsOutsideWindow()
+        {
+            const int realizedRangeSize = m_realized.Count();
+            int frontCutoffIndex = -1;
+            int backCutoffIndex = realizedRangeSize;
+            m_realized.GetDiscardCutoffIndices(m_realizationRect, ScrollOrientation::Vertical, frontCutoffIndex, backCutoffIndex);
+
+            if (backCutoffIndex < realizedRangeSize - 1)
+            {
+                m_realized.Erase(backCutoffIndex + 1, realizedRangeSize - backCutoffIndex - 1);
+            }
+
+            if (frontCutoffIndex > 0)
+            {
+                m_realized.Erase(0, std::min(frontCutoffIndex, m_realized.Count()));
+            }
+        }
+
+        int GetRealizedElementCount() { return m_realized.Count(); }
+        Rect GetLayoutBoundsForRealizedIndex(int realizedIndex) { return m_realized.BoundsAt(realizedIndex); }
+        void ArrangeElement(int /*realizedIndex*/, const Rect& bounds) { m_arrangeChecksum += bounds.X + bounds.Y; }
+        void OnElementLaidOut(int /*dataIndex*/, const Rect& /*bounds*/, bool /*isCorrection*/) { }
+
+        int FirstRealizedDataIndex() { return m_realized.FirstRealizedDataIndex(); }
+        void ClearRealizedRange(int realizedIndex, int count)
+        {
+            if (count > 0)
+            {
+                m_realized.Erase(realizedIndex, count);
+            }
+        }
+
+    private:
+        int m_itemCount{};
+        ElementManagerCore<int, Rect> m_realized;
+        Rect m_realizationRect{};
+        int m_elementsRealizedThisFrame{};
+        int m_elementsMeasuredThisFrame{};
+        double m_arrangeChecksum{};
+    };
+
+    enum class Path
+    {
+        Generic,
+        Uniform
+    };
+
+    struct Options
+    {
+        int itemCount{ 200000 };
+        int frames{ 2000 };
+        double maxAverageMicroseconds{ 0.0 };
+    };
+
+    struct Result
+    {
+        double averageMicroseconds{};
+        double p95Microseconds{};
+        double maxMicroseconds{};
+        double averageMeasuredPerFrame{};
+        double averageRealizedPerFrame{};
+        bool consistent{ true };
+    };
+
+    int ItemsPerLine(const Size& availableSize)
+    {
+        return UniformGridLayoutCore<SyntheticGridPolicy>::GetItemsPerLine(availableSize.Width, static_cast<float>(ItemWidth + ItemSpacing), std::numeric_limits<unsigned int>::max());
+    }
+
+    // Same flow as FlowLayoutAlgorithm::Measure with UniformGridLayout's delegates: discard, pick
+    // the first realized element as the anchor if the window is connected or compute it from the
+    // window otherwise, then generate in both directions.
+    void GenericMeasurePass(SyntheticGridPolicy& policy, FlowLayoutAlgorithmCore<SyntheticGridPolicy>& algorithm, const Size& availableSize)
+    {
+        using GenerateDirection = FlowLayoutAlgorithmCore<SyntheticGridPolicy>::GenerateDirection;
+        auto& realized = policy.Realized();
+        const auto window = policy.RealizationRect();
+        const float lineSize = static_cast<float>(ItemHeight + LineSpacing);
+
+        policy.DiscardElementsOutsideWindow();
+
+        int anchorIndex = -1;
+        Rect anchorBounds{};
+        if (realized.Count() > 0 && realized.IsWindowConnected(window, ScrollOrientation::Vertical, false /* scrollOrientationSameAsFlow */))
+        {
+            anchorIndex = realized.FirstRealizedDataIndex();
+            anchorBounds = realized.BoundsAt(0);
+        }
+        else
+        {
+            realized.Erase(0, realized.Count());
+            const int itemsPerLine = ItemsPerLine(availableSize);
+            const int anchorLine = static_cast<int>(std::max(0.0f, window.Y) / lineSize);
+            anchorIndex = std::max(0, std::min(policy.ItemCount() - 1, anchorLine * itemsPerLine));
+            anchorBounds = Rect{ 0.0f, (anchorIndex / itemsPerLine) * lineSize, 0.0f, 0.0f };
+        }
+
+        policy.EnsureElementRealized(true /* forward */, anchorIndex);
+        const auto anchorSize = policy.MeasureElement(anchorIndex, availableSize);
+        policy.SetLayoutBoundsForDataIndex(anchorIndex, Rect{ anchorBounds.X, anchorBounds.Y, anchorSize.Width, anchorSize.Height });
+
+        algorithm.ResetRealizationWindowIndices(anchorIndex);
+        algorithm.Generate(GenerateDirection::Forward, anchorIndex, availableSize, ItemSpacing, LineSpacing, std::numeric_limits<unsigned int>::max(), false /* disableVirtualization */);
+        algorithm.Generate(GenerateDirection::Backward, anchorIndex, availableSize, ItemSpacing, LineSpacing, std::numeric_limits<unsigned int>::max(), false /* disableVirtualization */);
+    }
+
+    // Every realized element must be where the closed form puts it, and the realized lines
+    // (with the spacing after them) must cover the realization window, up to the ends of the extent.
+    bool ValidateUniformRange(SyntheticGridPolicy& policy, const UniformGridLayoutCore<SyntheticGridPolicy>& uniform)
+    {
+        auto& realized = policy.Realized();
+        const auto window = policy.RealizationRect();
+        int first = -1;
+        int last = -1;
+        const bool hasRange = uniform.GetIndexRangeForWindow(window, policy.ItemCount(), first, last);
+        if (!hasRange)
+        {
+            return realized.Count() == 0;
+        }
+
+        if (realized.Count() != last - first + 1 || realized.FirstRealizedDataIndex() != first)
+        {
+            return false;
+        }
+
+        for (int i = 0; i < realized.Count(); i++)
+        {
+            const auto bounds = realized.BoundsAt(i);
+            const auto expected = uniform.GetLayoutRectForDataIndex(first + i);
+            if (bounds.X != expected.X || bounds.Y != expected.Y || bounds.Width != expected.Width || bounds.Height != expected.Height)
+            {
+                return false;
+            }
+        }
+
+        const auto firstBounds = realized.BoundsAt(0);
+        const auto lastBounds = realized.BoundsAt(realized.Count() - 1);
+        const bool coversStart = first == 0 || firstBounds.Y <= window.Y;
+        const bool coversEnd = last == policy.ItemCount() - 1 || lastBounds.Y + lastBounds.Height + LineSpacing >= window.Y + window.Height;
+        return coversStart && coversEnd;
+    }
+
+    Result RunSweep(Path path, float velocity, const Options& options)
+    {
+        SyntheticGridPolicy policy(options.itemCount);
+        FlowLayoutAlgorithmCore<SyntheticGridPolicy> algorithm(policy);
+        UniformGridLayoutCore<SyntheticGridPolicy> uniform(policy);
+        algorithm.SetScrollOrientation(ScrollOrientation::Vertical);
+        uniform.SetScrollOrientation(ScrollOrientation::Vertical);
+
+        const Size availableSize{ 1000.0f, std::numeric_limits<float>::infinity() };
+        const float viewportHeight = 1000.0f;
+        // Same default cache length as ItemsRepeater: one viewport on each side.
+        const float cacheLength = viewportHeight;
+        const float lineSize = static_cast<float>(ItemHeight + LineSpacing);
+        const int lineCount = (options.itemCount + ItemsPerLine(availableSize) - 1) / ItemsPerLine(availableSize);
+        const float maxOffset = std::max(0.0f, lineCount * lineSize - viewportHeight);
+
+        std::vector<double> durations;
+        durations.reserve(options.frames);
+        Result result;
+        int64_t totalMeasured = 0;
+        int64_t totalRealized = 0;
+        float offset = 0.0f;
+        float direction = 1.0f;
+
+        for (int frame = 0; frame < options.frames; frame++)
+        {
+            // Fling back and forth across the whole grid.
+            offset += direction * velocity;
+            if (offset >= maxOffset || offset <= 0.0f)
+            {
+                offset = std::max(0.0f, std::min(offset, maxOffset));
+                direction = -direction;
+            }
+
+            policy.SetRealizationRect(Rect{ 0.0f, offset - cacheLength, availableSize.Width, viewportHeight + 2 * cacheLength });
+            policy.ResetFrameCounters();
+
+            const auto start = std::chrono::steady_clock::now();
+            if (path == Path::Generic)
+            {
+                GenericMeasurePass(policy, algorithm, availableSize);
+            }
+            else
+            {
+                uniform.Measure(availableSize, ItemWidth, ItemHeight, ItemSpacing, LineSpacing, std::numeric_limits<unsigned int>::max(), 0.0f, 0.0f);
+            }
+            algorithm.Arrange(Size{ availableSize.Width, viewportHeight }, FlowLayoutAlgorithmLineAlignment::Start, true /* isWrapping */, false /* scrollOrientationSameAsFlow */, 0.0f, 0.0f);
+            const auto end = std::chrono::steady_clock::now();
+
+            durations.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+            totalMeasured += policy.ElementsMeasuredThisFrame();
+            totalRealized += policy.ElementsRealizedThisFrame();
+            if (path == Path::Uniform)
+            {
+                result.consistent = result.consistent && ValidateUniformRange(policy, uniform);
+            }
+        }
+
+        double total = 0.0;
+        for (auto duration : durations)
+        {
+            total += duration;
+        }
+
+        result.averageMicroseconds = total / durations.size();
+        result.averageMeasuredPerFrame = static_cast<double>(totalMeasured) / durations.size();
+        result.averageRealizedPerFrame = static_cast<double>(totalRealized) / durations.size();
+        std::sort(durations.begin(), durations.end());
+        result.p95Microseconds = durations[static_cast<size_t>(durations.size() * 0.95)];
+        result.maxMicroseconds = durations.back();
+        return result;
+    }
+
+    Options ParseOptions(int argc, char* argv[])
+    {
+        Options options;
+        for (int i = 1; i < argc; i++)
+        {
+            if (strcmp(argv[i], "--quick") == 0)
+            {
+                options.itemCount = 20000;
+                options.frames = 200;
+            }
+            else if (strcmp(argv[i], "--items") == 0 && i + 1 < argc)
+            {
+                options.itemCount = atoi(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            {
+                options.frames = atoi(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--max-avg-us") == 0 && i + 1 < argc)
+            {
+                options.maxAverageMicroseconds = atof(argv[++i]);
+            }
+        }
+        return options;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const auto options = ParseOptions(argc, argv);
+    bool passed = true;
+
+    printf("%-8s %9s %10s %10s %10s %14s %14s\n", "path", "velocity", "avg(us)", "p95(us)", "max(us)", "measured/frame", "realized/frame");
+    for (float velocity : { 60.0f, 600.0f, 3000.0f })
+    {
+        for (auto path : { Path::Generic, Path::Uniform })
+        {
+            const auto result = RunSweep(path, velocity, options);
+            printf("%-8s %9.0f %10.2f %10.2f %10.2f %14.2f %14.2f%s\n",
+                path == Path::Generic ? "generic" : "uniform",
+                velocity,
+                result.averageMicroseconds,
+                result.p95Microseconds,
+                result.maxMicroseconds,
+                result.averageMeasuredPerFrame,
+                result.averageRealizedPerFrame,
+                result.consistent ? "" : "  INCONSISTENT LAYOUT");
+
+            passed = passed && result.consistent;
+            if (path == Path::Uniform && options.maxAverageMicroseconds > 0.0 && result.averageMicroseconds > options.maxAverageMicroseconds)
+            {
+                passed = false;
+            }
+        }
+    }
+
+    return passed ? 0 : 1;
+}
@@ -6,19 +6,54 @@
 #include "QPCTimer.h"
 #include "BuildTreeScheduler.h"
 #include "RepeaterTestHooks.h"
+#include "RepeaterTrace.h"
 
-double BuildTreeScheduler::m_budgetInMs = 40.0;
+thread_local double BuildTreeScheduler::m_budgetInMs = BuildTreeScheduler::s_targetFrameTimeInMs;
+thread_local double BuildTreeScheduler::m_averageOverrunInMs = 0.0;
+thread_local uint64_t BuildTreeScheduler::m_nextSequence = 0;
+thread_local int BuildTreeScheduler::m_peakQueueDepth = 0;
+thread_local int BuildTreeScheduler::m_deferredWorkCount = 0;
+thread_local int BuildTreeScheduler::m_coalescedWorkCount = 0;
+thread_local int BuildTreeScheduler::m_framesOverBudgetCount = 0;
 thread_local QPCTimer BuildTreeScheduler::m_timer{};
 thread_local std::vector<WorkInfo> BuildTreeScheduler::m_pendingWork{};
 thread_local winrt::event_token BuildTreeScheduler::m_renderingToken{};
 
-void BuildTreeScheduler::RegisterWork(int priority, const std::function<void()>& workFunc)
+void BuildTreeScheduler::RegisterWork(const void* owner, int priority, bool isVisible, double distanceFromViewport, const std::function<void()>& workFunc)
 {
+    MUX_ASSERT(owner != nullptr);
     MUX_ASSERT(priority >= 0);
+    MUX_ASSERT(distanceFromViewport >= 0.0);
     MUX_ASSERT(workFunc != nullptr);
 
     QueueTick();
-    m_pendingWork.push_back(WorkInfo(priority, workFunc));
+
+    WorkInfo work(owner, priority, isVisible, distanceFromViewport, m_nextSequence++, workFunc);
+    auto it = std::find_if(m_pendingWork.begin(), m_pendingWork.end(), [owner](const WorkInfo& info) { return info.Owner() == owner; });
+    if (it != m_pendingWork.end())
+    {
+        // Coalesce with the work that is already queued for this owner. Its
+        // priority might have changed so the heap needs to be fixed up.
+        *it = std::move(work);
+        std::make_heap(m_pendingWork.begin(), m_pendingWork.end(), IsLessImportant);
+        m_coalescedWorkCount++;
+    }
+    else
+    {
+        m_pendingWork.push_back(std::move(work));
+        std::push_heap(m_pendingWork.begin(), m_pendingWork.end(), IsLessImportant);
+        m_peakQueueDepth = std::max(m_peakQueueDepth, QueueDepth());
+    }
+}
+
+void BuildTreeScheduler::UnregisterWork(const void* owner)
+{
+    auto it = std::find_if(m_pendingWork.begin(), m_pendingWork.end(), [owner](const WorkInfo& info) { return info.Owner() == owner; });
+    if (it != m_pendingWork.end())
+    {
+        m_pendingWork.erase(it);
+        std::make_heap(m_pendingWork.begin(), m_pendingWork.end(), IsLessImportant);
+    }
 }
 
 bool BuildTreeScheduler::ShouldYield()
@@ -26,20 +61,31 @@ bool BuildTreeScheduler::ShouldYield()
     return m_timer.DurationInMilliSeconds() > m_budgetInMs;
 }
 
+void BuildTreeScheduler::ResetCounters()
+{
+    m_peakQueueDepth = QueueDepth();
+    m_deferredWorkCount = 0;
+    m_coalescedWorkCount = 0;
+    m_framesOverBudgetCount = 0;
+}
+
 void BuildTreeScheduler::OnRendering(const winrt::IInspectable&, const winrt::IInspectable&)
 {
-      bool budgetReached = ShouldYield();
-    if (!budgetReached && m_pendingWork.size() > 0)
+    if (!ShouldYield() && !m_pendingWork.empty())
     {
-        // Sort in descending order of priority and work from the end of the list to avoid moving around during erase.
-        std::sort(m_pendingWork.begin(), m_pendingWork.end(), [](const auto& lhs, const auto& rhs) { return lhs.Priority() > rhs.Priority(); });
-        int currentIndex = static_cast<int>(m_pendingWork.size()) - 1;
-
         do
         {
-            m_pendingWork[currentIndex].InvokeWorkFunc();
-            m_pendingWork.erase(m_pendingWork.begin() + currentIndex);
-        } while (--currentIndex >= 0 && !ShouldYield());
+            // Take the work out of the heap before running it. It is free to register
+            // new work (usually for itself) or unregister work while it runs.
+            std::pop_heap(m_pendingWork.begin(), m_pendingWork.end(), IsLessImportant);
+            const auto work = std::move(m_pendingWork.back());
+            m_pendingWork.pop_back();
+            work.InvokeWorkFunc();
+        } while (!m_pendingWork.empty() && !ShouldYield());
+
+        // Sampled right after the work, so that the overrun is measured for the frame
+        // that ran it rather than for whatever the next frame does before we get called.
+        UpdateBudget(m_timer.DurationInMilliSeconds());
     }
 
     if (m_pendingWork.empty())
@@ -50,11 +96,31 @@ void BuildTreeScheduler::OnRendering(const winrt::IInspectable&, const winrt::II
         m_renderingToken.value = 0;
         RepeaterTestHooks::NotifyBuildTreeCompleted();
     }
+    else
+    {
+        m_deferredWorkCount += QueueDepth();
+    }
 
     // Reset the timer so it snaps the time just before rendering
     m_timer.Reset();
 }
 
+void BuildTreeScheduler::UpdateBudget(int frameTimeInMs)
+{
+    // Called for the frames in which we ran work. Work items cannot be interrupted, so
+    // frames routinely end up running past the budget; keep a running average of by how
+    // much and take it out of the budget so frames land near the target.
+    const double overrunInMs = std::max(0.0, frameTimeInMs - m_budgetInMs);
+    m_averageOverrunInMs += (overrunInMs - m_averageOverrunInMs) / 4.0;
+    m_budgetInMs = std::clamp(s_targetFrameTimeInMs - m_averageOverrunInMs, s_minBudgetInMs, s_targetFrameTimeInMs);
+
+    if (frameTimeInMs > s_targetFrameTimeInMs)
+    {
+        m_framesOverBudgetCount++;
+        REPEATER_TRACE_INFO(L"BuildTreeScheduler: frame took %dms, budget is now %.1fms with %d pending work items. \n", frameTimeInMs, m_budgetInMs, QueueDepth());
+    }
+}
+
 void  BuildTreeScheduler::QueueTick()
 {
     if (m_renderingToken.value == 0)
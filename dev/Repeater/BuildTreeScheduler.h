@@ -5,33 +5,96 @@
 
 struct WorkInfo
 {
-    WorkInfo(int priority, const std::function<void()>& workFunc) :
+    WorkInfo(const void* owner, int priority, bool isVisible, double distanceFromViewport, uint64_t sequence, const std::function<void()>& workFunc) :
+        m_owner(owner),
         m_priority(priority),
+        m_isVisible(isVisible),
+        m_distanceFromViewport(distanceFromViewport),
+        m_sequence(sequence),
         m_workFunc(workFunc)
     {}
 
+    const void* Owner() const { return m_owner; }
     int Priority() const { return m_priority; }
+    bool IsVisible() const { return m_isVisible; }
+    double DistanceFromViewport() const { return m_distanceFromViewport; }
     void InvokeWorkFunc() const { m_workFunc(); }
 
+    // Work for something on screen goes first, then work closest to the viewport. Ties are
+    // broken by the priority (lower runs first) and then in the order the work was registered.
+    bool IsMoreImportantThan(const WorkInfo& other) const
+    {
+        if (m_isVisible != other.m_isVisible)
+        {
+            return m_isVisible;
+        }
+
+        if (m_distanceFromViewport != other.m_distanceFromViewport)
+        {
+            return m_distanceFromViewport < other.m_distanceFromViewport;
+        }
+
+        if (m_priority != other.m_priority)
+        {
+            return m_priority < other.m_priority;
+        }
+
+        return m_sequence < other.m_sequence;
+    }
+
 private:
+    const void* m_owner;
     int m_priority;
+    bool m_isVisible;
+    double m_distanceFromViewport;
+    uint64_t m_sequence;
     std::function<void()> m_workFunc;
 };
 
-// High performance time management using QueryPerformanceCounter
+// Runs deferred build tree work (like x:Phase bindings) from CompositionTarget::Rendering,
+// most important work first, until the frame budget is used up. The budget adapts to how
+// far past it frames actually end up running, so that on slow hardware we yield earlier.
 class BuildTreeScheduler final
 {
 public:
-    static void RegisterWork(int priority, const std::function<void()>& workFunc);
+    // Registering work for an owner that already has pending work replaces the
+    // pending work instead of queuing it a second time.
+    static void RegisterWork(const void* owner, int priority, bool isVisible, double distanceFromViewport, const std::function<void()>& workFunc);
+    static void UnregisterWork(const void* owner);
     static bool ShouldYield();
 
+    static int QueueDepth() { return static_cast<int>(m_pendingWork.size()); }
+    static int PeakQueueDepth() { return m_peakQueueDepth; }
+    static int DeferredWorkCount() { return m_deferredWorkCount; }
+    static int CoalescedWorkCount() { return m_coalescedWorkCount; }
+    static int FramesOverBudgetCount() { return m_framesOverBudgetCount; }
+    static double BudgetInMs() { return m_budgetInMs; }
+    static void ResetCounters();
+
 private:
     static void OnRendering(const winrt::IInspectable& sender, const winrt::IInspectable& args);
     static void QueueTick();
+    static void UpdateBudget(int frameTimeInMs);
 
-    static double m_budgetInMs;
+    static bool IsLessImportant(const WorkInfo& lhs, const WorkInfo& rhs) { return rhs.IsMoreImportantThan(lhs); }
+
+    // The budget never grows past the target frame time, and never shrinks so much
+    // that a normal frame interval leaves no room for work.
+    static constexpr double s_targetFrameTimeInMs = 40.0;
+    static constexpr double s_minBudgetInMs = 20.0;
+
+    static thread_local double m_budgetInMs;
+    static thread_local double m_averageOverrunInMs;
+    static thread_local uint64_t m_nextSequence;
+
+    static thread_local int m_peakQueueDepth;
+    static thread_local int m_deferredWorkCount;
+    static thread_local int m_coalescedWorkCount;
+    static thread_local int m_framesOverBudgetCount;
 
     static thread_local QPCTimer m_timer;
+    // Binary heap ordered by WorkInfo::IsMoreImportantThan. There is one entry per
+    // owner (typically one per ItemsRepeater) so the linear lookups are cheap.
     static thread_local std::vector<WorkInfo> m_pendingWork;
     static thread_local winrt::event_token m_renderingToken;
-};
\ No newline at end of file
+};
@@ -0,0 +1,315 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+// Coalesces a sequence of collection changes (inserts and removes expressed in the
+// coordinates current at the time of each change) into a compact list of edits
+// expressed in the coordinates from before the first change.
+//
+// Each edit replaces the original items [Index, Index + Removed.size()) with the
+// Inserted items. Edits are sorted by Index and never overlap, and apart from replaces
+// they never touch either, so there is always at least one untouched original item
+// between two inserts or removes. This means a burst of inserts or removes at
+// neighbouring positions collapses into a single edit, and applying the edits from
+// last to first reproduces the final state of the collection without any edit
+// invalidating the index of the next one.
+//
+// Replaces of original items stay replaces (IsReplace) as long as no insert or remove
+// overlaps them: the replaced items keep their position, as they do when the replace
+// is not batched. Replacing items that an edit of the batch inserted updates that edit.
+//
+// MapIndex maps an index from before the batch to its index after the batch in
+// O(log(edits)), so realized elements can be moved to their final index in one pass.
+template <typename T>
+class CollectionChangeBatch final
+{
+public:
+    struct Edit
+    {
+        int Index{};
+        std::vector<T> Removed{};
+        std::vector<T> Inserted{};
+        bool IsReplace{ false };
+
+        int CountChange() const { return static_cast<int>(Inserted.size()) - static_cast<int>(Removed.size()); }
+    };
+
+    bool IsEmpty() const { return m_edits.empty() && !m_isReset; }
+    bool IsReset() const { return m_isReset; }
+    const std::vector<Edit>& Edits() const { return m_edits; }
+
+    int CountChange() const
+    {
+        int countChange = 0;
+        for (const auto& edit : m_edits)
+        {
+            countChange += edit.CountChange();
+        }
+        return countChange;
+    }
+
+    void Clear()
+    {
+        m_edits.clear();
+        m_isReset = false;
+        m_isMapDirty = true;
+    }
+
+    // A reset supersedes every change before it and every change after it
+    // until the batch is cleared.
+    void Reset()
+    {
+        m_edits.clear();
+        m_isReset = true;
+        m_isMapDirty = true;
+    }
+
+    void Insert(int index, std::vector<T> items)
+    {
+        if (m_isReset || items.empty())
+        {
+            return;
+        }
+
+        m_isMapDirty = true;
+        int delta = 0;
+        for (auto it = m_edits.begin(); it != m_edits.end(); ++it)
+        {
+            const int start = it->Index + delta;
+            const int stop = start + static_cast<int>(it->Inserted.size());
+            if (index < start || (it->IsReplace && index == start))
+            {
+                // Between two edits, in a run of original items.
+                m_edits.insert(it, Edit{ index - delta, {}, std::move(items) });
+                return;
+            }
+
+            if (index < stop || (!it->IsReplace && index == stop))
+            {
+                // Inside or at either end of the items this edit inserted. Inserting inside
+                // replaced items moves some of them, so they are no longer replaced in place.
+                it->Inserted.insert(it->Inserted.begin() + (index - start), std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+                it->IsReplace = false;
+                MergeTouchingEdits(it);
+                return;
+            }
+
+            delta += it->CountChange();
+        }
+
+        m_edits.push_back(Edit{ index - delta, {}, std::move(items) });
+    }
+
+    void Remove(int index, std::vector<T> items)
+    {
+        if (m_isReset || items.empty())
+        {
+            return;
+        }
+
+        m_isMapDirty = true;
+        const int end = index + static_cast<int>(items.size());
+
+        // Skip the edits that end strictly before the removed range.
+        int delta = 0;
+        auto first = m_edits.begin();
+        while (first != m_edits.end() && first->Index + delta + static_cast<int>(first->Inserted.size()) < index)
+        {
+            delta += first->CountChange();
+            ++first;
+        }
+
+        // Every edit touching [index, end] gets merged with the removed range into a single edit.
+        Edit merged{};
+        merged.Index = index - delta;
+        if (first != m_edits.end() && first->Index + delta <= index)
+        {
+            merged.Index = first->Index;
+            merged.Inserted.assign(
+                std::make_move_iterator(first->Inserted.begin()),
+                std::make_move_iterator(first->Inserted.begin() + (index - (first->Index + delta))));
+        }
+
+        int cursor = index;
+        auto last = first;
+        for (; last != m_edits.end() && last->Index + delta <= end; ++last)
+        {
+            const int start = last->Index + delta;
+            const int stop = start + static_cast<int>(last->Inserted.size());
+            if (cursor < start)
+            {
+                // Original items between the previous edit and this one.
+                AppendRange(merged.Removed, items, cursor - index, start - index);
+                cursor = start;
+            }
+
+            AppendRange(merged.Removed, last->Removed, 0, static_cast<int>(last->Removed.size()));
+            if (stop > end)
+            {
+                merged.Inserted.insert(
+                    merged.Inserted.end(),
+                    std::make_move_iterator(last->Inserted.begin() + (end - start)),
+                    std::make_move_iterator(last->Inserted.end()));
+            }
+
+            cursor = std::max(cursor, std::min(stop, end));
+            delta += last->CountChange();
+        }
+
+        if (cursor < end)
+        {
+            AppendRange(merged.Removed, items, cursor - index, end - index);
+        }
+
+        const auto position = m_edits.erase(first, last);
+        if (!merged.Removed.empty() || !merged.Inserted.empty())
+        {
+            // The merged range can start or end inside a replace, next to an edit that
+            // was only allowed to touch that replace.
+            MergeTouchingEdits(m_edits.insert(position, std::move(merged)));
+        }
+    }
+
+    void Replace(int index, std::vector<T> removed, std::vector<T> inserted)
+    {
+        if (m_isReset || removed.empty() || inserted.empty())
+        {
+            return;
+        }
+
+        m_isMapDirty = true;
+        const int end = index + static_cast<int>(removed.size());
+        int delta = 0;
+        auto it = m_edits.begin();
+        for (; it != m_edits.end(); ++it)
+        {
+            const int start = it->Index + delta;
+            const int stop = start + static_cast<int>(it->Inserted.size());
+            if (end <= start)
+            {
+                // Only original items, before this edit.
+                break;
+            }
+
+            if (index >= start && end <= stop)
+            {
+                // Only items this edit inserted.
+                it->Inserted.erase(it->Inserted.begin() + (index - start), it->Inserted.begin() + (end - start));
+                it->Inserted.insert(it->Inserted.begin() + (index - start), std::make_move_iterator(inserted.begin()), std::make_move_iterator(inserted.end()));
+                return;
+            }
+
+            if (index < stop)
+            {
+                // Both original items and items of this edit. This is an insert and a remove.
+                Remove(index, std::move(removed));
+                Insert(index, std::move(inserted));
+                return;
+            }
+
+            delta += it->CountChange();
+        }
+
+        m_edits.insert(it, Edit{ index - delta, std::move(removed), std::move(inserted), true /* IsReplace */ });
+    }
+
+    // Returns the index after the batch of the item that was at oldIndex before it,
+    // or -1 if that item was removed. Replaced items keep their position.
+    int MapIndex(int oldIndex) const
+    {
+        if (m_isReset)
+        {
+            return -1;
+        }
+
+        EnsureMap();
+        const auto it = std::upper_bound(m_edits.begin(), m_edits.end(), oldIndex,
+            [](int index, const Edit& edit) { return index < edit.Index; });
+        if (it == m_edits.begin())
+        {
+            return oldIndex;
+        }
+
+        const auto editIndex = static_cast<size_t>(std::distance(m_edits.begin(), it)) - 1;
+        const auto& edit = m_edits[editIndex];
+        if (oldIndex < edit.Index + static_cast<int>(edit.Removed.size()))
+        {
+            return edit.IsReplace ? oldIndex + m_countChangeThrough[editIndex] - edit.CountChange() : -1;
+        }
+
+        return oldIndex + m_countChangeThrough[editIndex];
+    }
+
+private:
+    using EditIterator = typename std::vector<Edit>::iterator;
+
+    static void AppendRange(std::vector<T>& target, std::vector<T>& source, int begin, int end)
+    {
+        target.insert(
+            target.end(),
+            std::make_move_iterator(source.begin() + begin),
+            std::make_move_iterator(source.begin() + end));
+    }
+
+    static void AppendEdit(Edit& target, Edit& source)
+    {
+        AppendRange(target.Removed, source.Removed, 0, static_cast<int>(source.Removed.size()));
+        AppendRange(target.Inserted, source.Inserted, 0, static_cast<int>(source.Inserted.size()));
+        target.IsReplace = false;
+    }
+
+    // Merges the edit that it points to with the edits that touch it, unless it is a replace.
+    void MergeTouchingEdits(EditIterator it)
+    {
+        if (it->IsReplace)
+        {
+            return;
+        }
+
+        while (it != m_edits.begin())
+        {
+            auto previous = std::prev(it);
+            if (previous->Index + static_cast<int>(previous->Removed.size()) != it->Index)
+            {
+                break;
+            }
+
+            AppendEdit(*previous, *it);
+            it = std::prev(m_edits.erase(it));
+        }
+
+        for (auto next = std::next(it); next != m_edits.end() && it->Index + static_cast<int>(it->Removed.size()) == next->Index; next = std::next(it))
+        {
+            AppendEdit(*it, *next);
+            m_edits.erase(next);
+        }
+    }
+
+    void EnsureMap() const
+    {
+        if (m_isMapDirty)
+        {
+            m_countChangeThrough.resize(m_edits.size());
+            int countChange = 0;
+            for (size_t i = 0; i < m_edits.size(); ++i)
+            {
+                countChange += m_edits[i].CountChange();
+                m_countChangeThrough[i] = countChange;
+            }
+            m_isMapDirty = false;
+        }
+    }
+
+    std::vector<Edit> m_edits{};
+    bool m_isReset{ false };
+
+    // Running sum of CountChange up to and including each edit, rebuilt lazily for MapIndex.
+    mutable std::vector<int> m_countChangeThrough{};
+    mutable bool m_isMapDirty{ true };
+};
@@ -30,12 +30,12 @@ void ElementManager::OnBeginMeasure(const ScrollOrientation& orientation)
             // If we are initialized with a non-virtualizing context, make sure that
             // we have enough space to hold the bounds for all the elements.
             int count = m_context.ItemCount();
-            if (static_cast<int>(m_realizedElementLayoutBounds.size()) != count)
+            if (m_realized.BoundsCount() != count)
             {
                 // Make sure there is enough space for the bounds.
                 // Note: We could optimize when the count becomes smaller, but keeping
                 // it always up to date is the simplest option for now.
-                m_realizedElementLayoutBounds.resize(count, winrt::Rect());
+                m_realized.ResizeBounds(count);
             }
         }
     }
@@ -44,7 +44,7 @@ void ElementManager::OnBeginMeasure(const ScrollOrientation& orientation)
 int ElementManager::GetRealizedElementCount() const
 {
     return IsVirtualizingContext() ?
-        static_cast<int>(m_realizedElements.size()) : m_context.ItemCount();
+        m_realized.Count() : m_context.ItemCount();
 }
 
 winrt::UIElement ElementManager::GetAt(int realizedIndex)
@@ -52,17 +52,17 @@ winrt::UIElement ElementManager::GetAt(int realizedIndex)
     winrt::UIElement element{ nullptr };
     if (IsVirtualizingContext())
     {
-        if (!m_realizedElements[realizedIndex])
+        element = m_realized.ElementAt(realizedIndex).get();
+        if (!element)
         {
             // Sentinel. Create the element now since we need it.
             int dataIndex = GetDataIndexFromRealizedRangeIndex(realizedIndex);
             REPEATER_TRACE_INFO(L"Creating element for sentinal with data index %d. \n", dataIndex);
             element = m_context.GetOrCreateElementAt(dataIndex, winrt::ElementRealizationOptions::ForceCreate | winrt::ElementRealizationOptions::SuppressAutoRecycle);
-            m_realizedElements[realizedIndex] = tracker_ref<winrt::UIElement>{ m_owner, element };
-        }
-        else
-        {
-            element = m_realizedElements[realizedIndex].get();
+            // Look the slot up again rather than holding on to it: creating the element runs app
+            // code, and a reference into the realized range does not survive it being changed.
+            MUX_ASSERT(realizedIndex < m_realized.Count());
+            m_realized.ElementAt(realizedIndex) = tracker_ref<winrt::UIElement>{ m_owner, element };
         }
     }
     else
@@ -77,27 +77,13 @@ winrt::UIElement ElementManager::GetAt(int realizedIndex)
 void ElementManager::Add(const winrt::UIElement& element, int dataIndex)
 {
     MUX_ASSERT(IsVirtualizingContext());
-
-    if (m_realizedElements.size() == 0)
-    {
-        m_firstRealizedDataIndex = dataIndex;
-    }
-
-    m_realizedElements.emplace_back(tracker_ref<winrt::UIElement>{ m_owner, element });
-    m_realizedElementLayoutBounds.emplace_back(winrt::Rect());
+    m_realized.Add(tracker_ref<winrt::UIElement>{ m_owner, element }, dataIndex);
 }
 
 void ElementManager::Insert(int realizedIndex, int dataIndex, const winrt::UIElement& element)
 {
     MUX_ASSERT(IsVirtualizingContext());
-    if (realizedIndex == 0)
-    {
-        m_firstRealizedDataIndex = dataIndex;
-    }
-
-    m_realizedElements.insert(m_realizedElements.begin() + realizedIndex, tracker_ref<winrt::UIElement>{ m_owner, element });
-    // Set bounds to an invalid rect since we do not know it yet.
-    m_realizedElementLayoutBounds.insert(m_realizedElementLayoutBounds.begin() + realizedIndex, winrt::Rect{ -1.f, -1.f, -1.f, -1.f });
+    m_realized.Insert(realizedIndex, dataIndex, tracker_ref<winrt::UIElement>{ m_owner, element });
 }
 
 void ElementManager::ClearRealizedRange(int realizedIndex, int count)
@@ -108,23 +94,13 @@ void ElementManager::ClearRealizedRange(int realizedIndex, int count)
         // Clear from the edges so that ItemsRepeater can optimize on maintaining 
         // realized indices without walking through all the children every time.
         int index = realizedIndex == 0 ? realizedIndex + i : (realizedIndex + count - 1) - i;
-        if (auto elementRef = m_realizedElements[index])
+        if (auto elementRef = m_realized.ElementAt(index))
         {
             m_context.RecycleElement(elementRef.get());
         }
     }
 
-    int endIndex = realizedIndex + count;
-    m_realizedElements.erase(m_realizedElements.begin() + realizedIndex, m_realizedElements.begin() + endIndex);
-    m_realizedElementLayoutBounds.erase(m_realizedElementLayoutBounds.begin() + realizedIndex, m_realizedElementLayoutBounds.begin() + endIndex);
-
-    if (realizedIndex == 0)
-    {
-        m_firstRealizedDataIndex =
-            m_realizedElements.size() == 0 ?
-            -1 :
-            m_firstRealizedDataIndex + count;
-    }
+    m_realized.Erase(realizedIndex, count);
 }
 
 void ElementManager::DiscardElementsOutsideWindow(bool forward, int startIndex)
@@ -156,24 +132,24 @@ void ElementManager::ClearRealizedRange()
 winrt::Rect ElementManager::GetLayoutBoundsForDataIndex(int dataIndex) const
 {
     int realizedIndex = GetRealizedRangeIndexFromDataIndex(dataIndex);
-    return m_realizedElementLayoutBounds[realizedIndex];
+    return m_realized.BoundsAt(realizedIndex);
 }
 
 void ElementManager::SetLayoutBoundsForDataIndex(int dataIndex, const winrt::Rect& bounds)
 {
     int realizedIndex = GetRealizedRangeIndexFromDataIndex(dataIndex);
-    m_realizedElementLayoutBounds[realizedIndex] = bounds;
+    m_realized.SetBoundsAt(realizedIndex, bounds);
 }
 
 
 winrt::Rect ElementManager::GetLayoutBoundsForRealizedIndex(int realizedIndex) const
 {
-    return m_realizedElementLayoutBounds[realizedIndex];
+    return m_realized.BoundsAt(realizedIndex);
 }
 
 void ElementManager::SetLayoutBoundsForRealizedIndex(int realizedIndex, const winrt::Rect& bounds)
 {
-    m_realizedElementLayoutBounds[realizedIndex] = bounds;
+    m_realized.SetBoundsAt(realizedIndex, bounds);
 }
 
 
@@ -181,11 +157,7 @@ bool ElementManager::IsDataIndexRealized(int index) const
 {
     if (IsVirtualizingContext())
     {
-        int realizedCount = GetRealizedElementCount();
-        return
-            realizedCount > 0 &&
-            GetDataIndexFromRealizedRangeIndex(0) <= index &&
-            GetDataIndexFromRealizedRangeIndex(realizedCount - 1) >= index;
+        return m_realized.IsDataIndexRealized(index);
     }
     else
     {
@@ -231,34 +203,13 @@ void ElementManager::EnsureElementRealized(bool forward, int dataIndex, const ws
 bool ElementManager::IsWindowConnected(const winrt::Rect& window, const ScrollOrientation& orientation, bool scrollOrientationSameAsFlow) const
 {
     MUX_ASSERT(IsVirtualizingContext());
-    bool intersects = false;
-    if (m_realizedElementLayoutBounds.size() > 0)
-    {
-        auto firstElementBounds = GetLayoutBoundsForRealizedIndex(0);
-        auto lastElementBounds = GetLayoutBoundsForRealizedIndex(GetRealizedElementCount() - 1);
-
-        auto effectiveOrientation = scrollOrientationSameAsFlow ?
-            (orientation == ScrollOrientation::Vertical ? ScrollOrientation::Horizontal : ScrollOrientation::Vertical) :
-            orientation;
-
-
-        auto windowStart = effectiveOrientation == ScrollOrientation::Vertical ? window.Y : window.X;
-        auto windowEnd = effectiveOrientation == ScrollOrientation::Vertical ? window.Y + window.Height : window.X + window.Width;
-        auto firstElementStart = effectiveOrientation == ScrollOrientation::Vertical ? firstElementBounds.Y : firstElementBounds.X;
-        auto lastElementEnd = effectiveOrientation == ScrollOrientation::Vertical ? lastElementBounds.Y + lastElementBounds.Height : lastElementBounds.X + lastElementBounds.Width;
-
-        intersects =
-            firstElementStart <= windowEnd &&
-            lastElementEnd >= windowStart;
-    }
-
-    return intersects;
+    return m_realized.IsWindowConnected(window, orientation, scrollOrientationSameAsFlow);
 }
 
 void ElementManager::DataSourceChanged(const winrt::IInspectable& /*source*/, winrt::NotifyCollectionChangedEventArgs const& args)
 {
     MUX_ASSERT(IsVirtualizingContext());
-    if (m_realizedElements.size() > 0)
+    if (m_realized.Count() > 0)
     {
         switch (args.Action())
         {
@@ -288,10 +239,10 @@ void ElementManager::DataSourceChanged(const winrt::IInspectable& /*source*/, wi
                 auto startRealizedIndex = GetRealizedRangeIndexFromDataIndex(oldStartIndex);
                 for (int realizedIndex = startRealizedIndex; realizedIndex < startRealizedIndex + oldSize; realizedIndex++)
                 {
-                    if (auto elementRef = m_realizedElements[realizedIndex])
+                    if (auto element = m_realized.ElementAt(realizedIndex).get())
                     {
-                        m_context.RecycleElement(elementRef.get());
-                        m_realizedElements[realizedIndex] = tracker_ref<winrt::UIElement>{ m_owner, nullptr };
+                        m_context.RecycleElement(element);
+                        m_realized.ElementAt(realizedIndex) = tracker_ref<winrt::UIElement>{ m_owner, nullptr };
                     }
                 }
             }
@@ -323,31 +274,35 @@ void ElementManager::DataSourceChanged(const winrt::IInspectable& /*source*/, wi
 int ElementManager::GetElementDataIndex(const winrt::UIElement& suggestedAnchor) const
 {
     MUX_ASSERT(suggestedAnchor);
-    auto it = std::find(m_realizedElements.cbegin(), m_realizedElements.cend(), suggestedAnchor);
-    return
-        it != m_realizedElements.cend() ?
-        GetDataIndexFromRealizedRangeIndex(static_cast<int>(std::distance(m_realizedElements.cbegin(), it))) :
-        -1;
+    for (int realizedIndex = 0; realizedIndex < m_realized.Count(); ++realizedIndex)
+    {
+        if (m_realized.ElementAt(realizedIndex) == suggestedAnchor)
+        {
+            return GetDataIndexFromRealizedRangeIndex(realizedIndex);
+        }
+    }
+
+    return -1;
 }
 
 int ElementManager::GetDataIndexFromRealizedRangeIndex(int rangeIndex) const
 {
     MUX_ASSERT(rangeIndex >= 0 && rangeIndex < GetRealizedElementCount());
     return IsVirtualizingContext() ?
-        rangeIndex + m_firstRealizedDataIndex : rangeIndex;
+        m_realized.GetDataIndexFromRealizedRangeIndex(rangeIndex) : rangeIndex;
 }
 
 int ElementManager::GetRealizedRangeIndexFromDataIndex(int dataIndex) const
 {
     MUX_ASSERT(IsDataIndexRealized(dataIndex));
     return IsVirtualizingContext() ?
-        dataIndex - m_firstRealizedDataIndex : dataIndex;
+        m_realized.GetRealizedRangeIndexFromDataIndex(dataIndex) : dataIndex;
 }
 
 void ElementManager::DiscardElementsOutsideWindow(const winrt::Rect& window, const ScrollOrientation& orientation)
 {
     MUX_ASSERT(IsVirtualizingContext());
-    MUX_ASSERT(m_realizedElements.size() == m_realizedElementLayoutBounds.size());
+    MUX_ASSERT(m_realized.Count() == m_realized.BoundsCount());
 
     // The following illustration explains the cutoff indices.
     // We will clear all the realized elements from both ends
@@ -374,22 +329,7 @@ void ElementManager::DiscardElementsOutsideWindow(const winrt::Rect& window, con
     const int realizedRangeSize = GetRealizedElementCount();
     int frontCutoffIndex = -1;
     int backCutoffIndex = realizedRangeSize;
-
-    for (int i = 0;
-        i < realizedRangeSize &&
-        !Intersects(window, m_realizedElementLayoutBounds[i], orientation);
-        ++i)
-    {
-        ++frontCutoffIndex;
-    }
-
-    for (int i = realizedRangeSize - 1;
-        i >= 0 &&
-        !Intersects(window, m_realizedElementLayoutBounds[i], orientation);
-        --i)
-    {
-        --backCutoffIndex;
-    }
+    m_realized.GetDiscardCutoffIndices(window, orientation, frontCutoffIndex, backCutoffIndex);
 
     if (backCutoffIndex < realizedRangeSize - 1)
     {
@@ -402,29 +342,19 @@ void ElementManager::DiscardElementsOutsideWindow(const winrt::Rect& window, con
     }
 }
 
-/* static */
-bool ElementManager::Intersects(const winrt::Rect& lhs, const winrt::Rect& rhs, const ScrollOrientation& orientation)
-{
-    auto lhsStart = orientation == ScrollOrientation::Vertical ? lhs.Y : lhs.X;
-    auto lhsEnd = orientation == ScrollOrientation::Vertical ? lhs.Y + lhs.Height : lhs.X + lhs.Width;
-    auto rhsStart = orientation == ScrollOrientation::Vertical ? rhs.Y : rhs.X;
-    auto rhsEnd = orientation == ScrollOrientation::Vertical ? rhs.Y + rhs.Height : rhs.X + rhs.Width;
-
-    return lhsEnd >= rhsStart && lhsStart <= rhsEnd;
-}
-
 void ElementManager::OnItemsAdded(int index, int count)
 {
     // Using the old indices here (before it was updated by the collection change)
     // if the insert data index is between the first and last realized data index, we need
     // to insert items.
-    const int lastRealizedDataIndex = m_firstRealizedDataIndex + GetRealizedElementCount() - 1;
+    const int firstRealizedDataIndex = m_realized.FirstRealizedDataIndex();
+    const int lastRealizedDataIndex = firstRealizedDataIndex + GetRealizedElementCount() - 1;
     const int newStartingIndex = index;
-    if (newStartingIndex > m_firstRealizedDataIndex &&
+    if (newStartingIndex > firstRealizedDataIndex &&
         newStartingIndex <= lastRealizedDataIndex)
     {
         // Inserted within the realized range
-        const int insertRangeStartIndex = newStartingIndex - m_firstRealizedDataIndex;
+        const int insertRangeStartIndex = newStartingIndex - firstRealizedDataIndex;
         for (int i = 0; i < count; i++)
         {
             // Insert null (sentinel) here instead of an element, that way we dont 
@@ -435,20 +365,20 @@ void ElementManager::OnItemsAdded(int index, int count)
             Insert(insertRangeIndex, dataIndex, nullptr);
         }
     }
-    else if (index <= m_firstRealizedDataIndex)
+    else if (index <= firstRealizedDataIndex)
     {
         // Items were inserted before the realized range.
-        // We need to update m_firstRealizedDataIndex;
-        m_firstRealizedDataIndex += count;
+        // We need to update the first realized data index.
+        m_realized.ShiftFirstRealizedDataIndex(count);
     }
 }
 
 void ElementManager::OnItemsRemoved(int index, int count)
 {
-    const int lastRealizedDataIndex = m_firstRealizedDataIndex + static_cast<int>(m_realizedElements.size()) - 1;
-    const int startIndex = std::max(m_firstRealizedDataIndex, index);
-    const int endIndex = std::min(lastRealizedDataIndex, index + count - 1);
-    const bool removeAffectsFirstRealizedDataIndex = (index <= m_firstRealizedDataIndex);
+    int startIndex = -1;
+    int endIndex = -1;
+    m_realized.GetRealizedRangeAffectedByRemove(index, count, startIndex, endIndex);
+    const bool removeAffectsFirstRealizedDataIndex = (index <= m_realized.FirstRealizedDataIndex());
 
     if (endIndex >= startIndex)
     {
@@ -456,9 +386,9 @@ void ElementManager::OnItemsRemoved(int index, int count)
     }
 
     if (removeAffectsFirstRealizedDataIndex &&
-        m_firstRealizedDataIndex != -1)
+        m_realized.FirstRealizedDataIndex() != -1)
     {
-        m_firstRealizedDataIndex -= count;
+        m_realized.ShiftFirstRealizedDataIndex(-count);
     }
 }
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "OrientationBasedMeasures.h"
+#include "ElementManagerCore.h"
 
 // Internal component for layout to keep track of elements and
 // help with collection changes.
@@ -52,7 +53,6 @@ private:
     int GetRealizedRangeIndexFromDataIndex(int dataIndex) const;
 
     void DiscardElementsOutsideWindow(const winrt::Rect& window, const ScrollOrientation& orientation);
-    static bool Intersects(const winrt::Rect& lhs, const winrt::Rect& rhs, const ScrollOrientation& orientation);
 
     void OnItemsAdded(int index, int count);
     void OnItemsRemoved(int index, int count);
@@ -61,8 +61,6 @@ private:
 
     const ITrackerHandleManager* m_owner;
 
-    std::vector<tracker_ref<winrt::UIElement>> m_realizedElements;
-    std::vector<winrt::Rect> m_realizedElementLayoutBounds;
-    int m_firstRealizedDataIndex{ -1 };
+    ElementManagerCore<tracker_ref<winrt::UIElement>, winrt::Rect> m_realized;
     winrt::VirtualizingLayoutContext m_context{ nullptr };
 };
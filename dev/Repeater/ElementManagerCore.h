@@ -0,0 +1,190 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include "RealizedBoundsBuffer.h"
+#include "ScrollOrientation.h"
+
+// Platform neutral bookkeeping for the contiguous range of realized elements that
+// ElementManager maintains on behalf of FlowLayoutAlgorithm. TElement is whatever
+// handle the host uses for an element (tracker_ref<winrt::UIElement> in the control,
+// a plain int in the headless benchmarks) and TRect is any type with float X, Y,
+// Width and Height members. This type never creates, measures or recycles elements;
+// that is left to the caller so that it can be exercised without a XAML context.
+//
+// Scrolling adds and removes elements at both ends of the range, so the elements
+// are kept in a deque. The bounds live in a RealizedBoundsBuffer, which makes
+// those operations cheap too and keeps the discard scans on contiguous floats.
+template <typename TElement, typename TRect>
+class ElementManagerCore final
+{
+public:
+    int Count() const { return static_cast<int>(m_realizedElements.size()); }
+    int FirstRealizedDataIndex() const { return m_firstRealizedDataIndex; }
+
+    TElement& ElementAt(int realizedIndex) { return m_realizedElements[realizedIndex]; }
+    const TElement& ElementAt(int realizedIndex) const { return m_realizedElements[realizedIndex]; }
+
+    TRect BoundsAt(int realizedIndex) const { return m_realizedElementLayoutBounds.At(realizedIndex); }
+    void SetBoundsAt(int realizedIndex, const TRect& bounds) { m_realizedElementLayoutBounds.SetAt(realizedIndex, bounds); }
+
+    int BoundsCount() const { return m_realizedElementLayoutBounds.Count(); }
+    void ResizeBounds(int count) { m_realizedElementLayoutBounds.Resize(count); }
+
+    void Add(TElement&& element, int dataIndex)
+    {
+        if (m_realizedElements.size() == 0)
+        {
+            m_firstRealizedDataIndex = dataIndex;
+        }
+
+        m_realizedElements.emplace_back(std::move(element));
+        m_realizedElementLayoutBounds.PushBack(TRect{});
+    }
+
+    void Insert(int realizedIndex, int dataIndex, TElement&& element)
+    {
+        if (realizedIndex == 0)
+        {
+            m_firstRealizedDataIndex = dataIndex;
+        }
+
+        // Set bounds to an invalid rect since we do not know it yet.
+        const TRect bounds{ -1.f, -1.f, -1.f, -1.f };
+        if (realizedIndex == 0)
+        {
+            m_realizedElements.emplace_front(std::move(element));
+            m_realizedElementLayoutBounds.PushFront(bounds);
+        }
+        else
+        {
+            m_realizedElements.insert(m_realizedElements.begin() + realizedIndex, std::move(element));
+            m_realizedElementLayoutBounds.Insert(realizedIndex, bounds);
+        }
+    }
+
+    // Removes the elements from the range. The caller is expected to have
+    // recycled them already.
+    void Erase(int realizedIndex, int count)
+    {
+        const int endIndex = realizedIndex + count;
+        m_realizedElements.erase(m_realizedElements.begin() + realizedIndex, m_realizedElements.begin() + endIndex);
+        m_realizedElementLayoutBounds.Erase(realizedIndex, count);
+
+        if (realizedIndex == 0)
+        {
+            m_firstRealizedDataIndex =
+                m_realizedElements.size() == 0 ?
+                -1 :
+                m_firstRealizedDataIndex + count;
+        }
+    }
+
+    void ShiftFirstRealizedDataIndex(int delta) { m_firstRealizedDataIndex += delta; }
+
+    bool IsDataIndexRealized(int index) const
+    {
+        const int realizedCount = Count();
+        return
+            realizedCount > 0 &&
+            m_firstRealizedDataIndex <= index &&
+            m_firstRealizedDataIndex + realizedCount - 1 >= index;
+    }
+
+    int GetDataIndexFromRealizedRangeIndex(int rangeIndex) const { return rangeIndex + m_firstRealizedDataIndex; }
+    int GetRealizedRangeIndexFromDataIndex(int dataIndex) const { return dataIndex - m_firstRealizedDataIndex; }
+
+    // Does the given window intersect the range of realized elements
+    bool IsWindowConnected(const TRect& window, const ScrollOrientation& orientation, bool scrollOrientationSameAsFlow) const
+    {
+        bool intersects = false;
+        if (m_realizedElementLayoutBounds.Count() > 0)
+        {
+            const auto effectiveOrientation = scrollOrientationSameAsFlow ?
+                (orientation == ScrollOrientation::Vertical ? ScrollOrientation::Horizontal : ScrollOrientation::Vertical) :
+                orientation;
+
+            const float* starts = m_realizedElementLayoutBounds.Starts(effectiveOrientation);
+            const float* sizes = m_realizedElementLayoutBounds.Sizes(effectiveOrientation);
+            const int last = Count() - 1;
+
+            const auto windowStart = effectiveOrientation == ScrollOrientation::Vertical ? window.Y : window.X;
+            const auto windowEnd = effectiveOrientation == ScrollOrientation::Vertical ? window.Y + window.Height : window.X + window.Width;
+            const auto firstElementStart = starts[0];
+            const auto lastElementEnd = starts[last] + sizes[last];
+
+            intersects =
+                firstElementStart <= windowEnd &&
+                lastElementEnd >= windowStart;
+        }
+
+        return intersects;
+    }
+
+    // Computes how many elements at each end of the realized range fall outside of
+    // the window. See ElementManager::DiscardElementsOutsideWindow for the details
+    // on how the cutoff indices are used.
+    void GetDiscardCutoffIndices(const TRect& window, const ScrollOrientation& orientation, int& frontCutoffIndex, int& backCutoffIndex) const
+    {
+        const int realizedRangeSize = Count();
+        const float* starts = m_realizedElementLayoutBounds.Starts(orientation);
+        const float* sizes = m_realizedElementLayoutBounds.Sizes(orientation);
+        const float windowStart = orientation == ScrollOrientation::Vertical ? window.Y : window.X;
+        const float windowEnd = orientation == ScrollOrientation::Vertical ? window.Y + window.Height : window.X + window.Width;
+
+        frontCutoffIndex = -1 + CountOutsideWindow(starts, sizes, realizedRangeSize, windowStart, windowEnd, true /* forward */);
+        backCutoffIndex = realizedRangeSize - CountOutsideWindow(starts, sizes, realizedRangeSize, windowStart, windowEnd, false /* forward */);
+    }
+
+    // Returns the [startIndex, endIndex] range of data indices that are both realized and
+    // part of the removed range. endIndex < startIndex if nothing realized was removed.
+    void GetRealizedRangeAffectedByRemove(int index, int count, int& startIndex, int& endIndex) const
+    {
+        const int lastRealizedDataIndex = m_firstRealizedDataIndex + Count() - 1;
+        startIndex = std::max(m_firstRealizedDataIndex, index);
+        endIndex = std::min(lastRealizedDataIndex, index + count - 1);
+    }
+
+private:
+    // Number of elements from the front (or the back) of the range up to the first one that
+    // intersects [windowStart, windowEnd]. Goes through a block of elements at a time with a
+    // branch free loop that the compiler can vectorize, and only looks for the exact element
+    // once a block has one that intersects.
+    static int CountOutsideWindow(const float* starts, const float* sizes, int count, float windowStart, float windowEnd, bool forward)
+    {
+        constexpr int blockSize = 16;
+        const auto intersects = [&](int i)
+        {
+            return (windowEnd >= starts[i]) & (windowStart <= starts[i] + sizes[i]);
+        };
+
+        int outside = 0;
+        for (; outside + blockSize <= count; outside += blockSize)
+        {
+            bool anyIntersects = false;
+            for (int j = outside; j < outside + blockSize; ++j)
+            {
+                anyIntersects |= intersects(forward ? j : count - 1 - j);
+            }
+
+            if (anyIntersects)
+            {
+                break;
+            }
+        }
+
+        while (outside < count && !intersects(forward ? outside : count - 1 - outside))
+        {
+            ++outside;
+        }
+
+        return outside;
+    }
+
+    std::deque<TElement> m_realizedElements;
+    RealizedBoundsBuffer<TRect> m_realizedElementLayoutBounds;
+    int m_firstRealizedDataIndex{ -1 };
+};
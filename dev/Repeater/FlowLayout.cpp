@@ -51,6 +51,8 @@ winrt::Size FlowLayout::MeasureOverride(
     winrt::VirtualizingLayoutContext const& context,
     winrt::Size const& availableSize)
 {
+    GetAsFlowState(context.LayoutState())->OnMeasureStart(m_isMeasuredSizeIndexEnabled, context.ItemCount());
+
     auto desiredSize = GetFlowAlgorithm(context).Measure(
         availableSize,
         context,
@@ -83,6 +85,7 @@ void FlowLayout::OnItemsChangedCore(
     winrt::IInspectable const& source,
     winrt::NotifyCollectionChangedEventArgs const& args)
 {
+    GetAsFlowState(context.LayoutState())->OnItemsSourceChanged(args);
     GetFlowAlgorithm(context).OnItemsSourceChanged(source, args, context);
     // Always invalidate layout to keep the view accurate.
     InvalidateLayout();
@@ -140,12 +143,22 @@ winrt::FlowLayoutAnchorInfo FlowLayout::GetAnchorForRealizationRect(
             DoesRealizationWindowOverlapExtent(realizationRect, MinorMajorRect(lastExtent.*MinorStart(), lastExtent.*MajorStart(), availableSize.*Minor(), static_cast<float>(extentMajorSize))))
         {
             const double realizationWindowStartWithinExtent = realizationRect.*MajorStart() - lastExtent.*MajorStart();
-            const int lineIndex = std::max(0, (int)(realizationWindowStartWithinExtent / averageLineSize));
-            anchorIndex = (int)(lineIndex * averageItemsPerLine);
-
-            // Clamp it to be within valid range
-            anchorIndex = std::max(0, std::min(itemsCount - 1, anchorIndex));
-            offset = lineIndex * averageLineSize + lastExtent.*MajorStart();
+            if (auto measuredSizes = flowState->MeasuredSizes())
+            {
+                const double itemEstimate = (averageLineSize - LineSpacing()) / averageItemsPerLine;
+                const double itemSpacing = LineSpacing() / averageItemsPerLine;
+                anchorIndex = measuredSizes->IndexAtOffset(std::max(0.0, realizationWindowStartWithinExtent), itemEstimate, itemSpacing);
+                offset = measuredSizes->OffsetOf(anchorIndex, itemEstimate, itemSpacing) + lastExtent.*MajorStart();
+            }
+            else
+            {
+                const int lineIndex = std::max(0, (int)(realizationWindowStartWithinExtent / averageLineSize));
+                anchorIndex = (int)(lineIndex * averageItemsPerLine);
+
+                // Clamp it to be within valid range
+                anchorIndex = std::max(0, std::min(itemsCount - 1, anchorIndex));
+                offset = lineIndex * averageLineSize + lastExtent.*MajorStart();
+            }
         }
     }
 
@@ -168,8 +181,17 @@ winrt::FlowLayoutAnchorInfo FlowLayout::GetAnchorForTargetElement(
         auto flowState = GetAsFlowState(state);
         double averageItemsPerLine = 0;
         const double averageLineSize = GetAverageLineInfo(availableSize, context, flowState, averageItemsPerLine) + LineSpacing();
-        const int lineIndex = (int)(targetIndex / averageItemsPerLine);
-        offset = lineIndex * averageLineSize + flowState->FlowAlgorithm().LastExtent().*MajorStart();
+        if (auto measuredSizes = flowState->MeasuredSizes())
+        {
+            const double itemEstimate = (averageLineSize - LineSpacing()) / averageItemsPerLine;
+            const double itemSpacing = LineSpacing() / averageItemsPerLine;
+            offset = measuredSizes->OffsetOf(targetIndex, itemEstimate, itemSpacing) + flowState->FlowAlgorithm().LastExtent().*MajorStart();
+        }
+        else
+        {
+            const int lineIndex = (int)(targetIndex / averageItemsPerLine);
+            offset = lineIndex * averageLineSize + flowState->FlowAlgorithm().LastExtent().*MajorStart();
+        }
     }
 
     return { index, offset };
@@ -203,12 +225,27 @@ winrt::Rect FlowLayout::GetExtent(
         if (firstRealized)
         {
             MUX_ASSERT(lastRealized);
-            const int linesBeforeFirst = static_cast<int>(firstRealizedItemIndex / averageItemsPerLine);
-            const double extentMajorStart = firstRealizedLayoutBounds.*MajorStart() - linesBeforeFirst * averageLineSize;
+            double sizeBeforeFirst = 0.0;
+            double sizeAfterLast = 0.0;
+            if (auto measuredSizes = flowState->MeasuredSizes())
+            {
+                const double itemEstimate = (averageLineSize - LineSpacing()) / averageItemsPerLine;
+                const double itemSpacing = LineSpacing() / averageItemsPerLine;
+                sizeBeforeFirst = measuredSizes->OffsetOf(firstRealizedItemIndex, itemEstimate, itemSpacing);
+                sizeAfterLast = measuredSizes->OffsetOf(itemsCount, itemEstimate, itemSpacing) - measuredSizes->OffsetOf(lastRealizedItemIndex + 1, itemEstimate, itemSpacing);
+            }
+            else
+            {
+                const int linesBeforeFirst = static_cast<int>(firstRealizedItemIndex / averageItemsPerLine);
+                sizeBeforeFirst = linesBeforeFirst * averageLineSize;
+                const int remainingItems = itemsCount - lastRealizedItemIndex - 1;
+                const int remainingLinesAfterLast = static_cast<int>((remainingItems / averageItemsPerLine));
+                sizeAfterLast = remainingLinesAfterLast * averageLineSize;
+            }
+
+            const double extentMajorStart = firstRealizedLayoutBounds.*MajorStart() - sizeBeforeFirst;
             extent.*MajorStart() = static_cast<float>(extentMajorStart);
-            const int remainingItems = itemsCount - lastRealizedItemIndex - 1;
-            const int remainingLinesAfterLast = static_cast<int>((remainingItems / averageItemsPerLine));
-            const double extentMajorSize = MajorEnd(lastRealizedLayoutBounds) - extent.*MajorStart() + remainingLinesAfterLast * averageLineSize;
+            const double extentMajorSize = MajorEnd(lastRealizedLayoutBounds) - extent.*MajorStart() + sizeAfterLast;
             extent.*MajorSize() = static_cast<float>(extentMajorSize);
 
             // If the available size is infinite, we will have realized all the items in one line.
@@ -274,6 +311,7 @@ void FlowLayout::OnLineArranged(
 
     const auto flowState = GetAsFlowState(context.LayoutState());
     flowState->OnLineArranged(startIndex, countInLine, lineSize, context);
+    flowState->RecordLineSize(startIndex, countInLine, lineSize);
 }
 
 #pragma endregion
@@ -389,6 +427,10 @@ void FlowLayout::OnPropertyChanged(const winrt::DependencyPropertyChangedEventAr
     {
         m_lineAlignment = unbox_value<winrt::FlowLayoutLineAlignment>(args.NewValue());
     }
+    else if (property == s_IsMeasuredSizeIndexEnabledProperty)
+    {
+        m_isMeasuredSizeIndexEnabled = unbox_value<bool>(args.NewValue());
+    }
 
     InvalidateLayout();
 }
@@ -157,6 +157,7 @@ private:
     double m_minRowSpacing{};
     double m_minColumnSpacing{};
     winrt::FlowLayoutLineAlignment m_lineAlignment{ winrt::FlowLayoutLineAlignment::Start };
+    bool m_isMeasuredSizeIndexEnabled{};
 
     // !!! WARNING !!!
     // Any storage here needs to be related to layout configuration. 
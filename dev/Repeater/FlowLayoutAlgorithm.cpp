@@ -14,6 +14,7 @@ void FlowLayoutAlgorithm::InitializeForContext(
     m_algorithmCallbacks = callbacks;
     m_context.set(context);
     m_elementManager.SetContext(context);
+    m_uniformCore.Invalidate();
 }
 
 void FlowLayoutAlgorithm::UninitializeForContext(const winrt::VirtualizingLayoutContext& context)
@@ -24,6 +25,7 @@ void FlowLayoutAlgorithm::UninitializeForContext(const winrt::VirtualizingLayout
         // being held and remove the layout state from the context.
         m_elementManager.ClearRealizedRange();
     }
+    m_uniformCore.Invalidate();
     context.LayoutStateCore(nullptr);
 }
 
@@ -39,6 +41,9 @@ winrt::Size FlowLayoutAlgorithm::Measure(
     const wstring_view& layoutId)
 {
     SetScrollOrientation(orientation);
+    m_core.SetScrollOrientation(orientation);
+    // The bounds generated below are not the ones MeasureUniform would compute.
+    m_uniformCore.Invalidate();
 
     // If minor size is infinity, there is only one line and no need to align that line.
     m_scrollOrientationSameAsFlow = availableSize.*Minor() == std::numeric_limits<float>::infinity();
@@ -80,6 +85,48 @@ winrt::Size FlowLayoutAlgorithm::Measure(
     return winrt::Size{ m_lastExtent.Width, m_lastExtent.Height };
 }
 
+winrt::Size FlowLayoutAlgorithm::MeasureUniform(
+    const winrt::Size& availableSize,
+    const winrt::VirtualizingLayoutContext& context,
+    double itemWidth,
+    double itemHeight,
+    double minItemSpacing,
+    double lineSpacing,
+    unsigned int maxItemsPerLine,
+    const ScrollOrientation& orientation,
+    const wstring_view& layoutId)
+{
+    SetScrollOrientation(orientation);
+    m_core.SetScrollOrientation(orientation);
+    m_uniformCore.SetScrollOrientation(orientation);
+    m_scrollOrientationSameAsFlow = availableSize.*Minor() == std::numeric_limits<float>::infinity();
+
+    if (!CanMeasureUniform(itemWidth, itemHeight, minItemSpacing, lineSpacing))
+    {
+        return Measure(availableSize, context, true /* isWrapping */, minItemSpacing, lineSpacing, maxItemsPerLine, orientation, false /* disableVirtualization */, layoutId);
+    }
+
+    const auto realizationRect = RealizationRect();
+    REPEATER_TRACE_INFO(L"%*s: \tMeasureLayout (uniform) Realization(%.0f,%.0f,%.0f,%.0f)\n",
+        winrt::get_self<VirtualizingLayoutContext>(context)->Indent(),
+        layoutId.data(),
+        realizationRect.X, realizationRect.Y, realizationRect.Width, realizationRect.Height);
+
+    m_corePolicy.LayoutId(layoutId);
+    m_uniformCore.Measure(availableSize, itemWidth, itemHeight, minItemSpacing, lineSpacing, maxItemsPerLine, m_lastExtent.*MinorStart(), m_lastExtent.*MajorStart());
+
+    m_lastAvailableSize = availableSize;
+    m_lastItemSpacing = minItemSpacing;
+
+    // The bounds are relative to the origin the uniform layout started from. Deriving
+    // it back from the first realized element would only accumulate rounding errors.
+    m_lastExtent = EstimateExtent(availableSize, layoutId);
+    m_lastExtent.*MajorStart() = m_uniformCore.OriginMajor();
+    SetLayoutOrigin();
+
+    return winrt::Size{ m_lastExtent.Width, m_lastExtent.Height };
+}
+
 winrt::Size FlowLayoutAlgorithm::Arrange(
     const winrt::Size& finalSize,
     const winrt::VirtualizingLayoutContext& context,
@@ -237,7 +284,7 @@ int FlowLayoutAlgorithm::GetAnchorIndex(
 
     REPEATER_TRACE_INFO(L"%*s: \tPicked anchor:%d \n", winrt::get_self<VirtualizingLayoutContext>(context)->Indent(), layoutId.data(), anchorIndex);
     MUX_ASSERT(anchorIndex == -1 || m_elementManager.IsIndexValidInData(anchorIndex));
-    m_firstRealizedDataIndexInsideRealizationWindow = m_lastRealizedDataIndexInsideRealizationWindow = anchorIndex;
+    m_core.ResetRealizationWindowIndices(anchorIndex);
     if (m_elementManager.IsIndexValidInData(anchorIndex))
     {
         if (!m_elementManager.IsDataIndexRealized(anchorIndex))
@@ -290,151 +337,35 @@ void FlowLayoutAlgorithm::Generate(
 {
     if (anchorIndex != -1)
     {
-        int step = (direction == GenerateDirection::Forward) ? 1 : -1;
-
         REPEATER_TRACE_INFO(L"%*s: \tGenerating %ls from anchor %d. \n",
             winrt::get_self<VirtualizingLayoutContext>(m_context.get())->Indent(),
             layoutId.data(),
             direction == GenerateDirection::Forward ? L"forward" : L"backward",
             anchorIndex);
 
-        int previousIndex = anchorIndex;
-        int currentIndex = anchorIndex + step;
-        auto anchorBounds = m_elementManager.GetLayoutBoundsForDataIndex(anchorIndex);
-        float lineOffset = anchorBounds.*MajorStart();
-        float lineMajorSize = anchorBounds.*MajorSize();
-        unsigned int countInLine = 1;
-        bool lineNeedsReposition = false;
-
-        while (m_elementManager.IsIndexValidInData(currentIndex) &&
-              (disableVirtualization || ShouldContinueFillingUpSpace(previousIndex, direction)))
-        {
-            // Ensure layout element.
-            m_elementManager.EnsureElementRealized(direction == GenerateDirection::Forward, currentIndex, layoutId);
-            auto currentElement = m_elementManager.GetRealizedElement(currentIndex);
-            auto desiredSize = MeasureElement(currentElement, currentIndex, availableSize, m_context.get());
-
-            // Lay it out.
-            auto previousElement = m_elementManager.GetRealizedElement(previousIndex);
-            winrt::Rect currentBounds = winrt::Rect{ 0, 0, desiredSize.Width, desiredSize.Height };
-            auto previousElementBounds = m_elementManager.GetLayoutBoundsForDataIndex(previousIndex);
-
-            if (direction == GenerateDirection::Forward)
-            {
-                double remainingSpace = availableSize.*Minor() - (previousElementBounds.*MinorStart() + previousElementBounds.*MinorSize() + minItemSpacing + desiredSize.*Minor());
-                if (countInLine >= maxItemsPerLine || m_algorithmCallbacks->Algorithm_ShouldBreakLine(currentIndex, remainingSpace))
-                {
-                    // No more space in this row. wrap to next row.
-                    currentBounds.*MinorStart() = 0;
-                    currentBounds.*MajorStart() = previousElementBounds.*MajorStart() + lineMajorSize + static_cast<float>(lineSpacing);
-
-                    if (lineNeedsReposition)
-                    {
-                        // reposition the previous line (countInLine items)
-                        for (unsigned int i = 0; i < countInLine; i++)
-                        {
-                            auto dataIndex = currentIndex - 1 - i;
-                            auto bounds = m_elementManager.GetLayoutBoundsForDataIndex(dataIndex);
-                            bounds.*MajorSize() = lineMajorSize;
-                            m_elementManager.SetLayoutBoundsForDataIndex(dataIndex, bounds);
-                        }
-                    }
-
-                    // Setup for next line.
-                    lineMajorSize = currentBounds.*MajorSize();
-                    lineOffset = currentBounds.*MajorStart();
-                    lineNeedsReposition = false;
-                    countInLine = 1;
-                }
-                else
-                {
-                    // More space is available in this row.
-                    currentBounds.*MinorStart() = previousElementBounds.*MinorStart() + previousElementBounds.*MinorSize() + static_cast<float>(minItemSpacing);
-                    currentBounds.*MajorStart() = lineOffset;
-                    lineMajorSize = std::max(lineMajorSize, currentBounds.*MajorSize());
-                    lineNeedsReposition = previousElementBounds.*MajorSize() != currentBounds.*MajorSize();
-                    countInLine++;
-                }
-            }
-            else
-            {
-                // Backward
-                double remainingSpace = previousElementBounds.*MinorStart() - (desiredSize.*Minor() + static_cast<float>(minItemSpacing));
-                if (countInLine >= maxItemsPerLine || m_algorithmCallbacks->Algorithm_ShouldBreakLine(currentIndex, remainingSpace))
-                {
-                    // Does not fit, wrap to the previous row
-                    const auto availableSizeMinor = availableSize.*Minor();
-                    currentBounds.*MinorStart() = std::isfinite(availableSizeMinor) ? availableSizeMinor - desiredSize.*Minor() : 0.0f;
-                    currentBounds.*MajorStart() = lineOffset - desiredSize.*Major() - static_cast<float>(lineSpacing);
-
-                    if (lineNeedsReposition)
-                    {
-                        auto previousLineOffset = m_elementManager.GetLayoutBoundsForDataIndex(currentIndex + countInLine + 1).*MajorStart();
-                        // reposition the previous line (countInLine items)
-                        for (unsigned int i = 0; i < countInLine; i++)
-                        {
-                            auto dataIndex = currentIndex + 1 + (int)i;
-                            if (dataIndex != anchorIndex)
-                            {
-                                auto bounds = m_elementManager.GetLayoutBoundsForDataIndex(dataIndex);
-                                bounds.*MajorStart() = previousLineOffset - lineMajorSize - static_cast<float>(lineSpacing);
-                                bounds.*MajorSize() = lineMajorSize;
-                                m_elementManager.SetLayoutBoundsForDataIndex(dataIndex, bounds);
-                                REPEATER_TRACE_INFO(L"%*s: \t Corrected Layout bounds of element %d are (%.0f,%.0f,%.0f,%.0f). \n",
-                                    winrt::get_self<VirtualizingLayoutContext>(m_context.get())->Indent(),
-                                    layoutId.data(),
-                                    dataIndex,
-                                    bounds.X, bounds.Y, bounds.Width, bounds.Height);
-                            }
-                        }
-                    }
-
-                    // Setup for next line.
-                    lineMajorSize = currentBounds.*MajorSize();
-                    lineOffset = currentBounds.*MajorStart();
-                    lineNeedsReposition = false;
-                    countInLine = 1;
-                }
-                else
-                {
-                    // Fits in this row. put it in the previous position
-                    currentBounds.*MinorStart() = previousElementBounds.*MinorStart() - desiredSize.*Minor() - static_cast<float>(minItemSpacing);
-                    currentBounds.*MajorStart() = lineOffset;
-                    lineMajorSize = std::max(lineMajorSize, currentBounds.*MajorSize());
-                    lineNeedsReposition = previousElementBounds.*MajorSize() != currentBounds.*MajorSize();
-                    countInLine++;
-                }
-            }
-
-            m_elementManager.SetLayoutBoundsForDataIndex(currentIndex, currentBounds);
-
-            REPEATER_TRACE_INFO(L"%*s: \tLayout bounds of element %d are (%.0f,%.0f,%.0f,%.0f). \n",
-                winrt::get_self<VirtualizingLayoutContext>(m_context.get())->Indent(),
-                layoutId.data(),
-                currentIndex,
-                currentBounds.X, currentBounds.Y, currentBounds.Width, currentBounds.Height);
-            previousIndex = currentIndex;
-            currentIndex += step;
-        }
+        m_corePolicy.LayoutId(layoutId);
+        m_core.Generate(direction, anchorIndex, availableSize, minItemSpacing, lineSpacing, maxItemsPerLine, disableVirtualization);
+    }
+}
 
-        // If we did not reach the top or bottom of the extent, we realized one
-        // extra item before we knew we were outside the realization window. Do not
-        // account for that element in the indicies inside the realization window.
-        if (direction == GenerateDirection::Forward)
-        {
-            int dataCount = m_context.get().ItemCount();
-            m_lastRealizedDataIndexInsideRealizationWindow = previousIndex == dataCount - 1 ? dataCount - 1 : previousIndex - 1;
-            m_lastRealizedDataIndexInsideRealizationWindow = std::max(0, m_lastRealizedDataIndexInsideRealizationWindow);
-        }
-        else
-        {
-            int dataCount = m_context.get().ItemCount();
-            m_firstRealizedDataIndexInsideRealizationWindow = previousIndex == 0 ? 0 : previousIndex + 1;
-            m_firstRealizedDataIndexInsideRealizationWindow = std::min(dataCount - 1, m_firstRealizedDataIndexInsideRealizationWindow);
-        }
+bool FlowLayoutAlgorithm::CanMeasureUniform(double itemWidth, double itemHeight, double minItemSpacing, double lineSpacing)
+{
+    if (!IsVirtualizingContext() ||
+        m_scrollOrientationSameAsFlow ||
+        m_collectionChangePending)
+    {
+        return false;
+    }
 
-        m_elementManager.DiscardElementsOutsideWindow(direction == GenerateDirection::Forward, currentIndex);
+    // Lines need a size to compute the realized range from.
+    if (!(itemWidth > 0.0) || !(itemHeight > 0.0) || minItemSpacing < 0.0 || lineSpacing < 0.0)
+    {
+        return false;
     }
+
+    // A suggested anchor that is not realized yet (e.g. bring into view) has to go through MakeAnchor.
+    const int suggestedAnchorIndex = m_context.get().RecommendedAnchorIndex();
+    return !m_elementManager.IsIndexValidInData(suggestedAnchorIndex) || m_elementManager.IsDataIndexRealized(suggestedAnchorIndex);
 }
 
 bool FlowLayoutAlgorithm::IsReflowRequired() const
@@ -446,40 +377,6 @@ bool FlowLayoutAlgorithm::IsReflowRequired() const
         m_elementManager.GetLayoutBoundsForRealizedIndex(0).*MinorStart() != 0;
 }
 
-bool FlowLayoutAlgorithm::ShouldContinueFillingUpSpace(
-    int index,
-    GenerateDirection direction)
-{
-    bool shouldContinue = false;
-    if (!IsVirtualizingContext())
-    {
-        shouldContinue = true;
-    }
-    else
-    {
-        auto realizationRect = m_context.get().RealizationRect();
-        auto elementBounds = m_elementManager.GetLayoutBoundsForDataIndex(index);
-
-        auto elementMajorStart = elementBounds.*MajorStart();
-        auto elementMajorEnd = MajorEnd(elementBounds);
-        auto rectMajorStart = realizationRect.*MajorStart();
-        auto rectMajorEnd = MajorEnd(realizationRect);
-
-        auto elementMinorStart = elementBounds.*MinorStart();
-        auto elementMinorEnd = MinorEnd(elementBounds);
-        auto rectMinorStart = realizationRect.*MinorStart();
-        auto rectMinorEnd = MinorEnd(realizationRect);
-
-        // Ensure that both minor and major directions are taken into consideration so that if the scrolling direction
-        // is the same as the flow direction we still stop at the end of the viewport rectangle.
-        shouldContinue =
-            (direction == GenerateDirection::Forward && elementMajorStart < rectMajorEnd && elementMinorStart < rectMinorEnd) ||
-            (direction == GenerateDirection::Backward && elementMajorEnd > rectMajorStart&& elementMinorEnd > rectMinorStart);
-    }
-
-    return shouldContinue;
-}
-
 winrt::Rect FlowLayoutAlgorithm::EstimateExtent(const winrt::Size& availableSize, const wstring_view& layoutId)
 {
     winrt::UIElement firstRealizedElement = nullptr;
@@ -523,12 +420,14 @@ void FlowLayoutAlgorithm::RaiseLineArranged()
         int realizedElementCount = m_elementManager.GetRealizedElementCount();
         if (realizedElementCount > 0)
         {
-            MUX_ASSERT(m_firstRealizedDataIndexInsideRealizationWindow != -1 && m_lastRealizedDataIndexInsideRealizationWindow != -1);
+            const int firstRealizedDataIndexInsideRealizationWindow = m_core.FirstRealizedDataIndexInsideRealizationWindow();
+            const int lastRealizedDataIndexInsideRealizationWindow = m_core.LastRealizedDataIndexInsideRealizationWindow();
+            MUX_ASSERT(firstRealizedDataIndexInsideRealizationWindow != -1 && lastRealizedDataIndexInsideRealizationWindow != -1);
             int countInLine = 0;
-            auto previousElementBounds = m_elementManager.GetLayoutBoundsForDataIndex(m_firstRealizedDataIndexInsideRealizationWindow);
+            auto previousElementBounds = m_elementManager.GetLayoutBoundsForDataIndex(firstRealizedDataIndexInsideRealizationWindow);
             auto currentLineOffset = previousElementBounds.*MajorStart();
             auto currentLineSize = previousElementBounds.*MajorSize();
-            for (int currentDataIndex = m_firstRealizedDataIndexInsideRealizationWindow; currentDataIndex <= m_lastRealizedDataIndexInsideRealizationWindow; currentDataIndex++)
+            for (int currentDataIndex = firstRealizedDataIndexInsideRealizationWindow; currentDataIndex <= lastRealizedDataIndexInsideRealizationWindow; currentDataIndex++)
             {
                 auto currentBounds = m_elementManager.GetLayoutBoundsForDataIndex(currentDataIndex);
                 if (currentBounds.*MajorStart() != currentLineOffset)
@@ -546,7 +445,7 @@ void FlowLayoutAlgorithm::RaiseLineArranged()
             }
 
             // Raise for the last line.
-            m_algorithmCallbacks->Algorithm_OnLineArranged(m_lastRealizedDataIndexInsideRealizationWindow - countInLine + 1, countInLine, currentLineSize, m_context.get());
+            m_algorithmCallbacks->Algorithm_OnLineArranged(lastRealizedDataIndexInsideRealizationWindow - countInLine + 1, countInLine, currentLineSize, m_context.get());
         }
     }
 }
@@ -561,134 +460,8 @@ void FlowLayoutAlgorithm::ArrangeVirtualizingLayout(
     bool isWrapping,
     const wstring_view& layoutId)
 {
-    // Walk through the realized elements one line at a time and
-    // align them, Then call element.Arrange with the arranged bounds.
-    int realizedElementCount = m_elementManager.GetRealizedElementCount();
-    if (realizedElementCount > 0)
-    {
-        int countInLine = 1;
-        auto previousElementBounds = m_elementManager.GetLayoutBoundsForRealizedIndex(0);
-        auto currentLineOffset = previousElementBounds.*MajorStart();
-        auto spaceAtLineStart = previousElementBounds.*MinorStart();
-        float spaceAtLineEnd = 0;
-        float currentLineSize = previousElementBounds.*MajorSize();
-        for (int i = 1; i < realizedElementCount; i++)
-        {
-            auto currentBounds = m_elementManager.GetLayoutBoundsForRealizedIndex(i);
-            if (currentBounds.*MajorStart() != currentLineOffset)
-            {
-                spaceAtLineEnd = finalSize.*Minor() - previousElementBounds.*MinorStart() - previousElementBounds.*MinorSize();
-                PerformLineAlignment(i - countInLine, countInLine, spaceAtLineStart, spaceAtLineEnd, currentLineSize, lineAlignment, isWrapping, finalSize, layoutId);
-                spaceAtLineStart = currentBounds.*MinorStart();
-                countInLine = 0;
-                currentLineOffset = currentBounds.*MajorStart();
-                currentLineSize = 0;
-            }
-
-            countInLine++; // for current element
-            currentLineSize = std::max(currentLineSize, currentBounds.*MajorSize());
-            previousElementBounds = currentBounds;
-        }
-
-        // Last line - potentially have a property to customize
-        // aligning the last line or not.
-        if (countInLine > 0)
-        {
-            float spaceAtEnd = finalSize.*Minor() - previousElementBounds.*MinorStart() - previousElementBounds.*MinorSize();
-            PerformLineAlignment(realizedElementCount - countInLine, countInLine, spaceAtLineStart, spaceAtEnd, currentLineSize, lineAlignment, isWrapping, finalSize, layoutId);
-        }
-    }
-}
-
-// Align elements within a line. Note that this does not modify LayoutBounds. So if we get
-// repeated measures, the LayoutBounds remain the same in each layout.
-void FlowLayoutAlgorithm::PerformLineAlignment(
-    int lineStartIndex,
-    int countInLine,
-    float spaceAtLineStart,
-    float spaceAtLineEnd,
-    float lineSize,
-    FlowLayoutAlgorithm::LineAlignment lineAlignment,
-    bool isWrapping,
-    const winrt::Size& finalSize,
-    const wstring_view& layoutId)
-{
-    for (int rangeIndex = lineStartIndex; rangeIndex < lineStartIndex + countInLine; ++rangeIndex)
-    {
-        auto bounds = m_elementManager.GetLayoutBoundsForRealizedIndex(rangeIndex);
-        bounds.*MajorSize() = lineSize;
-
-        if (!m_scrollOrientationSameAsFlow)
-        {
-            // Note: Space at start could potentially be negative
-            if (spaceAtLineStart != 0 || spaceAtLineEnd != 0)
-            {
-                float totalSpace = spaceAtLineStart + spaceAtLineEnd;
-                switch (lineAlignment)
-                {
-                case FlowLayoutAlgorithm::LineAlignment::Start:
-                {
-                    bounds.*MinorStart() -= spaceAtLineStart;
-                    break;
-                }
-
-                case FlowLayoutAlgorithm::LineAlignment::End:
-                {
-                    bounds.*MinorStart() += spaceAtLineEnd;
-                    break;
-                }
-
-                case FlowLayoutAlgorithm::LineAlignment::Center:
-                {
-                    bounds.*MinorStart() -= spaceAtLineStart;
-                    bounds.*MinorStart() += totalSpace / 2;
-                    break;
-                }
-
-                case FlowLayoutAlgorithm::LineAlignment::SpaceAround:
-                {
-                    float interItemSpace = countInLine >= 1 ? totalSpace / (countInLine * 2) : 0;
-                    bounds.*MinorStart() -= spaceAtLineStart;
-                    bounds.*MinorStart() += interItemSpace * ((rangeIndex - lineStartIndex + 1) * 2 - 1);
-                    break;
-                }
-
-                case FlowLayoutAlgorithm::LineAlignment::SpaceBetween:
-                {
-                    float interItemSpace = countInLine > 1 ? totalSpace / (countInLine - 1) : 0;
-                    bounds.*MinorStart() -= spaceAtLineStart;
-                    bounds.*MinorStart() += interItemSpace * (rangeIndex - lineStartIndex);
-                    break;
-                }
-
-                case FlowLayoutAlgorithm::LineAlignment::SpaceEvenly:
-                {
-                    float interItemSpace = countInLine >= 1 ? totalSpace / (countInLine + 1) : 0;
-                    bounds.*MinorStart() -= spaceAtLineStart;
-                    bounds.*MinorStart() += interItemSpace * (rangeIndex - lineStartIndex + 1);
-                    break;
-                }
-                }
-            }
-        }
-
-        bounds.X -= m_lastExtent.X;
-        bounds.Y -= m_lastExtent.Y;
-
-        if (!isWrapping)
-        {
-            bounds.*MinorSize() = std::max(bounds.*MinorSize(), finalSize.*Minor());
-        }
-
-        auto element = m_elementManager.GetAt(rangeIndex);
-
-        REPEATER_TRACE_INFO(L"%*s: \tArranging element %d at (%.0f,%.0f,%.0f,%.0f). \n",
-            winrt::get_self<VirtualizingLayoutContext>(m_context.get())->Indent(),
-            layoutId.data(),
-            m_elementManager.GetDataIndexFromRealizedRangeIndex(rangeIndex),
-            bounds.X, bounds.Y, bounds.Width, bounds.Height);
-        element.Arrange(bounds);
-    }
+    m_corePolicy.LayoutId(layoutId);
+    m_core.Arrange(finalSize, lineAlignment, isWrapping, m_scrollOrientationSameAsFlow, m_lastExtent.X, m_lastExtent.Y);
 }
 
 #pragma endregion
@@ -731,6 +504,8 @@ bool FlowLayoutAlgorithm::TryAddElement0(winrt::UIElement const& element)
     if (m_elementManager.GetRealizedElementCount() == 0)
     {
         m_elementManager.Add(element, 0);
+        // Element 0 has no bounds yet.
+        m_uniformCore.Invalidate();
         return true;
     }
 
@@ -749,3 +524,98 @@ bool FlowLayoutAlgorithm::IsVirtualizingContext()
 }
 
 #pragma endregion
+
+#pragma region CorePolicy
+
+bool FlowLayoutAlgorithm::CorePolicy::IsVirtualizingContext()
+{
+    return m_owner->IsVirtualizingContext();
+}
+
+winrt::Rect FlowLayoutAlgorithm::CorePolicy::RealizationRect()
+{
+    return m_owner->RealizationRect();
+}
+
+int FlowLayoutAlgorithm::CorePolicy::ItemCount()
+{
+    return m_owner->m_context.get().ItemCount();
+}
+
+void FlowLayoutAlgorithm::CorePolicy::EnsureElementRealized(bool forward, int dataIndex)
+{
+    m_owner->m_elementManager.EnsureElementRealized(forward, dataIndex, m_layoutId);
+}
+
+winrt::Size FlowLayoutAlgorithm::CorePolicy::MeasureElement(int dataIndex, const winrt::Size& availableSize)
+{
+    auto element = m_owner->m_elementManager.GetRealizedElement(dataIndex);
+    return m_owner->MeasureElement(element, dataIndex, availableSize, m_owner->m_context.get());
+}
+
+bool FlowLayoutAlgorithm::CorePolicy::ShouldBreakLine(int dataIndex, double remainingSpace)
+{
+    return m_owner->m_algorithmCallbacks->Algorithm_ShouldBreakLine(dataIndex, remainingSpace);
+}
+
+winrt::Rect FlowLayoutAlgorithm::CorePolicy::GetLayoutBoundsForDataIndex(int dataIndex)
+{
+    return m_owner->m_elementManager.GetLayoutBoundsForDataIndex(dataIndex);
+}
+
+void FlowLayoutAlgorithm::CorePolicy::SetLayoutBoundsForDataIndex(int dataIndex, const winrt::Rect& bounds)
+{
+    m_owner->m_elementManager.SetLayoutBoundsForDataIndex(dataIndex, bounds);
+}
+
+void FlowLayoutAlgorithm::CorePolicy::DiscardElementsOutsideWindow(bool forward, int startIndex)
+{
+    m_owner->m_elementManager.DiscardElementsOutsideWindow(forward, startIndex);
+}
+
+int FlowLayoutAlgorithm::CorePolicy::GetRealizedElementCount()
+{
+    return m_owner->m_elementManager.GetRealizedElementCount();
+}
+
+winrt::Rect FlowLayoutAlgorithm::CorePolicy::GetLayoutBoundsForRealizedIndex(int realizedIndex)
+{
+    return m_owner->m_elementManager.GetLayoutBoundsForRealizedIndex(realizedIndex);
+}
+
+void FlowLayoutAlgorithm::CorePolicy::ArrangeElement(int realizedIndex, const winrt::Rect& bounds)
+{
+    auto element = m_owner->m_elementManager.GetAt(realizedIndex);
+
+    REPEATER_TRACE_INFO(L"%*s: \tArranging element %d at (%.0f,%.0f,%.0f,%.0f). \n",
+        winrt::get_self<VirtualizingLayoutContext>(m_owner->m_context.get())->Indent(),
+        m_layoutId.data(),
+        m_owner->m_elementManager.GetDataIndexFromRealizedRangeIndex(realizedIndex),
+        bounds.X, bounds.Y, bounds.Width, bounds.Height);
+    element.Arrange(bounds);
+}
+
+void FlowLayoutAlgorithm::CorePolicy::OnElementLaidOut(int dataIndex, const winrt::Rect& bounds, bool isCorrection)
+{
+    REPEATER_TRACE_INFO(L"%*s: \t%ls bounds of element %d are (%.0f,%.0f,%.0f,%.0f). \n",
+        winrt::get_self<VirtualizingLayoutContext>(m_owner->m_context.get())->Indent(),
+        m_layoutId.data(),
+        isCorrection ? L" Corrected Layout" : L"Layout",
+        dataIndex,
+        bounds.X, bounds.Y, bounds.Width, bounds.Height);
+}
+
+int FlowLayoutAlgorithm::CorePolicy::FirstRealizedDataIndex()
+{
+    return m_owner->m_elementManager.GetDataIndexFromRealizedRangeIndex(0);
+}
+
+void FlowLayoutAlgorithm::CorePolicy::ClearRealizedRange(int realizedIndex, int count)
+{
+    if (count > 0)
+    {
+        m_owner->m_elementManager.ClearRealizedRange(realizedIndex, count);
+    }
+}
+
+#pragma endregion
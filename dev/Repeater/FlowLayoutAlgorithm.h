@@ -4,6 +4,8 @@
 #pragma once
 
 #include "ElementManager.h"
+#include "FlowLayoutAlgorithmCore.h"
+#include "UniformGridLayoutCore.h"
 #include "IFlowLayoutAlgorithmDelegates.h"
 #include "OrientationBasedMeasures.h"
 
@@ -11,15 +13,7 @@ class FlowLayoutAlgorithm : OrientationBasedMeasures
 {
 public:
     // Types
-    enum class LineAlignment
-    {
-        Start,
-        Center,
-        End,
-        SpaceAround,
-        SpaceBetween,
-        SpaceEvenly
-    };
+    using LineAlignment = FlowLayoutAlgorithmLineAlignment;
 
     FlowLayoutAlgorithm(const ITrackerHandleManager* owner) :
         m_owner(owner),
@@ -43,6 +37,19 @@ public:
         const ScrollOrientation& orientation,
         const bool disableVirtualization,
         const wstring_view& layoutId);
+    // Measure for layouts where every item has the same size. Computes the realized range and
+    // the element bounds in closed form (see UniformGridLayoutCore) and falls back to Measure
+    // when it can't, e.g. while a collection change or a bring into view is pending.
+    winrt::Size MeasureUniform(
+        const winrt::Size& availableSize,
+        const winrt::VirtualizingLayoutContext& context,
+        double itemWidth,
+        double itemHeight,
+        double minItemSpacing,
+        double lineSpacing,
+        unsigned int maxItemsPerLine,
+        const ScrollOrientation& orientation,
+        const wstring_view& layoutId);
     winrt::Size Arrange(
         const winrt::Size& finalSize,
         const winrt::VirtualizingLayoutContext& context,
@@ -65,12 +72,42 @@ public:
 
 private:
     // Types
-    enum class GenerateDirection
+
+    // Adapts the element manager and the layout context to the
+    // platform neutral FlowLayoutAlgorithmCore.
+    class CorePolicy
     {
-        Forward,
-        Backward
+    public:
+        using Rect = winrt::Rect;
+        using Size = winrt::Size;
+
+        CorePolicy(FlowLayoutAlgorithm* owner) : m_owner(owner) { }
+
+        void LayoutId(const wstring_view& layoutId) { m_layoutId = layoutId; }
+
+        bool IsVirtualizingContext();
+        winrt::Rect RealizationRect();
+        int ItemCount();
+        void EnsureElementRealized(bool forward, int dataIndex);
+        winrt::Size MeasureElement(int dataIndex, const winrt::Size& availableSize);
+        bool ShouldBreakLine(int dataIndex, double remainingSpace);
+        winrt::Rect GetLayoutBoundsForDataIndex(int dataIndex);
+        void SetLayoutBoundsForDataIndex(int dataIndex, const winrt::Rect& bounds);
+        void DiscardElementsOutsideWindow(bool forward, int startIndex);
+        int GetRealizedElementCount();
+        winrt::Rect GetLayoutBoundsForRealizedIndex(int realizedIndex);
+        void ArrangeElement(int realizedIndex, const winrt::Rect& bounds);
+        void OnElementLaidOut(int dataIndex, const winrt::Rect& bounds, bool isCorrection);
+        int FirstRealizedDataIndex();
+        void ClearRealizedRange(int realizedIndex, int count);
+
+    private:
+        FlowLayoutAlgorithm* m_owner;
+        wstring_view m_layoutId{};
     };
 
+    using GenerateDirection = FlowLayoutAlgorithmCore<CorePolicy>::GenerateDirection;
+
     // Methods
 #pragma region Measure related private methods
     int GetAnchorIndex(
@@ -92,9 +129,7 @@ private:
         int index,
         const winrt::Size& availableSize);
     bool IsReflowRequired() const;
-    bool ShouldContinueFillingUpSpace(
-        int index,
-        GenerateDirection direction);
+    bool CanMeasureUniform(double itemWidth, double itemHeight, double minItemSpacing, double lineSpacing);
     winrt::Rect EstimateExtent(const winrt::Size& availableSize, const wstring_view& layoutId);
     void RaiseLineArranged();
 #pragma endregion
@@ -105,16 +140,6 @@ private:
         FlowLayoutAlgorithm::LineAlignment lineAlignment,
         bool isWrapping,
         const wstring_view& layoutId);
-    void PerformLineAlignment(
-        int lineStartIndex,
-        int countInLine,
-        float spaceAtLineStart,
-        float spaceAtLineEnd,
-        float lineSize,
-        FlowLayoutAlgorithm::LineAlignment lineAlignment,
-        bool isWrapping,
-        const winrt::Size& finalSize,
-        const wstring_view& layoutId);
 #pragma endregion
 
 #pragma region Layout Context Helpers
@@ -133,8 +158,9 @@ private:
     tracker_ref<winrt::VirtualizingLayoutContext> m_context;
     IFlowLayoutAlgorithmDelegates* m_algorithmCallbacks{ nullptr };
     winrt::Rect m_lastExtent{};
-    int m_firstRealizedDataIndexInsideRealizationWindow{ -1 };
-    int m_lastRealizedDataIndexInsideRealizationWindow{ -1 };
+    CorePolicy m_corePolicy{ this };
+    FlowLayoutAlgorithmCore<CorePolicy> m_core{ m_corePolicy };
+    UniformGridLayoutCore<CorePolicy> m_uniformCore{ m_corePolicy };
 
     // If the scroll orientation is the same as the folow orientation
     // we will only have one line since we will never wrap. In that case
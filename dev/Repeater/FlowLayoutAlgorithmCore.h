@@ -0,0 +1,418 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include "ScrollOrientation.h"
+
+enum class FlowLayoutAlgorithmLineAlignment
+{
+    Start,
+    Center,
+    End,
+    SpaceAround,
+    SpaceBetween,
+    SpaceEvenly
+};
+
+// Same as OrientationBasedMeasures, but over any rect/size type with
+// float X, Y, Width, Height (resp. Width, Height) members.
+template <typename TRect, typename TSize>
+class OrientationBasedMeasuresCore
+{
+public:
+    ScrollOrientation GetScrollOrientation() const { return m_orientation; }
+    void SetScrollOrientation(ScrollOrientation value) { m_orientation = value; }
+
+    // Major - Scrolling/virtualizing direction
+    // Minor - Opposite direction
+    float TSize::* Major() const { return m_orientation == ScrollOrientation::Vertical ? &TSize::Height : &TSize::Width; }
+    float TSize::* Minor() const { return m_orientation == ScrollOrientation::Vertical ? &TSize::Width : &TSize::Height; }
+
+    float TRect::* MajorSize() const { return m_orientation == ScrollOrientation::Vertical ? &TRect::Height : &TRect::Width; }
+    float TRect::* MinorSize() const { return m_orientation == ScrollOrientation::Vertical ? &TRect::Width : &TRect::Height; }
+    float TRect::* MajorStart() const { return m_orientation == ScrollOrientation::Vertical ? &TRect::Y : &TRect::X; }
+    float TRect::* MinorStart() const { return m_orientation == ScrollOrientation::Vertical ? &TRect::X : &TRect::Y; }
+    float MajorEnd(const TRect& rect) const { return rect.*MajorStart() + rect.*MajorSize(); }
+    float MinorEnd(const TRect& rect) const { return rect.*MinorStart() + rect.*MinorSize(); }
+
+private:
+    ScrollOrientation m_orientation{ ScrollOrientation::Vertical };
+};
+
+// Platform neutral line generation and realization window math used by FlowLayoutAlgorithm.
+// All element access goes through TPolicy so that the same code runs against a
+// VirtualizingLayoutContext in the control and against synthetic items in the
+// headless benchmarks (see Benchmarks/FlowLayoutBenchmark.cpp).
+//
+// TPolicy must provide:
+//   using Rect = ...; using Size = ...;
+//   bool IsVirtualizingContext();
+//   Rect RealizationRect();
+//   int ItemCount();
+//   void EnsureElementRealized(bool forward, int dataIndex);
+//   Size MeasureElement(int dataIndex, const Size& availableSize);
+//   bool ShouldBreakLine(int dataIndex, double remainingSpace);
+//   Rect GetLayoutBoundsForDataIndex(int dataIndex);
+//   void SetLayoutBoundsForDataIndex(int dataIndex, const Rect& bounds);
+//   void DiscardElementsOutsideWindow(bool forward, int startIndex);
+//   int GetRealizedElementCount();
+//   Rect GetLayoutBoundsForRealizedIndex(int realizedIndex);
+//   void ArrangeElement(int realizedIndex, const Rect& bounds);
+//   void OnElementLaidOut(int dataIndex, const Rect& bounds, bool isCorrection);
+template <typename TPolicy>
+class FlowLayoutAlgorithmCore : public OrientationBasedMeasuresCore<typename TPolicy::Rect, typename TPolicy::Size>
+{
+public:
+    using Rect = typename TPolicy::Rect;
+    using Size = typename TPolicy::Size;
+    using Measures = OrientationBasedMeasuresCore<Rect, Size>;
+    using Measures::Minor;
+    using Measures::Major;
+    using Measures::MinorSize;
+    using Measures::MajorSize;
+    using Measures::MinorStart;
+    using Measures::MajorStart;
+    using Measures::MinorEnd;
+    using Measures::MajorEnd;
+
+    enum class GenerateDirection
+    {
+        Forward,
+        Backward
+    };
+
+    explicit FlowLayoutAlgorithmCore(TPolicy& policy) : m_policy(policy) { }
+
+    int FirstRealizedDataIndexInsideRealizationWindow() const { return m_firstRealizedDataIndexInsideRealizationWindow; }
+    int LastRealizedDataIndexInsideRealizationWindow() const { return m_lastRealizedDataIndexInsideRealizationWindow; }
+    void ResetRealizationWindowIndices(int anchorIndex)
+    {
+        m_firstRealizedDataIndexInsideRealizationWindow = m_lastRealizedDataIndexInsideRealizationWindow = anchorIndex;
+    }
+
+    void Generate(
+        GenerateDirection direction,
+        int anchorIndex,
+        const Size& availableSize,
+        double minItemSpacing,
+        double lineSpacing,
+        unsigned int maxItemsPerLine,
+        const bool disableVirtualization)
+    {
+        if (anchorIndex == -1)
+        {
+            return;
+        }
+
+        const int step = (direction == GenerateDirection::Forward) ? 1 : -1;
+        const int dataCount = m_policy.ItemCount();
+        int previousIndex = anchorIndex;
+        int currentIndex = anchorIndex + step;
+        const auto anchorBounds = m_policy.GetLayoutBoundsForDataIndex(anchorIndex);
+        float lineOffset = anchorBounds.*MajorStart();
+        float lineMajorSize = anchorBounds.*MajorSize();
+        unsigned int countInLine = 1;
+        bool lineNeedsReposition = false;
+
+        while (currentIndex >= 0 && currentIndex < dataCount &&
+            (disableVirtualization || ShouldContinueFillingUpSpace(previousIndex, direction)))
+        {
+            // Ensure layout element.
+            m_policy.EnsureElementRealized(direction == GenerateDirection::Forward, currentIndex);
+            const auto desiredSize = m_policy.MeasureElement(currentIndex, availableSize);
+
+            // Lay it out.
+            Rect currentBounds{ 0, 0, desiredSize.Width, desiredSize.Height };
+            const auto previousElementBounds = m_policy.GetLayoutBoundsForDataIndex(previousIndex);
+
+            if (direction == GenerateDirection::Forward)
+            {
+                const double remainingSpace = availableSize.*Minor() - (previousElementBounds.*MinorStart() + previousElementBounds.*MinorSize() + minItemSpacing + desiredSize.*Minor());
+                if (countInLine >= maxItemsPerLine || m_policy.ShouldBreakLine(currentIndex, remainingSpace))
+                {
+                    // No more space in this row. wrap to next row.
+                    currentBounds.*MinorStart() = 0;
+                    currentBounds.*MajorStart() = previousElementBounds.*MajorStart() + lineMajorSize + static_cast<float>(lineSpacing);
+
+                    if (lineNeedsReposition)
+                    {
+                        // reposition the previous line (countInLine items)
+                        for (unsigned int i = 0; i < countInLine; i++)
+                        {
+                            const int dataIndex = currentIndex - 1 - static_cast<int>(i);
+                            auto bounds = m_policy.GetLayoutBoundsForDataIndex(dataIndex);
+                            bounds.*MajorSize() = lineMajorSize;
+                            m_policy.SetLayoutBoundsForDataIndex(dataIndex, bounds);
+                        }
+                    }
+
+                    // Setup for next line.
+                    lineMajorSize = currentBounds.*MajorSize();
+                    lineOffset = currentBounds.*MajorStart();
+                    lineNeedsReposition = false;
+                    countInLine = 1;
+                }
+                else
+                {
+                    // More space is available in this row.
+                    currentBounds.*MinorStart() = previousElementBounds.*MinorStart() + previousElementBounds.*MinorSize() + static_cast<float>(minItemSpacing);
+                    currentBounds.*MajorStart() = lineOffset;
+                    lineMajorSize = std::max(lineMajorSize, currentBounds.*MajorSize());
+                    lineNeedsReposition = previousElementBounds.*MajorSize() != currentBounds.*MajorSize();
+                    countInLine++;
+                }
+            }
+            else
+            {
+                // Backward
+                const double remainingSpace = previousElementBounds.*MinorStart() - (desiredSize.*Minor() + static_cast<float>(minItemSpacing));
+                if (countInLine >= maxItemsPerLine || m_policy.ShouldBreakLine(currentIndex, remainingSpace))
+                {
+                    // Does not fit, wrap to the previous row
+                    const auto availableSizeMinor = availableSize.*Minor();
+                    currentBounds.*MinorStart() = std::isfinite(availableSizeMinor) ? availableSizeMinor - desiredSize.*Minor() : 0.0f;
+                    currentBounds.*MajorStart() = lineOffset - desiredSize.*Major() - static_cast<float>(lineSpacing);
+
+                    if (lineNeedsReposition)
+                    {
+                        const auto previousLineOffset = m_policy.GetLayoutBoundsForDataIndex(currentIndex + countInLine + 1).*MajorStart();
+                        // reposition the previous line (countInLine items)
+                        for (unsigned int i = 0; i < countInLine; i++)
+                        {
+                            const int dataIndex = currentIndex + 1 + static_cast<int>(i);
+                            if (dataIndex != anchorIndex)
+                            {
+                                auto bounds = m_policy.GetLayoutBoundsForDataIndex(dataIndex);
+                                bounds.*MajorStart() = previousLineOffset - lineMajorSize - static_cast<float>(lineSpacing);
+                                bounds.*MajorSize() = lineMajorSize;
+                                m_policy.SetLayoutBoundsForDataIndex(dataIndex, bounds);
+                                m_policy.OnElementLaidOut(dataIndex, bounds, true /* isCorrection */);
+                            }
+                        }
+                    }
+
+                    // Setup for next line.
+                    lineMajorSize = currentBounds.*MajorSize();
+                    lineOffset = currentBounds.*MajorStart();
+                    lineNeedsReposition = false;
+                    countInLine = 1;
+                }
+                else
+                {
+                    // Fits in this row. put it in the previous position
+                    currentBounds.*MinorStart() = previousElementBounds.*MinorStart() - desiredSize.*Minor() - static_cast<float>(minItemSpacing);
+                    currentBounds.*MajorStart() = lineOffset;
+                    lineMajorSize = std::max(lineMajorSize, currentBounds.*MajorSize());
+                    lineNeedsReposition = previousElementBounds.*MajorSize() != currentBounds.*MajorSize();
+                    countInLine++;
+                }
+            }
+
+            m_policy.SetLayoutBoundsForDataIndex(currentIndex, currentBounds);
+            m_policy.OnElementLaidOut(currentIndex, currentBounds, false /* isCorrection */);
+
+            previousIndex = currentIndex;
+            currentIndex += step;
+        }
+
+        // If we did not reach the top or bottom of the extent, we realized one
+        // extra item before we knew we were outside the realization window. Do not
+        // account for that element in the indicies inside the realization window.
+        if (direction == GenerateDirection::Forward)
+        {
+            m_lastRealizedDataIndexInsideRealizationWindow = previousIndex == dataCount - 1 ? dataCount - 1 : previousIndex - 1;
+            m_lastRealizedDataIndexInsideRealizationWindow = std::max(0, m_lastRealizedDataIndexInsideRealizationWindow);
+        }
+        else
+        {
+            m_firstRealizedDataIndexInsideRealizationWindow = previousIndex == 0 ? 0 : previousIndex + 1;
+            m_firstRealizedDataIndexInsideRealizationWindow = std::min(dataCount - 1, m_firstRealizedDataIndexInsideRealizationWindow);
+        }
+
+        m_policy.DiscardElementsOutsideWindow(direction == GenerateDirection::Forward, currentIndex);
+    }
+
+    bool ShouldContinueFillingUpSpace(
+        int index,
+        GenerateDirection direction)
+    {
+        if (!m_policy.IsVirtualizingContext())
+        {
+            return true;
+        }
+
+        const auto realizationRect = m_policy.RealizationRect();
+        const auto elementBounds = m_policy.GetLayoutBoundsForDataIndex(index);
+
+        const auto elementMajorStart = elementBounds.*MajorStart();
+        const auto elementMajorEnd = MajorEnd(elementBounds);
+        const auto rectMajorStart = realizationRect.*MajorStart();
+        const auto rectMajorEnd = MajorEnd(realizationRect);
+
+        const auto elementMinorStart = elementBounds.*MinorStart();
+        const auto elementMinorEnd = MinorEnd(elementBounds);
+        const auto rectMinorStart = realizationRect.*MinorStart();
+        const auto rectMinorEnd = MinorEnd(realizationRect);
+
+        // Ensure that both minor and major directions are taken into consideration so that if the scrolling direction
+        // is the same as the flow direction we still stop at the end of the viewport rectangle.
+        return
+            (direction == GenerateDirection::Forward && elementMajorStart < rectMajorEnd && elementMinorStart < rectMinorEnd) ||
+            (direction == GenerateDirection::Backward && elementMajorEnd > rectMajorStart && elementMinorEnd > rectMinorStart);
+    }
+
+    // Walk through the realized elements one line at a time and
+    // align them, Then call ArrangeElement with the arranged bounds.
+    void Arrange(
+        const Size& finalSize,
+        FlowLayoutAlgorithmLineAlignment lineAlignment,
+        bool isWrapping,
+        bool scrollOrientationSameAsFlow,
+        float extentX,
+        float extentY)
+    {
+        const int realizedElementCount = m_policy.GetRealizedElementCount();
+        if (realizedElementCount > 0)
+        {
+            int countInLine = 1;
+            auto previousElementBounds = m_policy.GetLayoutBoundsForRealizedIndex(0);
+            auto currentLineOffset = previousElementBounds.*MajorStart();
+            auto spaceAtLineStart = previousElementBounds.*MinorStart();
+            float spaceAtLineEnd = 0;
+            float currentLineSize = previousElementBounds.*MajorSize();
+            for (int i = 1; i < realizedElementCount; i++)
+            {
+                const auto currentBounds = m_policy.GetLayoutBoundsForRealizedIndex(i);
+                if (currentBounds.*MajorStart() != currentLineOffset)
+                {
+                    spaceAtLineEnd = finalSize.*Minor() - previousElementBounds.*MinorStart() - previousElementBounds.*MinorSize();
+                    PerformLineAlignment(i - countInLine, countInLine, spaceAtLineStart, spaceAtLineEnd, currentLineSize, lineAlignment, isWrapping, scrollOrientationSameAsFlow, finalSize, extentX, extentY);
+                    spaceAtLineStart = currentBounds.*MinorStart();
+                    countInLine = 0;
+                    currentLineOffset = currentBounds.*MajorStart();
+                    currentLineSize = 0;
+                }
+
+                countInLine++; // for current element
+                currentLineSize = std::max(currentLineSize, currentBounds.*MajorSize());
+                previousElementBounds = currentBounds;
+            }
+
+            // Last line - potentially have a property to customize
+            // aligning the last line or not.
+            if (countInLine > 0)
+            {
+                const float spaceAtEnd = finalSize.*Minor() - previousElementBounds.*MinorStart() - previousElementBounds.*MinorSize();
+                PerformLineAlignment(realizedElementCount - countInLine, countInLine, spaceAtLineStart, spaceAtEnd, currentLineSize, lineAlignment, isWrapping, scrollOrientationSameAsFlow, finalSize, extentX, extentY);
+            }
+        }
+    }
+
+    // Returns the aligned minor start of the element at indexInLine. Note that
+    // spaceAtLineStart could potentially be negative.
+    static float AlignMinorStart(
+        float minorStart,
+        int indexInLine,
+        int countInLine,
+        float spaceAtLineStart,
+        float spaceAtLineEnd,
+        FlowLayoutAlgorithmLineAlignment lineAlignment)
+    {
+        if (spaceAtLineStart != 0 || spaceAtLineEnd != 0)
+        {
+            const float totalSpace = spaceAtLineStart + spaceAtLineEnd;
+            switch (lineAlignment)
+            {
+            case FlowLayoutAlgorithmLineAlignment::Start:
+            {
+                minorStart -= spaceAtLineStart;
+                break;
+            }
+
+            case FlowLayoutAlgorithmLineAlignment::End:
+            {
+                minorStart += spaceAtLineEnd;
+                break;
+            }
+
+            case FlowLayoutAlgorithmLineAlignment::Center:
+            {
+                minorStart -= spaceAtLineStart;
+                minorStart += totalSpace / 2;
+                break;
+            }
+
+            case FlowLayoutAlgorithmLineAlignment::SpaceAround:
+            {
+                const float interItemSpace = countInLine >= 1 ? totalSpace / (countInLine * 2) : 0;
+                minorStart -= spaceAtLineStart;
+                minorStart += interItemSpace * ((indexInLine + 1) * 2 - 1);
+                break;
+            }
+
+            case FlowLayoutAlgorithmLineAlignment::SpaceBetween:
+            {
+                const float interItemSpace = countInLine > 1 ? totalSpace / (countInLine - 1) : 0;
+                minorStart -= spaceAtLineStart;
+                minorStart += interItemSpace * indexInLine;
+                break;
+            }
+
+            case FlowLayoutAlgorithmLineAlignment::SpaceEvenly:
+            {
+                const float interItemSpace = countInLine >= 1 ? totalSpace / (countInLine + 1) : 0;
+                minorStart -= spaceAtLineStart;
+                minorStart += interItemSpace * (indexInLine + 1);
+                break;
+            }
+            }
+        }
+
+        return minorStart;
+    }
+
+private:
+    // Align elements within a line. Note that this does not modify LayoutBounds. So if we get
+    // repeated measures, the LayoutBounds remain the same in each layout.
+    void PerformLineAlignment(
+        int lineStartIndex,
+        int countInLine,
+        float spaceAtLineStart,
+        float spaceAtLineEnd,
+        float lineSize,
+        FlowLayoutAlgorithmLineAlignment lineAlignment,
+        bool isWrapping,
+        bool scrollOrientationSameAsFlow,
+        const Size& finalSize,
+        float extentX,
+        float extentY)
+    {
+        for (int rangeIndex = lineStartIndex; rangeIndex < lineStartIndex + countInLine; ++rangeIndex)
+        {
+            auto bounds = m_policy.GetLayoutBoundsForRealizedIndex(rangeIndex);
+            bounds.*MajorSize() = lineSize;
+
+            if (!scrollOrientationSameAsFlow)
+            {
+                bounds.*MinorStart() = AlignMinorStart(bounds.*MinorStart(), rangeIndex - lineStartIndex, countInLine, spaceAtLineStart, spaceAtLineEnd, lineAlignment);
+            }
+
+            bounds.X -= extentX;
+            bounds.Y -= extentY;
+
+            if (!isWrapping)
+            {
+                bounds.*MinorSize() = std::max(bounds.*MinorSize(), finalSize.*Minor());
+            }
+
+            m_policy.ArrangeElement(rangeIndex, bounds);
+        }
+    }
+
+    TPolicy& m_policy;
+    int m_firstRealizedDataIndexInsideRealizationWindow{ -1 };
+    int m_lastRealizedDataIndexInsideRealizationWindow{ -1 };
+};
@@ -52,4 +52,67 @@ void FlowLayoutState::OnLineArranged(int startIndex, int countInLine, double lin
         m_totalItemsPerLine += countInLine;
         m_itemsPerLineEstimationBuffer[estimationBufferIndex] = countInLine;
     }
-}
\ No newline at end of file
+}
+
+void FlowLayoutState::OnMeasureStart(bool isMeasuredSizeIndexEnabled, int itemCount)
+{
+    if (isMeasuredSizeIndexEnabled != m_isMeasuredSizeIndexEnabled)
+    {
+        m_isMeasuredSizeIndexEnabled = isMeasuredSizeIndexEnabled;
+        m_measuredSizeIndex.Reset(isMeasuredSizeIndexEnabled ? itemCount : 0);
+        m_isMeasuredSizeIndexStale = false;
+    }
+    else if (m_isMeasuredSizeIndexStale)
+    {
+        m_measuredSizeIndex.Reset(itemCount);
+        m_isMeasuredSizeIndexStale = false;
+    }
+    else if (isMeasuredSizeIndexEnabled)
+    {
+        // Collection changes keep the index in sync. This only handles
+        // a new items source being set.
+        m_measuredSizeIndex.Resize(itemCount);
+    }
+}
+
+void FlowLayoutState::OnItemsSourceChanged(const winrt::NotifyCollectionChangedEventArgs& args)
+{
+    if (m_isMeasuredSizeIndexEnabled && !m_isMeasuredSizeIndexStale)
+    {
+        switch (args.Action())
+        {
+        case winrt::NotifyCollectionChangedAction::Add:
+            m_measuredSizeIndex.OnItemsAdded(args.NewStartingIndex(), args.NewItems().Size());
+            break;
+
+        case winrt::NotifyCollectionChangedAction::Replace:
+            m_measuredSizeIndex.OnItemsRemoved(args.OldStartingIndex(), args.OldItems().Size());
+            m_measuredSizeIndex.OnItemsAdded(args.NewStartingIndex(), args.NewItems().Size());
+            break;
+
+        case winrt::NotifyCollectionChangedAction::Remove:
+            m_measuredSizeIndex.OnItemsRemoved(args.OldStartingIndex(), args.OldItems().Size());
+            break;
+
+        case winrt::NotifyCollectionChangedAction::Reset:
+            // We do not know the count the changes after this one apply to, so they
+            // are ignored until OnMeasureStart resets the index to the new count.
+            m_measuredSizeIndex.Reset(0);
+            m_isMeasuredSizeIndexStale = true;
+            break;
+        }
+    }
+}
+
+void FlowLayoutState::RecordLineSize(int startIndex, int countInLine, double lineSize)
+{
+    if (m_isMeasuredSizeIndexEnabled && countInLine > 0)
+    {
+        const double itemShare = lineSize / countInLine;
+        const int endIndex = std::min(startIndex + countInLine, m_measuredSizeIndex.Count());
+        for (int index = std::max(0, startIndex); index < endIndex; index++)
+        {
+            m_measuredSizeIndex.Record(index, itemShare);
+        }
+    }
+}
@@ -5,6 +5,7 @@
 
 #include "FlowLayoutState.g.h"
 #include "FlowLayoutAlgorithm.h"
+#include "MeasuredSizeIndex.h"
 
 class FlowLayoutState :
     public ReferenceTracker<FlowLayoutState, winrt::implementation::FlowLayoutStateT, winrt::composing>
@@ -15,12 +16,20 @@ public:
         IFlowLayoutAlgorithmDelegates* callbacks);
     void UninitializeForContext(const winrt::VirtualizingLayoutContext& context);
     void OnLineArranged(int startIndex, int countInLine, double lineSize, const winrt::VirtualizingLayoutContext& context);
+    void OnMeasureStart(bool isMeasuredSizeIndexEnabled, int itemCount);
+    void OnItemsSourceChanged(const winrt::NotifyCollectionChangedEventArgs& args);
+    void RecordLineSize(int startIndex, int countInLine, double lineSize);
 
     ::FlowLayoutAlgorithm& FlowAlgorithm() { return m_flowAlgorithm; }
     double TotalLineSize() const { return m_totalLineSize; }
     int TotalLinesMeasured() const { return m_totalLinesMeasured; }
     double TotalItemsPerLine() const { return m_totalItemsPerLine; }
 
+    // Null unless the layout opted in through IsMeasuredSizeIndexEnabled. Each item
+    // of an arranged line is recorded with an equal share of the line size so that
+    // the offset of the first item of a line is the sum of the preceding lines.
+    MeasuredSizeIndex* MeasuredSizes() { return m_isMeasuredSizeIndexEnabled ? &m_measuredSizeIndex : nullptr; }
+
     winrt::Size SpecialElementDesiredSize() const { return m_specialElementDesiredSize; }
     void SpecialElementDesiredSize(winrt::Size value) { m_specialElementDesiredSize = value; }
 
@@ -32,5 +41,9 @@ private:
     int m_totalLinesMeasured{};
     double m_totalItemsPerLine{};
     winrt::Size m_specialElementDesiredSize{};
+    bool m_isMeasuredSizeIndexEnabled{};
+    // Set by a Reset of the collection until the next measure pass.
+    bool m_isMeasuredSizeIndexStale{};
+    MeasuredSizeIndex m_measuredSizeIndex{};
     static const int BufferSize = 100;
 };
\ No newline at end of file
@@ -0,0 +1,187 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include "pch.h"
+#include "IndexRangeSet.h"
+
+bool IndexRangeSet::Contains(int index) const
+{
+    const auto it = FirstEndingAtOrAfter(index);
+    return it != m_ranges.end() && it->Contains(index);
+}
+
+bool IndexRangeSet::Intersects(const IndexRange& range) const
+{
+    const auto it = FirstEndingAtOrAfter(range.Begin());
+    return it != m_ranges.end() && it->Begin() <= range.End();
+}
+
+int IndexRangeSet::First() const
+{
+    return m_ranges.empty() ? -1 : m_ranges.front().Begin();
+}
+
+int IndexRangeSet::IndexAt(int position) const
+{
+    MUX_ASSERT(position >= 0 && position < m_count);
+    EnsureStartPositions();
+
+    // Last range that starts at or before position.
+    const auto it = std::upper_bound(m_startPositions.begin(), m_startPositions.end(), position) - 1;
+    const auto& range = m_ranges[it - m_startPositions.begin()];
+    return range.Begin() + (position - *it);
+}
+
+int IndexRangeSet::Add(const IndexRange& range)
+{
+    // Every range that overlaps or touches the new range gets merged into it.
+    const auto first = std::lower_bound(m_ranges.begin(), m_ranges.end(), range.Begin(),
+        [](const IndexRange& item, int begin) { return item.End() < begin - 1; });
+    const auto last = std::find_if(first, m_ranges.end(),
+        [&range](const IndexRange& item) { return item.Begin() - 1 > range.End(); });
+
+    int alreadyInSet = 0;
+    int begin = range.Begin();
+    int end = range.End();
+    for (auto it = first; it != last; ++it)
+    {
+        alreadyInSet += Size(*it);
+        begin = std::min(begin, it->Begin());
+        end = std::max(end, it->End());
+    }
+
+    const IndexRange merged(begin, end);
+    const int added = Size(merged) - alreadyInSet;
+    if (added > 0)
+    {
+        m_ranges.insert(m_ranges.erase(first, last), merged);
+        m_count += added;
+        m_startPositionsAreValid = false;
+    }
+
+    return added;
+}
+
+int IndexRangeSet::Remove(const IndexRange& range)
+{
+    const auto first = FirstEndingAtOrAfter(range.Begin());
+    const auto last = std::find_if(first, m_ranges.end(),
+        [&range](const IndexRange& item) { return item.Begin() > range.End(); });
+
+    if (first == last)
+    {
+        return 0;
+    }
+
+    int removed = 0;
+    for (auto it = first; it != last; ++it)
+    {
+        removed += std::min(it->End(), range.End()) - std::max(it->Begin(), range.Begin()) + 1;
+    }
+
+    // Keep whatever sticks out on either side of the removed range.
+    std::vector<IndexRange> remaining;
+    if (first->Begin() < range.Begin())
+    {
+        remaining.emplace_back(first->Begin(), range.Begin() - 1);
+    }
+
+    if ((last - 1)->End() > range.End())
+    {
+        remaining.emplace_back(range.End() + 1, (last - 1)->End());
+    }
+
+    const auto insertAt = m_ranges.erase(first, last);
+    m_ranges.insert(insertAt, remaining.begin(), remaining.end());
+    m_count -= removed;
+    m_startPositionsAreValid = false;
+    return removed;
+}
+
+void IndexRangeSet::Clear()
+{
+    m_ranges.clear();
+    m_count = 0;
+    m_startPositionsAreValid = false;
+}
+
+bool IndexRangeSet::OnItemsAdded(int index, int count)
+{
+    auto it = FirstEndingAtOrAfter(index);
+    if (it == m_ranges.end())
+    {
+        return false;
+    }
+
+    // If the insertion point falls inside a range, split it and leave the left piece in place.
+    if (it->Begin() < index)
+    {
+        const IndexRange after(index, it->End());
+        *it = IndexRange(it->Begin(), index - 1);
+        it = m_ranges.insert(it + 1, after);
+    }
+
+    for (; it != m_ranges.end(); ++it)
+    {
+        *it = IndexRange(it->Begin() + count, it->End() + count);
+    }
+
+    m_startPositionsAreValid = false;
+    return true;
+}
+
+bool IndexRangeSet::OnItemsRemoved(int index, int count)
+{
+    const bool removedAny = Remove(IndexRange(index, index + count - 1)) > 0;
+
+    auto it = FirstEndingAtOrAfter(index);
+    if (it == m_ranges.end())
+    {
+        return removedAny;
+    }
+
+    for (auto shifted = it; shifted != m_ranges.end(); ++shifted)
+    {
+        MUX_ASSERT(shifted->Begin() >= index + count);
+        *shifted = IndexRange(shifted->Begin() - count, shifted->End() - count);
+    }
+
+    // Closing the gap can make the ranges on either side of it touch.
+    if (it != m_ranges.begin() && (it - 1)->End() + 1 == it->Begin())
+    {
+        const IndexRange merged((it - 1)->Begin(), it->End());
+        it = m_ranges.erase(it);
+        *(it - 1) = merged;
+    }
+
+    m_startPositionsAreValid = false;
+    return true;
+}
+
+std::vector<IndexRange>::iterator IndexRangeSet::FirstEndingAtOrAfter(int index)
+{
+    return std::lower_bound(m_ranges.begin(), m_ranges.end(), index,
+        [](const IndexRange& item, int value) { return item.End() < value; });
+}
+
+std::vector<IndexRange>::const_iterator IndexRangeSet::FirstEndingAtOrAfter(int index) const
+{
+    return std::lower_bound(m_ranges.begin(), m_ranges.end(), index,
+        [](const IndexRange& item, int value) { return item.End() < value; });
+}
+
+void IndexRangeSet::EnsureStartPositions() const
+{
+    if (!m_startPositionsAreValid)
+    {
+        m_startPositions.resize(m_ranges.size());
+        int position = 0;
+        for (size_t i = 0; i < m_ranges.size(); i++)
+        {
+            m_startPositions[i] = position;
+            position += Size(m_ranges[i]);
+        }
+
+        m_startPositionsAreValid = true;
+    }
+}
@@ -0,0 +1,53 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+#include "IndexRange.h"
+
+// Set of indices stored as a sorted list of disjoint, non adjacent ranges.
+// Overlapping and touching ranges get merged when they are added, so a
+// SelectAll is a single range no matter how many items there are. Lookups
+// are a binary search over the ranges.
+class IndexRangeSet final
+{
+public:
+    // Number of indices in the set.
+    int Count() const { return m_count; }
+    bool Empty() const { return m_ranges.empty(); }
+    const std::vector<IndexRange>& Ranges() const { return m_ranges; }
+
+    bool Contains(int index) const;
+    bool Intersects(const IndexRange& range) const;
+
+    // Smallest index in the set or -1 if the set is empty.
+    int First() const;
+    // Returns the position'th smallest index in the set.
+    int IndexAt(int position) const;
+
+    // Returns the number of indices that were not in the set before.
+    int Add(const IndexRange& range);
+    // Returns the number of indices that were removed from the set.
+    int Remove(const IndexRange& range);
+    void Clear();
+
+    // Shift the indices to account for items being inserted into or removed from
+    // the underlying collection. Returns true if any index in the set was affected.
+    bool OnItemsAdded(int index, int count);
+    bool OnItemsRemoved(int index, int count);
+
+private:
+    static int Size(const IndexRange& range) { return range.End() - range.Begin() + 1; }
+
+    // First range that ends at or after index.
+    std::vector<IndexRange>::iterator FirstEndingAtOrAfter(int index);
+    std::vector<IndexRange>::const_iterator FirstEndingAtOrAfter(int index) const;
+    void EnsureStartPositions() const;
+
+    std::vector<IndexRange> m_ranges;
+    int m_count{ 0 };
+
+    // m_startPositions[i] is the number of indices in the ranges before m_ranges[i].
+    // Only used for IndexAt, so it is built on demand.
+    mutable std::vector<int> m_startPositions;
+    mutable bool m_startPositionsAreValid{ false };
+};
@@ -7,6 +7,28 @@
 #include "ItemsRepeater.common.h"
 #include "InspectingDataSource.h"
 
+namespace
+{
+    // Returns the source as a read only view if it raises change notifications.
+    winrt::IVectorView<winrt::IInspectable> GetObservableVectorView(const winrt::IInspectable& source)
+    {
+        if (source.try_as<winrt::INotifyCollectionChanged>())
+        {
+            if (auto vectorView = source.try_as<winrt::IVectorView<winrt::IInspectable>>())
+            {
+                return vectorView;
+            }
+
+            if (auto bindableVectorView = source.try_as<winrt::IBindableVectorView>())
+            {
+                return reinterpret_cast<const winrt::IVectorView<winrt::IInspectable>&>(bindableVectorView);
+            }
+        }
+
+        return nullptr;
+    }
+}
+
 InspectingDataSource::InspectingDataSource(const winrt::IInspectable& source)
 {
     if (!source)
@@ -30,6 +52,14 @@ InspectingDataSource::InspectingDataSource(const winrt::IInspectable& source)
             m_vector.set(reinterpret_cast<const winrt::IVector<winrt::IInspectable>&>(bindableVector));
             ListenToCollectionChanges();
         }
+        else if (auto vectorView = GetObservableVectorView(source))
+        {
+            // Read only views that tell us when they change (e.g. over the native storage
+            // of the host) are used in place. Other views are copied like any iterable,
+            // since we would not know when their items change.
+            m_vectorView.set(vectorView);
+            ListenToCollectionChanges();
+        }
         else
         {
             auto iterable = source.try_as<winrt::IIterable<winrt::IInspectable>>();
@@ -64,12 +94,14 @@ InspectingDataSource::~InspectingDataSource()
 
 int32_t InspectingDataSource::GetSizeCore()
 {
-    return static_cast<int>(m_vector.get().Size());
+    return static_cast<int>(m_vector ? m_vector.get().Size() : m_vectorView.get().Size());
 }
 
 winrt::IInspectable InspectingDataSource::GetAtCore(int index)
 {
-    return m_vector.get().GetAt(static_cast<unsigned>(index));
+    return m_vector ?
+        m_vector.get().GetAt(static_cast<unsigned>(index)) :
+        m_vectorView.get().GetAt(static_cast<unsigned>(index));
 }
 
 bool InspectingDataSource::HasKeyIndexMappingCore()
@@ -106,10 +138,13 @@ int InspectingDataSource::IndexFromKeyCore(winrt::hstring const& id)
 int InspectingDataSource::IndexOf(winrt::IInspectable const& value)
 {
     int index = -1;
-    if (m_vector && value)
+    if (value)
     {
         auto v = static_cast<uint32_t>(-1);
-        if (m_vector.get().IndexOf(value, v))
+        const bool found = m_vector ?
+            m_vector.get().IndexOf(value, v) :
+            m_vectorView.get().IndexOf(value, v);
+        if (found)
         {
             index = static_cast<int>(v);
         }
@@ -149,14 +184,16 @@ void InspectingDataSource::UnListenToCollectionChanges()
 
 void InspectingDataSource::ListenToCollectionChanges()
 {
-    MUX_ASSERT(m_vector);
-    auto incc = m_vector.try_as<winrt::INotifyCollectionChanged>();
+    MUX_ASSERT(m_vector || m_vectorView);
+    auto incc = m_vector ?
+        m_vector.try_as<winrt::INotifyCollectionChanged>() :
+        m_vectorView.try_as<winrt::INotifyCollectionChanged>();
     if(incc)
     {
         m_eventToken = incc.CollectionChanged({ this, &InspectingDataSource::OnCollectionChanged });
         m_notifyCollectionChanged.set(incc);
     }
-    else
+    else if (m_vector)
     {
         auto bindableObservableVector = m_vector.try_as<winrt::IBindableObservableVector>();
         if (bindableObservableVector)
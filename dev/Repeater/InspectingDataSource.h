@@ -45,6 +45,9 @@ private:
         const winrt::Collections::IVectorChangedEventArgs& e);
 
     tracker_ref<winrt::Collections::IVector<winrt::IInspectable>> m_vector{ this };
+    // Read only sources that raise change notifications are used as is instead of
+    // being copied into m_vector. Exactly one of m_vector and m_vectorView is set.
+    tracker_ref<winrt::Collections::IVectorView<winrt::IInspectable>> m_vectorView{ this };
 
     // To unhook event from data source
     tracker_ref<winrt::INotifyCollectionChanged> m_notifyCollectionChanged{ this };
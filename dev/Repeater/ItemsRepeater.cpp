@@ -5,6 +5,7 @@
 #include <common.h>
 #include "ItemsRepeater.common.h"
 #include "ItemsRepeater.h"
+#include "ItemsSourceView.h"
 #include "RepeaterLayoutContext.h"
 #include "ChildrenInTabFocusOrderIterable.h"
 #include "SharedHelpers.h"
@@ -96,6 +97,9 @@ winrt::Size ItemsRepeater::MeasureOverride(winrt::Size const& availableSize)
         throw winrt::hresult_error(E_FAIL, L"Cannot run layout in the middle of a collection change.");
     }
 
+    // Changes batched by the ItemsSourceView are applied before layout reads any item by index.
+    FlushItemsSourceChanges();
+
     m_viewportManager->OnOwnerMeasuring();
 
     m_isLayoutInProgress = true;
@@ -212,6 +216,9 @@ winrt::Size ItemsRepeater::ArrangeOverride(winrt::Size const& finalSize)
         }
     }
 
+    // Phased work is prioritized by the arrange bounds of the elements.
+    m_viewManager.OnElementsArranged();
+
     m_viewportManager->OnOwnerArranged();
     m_animationManager.OnOwnerArranged();
 
@@ -234,6 +241,7 @@ int32_t ItemsRepeater::GetElementIndex(winrt::UIElement const& element)
 
 winrt::UIElement ItemsRepeater::TryGetElement(int index)
 {
+    FlushItemsSourceChanges();
     return GetElementFromIndexImpl(index);
 }
 
@@ -249,6 +257,7 @@ void ItemsRepeater::UnpinElement(winrt::UIElement const& element)
 
 winrt::UIElement ItemsRepeater::GetOrCreateElement(int index)
 {
+    FlushItemsSourceChanges();
     return GetOrCreateElementImpl(index);
 }
 
@@ -265,11 +274,13 @@ void ItemsRepeater::ClearElementImpl(const winrt::UIElement& element)
     // Clearing an element due to a collection change
     // is more strict in that pinned elements will be forcibly
     // unpinned and sent back to the view generator.
+    // Elements cleared while applying a batch of changes belong to removed items.
     const bool isClearedDueToCollectionChange =
-        IsProcessingCollectionChange() &&
+        m_isApplyingItemsSourceChangeBatch ||
+        (IsProcessingCollectionChange() &&
         (m_processingItemsSourceChange.get().Action() == winrt::NotifyCollectionChangedAction::Remove ||
             m_processingItemsSourceChange.get().Action() == winrt::NotifyCollectionChangedAction::Replace ||
-            m_processingItemsSourceChange.get().Action() == winrt::NotifyCollectionChangedAction::Reset);
+            m_processingItemsSourceChange.get().Action() == winrt::NotifyCollectionChangedAction::Reset));
 
     m_viewManager.ClearElement(element, isClearedDueToCollectionChange);
     m_viewportManager->OnElementCleared(element);
@@ -289,20 +300,7 @@ int ItemsRepeater::GetElementIndexImpl(const winrt::UIElement& element)
 
 winrt::UIElement ItemsRepeater::GetElementFromIndexImpl(int index)
 {
-    winrt::UIElement result = nullptr;
-
-    auto children = Children();
-    for (unsigned i = 0u; i < children.Size() && !result; ++i)
-    {
-        auto element = children.GetAt(i);
-        auto virtInfo = TryGetVirtualizationInfo(element);
-        if (virtInfo && virtInfo->IsRealized() && virtInfo->Index() == index)
-        {
-            result = element;
-        }
-    }
-
-    return result;
+    return m_viewManager.GetRealizedElement(index);
 }
 
 winrt::UIElement ItemsRepeater::GetOrCreateElementImpl(int index)
@@ -721,7 +719,28 @@ void ItemsRepeater::OnItemsSourceViewChanged(const winrt::IInspectable& sender,
     });
 
     m_animationManager.OnItemsSourceChanged(sender, args);
-    m_viewManager.OnItemsSourceChanged(sender, args);
+
+    // When the ItemsSourceView raises a batch of coalesced changes, the realized elements
+    // are moved to their final index on the first change and the others are skipped.
+    auto const itemsSourceView = winrt::get_self<::ItemsSourceView>(m_itemsSourceView.get());
+    auto const changeBatch = itemsSourceView->ProcessingChangeBatch();
+    if (changeBatch && !changeBatch->IsReset())
+    {
+        if (itemsSourceView->IsProcessingFirstChangeOfBatch())
+        {
+            m_isApplyingItemsSourceChangeBatch = true;
+            auto applyingBatch = gsl::finally([this]()
+            {
+                m_isApplyingItemsSourceChangeBatch = false;
+            });
+
+            m_viewManager.OnItemsSourceChangeBatch(*changeBatch);
+        }
+    }
+    else
+    {
+        m_viewManager.OnItemsSourceChanged(sender, args);
+    }
 
     if (auto layout = Layout())
     {
@@ -737,6 +756,20 @@ void ItemsRepeater::OnItemsSourceViewChanged(const winrt::IInspectable& sender,
     }
 }
 
+void ItemsRepeater::FlushItemsSourceChanges()
+{
+    // The pending changes get flushed on the next tick if they cannot be raised now.
+    if (m_isLayoutInProgress || IsProcessingCollectionChange())
+    {
+        return;
+    }
+
+    if (auto const itemsSourceView = m_itemsSourceView.get())
+    {
+        winrt::get_self<::ItemsSourceView>(itemsSourceView)->FlushCollectionChanges();
+    }
+}
+
 void ItemsRepeater::InvalidateMeasureForLayout(winrt::Layout const&, winrt::IInspectable const&)
 {
     InvalidateMeasure();
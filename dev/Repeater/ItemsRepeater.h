@@ -127,6 +127,7 @@ private:
     void OnAnimatorChanged(const winrt::ElementAnimator& oldValue, const winrt::ElementAnimator& newValue);
 
     void OnItemsSourceViewChanged(const winrt::IInspectable& sender, const winrt::NotifyCollectionChangedEventArgs& args);
+    void FlushItemsSourceChanges();
     void InvalidateMeasureForLayout(winrt::Layout const& sender, winrt::IInspectable const& args);
     void InvalidateArrangeForLayout(winrt::Layout const& sender, winrt::IInspectable const& args);
 
@@ -147,6 +148,8 @@ private:
     tracker_ref<winrt::IInspectable> m_layoutState{ this };
     // Value is different from null only while we are on the OnItemsSourceChanged call stack.
     tracker_ref<winrt::NotifyCollectionChangedEventArgs> m_processingItemsSourceChange{ this };
+    // True only while realized elements are moved to their index after a batch of changes.
+    bool m_isApplyingItemsSourceChangeBatch{ false };
 
     winrt::Size m_lastAvailableSize{};
     bool m_isLayoutInProgress{ false };
@@ -3,9 +3,11 @@
 
 #include <pch.h>
 #include <common.h>
+#include <BindableVector.h>
 #include "ItemsRepeater.common.h"
 #include "ItemsSourceView.h"
 #include "InspectingDataSource.h"
+#include "DispatcherHelper.h"
 
 #pragma region IDataSource
 
@@ -51,16 +53,205 @@ void ItemsSourceView::CollectionChanged(winrt::event_token const& token)
     m_collectionChangedEventSource.remove(token);
 }
 
+bool ItemsSourceView::IsCollectionChangeBatchingEnabled()
+{
+    return m_isCollectionChangeBatchingEnabled;
+}
+
+void ItemsSourceView::IsCollectionChangeBatchingEnabled(bool value)
+{
+    m_isCollectionChangeBatchingEnabled = value;
+    if (!value)
+    {
+        FlushCollectionChanges();
+    }
+}
+
 #pragma endregion
 
 #pragma region IDataSourceProtected
 
 void ItemsSourceView::OnItemsSourceChanged(winrt::NotifyCollectionChangedEventArgs const& args)
 {
+    if (m_isCollectionChangeBatchingEnabled && args.Action() != winrt::NotifyCollectionChangedAction::Move)
+    {
+        // Count follows the data even while the change is held back, so that it always
+        // matches the items GetAt returns.
+        m_cachedSize = GetSizeCore();
+        QueueCollectionChange(args);
+        return;
+    }
+
+    // Changes that cannot be batched are raised after the ones that are already pending.
+    FlushCollectionChanges();
     m_cachedSize = GetSizeCore();
     m_collectionChangedEventSource(*this, args);
 }
 
+void ItemsSourceView::FlushCollectionChanges()
+{
+    if (m_isProcessingChangeBatch)
+    {
+        return;
+    }
+
+    m_isFlushScheduled = false;
+    if (m_pendingChangeBatch.IsEmpty())
+    {
+        return;
+    }
+
+    std::swap(m_processingChangeBatch, m_pendingChangeBatch);
+    m_pendingChangeBatch.Clear();
+
+    m_isProcessingChangeBatch = true;
+    auto processingBatch = gsl::finally([this]()
+    {
+        m_isProcessingChangeBatch = false;
+        m_processingChangeIndex = -1;
+        m_processingChangeCount = 0;
+        m_processingChangeBatch.Clear();
+    });
+
+    RaiseChangeBatch();
+}
+
+#pragma endregion
+
+#pragma region Change batching
+
+namespace
+{
+    std::vector<winrt::IInspectable> GetItems(winrt::IBindableVector const& items)
+    {
+        std::vector<winrt::IInspectable> result;
+        if (items)
+        {
+            const auto size = items.Size();
+            result.reserve(size);
+            for (unsigned i = 0u; i < size; ++i)
+            {
+                result.push_back(items.GetAt(i));
+            }
+        }
+        return result;
+    }
+
+    winrt::IBindableVector MakeItems(std::vector<winrt::IInspectable> const& items)
+    {
+        auto result = winrt::make<Vector<winrt::IInspectable, MakeVectorParam<VectorFlag::Bindable>()>>();
+        for (auto const& item : items)
+        {
+            result.Append(item);
+        }
+        return result;
+    }
+}
+
+void ItemsSourceView::QueueCollectionChange(winrt::NotifyCollectionChangedEventArgs const& args)
+{
+    switch (args.Action())
+    {
+    case winrt::NotifyCollectionChangedAction::Add:
+        m_pendingChangeBatch.Insert(args.NewStartingIndex(), GetItems(args.NewItems()));
+        break;
+
+    case winrt::NotifyCollectionChangedAction::Remove:
+        m_pendingChangeBatch.Remove(args.OldStartingIndex(), GetItems(args.OldItems()));
+        break;
+
+    case winrt::NotifyCollectionChangedAction::Replace:
+        m_pendingChangeBatch.Replace(args.OldStartingIndex(), GetItems(args.OldItems()), GetItems(args.NewItems()));
+        break;
+
+    case winrt::NotifyCollectionChangedAction::Reset:
+        m_pendingChangeBatch.Reset();
+        break;
+
+    default:
+        MUX_ASSERT(false);
+        break;
+    }
+
+    ScheduleFlush();
+}
+
+void ItemsSourceView::ScheduleFlush()
+{
+    if (!m_isFlushScheduled && !m_pendingChangeBatch.IsEmpty())
+    {
+        m_isFlushScheduled = true;
+        DispatcherHelper{}.RunAsync([weakThis{ get_weak() }]()
+        {
+            if (auto strongThis = weakThis.get())
+            {
+                strongThis->FlushCollectionChanges();
+            }
+        }, true /* fallbackToThisThread */);
+    }
+}
+
+void ItemsSourceView::RaiseChangeBatch()
+{
+    m_processingChangeIndex = 0;
+    if (m_processingChangeBatch.IsReset())
+    {
+        m_processingChangeCount = 1;
+        m_collectionChangedEventSource(*this, winrt::NotifyCollectionChangedEventArgs(
+            winrt::NotifyCollectionChangedAction::Reset,
+            nullptr /* newItems */,
+            nullptr /* oldItems */,
+            -1 /* newIndex */,
+            -1 /* oldIndex */));
+        return;
+    }
+
+    // Edits are raised from the last one to the first one. That way each of them can be
+    // applied on its own without the previous ones moving the indices it refers to.
+    // Replaces are raised as such. Other edits that both remove and insert items are
+    // raised as a remove followed by an add at the same index.
+    auto const& edits = m_processingChangeBatch.Edits();
+    m_processingChangeCount = 0;
+    for (auto const& edit : edits)
+    {
+        m_processingChangeCount += !edit.IsReplace && !edit.Removed.empty() && !edit.Inserted.empty() ? 2 : 1;
+    }
+
+    for (auto edit = edits.rbegin(); edit != edits.rend(); ++edit)
+    {
+        if (edit->IsReplace)
+        {
+            RaiseChange(winrt::NotifyCollectionChangedAction::Replace, edit->Index, edit->Inserted, edit->Removed);
+            continue;
+        }
+
+        if (!edit->Removed.empty())
+        {
+            RaiseChange(winrt::NotifyCollectionChangedAction::Remove, edit->Index, {}, edit->Removed);
+        }
+
+        if (!edit->Inserted.empty())
+        {
+            RaiseChange(winrt::NotifyCollectionChangedAction::Add, edit->Index, edit->Inserted, {});
+        }
+    }
+}
+
+void ItemsSourceView::RaiseChange(
+    winrt::NotifyCollectionChangedAction action,
+    int index,
+    std::vector<winrt::IInspectable> const& newItems,
+    std::vector<winrt::IInspectable> const& oldItems)
+{
+    m_collectionChangedEventSource(*this, winrt::NotifyCollectionChangedEventArgs(
+        action,
+        newItems.empty() ? nullptr : MakeItems(newItems),
+        oldItems.empty() ? nullptr : MakeItems(oldItems),
+        newItems.empty() ? -1 : index,
+        oldItems.empty() ? -1 : index));
+    ++m_processingChangeIndex;
+}
+
 #pragma endregion
 
 #pragma region IDataSourceOverrides
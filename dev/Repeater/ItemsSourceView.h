@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "CollectionChangeBatch.h"
 #include "ItemsSourceView.g.h"
 
 class ItemsSourceView :
@@ -20,6 +21,9 @@ public:
 
     winrt::event_token CollectionChanged(winrt::NotifyCollectionChangedEventHandler const& value);
     void CollectionChanged(winrt::event_token const& token);
+
+    bool IsCollectionChangeBatchingEnabled();
+    void IsCollectionChangeBatchingEnabled(bool value);
 #pragma endregion
 
 #pragma region Consume API for internal use only.
@@ -31,9 +35,38 @@ public:
     virtual bool HasKeyIndexMappingCore();
     virtual winrt::hstring KeyFromIndexCore(int index);
     virtual int IndexFromKeyCore(winrt::hstring const& id);
+
+    // Raises the changes held back while batching is enabled. Consumers that are about
+    // to read items by index (e.g. ItemsRepeater before a layout pass) call this so that
+    // the indices they hold are in sync with the data.
+    void FlushCollectionChanges();
+
+    // Non-null while the changes of a batch are being raised. Every change of the batch
+    // is still raised as a regular CollectionChanged event (last edit first), consumers
+    // that can apply the whole batch at once do so on the first one and skip the others.
+    const CollectionChangeBatch<winrt::IInspectable>* ProcessingChangeBatch() const { return m_isProcessingChangeBatch ? &m_processingChangeBatch : nullptr; }
+    bool IsProcessingFirstChangeOfBatch() const { return m_isProcessingChangeBatch && m_processingChangeIndex == 0; }
+    bool IsProcessingLastChangeOfBatch() const { return m_isProcessingChangeBatch && m_processingChangeIndex == m_processingChangeCount - 1; }
 #pragma endregion
 
 private:
+    void QueueCollectionChange(winrt::NotifyCollectionChangedEventArgs const& args);
+    void RaiseChangeBatch();
+    void RaiseChange(
+        winrt::NotifyCollectionChangedAction action,
+        int index,
+        std::vector<winrt::IInspectable> const& newItems,
+        std::vector<winrt::IInspectable> const& oldItems);
+    void ScheduleFlush();
+
     event_source<winrt::NotifyCollectionChangedEventHandler> m_collectionChangedEventSource{ this };
     int m_cachedSize{ -1 };
+
+    bool m_isCollectionChangeBatchingEnabled{ false };
+    bool m_isFlushScheduled{ false };
+    bool m_isProcessingChangeBatch{ false };
+    int m_processingChangeIndex{ -1 };
+    int m_processingChangeCount{ 0 };
+    CollectionChangeBatch<winrt::IInspectable> m_pendingChangeBatch{};
+    CollectionChangeBatch<winrt::IInspectable> m_processingChangeBatch{};
 };
\ No newline at end of file
@@ -0,0 +1,209 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Records the measured major size of every item keyed by data index and answers
+// "offset of index i" and "index at offset y" in O(log n) using a Fenwick tree.
+// Items that have not been measured yet are accounted for with a caller provided
+// estimate, so the answers stay stable as more items get measured instead of
+// depending on which items happen to be in a fixed size sample.
+//
+// Collection changes shift the recorded sizes so that measurements are kept
+// across inserts and removes. The tree itself is rebuilt lazily (in O(n)) on the
+// next query after such a change.
+class MeasuredSizeIndex final
+{
+public:
+    int Count() const { return static_cast<int>(m_sizes.size()); }
+    int MeasuredCount() const { return m_measuredCount; }
+    double MeasuredTotal() const { return m_measuredTotal; }
+    double AverageMeasuredSize() const { return m_measuredCount > 0 ? m_measuredTotal / m_measuredCount : 0.0; }
+
+    bool IsMeasured(int index) const { return m_sizes[index] >= 0.0; }
+
+    // Throw away all the measurements.
+    void Reset(int count)
+    {
+        m_sizes.assign(count, Unmeasured);
+        m_measuredTotal = 0.0;
+        m_measuredCount = 0;
+        m_isTreeDirty = true;
+    }
+
+    // Grow or shrink at the end, keeping the measurements of the remaining items.
+    void Resize(int count)
+    {
+        if (count < Count())
+        {
+            OnItemsRemoved(count, Count() - count);
+        }
+        else if (count > Count())
+        {
+            OnItemsAdded(Count(), count - Count());
+        }
+    }
+
+    void Record(int index, double size)
+    {
+        const double previous = m_sizes[index];
+        if (previous == size)
+        {
+            return;
+        }
+
+        const bool wasMeasured = previous >= 0.0;
+        m_sizes[index] = size;
+        m_measuredTotal += size - (wasMeasured ? previous : 0.0);
+        m_measuredCount += wasMeasured ? 0 : 1;
+
+        if (!m_isTreeDirty)
+        {
+            const double sizeDelta = size - (wasMeasured ? previous : 0.0);
+            const int countDelta = wasMeasured ? 0 : 1;
+            for (int i = index + 1; i <= Count(); i += LowestBit(i))
+            {
+                m_sizeTree[i] += sizeDelta;
+                m_countTree[i] += countDelta;
+            }
+        }
+    }
+
+    void Invalidate(int index)
+    {
+        if (IsMeasured(index))
+        {
+            m_measuredTotal -= m_sizes[index];
+            m_measuredCount--;
+            m_sizes[index] = Unmeasured;
+            m_isTreeDirty = true;
+        }
+    }
+
+    // Sum of the sizes of the items before index. Every item (measured or not)
+    // is followed by spacing.
+    double OffsetOf(int index, double estimate, double spacing)
+    {
+        EnsureTree();
+        index = std::max(0, std::min(index, Count()));
+        double size = 0.0;
+        int measured = 0;
+        for (int i = index; i > 0; i -= LowestBit(i))
+        {
+            size += m_sizeTree[i];
+            measured += m_countTree[i];
+        }
+
+        return size + (index - measured) * estimate + index * spacing;
+    }
+
+    // Total size of all the items, without the spacing after the last one.
+    double TotalSize(double estimate, double spacing)
+    {
+        return Count() > 0 ? OffsetOf(Count(), estimate, spacing) - spacing : 0.0;
+    }
+
+    // Returns the index of the item that contains offset, clamped to the valid range.
+    int IndexAtOffset(double offset, double estimate, double spacing)
+    {
+        EnsureTree();
+        const int count = Count();
+        if (count == 0)
+        {
+            return -1;
+        }
+
+        int position = 0;
+        double remaining = offset;
+        int step = 1;
+        while (step * 2 <= count)
+        {
+            step *= 2;
+        }
+
+        for (; step > 0; step /= 2)
+        {
+            const int next = position + step;
+            if (next <= count)
+            {
+                // Node 'next' covers exactly the 'step' items before it.
+                const double nodeSize = m_sizeTree[next] + (step - m_countTree[next]) * estimate + step * spacing;
+                if (nodeSize <= remaining)
+                {
+                    position = next;
+                    remaining -= nodeSize;
+                }
+            }
+        }
+
+        return std::min(position, count - 1);
+    }
+
+    void OnItemsAdded(int index, int count)
+    {
+        MUX_ASSERT(index >= 0 && index <= Count());
+        m_sizes.insert(m_sizes.begin() + index, count, Unmeasured);
+        m_isTreeDirty = true;
+    }
+
+    void OnItemsRemoved(int index, int count)
+    {
+        MUX_ASSERT(index >= 0 && index + count <= Count());
+        for (int i = index; i < index + count; i++)
+        {
+            if (IsMeasured(i))
+            {
+                m_measuredTotal -= m_sizes[i];
+                m_measuredCount--;
+            }
+        }
+
+        m_sizes.erase(m_sizes.begin() + index, m_sizes.begin() + index + count);
+        m_isTreeDirty = true;
+    }
+
+private:
+    static int LowestBit(int i) { return i & (-i); }
+
+    void EnsureTree()
+    {
+        if (m_isTreeDirty)
+        {
+            // Linear time Fenwick construction: every node pushes its
+            // partial sums to its parent.
+            const int count = Count();
+            m_sizeTree.assign(count + 1, 0.0);
+            m_countTree.assign(count + 1, 0);
+            for (int i = 1; i <= count; i++)
+            {
+                if (m_sizes[i - 1] >= 0.0)
+                {
+                    m_sizeTree[i] += m_sizes[i - 1];
+                    m_countTree[i] += 1;
+                }
+
+                const int parent = i + LowestBit(i);
+                if (parent <= count)
+                {
+                    m_sizeTree[parent] += m_sizeTree[i];
+                    m_countTree[parent] += m_countTree[i];
+                }
+            }
+
+            m_isTreeDirty = false;
+        }
+    }
+
+    static constexpr double Unmeasured = -1.0;
+
+    std::vector<double> m_sizes;
+    std::vector<double> m_sizeTree;
+    std::vector<int> m_countTree;
+    double m_measuredTotal{};
+    int m_measuredCount{};
+    bool m_isTreeDirty{ true };
+};
@@ -3,11 +3,7 @@
 
 #pragma once
 
-enum class ScrollOrientation
-{
-    Vertical,
-    Horizontal
-};
+#include "ScrollOrientation.h"
 
 class OrientationBasedMeasures
 {
@@ -11,11 +11,21 @@
 #include "Phaser.h"
 
 Phaser::Phaser(ItemsRepeater* owner) :
-    m_owner(owner)
+    m_owner(owner),
+    m_pendingElements([](const ElementInfo& info) { return info.VirtInfo()->ArrangeBounds(); })
 {
     // ItemsRepeater is not fully constructed yet. Don't interact with it.
 }
 
+Phaser::~Phaser()
+{
+    // The scheduler holds on to a callback that captures this.
+    if (m_registeredForCallback)
+    {
+        BuildTreeScheduler::UnregisterWork(this);
+    }
+}
+
 void Phaser::PhaseElement(
     const winrt::UIElement& element,
     const winrt::com_ptr<VirtualizationInfo>& virtInfo)
@@ -62,25 +72,40 @@ void Phaser::PhaseElement(
 
     if (shouldPhase)
     {
-        // Insert at the top since we remove from bottom during DoPhasedWorkCallback. This keeps the ordering of items
-        // the same as the order in which items are realized.
-        m_pendingElements.insert(m_pendingElements.begin(), ElementInfo(element, virtInfo));
-        RegisterForCallback();
+        // Elements of the same phase and visibility are worked on in the order in which they are realized.
+        m_pendingElements.Push(virtInfo.get(), ElementInfo(element, virtInfo), nextPhase);
+
+        // The element is most likely not arranged yet, so until the owner is arranged (see OnOwnerArranged)
+        // rank it by where the owner is. Before the owner has a size and a viewport, it counts as visible.
+        const auto size = m_owner->RenderSize();
+        const auto origin = m_owner->LayoutOrigin();
+        const auto window = m_owner->VisibleWindow();
+        const winrt::Rect ownerBounds{ origin.X, origin.Y, size.Width, size.Height };
+        bool isVisible =
+            size.Width <= 0 || size.Height <= 0 ||
+            window.Width <= 0 || window.Height <= 0 ||
+            PendingElements::Intersects(ownerBounds, window);
+        double distanceFromViewport = isVisible ? 0.0 : PendingElements::DistanceFromWindow(ownerBounds, window);
+
+        // Adding an element can only make the front of the queue more important.
+        if (m_registeredForCallback)
+        {
+            nextPhase = std::min(nextPhase, m_registeredPhase);
+            isVisible = isVisible || m_registeredIsVisible;
+            distanceFromViewport = std::min(distanceFromViewport, m_registeredDistanceFromViewport);
+        }
+
+        RegisterForCallback(nextPhase, isVisible, distanceFromViewport);
     }
 }
 
-void Phaser::StopPhasing(const winrt::UIElement& element, const winrt::com_ptr<VirtualizationInfo>& virtInfo)
+void Phaser::StopPhasing(const winrt::UIElement& /*element*/, const winrt::com_ptr<VirtualizationInfo>& virtInfo)
 {
     // We need to remove the element from the pending elements list. We cannot just change the phase to -1
     // since it will get updated when the element gets recycled.
     if (virtInfo->DataTemplateComponent())
     {
-        auto it = std::find_if(m_pendingElements.begin(), m_pendingElements.end(), [&element](const ElementInfo& info) { return info.Element() == element; });
-
-        if (it != m_pendingElements.end())
-        {
-            m_pendingElements.erase(it);
-        }
+        m_pendingElements.Remove(virtInfo.get());
     }
 
     // Clean Phasing information for this item.
@@ -91,17 +116,15 @@ void Phaser::DoPhasedWorkCallback()
 {
     MarkCallbackRecieved();
 
-    if (!m_pendingElements.empty() && !BuildTreeScheduler::ShouldYield())
+    if (!m_pendingElements.Empty() && !BuildTreeScheduler::ShouldYield())
     {
-        const auto visibleWindow = m_owner->VisibleWindow();
-        SortElements(visibleWindow);
-        int currentIndex = static_cast<int>(m_pendingElements.size()) - 1;
+        m_pendingElements.UpdateWindow(m_owner->VisibleWindow());
         do
         {
-            auto info = m_pendingElements[currentIndex];
+            // Work on the visible elements first and go through them one phase at a time.
+            auto info = m_pendingElements.Pop().Value;
             auto element = info.Element();
             auto virtInfo = info.VirtInfo();
-            auto dataIndex = virtInfo->Index();
 
             int currentPhase = virtInfo->Phase();
             if (currentPhase > 0)
@@ -116,62 +139,65 @@ void Phaser::DoPhasedWorkCallback()
                 if (nextPhase > 0)
                 {
                     virtInfo->Phase(nextPhase);
-                    // If we are the first item or 
-                    // If the current items phase is higher than the next items phase, then move to the next item.
-                    if (currentIndex == 0 ||
-                        virtInfo->Phase() > m_pendingElements[currentIndex - 1].VirtInfo()->Phase())
-                    {
-                        currentIndex--;
-                    }
-                }
-                else
-                {
-                    m_pendingElements.erase(m_pendingElements.begin() + currentIndex);
-                    currentIndex--;
+                    // Goes to the back of the next phase's bucket, so the other elements get
+                    // to run the current phase first.
+                    m_pendingElements.Push(virtInfo.get(), info, nextPhase);
                 }
             }
             else
             {
                 throw winrt::hresult_error(E_FAIL, L"Cleared element found in pending list which is not expected");
             }
+        } while (!m_pendingElements.Empty() && !BuildTreeScheduler::ShouldYield());
+    }
 
-            auto pendingCount = static_cast<int>(m_pendingElements.size());
-            if (currentIndex == -1)
-            {
-                // Reached the top, start from the bottom again
-                currentIndex = pendingCount - 1;
-            }
-            else if (currentIndex > -1 && currentIndex < pendingCount - 1)
-            {
-                // If the next element is oustide the visible window and there are elements in the visible window
-                // go back to the visible window.
-                bool nextItemIsVisible = SharedHelpers::DoRectsIntersect(visibleWindow, m_pendingElements[currentIndex].VirtInfo()->ArrangeBounds());
-                if (!nextItemIsVisible)
-                {
-                    bool haveVisibleItems = SharedHelpers::DoRectsIntersect(visibleWindow, m_pendingElements[pendingCount - 1].VirtInfo()->ArrangeBounds());
-                    if (haveVisibleItems)
-                    {
-                        currentIndex = pendingCount - 1;
-                    }
-                }
-            }
-        } while (!m_pendingElements.empty() && !BuildTreeScheduler::ShouldYield());
+    if (!m_pendingElements.Empty())
+    {
+        RegisterForCallbackFromFront();
     }
+}
 
-    if (!m_pendingElements.empty())
+// The pending elements have their arrange bounds now, so rank this repeater by them rather than by
+// the estimate made when the elements were realized, and drop the callback if nothing is left.
+void Phaser::OnOwnerArranged()
+{
+    if (!m_pendingElements.Empty())
+    {
+        m_pendingElements.UpdateWindow(m_owner->VisibleWindow());
+        RegisterForCallbackFromFront();
+    }
+    else if (m_registeredForCallback)
     {
-        RegisterForCallback();
+        BuildTreeScheduler::UnregisterWork(this);
+        m_registeredForCallback = false;
     }
 }
 
-void Phaser::RegisterForCallback()
+void Phaser::RegisterForCallbackFromFront()
 {
-    if (!m_registeredForCallback)
+    const auto& front = m_pendingElements.Front();
+    RegisterForCallback(front.Phase, m_pendingElements.VisibleCount() > 0, front.Distance);
+}
+
+// Registers again whenever the rank of the most important pending element changes. The
+// scheduler replaces the work queued for this repeater and re-ranks it among the others.
+void Phaser::RegisterForCallback(int phase, bool isVisible, double distanceFromViewport)
+{
+    if (!m_registeredForCallback ||
+        phase != m_registeredPhase ||
+        isVisible != m_registeredIsVisible ||
+        distanceFromViewport != m_registeredDistanceFromViewport)
     {
-        MUX_ASSERT(!m_pendingElements.empty());
+        MUX_ASSERT(!m_pendingElements.Empty());
         m_registeredForCallback = true;
+        m_registeredPhase = phase;
+        m_registeredIsVisible = isVisible;
+        m_registeredDistanceFromViewport = distanceFromViewport;
         BuildTreeScheduler::RegisterWork(
-            m_pendingElements[m_pendingElements.size() - 1].VirtInfo()->Phase(), // Use the phase of the last one in the sorted list
+            this,
+            phase,
+            isVisible,
+            distanceFromViewport,
             [this]()
         {
             DoPhasedWorkCallback();
@@ -193,35 +219,3 @@ void Phaser::ValidatePhaseOrdering(int currentPhase, int nextPhase)
         throw winrt::hresult_error(E_FAIL, L"Phases are required to be monotonically increasing.");
     }
 }
-
-void Phaser::SortElements(const winrt::Rect& visibleWindow)
-{
-    // Sort in descending order (inVisibleWindow, phase)
-    std::sort(
-        m_pendingElements.begin(),
-        m_pendingElements.end(),
-        [visibleWindow](const auto& lhs, const auto& rhs)
-    {
-        const auto lhsBounds = lhs.VirtInfo()->ArrangeBounds();
-        const auto lhsIntersects = SharedHelpers::DoRectsIntersect(lhsBounds, visibleWindow);
-        const auto rhsBounds = rhs.VirtInfo()->ArrangeBounds();
-        const auto rhsIntersects = SharedHelpers::DoRectsIntersect(rhsBounds, visibleWindow);
-
-        if ((lhsIntersects && rhsIntersects) ||
-            (!lhsIntersects && !rhsIntersects))
-        {
-            // Both are in the visible window or both are not
-            return lhs.VirtInfo()->Phase() < rhs.VirtInfo()->Phase();
-        }
-        else if (lhsIntersects)
-        {
-            // Left is in visible window
-            return false;
-        }
-        else
-        {
-            return true;
-        }
-    }
-    );
-}
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "PhaserCore.h"
+
 class ItemsRepeater;
 
 struct ElementInfo
@@ -23,17 +25,25 @@ class Phaser final
 {
 public:
     Phaser(ItemsRepeater* owner);
+    ~Phaser();
     void PhaseElement(const winrt::UIElement& element, const winrt::com_ptr<VirtualizationInfo>& virtInfo);
     void StopPhasing(const winrt::UIElement& element, const winrt::com_ptr<VirtualizationInfo>& virtInfo);
+    void OnOwnerArranged();
 
 private:
+    using PendingElements = PhaserCore<VirtualizationInfo*, ElementInfo, winrt::Rect>;
+
     void DoPhasedWorkCallback();
-    void RegisterForCallback();
+    void RegisterForCallbackFromFront();
+    void RegisterForCallback(int phase, bool isVisible, double distanceFromViewport);
     void MarkCallbackRecieved();
-    void SortElements(const winrt::Rect& visibleWindow);
     static void ValidatePhaseOrdering(int currentPhase, int nextPhase);
 
     ItemsRepeater* m_owner{ nullptr };
-    std::vector<ElementInfo> m_pendingElements{};
+    PendingElements m_pendingElements;
     bool m_registeredForCallback{ false };
+    // How the work queued with BuildTreeScheduler is ranked, while registered.
+    int m_registeredPhase{ 0 };
+    bool m_registeredIsVisible{ false };
+    double m_registeredDistanceFromViewport{ 0.0 };
 };
@@ -0,0 +1,321 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+// Platform neutral queue of the elements that Phaser still has to run phases for. Elements
+// are kept in buckets per phase, one set of buckets for the elements in the visible window
+// and one for the rest, so the next element to work on (visible first, then lowest phase)
+// is found without looking at the other pending elements. Within a bucket elements are in
+// order of distance from the visible window, as of the last time the queue was re-keyed.
+//
+// Elements are classified against the window lazily, the next time the queue is looked at,
+// so that elements queued before they are arranged are classified by their arranged bounds.
+// Re-keying (re-classifying every pending element against the window) is O(n log n), so it
+// only happens when the window moves or resizes by more than a quarter of its size. Between
+// re-keys, elements near the edges of the window can be classified as of the old window.
+//
+// TKey identifies an element (the VirtualizationInfo in the control, an int in the headless
+// benchmarks) and TRect is any type with float X, Y, Width and Height members. Removal is
+// lazy: the stale entry stays in its bucket and is skipped when it comes up.
+template <typename TKey, typename TValue, typename TRect>
+class PhaserCore final
+{
+public:
+    explicit PhaserCore(const std::function<TRect(const TValue&)>& boundsOf) :
+        m_boundsOf(boundsOf)
+    {}
+
+    struct Entry
+    {
+        TKey Key;
+        TValue Value;
+        int Phase;
+        double Distance;
+        uint64_t Ticket;
+    };
+
+    int Count() const { return static_cast<int>(m_live.size()); }
+    bool Empty() const { return m_live.empty(); }
+    int VisibleCount() const { return m_visibleCount; }
+    int RekeyCount() const { return m_rekeyCount; }
+
+    // Queues value to run the given phase next, replacing anything queued for key before.
+    void Push(const TKey& key, const TValue& value, int phase)
+    {
+        const uint64_t ticket = m_nextTicket++;
+        auto& live = m_live[key];
+        if (live.Ticket != 0)
+        {
+            Forget(live);
+        }
+
+        live = LiveEntry{ ticket, false /* isVisible */, false /* isClassified */ };
+        m_unclassified.push_back(Entry{ key, value, phase, 0.0, ticket });
+
+        if (m_staleCount > 64 && m_staleCount > Count())
+        {
+            Compact();
+        }
+    }
+
+    void Remove(const TKey& key)
+    {
+        auto it = m_live.find(key);
+        if (it != m_live.end())
+        {
+            Forget(it->second);
+            m_live.erase(it);
+        }
+    }
+
+    // The most important pending element. The queue must not be empty.
+    const Entry& Front()
+    {
+        return FrontBucket().front();
+    }
+
+    Entry Pop()
+    {
+        auto& bucket = FrontBucket();
+        Entry entry = std::move(bucket.front());
+        bucket.pop_front();
+        auto it = m_live.find(entry.Key);
+        m_visibleCount -= it->second.IsVisible ? 1 : 0;
+        m_live.erase(it);
+        return entry;
+    }
+
+    // Re-keys the pending elements if window is far enough from the window used last time.
+    void UpdateWindow(const TRect& window)
+    {
+        if (!m_hasWindow || HasMovedPastThreshold(window))
+        {
+            m_window = window;
+            m_hasWindow = true;
+            Rekey();
+        }
+    }
+
+    void Clear()
+    {
+        m_live.clear();
+        m_unclassified.clear();
+        m_buckets[0].clear();
+        m_buckets[1].clear();
+        m_visibleCount = 0;
+        m_staleCount = 0;
+    }
+
+    // Gap between bounds and window; zero when they touch or overlap.
+    static double DistanceFromWindow(const TRect& bounds, const TRect& window)
+    {
+        const double dx = std::max({ 0.0f, window.X - (bounds.X + bounds.Width), bounds.X - (window.X + window.Width) });
+        const double dy = std::max({ 0.0f, window.Y - (bounds.Y + bounds.Height), bounds.Y - (window.Y + window.Height) });
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    // Same as SharedHelpers::DoRectsIntersect: empty rects never intersect anything.
+    static bool Intersects(const TRect& lhs, const TRect& rhs)
+    {
+        return
+            !(lhs.Width <= 0 || lhs.Height <= 0 || rhs.Width <= 0 || rhs.Height <= 0) &&
+            (rhs.X <= lhs.X + lhs.Width) &&
+            (rhs.X + rhs.Width >= lhs.X) &&
+            (rhs.Y <= lhs.Y + lhs.Height) &&
+            (rhs.Y + rhs.Height >= lhs.Y);
+    }
+
+private:
+    struct LiveEntry
+    {
+        uint64_t Ticket{};
+        bool IsVisible{};
+        bool IsClassified{};
+    };
+
+    using Bucket = std::deque<Entry>;
+
+    bool IsLive(const Entry& entry) const
+    {
+        auto it = m_live.find(entry.Key);
+        return it != m_live.end() && it->second.Ticket == entry.Ticket;
+    }
+
+    // The entry for live is about to be replaced or removed, leaving a stale entry behind.
+    void Forget(const LiveEntry& live)
+    {
+        m_visibleCount -= live.IsVisible ? 1 : 0;
+        m_staleCount++;
+    }
+
+    void Classify(Entry& entry, LiveEntry& live)
+    {
+        const TRect bounds = m_boundsOf(entry.Value);
+        const bool isVisible = !m_hasWindow || Intersects(bounds, m_window);
+        entry.Distance = isVisible ? 0.0 : DistanceFromWindow(bounds, m_window);
+        live.IsVisible = isVisible;
+        live.IsClassified = true;
+        m_visibleCount += isVisible ? 1 : 0;
+    }
+
+    void ClassifyQueued()
+    {
+        for (auto& entry : m_unclassified)
+        {
+            auto it = m_live.find(entry.Key);
+            if (it != m_live.end() && it->second.Ticket == entry.Ticket)
+            {
+                Classify(entry, it->second);
+                m_buckets[it->second.IsVisible ? 0 : 1][entry.Phase].push_back(std::move(entry));
+            }
+            else
+            {
+                m_staleCount--;
+            }
+        }
+
+        m_unclassified.clear();
+    }
+
+    // Returns the bucket holding the most important live entry, dropping the
+    // stale entries and empty buckets in front of it on the way.
+    Bucket& FrontBucket()
+    {
+        MUX_ASSERT(!Empty());
+        ClassifyQueued();
+        for (auto& buckets : m_buckets)
+        {
+            while (!buckets.empty())
+            {
+                auto it = buckets.begin();
+                auto& bucket = it->second;
+                while (!bucket.empty() && !IsLive(bucket.front()))
+                {
+                    bucket.pop_front();
+                    m_staleCount--;
+                }
+
+                if (!bucket.empty())
+                {
+                    return bucket;
+                }
+
+                buckets.erase(it);
+            }
+        }
+
+        MUX_ASSERT(false);
+        return m_buckets[1].begin()->second;
+    }
+
+    bool HasMovedPastThreshold(const TRect& window) const
+    {
+        const float thresholdX = m_window.Width / 4;
+        const float thresholdY = m_window.Height / 4;
+        return
+            std::abs(window.X - m_window.X) > thresholdX ||
+            std::abs(window.Y - m_window.Y) > thresholdY ||
+            std::abs(window.Width - m_window.Width) > thresholdX ||
+            std::abs(window.Height - m_window.Height) > thresholdY;
+    }
+
+    void Rekey()
+    {
+        std::vector<Entry> entries;
+        std::vector<bool> isVisible;
+        entries.reserve(m_live.size());
+        isVisible.reserve(m_live.size());
+        m_visibleCount = 0;
+        m_staleCount = 0;
+
+        const auto classifyIfLive = [this, &entries, &isVisible](Entry& entry)
+        {
+            auto it = m_live.find(entry.Key);
+            if (it != m_live.end() && it->second.Ticket == entry.Ticket)
+            {
+                Classify(entry, it->second);
+                isVisible.push_back(it->second.IsVisible);
+                entries.push_back(std::move(entry));
+            }
+        };
+
+        // Queued order: what was already classified, then what was queued since.
+        for (auto& buckets : m_buckets)
+        {
+            for (auto& pair : buckets)
+            {
+                for (auto& entry : pair.second)
+                {
+                    classifyIfLive(entry);
+                }
+            }
+
+            buckets.clear();
+        }
+
+        for (auto& entry : m_unclassified)
+        {
+            classifyIfLive(entry);
+        }
+
+        m_unclassified.clear();
+
+        // Sort positions rather than the entries themselves, which can be expensive to move.
+        // Stable so that elements at the same distance stay in the order they were queued.
+        std::vector<uint32_t> order(entries.size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&entries](uint32_t lhs, uint32_t rhs) { return entries[lhs].Distance < entries[rhs].Distance; });
+        for (const auto position : order)
+        {
+            m_buckets[isVisible[position] ? 0 : 1][entries[position].Phase].push_back(std::move(entries[position]));
+        }
+
+        m_rekeyCount++;
+    }
+
+    // Drops the stale entries without changing the order of the live ones.
+    void Compact()
+    {
+        m_unclassified.erase(
+            std::remove_if(m_unclassified.begin(), m_unclassified.end(), [this](const Entry& entry) { return !IsLive(entry); }),
+            m_unclassified.end());
+
+        for (auto& buckets : m_buckets)
+        {
+            for (auto it = buckets.begin(); it != buckets.end();)
+            {
+                auto& bucket = it->second;
+                bucket.erase(
+                    std::remove_if(bucket.begin(), bucket.end(), [this](const Entry& entry) { return !IsLive(entry); }),
+                    bucket.end());
+                it = bucket.empty() ? buckets.erase(it) : std::next(it);
+            }
+        }
+
+        m_staleCount = 0;
+    }
+
+    std::function<TRect(const TValue&)> m_boundsOf;
+    // Queued since the queue was last looked at, in the order they were queued.
+    std::vector<Entry> m_unclassified;
+    // [0] holds the elements in the visible window, [1] the rest. Each maps phase to bucket.
+    std::map<int, Bucket> m_buckets[2];
+    std::unordered_map<TKey, LiveEntry> m_live;
+    TRect m_window{};
+    bool m_hasWindow{ false };
+    uint64_t m_nextTicket{ 1 };
+    int m_visibleCount{};
+    int m_staleCount{};
+    int m_rekeyCount{};
+};
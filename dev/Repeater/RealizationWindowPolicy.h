@@ -0,0 +1,143 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+// Velocity-aware sizing of the cache buffer around the visible window.
+//
+// At rest the buffer is the symmetric one given by the cache length (half of
+// cacheLength * viewportSize on each side). While scrolling, the buffer grows with
+// the scroll speed and most of it moves to the side the viewport is heading to, so
+// the elements about to come into view are realized before they are needed. Once
+// no viewport change has been seen for IdleTimeoutInMs the velocity goes back to
+// zero and the buffer shrinks back to its resting size, which releases the extra
+// elements realized while scrolling.
+class RealizationWindowPolicy final
+{
+public:
+    // Buffer in pixels before (left/top) and after (right/bottom) the visible window along one axis.
+    struct Buffer
+    {
+        double Before{};
+        double After{};
+
+        bool operator==(const Buffer& other) const { return Before == other.Before && After == other.After; }
+        bool operator!=(const Buffer& other) const { return !(*this == other); }
+    };
+
+    // No viewport change for that long means scrolling stopped.
+    static constexpr double IdleTimeoutInMs = 150.0;
+    // Speed (in viewports per second) at which the buffer stops growing and skewing.
+    static constexpr double SaturationSpeedInViewportsPerSecond = 5.0;
+    // Size of the buffer at the saturation speed, relative to its size at rest.
+    static constexpr double MaximumSpeedScale = 2.0;
+    // Share of the buffer placed ahead of the visible window at the saturation speed.
+    static constexpr double MaximumLeadingShare = 0.85;
+    // Weight of the newest sample in the smoothed velocity.
+    static constexpr double VelocitySmoothing = 0.5;
+
+    double HorizontalVelocity() const { return m_horizontalVelocity; }
+    double VerticalVelocity() const { return m_verticalVelocity; }
+    bool IsScrolling() const { return m_horizontalVelocity != 0.0 || m_verticalVelocity != 0.0; }
+
+    void Reset()
+    {
+        m_hasPosition = false;
+        m_horizontalVelocity = 0.0;
+        m_verticalVelocity = 0.0;
+    }
+
+    // Records a new viewport. elapsedInMs is the time since the previous call.
+    // A change of the viewport size is a resize, not a scroll, so it only moves the reference position.
+    void OnViewportChanged(double x, double y, double width, double height, double elapsedInMs)
+    {
+        const bool isScroll =
+            m_hasPosition &&
+            width == m_width &&
+            height == m_height &&
+            elapsedInMs < IdleTimeoutInMs;
+
+        if (isScroll)
+        {
+            // Events raised within the same millisecond still count as taking one.
+            const double elapsed = std::max(elapsedInMs, 1.0);
+            m_horizontalVelocity = Smooth(m_horizontalVelocity, (x - m_x) / elapsed);
+            m_verticalVelocity = Smooth(m_verticalVelocity, (y - m_y) / elapsed);
+        }
+        else
+        {
+            m_horizontalVelocity = 0.0;
+            m_verticalVelocity = 0.0;
+        }
+
+        m_hasPosition = true;
+        m_x = x;
+        m_y = y;
+        m_width = width;
+        m_height = height;
+    }
+
+    // Called while scrolling with the time since the last viewport change.
+    // Returns true when that means scrolling just stopped.
+    bool OnIdle(double elapsedSinceLastChangeInMs)
+    {
+        if (IsScrolling() && elapsedSinceLastChangeInMs >= IdleTimeoutInMs)
+        {
+            m_horizontalVelocity = 0.0;
+            m_verticalVelocity = 0.0;
+            return true;
+        }
+
+        return false;
+    }
+
+    // How close the speed is to the saturation speed, from 0 (at rest) to 1.
+    static double SpeedFactor(double velocityInPixelsPerMs, double viewportSize)
+    {
+        if (viewportSize <= 0.0)
+        {
+            return 0.0;
+        }
+
+        const double viewportsPerSecond = std::abs(velocityInPixelsPerMs) * 1000.0 / viewportSize;
+        return std::min(viewportsPerSecond / SaturationSpeedInViewportsPerSecond, 1.0);
+    }
+
+    // Buffer to build up to along an axis. A positive velocity means the viewport moves
+    // toward the end of the axis, so the larger part of the buffer goes after it.
+    static Buffer TargetBuffer(double velocityInPixelsPerMs, double viewportSize, double cacheLength)
+    {
+        const double restingBufferPerSide = cacheLength * viewportSize / 2.0;
+        const double speedFactor = SpeedFactor(velocityInPixelsPerMs, viewportSize);
+        if (speedFactor == 0.0)
+        {
+            return Buffer{ restingBufferPerSide, restingBufferPerSide };
+        }
+
+        const double total = 2.0 * restingBufferPerSide * (1.0 + speedFactor * (MaximumSpeedScale - 1.0));
+        const double leading = total * (0.5 + speedFactor * (MaximumLeadingShare - 0.5));
+        const double trailing = total - leading;
+        return velocityInPixelsPerMs > 0.0 ?
+            Buffer{ trailing, leading } :
+            Buffer{ leading, trailing };
+    }
+
+private:
+    static double Smooth(double previous, double sample)
+    {
+        return VelocitySmoothing * sample + (1.0 - VelocitySmoothing) * previous;
+    }
+
+    bool m_hasPosition{ false };
+    double m_x{};
+    double m_y{};
+    double m_width{};
+    double m_height{};
+
+    // In pixels per millisecond.
+    double m_horizontalVelocity{};
+    double m_verticalVelocity{};
+};
@@ -0,0 +1,197 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include "ScrollOrientation.h"
+
+// Layout bounds of the realized range, stored as one float array per component
+// (X, Y, Width, Height) so that scans along an axis read contiguous memory and
+// can be vectorized.
+//
+// As the viewport moves, bounds are added and removed at either end of the range.
+// The arrays keep free room before and after the range so that this is O(1)
+// amortized and never shifts the rest of the range. When one end runs out of room
+// while the range fills at most half of the arrays, the range is moved back to the
+// middle instead of growing them, so scrolling in one direction keeps the capacity
+// at about twice the largest realized range. Inserting or erasing in the middle
+// (collection changes) shifts the shorter side.
+template <typename TRect>
+class RealizedBoundsBuffer final
+{
+public:
+    int Count() const { return m_end - m_begin; }
+    int Capacity() const { return static_cast<int>(m_x.size()); }
+
+    TRect At(int index) const
+    {
+        const int i = m_begin + index;
+        TRect rect{};
+        rect.X = m_x[i];
+        rect.Y = m_y[i];
+        rect.Width = m_width[i];
+        rect.Height = m_height[i];
+        return rect;
+    }
+
+    void SetAt(int index, const TRect& rect) { Store(m_begin + index, rect); }
+
+    // Start and size of the bounds along the scrolling axis of the given orientation.
+    // Both point to Count() values.
+    const float* Starts(const ScrollOrientation& orientation) const { return (orientation == ScrollOrientation::Vertical ? m_y : m_x).data() + m_begin; }
+    const float* Sizes(const ScrollOrientation& orientation) const { return (orientation == ScrollOrientation::Vertical ? m_height : m_width).data() + m_begin; }
+
+    void PushBack(const TRect& rect)
+    {
+        if (m_end == Capacity())
+        {
+            Grow();
+        }
+
+        Store(m_end++, rect);
+    }
+
+    void PushFront(const TRect& rect)
+    {
+        if (m_begin == 0)
+        {
+            Grow();
+        }
+
+        Store(--m_begin, rect);
+    }
+
+    void Insert(int index, const TRect& rect)
+    {
+        if (index < Count() / 2)
+        {
+            // Make room at the front and move the bounds before index down by one.
+            PushFront(rect);
+            Move(m_begin + 1, m_begin + index + 1, m_begin);
+        }
+        else
+        {
+            // Make room at the back and move the bounds from index up by one.
+            PushBack(rect);
+            MoveBackward(m_begin + index, m_end - 1, m_end);
+        }
+
+        Store(m_begin + index, rect);
+    }
+
+    void Erase(int index, int count)
+    {
+        const int countAfter = Count() - index - count;
+        if (index < countAfter)
+        {
+            MoveBackward(m_begin, m_begin + index, m_begin + index + count);
+            m_begin += count;
+        }
+        else
+        {
+            Move(m_begin + index + count, m_end, m_begin + index);
+            m_end -= count;
+        }
+
+        if (m_begin == m_end)
+        {
+            // Leave as much room on both sides for whichever direction comes next.
+            m_begin = m_end = Capacity() / 2;
+        }
+    }
+
+    // Used when everything is realized (non virtualizing context). New bounds are empty rects.
+    void Resize(int count)
+    {
+        if (m_begin + count > Capacity())
+        {
+            Reallocate(m_begin + count, m_begin);
+        }
+
+        for (int i = m_end; i < m_begin + count; ++i)
+        {
+            Store(i, TRect{});
+        }
+
+        m_end = m_begin + count;
+    }
+
+private:
+    static constexpr int MinimumCapacity = 64;
+
+    void Store(int i, const TRect& rect)
+    {
+        m_x[i] = rect.X;
+        m_y[i] = rect.Y;
+        m_width[i] = rect.Width;
+        m_height[i] = rect.Height;
+    }
+
+    void Grow()
+    {
+        const int count = Count();
+        if (Capacity() > 0 && count <= Capacity() / 2)
+        {
+            Recenter((Capacity() - count) / 2);
+            return;
+        }
+
+        const int capacity = std::max(MinimumCapacity, 2 * Capacity());
+        Reallocate(capacity, (capacity - count) / 2);
+    }
+
+    void Recenter(int begin)
+    {
+        const int count = Count();
+        if (begin < m_begin)
+        {
+            Move(m_begin, m_end, begin);
+        }
+        else
+        {
+            MoveBackward(m_begin, m_end, begin + count);
+        }
+
+        m_begin = begin;
+        m_end = begin + count;
+    }
+
+    void Reallocate(int capacity, int begin)
+    {
+        const int count = Count();
+        for (auto* component : { &m_x, &m_y, &m_width, &m_height })
+        {
+            std::vector<float> storage(capacity);
+            std::copy(component->begin() + m_begin, component->begin() + m_end, storage.begin() + begin);
+            component->swap(storage);
+        }
+
+        m_begin = begin;
+        m_end = begin + count;
+    }
+
+    void Move(int first, int last, int destination)
+    {
+        for (auto* component : { &m_x, &m_y, &m_width, &m_height })
+        {
+            std::copy(component->begin() + first, component->begin() + last, component->begin() + destination);
+        }
+    }
+
+    void MoveBackward(int first, int last, int destinationEnd)
+    {
+        for (auto* component : { &m_x, &m_y, &m_width, &m_height })
+        {
+            std::copy_backward(component->begin() + first, component->begin() + last, component->begin() + destinationEnd);
+        }
+    }
+
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_width;
+    std::vector<float> m_height;
+    int m_begin{ 0 };
+    int m_end{ 0 };
+};
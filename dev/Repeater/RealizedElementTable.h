@@ -0,0 +1,130 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+// Realized elements sorted by data index, so that index -> element lookups are
+// O(log n) and shifting the indices after a collection change only touches the
+// entries at or after the change.
+//
+// Entries are identified by an id (e.g. the element's VirtualizationInfo) since
+// more than one entry can have the same index for a while: an element that is
+// not recycled when its item is removed keeps its old index.
+template <typename TId, typename TValue>
+class RealizedElementTable final
+{
+public:
+    struct Entry
+    {
+        int Index;
+        TId Id;
+        TValue Value;
+    };
+
+    using const_iterator = typename std::vector<Entry>::const_iterator;
+
+    int Count() const { return static_cast<int>(m_entries.size()); }
+    const_iterator begin() const { return m_entries.begin(); }
+    const_iterator end() const { return m_entries.end(); }
+
+    // First entry with an index greater than or equal to index.
+    const_iterator LowerBound(int index) const
+    {
+        return std::lower_bound(m_entries.begin(), m_entries.end(), index,
+            [](const Entry& entry, int value) { return entry.Index < value; });
+    }
+
+    void Clear()
+    {
+        m_entries.clear();
+    }
+
+    void Add(int index, TId id, TValue value)
+    {
+        const auto position = UpperBound(index);
+        m_entries.insert(position, Entry{ index, id, std::move(value) });
+    }
+
+    bool Remove(int index, TId id)
+    {
+        const auto it = FindEntry(index, id);
+        if (it == m_entries.end())
+        {
+            return false;
+        }
+
+        m_entries.erase(it);
+        return true;
+    }
+
+    // Moves the entry to its new position with a rotation, so shifting a run of
+    // entries one by one (from the last to the first when moving them up, and
+    // from the first to the last when moving them down) is O(1) per entry after
+    // the lookup.
+    bool UpdateIndex(int oldIndex, int newIndex, TId id)
+    {
+        auto it = FindEntry(oldIndex, id);
+        if (it == m_entries.end())
+        {
+            return false;
+        }
+
+        it->Index = newIndex;
+        if (newIndex > oldIndex)
+        {
+            const auto position = std::upper_bound(it + 1, m_entries.end(), newIndex,
+                [](int value, const Entry& entry) { return value < entry.Index; });
+            std::rotate(it, it + 1, position);
+        }
+        else if (newIndex < oldIndex)
+        {
+            const auto position = std::upper_bound(m_entries.begin(), it, newIndex,
+                [](int value, const Entry& entry) { return value < entry.Index; });
+            std::rotate(position, it, it + 1);
+        }
+
+        return true;
+    }
+
+    // First entry with the given index for which predicate(entry) is true.
+    template <typename TPredicate>
+    const Entry* Find(int index, TPredicate&& predicate) const
+    {
+        for (auto it = LowerBound(index); it != m_entries.end() && it->Index == index; ++it)
+        {
+            if (predicate(*it))
+            {
+                return &*it;
+            }
+        }
+
+        return nullptr;
+    }
+
+private:
+    typename std::vector<Entry>::iterator UpperBound(int index)
+    {
+        return std::upper_bound(m_entries.begin(), m_entries.end(), index,
+            [](int value, const Entry& entry) { return value < entry.Index; });
+    }
+
+    typename std::vector<Entry>::iterator FindEntry(int index, TId id)
+    {
+        auto it = std::lower_bound(m_entries.begin(), m_entries.end(), index,
+            [](const Entry& entry, int value) { return entry.Index < value; });
+        for (; it != m_entries.end() && it->Index == index; ++it)
+        {
+            if (it->Id == id)
+            {
+                return it;
+            }
+        }
+
+        return m_entries.end();
+    }
+
+    std::vector<Entry> m_entries{};
+};
@@ -36,6 +36,26 @@ winrt::UIElement RecyclePool::TryGetElement(
     return TryGetElementCore(key, owner);
 }
 
+void RecyclePool::MaxElementsPerKey(int value)
+{
+    if (value < 0)
+    {
+        throw winrt::hresult_invalid_argument(L"MaxElementsPerKey cannot be negative.");
+    }
+
+    m_maxElementsPerKey = value;
+    if (m_maxElementsPerKey > 0)
+    {
+        for (auto& entry : m_elements)
+        {
+            while (entry.second.Count > m_maxElementsPerKey)
+            {
+                EvictOldest(entry.second);
+            }
+        }
+    }
+}
+
 #pragma endregion
 
 #pragma region IRecyclePoolOverrides
@@ -45,23 +65,23 @@ void RecyclePool::PutElementCore(
     winrt::hstring const& key,
     winrt::UIElement const& owner)
 {
+    auto winrtOwnerAsPanel = EnsureOwnerIsPanelOrNull(owner);
+    auto& bucket = m_elements[key];
 
-    const auto& winrtKey = key;
-    auto iterator = m_elements.find(winrtKey);
-    const auto& winrtOwner = owner;
-    auto winrtOwnerAsPanel = EnsureOwnerIsPanelOrNull(winrtOwner);
-
-    ElementInfo elementInfo{ this /* refManager */, element, winrtOwnerAsPanel };
-
-    if (iterator != m_elements.end())
+    auto ownerBucket = FindOwnerBucket(bucket, winrtOwnerAsPanel);
+    if (!ownerBucket)
     {
-        iterator->second.emplace_back(std::move(elementInfo));
+        ownerBucket = &bucket.Owners.emplace_back(this /* refManager */, winrtOwnerAsPanel);
     }
-    else
+
+    ownerBucket->Elements.emplace_back(this /* refManager */, element, m_nextSequence++);
+    bucket.Count++;
+    m_size++;
+    m_peakSize = std::max(m_peakSize, m_size);
+
+    if (m_maxElementsPerKey > 0 && bucket.Count > m_maxElementsPerKey)
     {
-        std::vector<ElementInfo> pool;
-        pool.emplace_back(elementInfo);
-        m_elements.emplace(winrtKey, std::move(pool));
+        EvictOldest(bucket);
     }
 }
 
@@ -70,60 +90,131 @@ winrt::UIElement RecyclePool::TryGetElementCore(
     winrt::UIElement const& owner)
 {
     auto iterator = m_elements.find(key);
-    if (iterator != m_elements.end())
+    if (iterator != m_elements.end() && iterator->second.Count > 0)
     {
-        auto& elements = iterator->second;
-        if (elements.size() > 0)
+        auto& bucket = iterator->second;
+        auto ownerAsPanel = EnsureOwnerIsPanelOrNull(owner);
+
+        // Prefer an element from the same owner, then one with no owner so that we don't
+        // incur the enter/leave cost during recycling. Otherwise take one from any owner.
+        OwnerBucket* ownerBucket = FindOwnerBucket(bucket, ownerAsPanel);
+        if (!ownerBucket && ownerAsPanel)
         {
-            ElementInfo elementInfo{ this /* refManager */, nullptr, nullptr };
-            // Prefer an element from the same owner or with no owner so that we don't incur
-            // the enter/leave cost during recycling.
-            // TODO: prioritize elements with the same owner to those without an owner.
-            const auto& winrtOwner = owner;
-            auto iter = std::find_if(
-                elements.begin(),
-                elements.end(),
-                [&winrtOwner](const ElementInfo& elemInfo) { return elemInfo.Owner() == winrtOwner || !elemInfo.Owner(); });
-
-            if (iter != elements.end())
-            {
-                elementInfo = *iter;
-                elements.erase(iter);
-            }
-            else
-            {
-                elementInfo = elements.back();
-                elements.pop_back();
-            }
+            ownerBucket = FindOwnerBucket(bucket, nullptr);
+        }
+
+        if (!ownerBucket)
+        {
+            // Owner buckets go away with their last element, so any of them will do.
+            MUX_ASSERT(!bucket.Owners.empty());
+            ownerBucket = &bucket.Owners.front();
+        }
 
-            auto ownerAsPanel = EnsureOwnerIsPanelOrNull(winrtOwner);
-            if (elementInfo.Owner() && elementInfo.Owner() != ownerAsPanel)
+        auto element = ownerBucket->Elements.back().Element();
+        auto elementOwner = ownerBucket->Owner();
+        ownerBucket->Elements.pop_back();
+        RemoveOwnerBucketIfEmpty(bucket, ownerBucket);
+        bucket.Count--;
+        m_size--;
+        m_hitCount++;
+
+        if (elementOwner && elementOwner != ownerAsPanel)
+        {
+            // Element is still under its parent. remove it from its parent.
+            if (!RemoveFromOwner(element, elementOwner))
             {
-                // Element is still under its parent. remove it from its parent.
-                auto panel = elementInfo.Owner();
-                if (panel)
-                {
-                    unsigned int childIndex = 0;
-                    bool found = panel.Children().IndexOf(elementInfo.Element(), childIndex);
-                    if (!found)
-                    {
-                        throw winrt::hresult_error(E_FAIL, L"ItemsRepeater's child not found in its Children collection.");
-                    }
-
-                    panel.Children().RemoveAt(childIndex);
-                }
+                throw winrt::hresult_error(E_FAIL, L"ItemsRepeater's child not found in its Children collection.");
             }
-
-            return elementInfo.Element();
         }
+
+        return element;
     }
 
+    m_missCount++;
     return nullptr;
 }
 
 
 #pragma endregion
 
+void RecyclePool::ResetCounters()
+{
+    m_hitCount = 0;
+    m_missCount = 0;
+    m_evictionCount = 0;
+    m_peakSize = m_size;
+}
+
+RecyclePool::OwnerBucket* RecyclePool::FindOwnerBucket(KeyBucket& bucket, const winrt::Panel& owner)
+{
+    for (auto& ownerBucket : bucket.Owners)
+    {
+        if (ownerBucket.Owner() == owner)
+        {
+            return &ownerBucket;
+        }
+    }
+
+    return nullptr;
+}
+
+void RecyclePool::RemoveOwnerBucketIfEmpty(KeyBucket& bucket, OwnerBucket* ownerBucket)
+{
+    // Don't hold on to owners that have nothing left in the pool.
+    if (ownerBucket->Elements.empty())
+    {
+        bucket.Owners.erase(bucket.Owners.begin() + (ownerBucket - bucket.Owners.data()));
+    }
+}
+
+void RecyclePool::EvictOldest(KeyBucket& bucket)
+{
+    OwnerBucket* oldest = nullptr;
+    for (auto& ownerBucket : bucket.Owners)
+    {
+        if (!ownerBucket.Elements.empty() &&
+            (!oldest || ownerBucket.Elements.front().Sequence() < oldest->Elements.front().Sequence()))
+        {
+            oldest = &ownerBucket;
+        }
+    }
+
+    MUX_ASSERT(oldest);
+    if (!oldest)
+    {
+        return;
+    }
+
+    auto element = oldest->Elements.front().Element();
+    auto owner = oldest->Owner();
+    oldest->Elements.pop_front();
+    RemoveOwnerBucketIfEmpty(bucket, oldest);
+    bucket.Count--;
+    m_size--;
+    m_evictionCount++;
+
+    // The owner keeps recycled elements as children until they get reused. Nobody is
+    // going to ask for this one anymore, so let it go. If the owner already let go of
+    // it, there is nothing left to do.
+    if (owner)
+    {
+        RemoveFromOwner(element, owner);
+    }
+}
+
+/* static */
+bool RecyclePool::RemoveFromOwner(const winrt::UIElement& element, const winrt::Panel& owner)
+{
+    unsigned int childIndex = 0;
+    const bool found = owner.Children().IndexOf(element, childIndex);
+    if (found)
+    {
+        owner.Children().RemoveAt(childIndex);
+    }
+
+    return found;
+}
+
 winrt::Panel RecyclePool::EnsureOwnerIsPanelOrNull(const winrt::UIElement& owner)
 {
     winrt::Panel ownerAsPanel = nullptr;
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <deque>
+#include <unordered_map>
+
 #include "RecyclePool.g.h"
 #include "RecyclePool.properties.h"
 
@@ -24,6 +27,9 @@ public:
     winrt::UIElement TryGetElement(
         winrt::hstring const& key,
         winrt::UIElement const& owner);
+
+    int MaxElementsPerKey() { return m_maxElementsPerKey; }
+    void MaxElementsPerKey(int value);
 #pragma endregion
 
 #pragma region IRecyclePoolOverrides
@@ -51,24 +57,74 @@ public:
     /* internal */
     static winrt::DependencyProperty GetOriginTemplateProperty() { return s_originTemplateProperty; };
 
+    // Counters exposed through RepeaterTestHooks.
+    int HitCount() const { return m_hitCount; }
+    int MissCount() const { return m_missCount; }
+    int EvictionCount() const { return m_evictionCount; }
+    int Size() const { return m_size; }
+    int PeakSize() const { return m_peakSize; }
+    void ResetCounters();
+
 private:
     static GlobalDependencyProperty s_reuseKeyProperty;
     static GlobalDependencyProperty s_originTemplateProperty;
 
     winrt::Panel EnsureOwnerIsPanelOrNull(const winrt::UIElement& owner);
+    // Returns false if the element is not a child of owner.
+    static bool RemoveFromOwner(const winrt::UIElement& element, const winrt::Panel& owner);
 
     struct ElementInfo
     {
-        ElementInfo(const ITrackerHandleManager* refManager, const winrt::UIElement& element, const winrt::Panel& owner)
-            :m_element(refManager, element), m_owner(refManager, owner) {}
+        ElementInfo(const ITrackerHandleManager* refManager, const winrt::UIElement& element, uint64_t sequence)
+            :m_element(refManager, element), m_sequence(sequence) {}
 
         winrt::UIElement Element() const { return m_element.get(); };
-        winrt::Panel Owner() const { return m_owner.get(); };
+        // Order in which the elements were put in the pool, used to find the oldest one.
+        uint64_t Sequence() const { return m_sequence; }
 
     private:
         tracker_ref<winrt::UIElement> m_element;
+        uint64_t m_sequence;
+    };
+
+    // Elements of one key that were recycled by the same owner (or without owner). A
+    // bucket is removed once it is empty so that the pool doesn't keep the owner alive.
+    // The most recently recycled element is at the back so that we hand out the
+    // elements that are most likely to still be warm, and evict from the front.
+    struct OwnerBucket
+    {
+        OwnerBucket(const ITrackerHandleManager* refManager, const winrt::Panel& owner)
+            :m_owner(refManager, owner) {}
+
+        winrt::Panel Owner() const { return m_owner.get(); };
+
+        std::deque<ElementInfo> Elements;
+
+    private:
         tracker_ref<winrt::Panel> m_owner;
     };
 
-    std::map<winrt::hstring /*key*/, std::vector<ElementInfo>> m_elements;
+    struct KeyBucket
+    {
+        // There are only ever a few owners (one per ItemsRepeater sharing the pool),
+        // so a linear search is cheaper than another level of hashing.
+        std::vector<OwnerBucket> Owners;
+        int Count{ 0 };
+    };
+
+    OwnerBucket* FindOwnerBucket(KeyBucket& bucket, const winrt::Panel& owner);
+    static void RemoveOwnerBucketIfEmpty(KeyBucket& bucket, OwnerBucket* ownerBucket);
+    void EvictOldest(KeyBucket& bucket);
+
+    std::unordered_map<winrt::hstring /*key*/, KeyBucket> m_elements;
+
+    // 0 means no limit.
+    int m_maxElementsPerKey{ 0 };
+    uint64_t m_nextSequence{ 0 };
+
+    int m_hitCount{ 0 };
+    int m_missCount{ 0 };
+    int m_evictionCount{ 0 };
+    int m_size{ 0 };
+    int m_peakSize{ 0 };
 };
@@ -7,6 +7,11 @@
 #include "layout.h"
 #include "ElementFactoryGetArgs.h"
 #include "ElementFactoryRecycleArgs.h"
+#include "RecyclePool.h"
+#include "QPCTimer.h"
+#include "BuildTreeScheduler.h"
+#include "ItemsRepeater.common.h"
+#include "ItemsRepeater.h"
 
 
 winrt::event_token RepeaterTestHooks::BuildTreeCompletedImpl(
@@ -67,4 +72,114 @@ void RepeaterTestHooks::SetLayoutId(winrt::IInspectable const& layout, const hst
     {
         instance->LayoutId(id);
     }
+}
+
+/* static */
+int RepeaterTestHooks::GetRecyclePoolHitCount(winrt::RecyclePool const& recyclePool)
+{
+    return winrt::get_self<RecyclePool>(recyclePool)->HitCount();
+}
+
+/* static */
+int RepeaterTestHooks::GetRecyclePoolMissCount(winrt::RecyclePool const& recyclePool)
+{
+    return winrt::get_self<RecyclePool>(recyclePool)->MissCount();
+}
+
+/* static */
+int RepeaterTestHooks::GetRecyclePoolEvictionCount(winrt::RecyclePool const& recyclePool)
+{
+    return winrt::get_self<RecyclePool>(recyclePool)->EvictionCount();
+}
+
+/* static */
+int RepeaterTestHooks::GetRecyclePoolSize(winrt::RecyclePool const& recyclePool)
+{
+    return winrt::get_self<RecyclePool>(recyclePool)->Size();
+}
+
+/* static */
+int RepeaterTestHooks::GetRecyclePoolPeakSize(winrt::RecyclePool const& recyclePool)
+{
+    return winrt::get_self<RecyclePool>(recyclePool)->PeakSize();
+}
+
+/* static */
+void RepeaterTestHooks::ResetRecyclePoolCounters(winrt::RecyclePool const& recyclePool)
+{
+    winrt::get_self<RecyclePool>(recyclePool)->ResetCounters();
+}
+
+// The scheduler is per thread, so these report on the calling (UI) thread.
+/* static */
+int RepeaterTestHooks::GetBuildTreeSchedulerQueueDepth()
+{
+    return BuildTreeScheduler::QueueDepth();
+}
+
+/* static */
+int RepeaterTestHooks::GetBuildTreeSchedulerPeakQueueDepth()
+{
+    return BuildTreeScheduler::PeakQueueDepth();
+}
+
+/* static */
+int RepeaterTestHooks::GetBuildTreeSchedulerDeferredWorkCount()
+{
+    return BuildTreeScheduler::DeferredWorkCount();
+}
+
+/* static */
+int RepeaterTestHooks::GetBuildTreeSchedulerCoalescedWorkCount()
+{
+    return BuildTreeScheduler::CoalescedWorkCount();
+}
+
+/* static */
+int RepeaterTestHooks::GetBuildTreeSchedulerFramesOverBudgetCount()
+{
+    return BuildTreeScheduler::FramesOverBudgetCount();
+}
+
+/* static */
+double RepeaterTestHooks::GetBuildTreeSchedulerBudgetInMs()
+{
+    return BuildTreeScheduler::BudgetInMs();
+}
+
+/* static */
+void RepeaterTestHooks::ResetBuildTreeSchedulerCounters()
+{
+    BuildTreeScheduler::ResetCounters();
+}
+
+// The windows are in layout coordinates, as seen by the layout through the context.
+/* static */
+winrt::Rect RepeaterTestHooks::GetVisibleWindow(winrt::ItemsRepeater const& repeater)
+{
+    return winrt::get_self<ItemsRepeater>(repeater)->VisibleWindow();
+}
+
+/* static */
+winrt::Rect RepeaterTestHooks::GetRealizationWindow(winrt::ItemsRepeater const& repeater)
+{
+    return winrt::get_self<ItemsRepeater>(repeater)->RealizationWindow();
+}
+
+/* static */
+int RepeaterTestHooks::GetRealizedElementHitCount(winrt::ItemsRepeater const& repeater)
+{
+    return winrt::get_self<ItemsRepeater>(repeater)->ViewManager().RealizedElementHitCount();
+}
+
+/* static */
+int RepeaterTestHooks::GetRealizedElementMissCount(winrt::ItemsRepeater const& repeater)
+{
+    return winrt::get_self<ItemsRepeater>(repeater)->ViewManager().RealizedElementMissCount();
+}
+
+/* static */
+void RepeaterTestHooks::ResetRealizedElementCounters(winrt::ItemsRepeater const& repeater)
+{
+    winrt::get_self<ItemsRepeater>(repeater)->ViewManager().ResetCounters();
 }
\ No newline at end of file
@@ -30,6 +30,27 @@ public:
     static hstring GetLayoutId(winrt::IInspectable const& layout);
     static void SetLayoutId(winrt::IInspectable const& layout, const hstring& id);
 
+    static int GetRecyclePoolHitCount(winrt::RecyclePool const& recyclePool);
+    static int GetRecyclePoolMissCount(winrt::RecyclePool const& recyclePool);
+    static int GetRecyclePoolEvictionCount(winrt::RecyclePool const& recyclePool);
+    static int GetRecyclePoolSize(winrt::RecyclePool const& recyclePool);
+    static int GetRecyclePoolPeakSize(winrt::RecyclePool const& recyclePool);
+    static void ResetRecyclePoolCounters(winrt::RecyclePool const& recyclePool);
+
+    static int GetBuildTreeSchedulerQueueDepth();
+    static int GetBuildTreeSchedulerPeakQueueDepth();
+    static int GetBuildTreeSchedulerDeferredWorkCount();
+    static int GetBuildTreeSchedulerCoalescedWorkCount();
+    static int GetBuildTreeSchedulerFramesOverBudgetCount();
+    static double GetBuildTreeSchedulerBudgetInMs();
+    static void ResetBuildTreeSchedulerCounters();
+
+    static winrt::Rect GetVisibleWindow(winrt::ItemsRepeater const& repeater);
+    static winrt::Rect GetRealizationWindow(winrt::ItemsRepeater const& repeater);
+    static int GetRealizedElementHitCount(winrt::ItemsRepeater const& repeater);
+    static int GetRealizedElementMissCount(winrt::ItemsRepeater const& repeater);
+    static void ResetRealizedElementCounters(winrt::ItemsRepeater const& repeater);
+
 private:
     static RepeaterTestHooks* s_testHooks;
 
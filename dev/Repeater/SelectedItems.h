@@ -5,6 +5,12 @@
 
 struct SelectedItemInfo;
 
+// Flat, read only view over the selected items of a SelectionModel. Nothing
+// is expanded up front: the view only keeps the selected nodes and how many
+// items are selected before each of them. GetAt finds the node and then the
+// range in that node with two binary searches, and the iterator walks the
+// ranges of each node in order. Memory scales with the number of selected
+// nodes, not with the number of selected items.
 template <typename T>
 class SelectedItems:
     public ReferenceTracker<SelectedItems<T>,
@@ -12,21 +18,17 @@ class SelectedItems:
         typename winrt::IIterable<T>>
 {
 public:
+    // getAtImpl maps a data index within the given node to the value exposed by the view.
     SelectedItems(const std::vector<SelectedItemInfo>& infos, 
-        std::function<T(const std::vector<SelectedItemInfo>& infos, unsigned int index)> getAtImpl)
+        std::function<T(const SelectedItemInfo& info, const std::shared_ptr<SelectionNode>& node, int dataIndex)> getAtImpl)
     {
         m_infos = infos;
         m_getAtImpl = getAtImpl;
+        m_startPositions.reserve(infos.size());
         for (auto& info: infos)
         {
-            if (auto node = info.Node.lock())
-            {
-                m_totalCount += node->SelectedCount();
-            }
-            else
-            {
-                throw winrt::hresult_error(E_FAIL, L"Selection changed after the SelectedIndices/Items property was read.");
-            }
+            m_startPositions.push_back(m_totalCount);
+            m_totalCount += LockNode(info)->SelectedCount();
         }
     }
 
@@ -43,7 +45,14 @@ public:
 
     T GetAt(uint32_t index)
     {
-        return m_getAtImpl(m_infos, index);
+        T item{ nullptr };
+        if (index < m_totalCount)
+        {
+            const auto cursor = CursorAt(index);
+            item = Resolve(cursor);
+        }
+
+        return item;
     }
 
     bool IndexOf(T const& value, uint32_t &index) noexcept
@@ -51,9 +60,22 @@ public:
         winrt::throw_hresult(E_NOTIMPL);
     }
 
-    uint32_t GetMany(uint32_t startIndex, winrt::array_view<T> const& values) noexcept
+    uint32_t GetMany(uint32_t startIndex, winrt::array_view<T> const& values)
     {
-        winrt::throw_hresult(E_NOTIMPL);
+        uint32_t howMany = 0;
+        if (startIndex < m_totalCount)
+        {
+            auto cursor = CursorAt(startIndex);
+            do
+            {
+                if (howMany >= values.size()) break;
+
+                values[howMany] = Resolve(cursor);
+                howMany++;
+            } while (MoveNext(cursor));
+        }
+
+        return howMany;
     }
 
 #pragma endregion
@@ -66,6 +88,86 @@ public:
 #pragma endregion
 
 private:
+    // Location of one selected item: the position in the flat view, which
+    // selected node it belongs to, which range of that node and the data index.
+    struct Cursor
+    {
+        uint32_t Position{ 0 };
+        size_t InfoIndex{ 0 };
+        size_t RangeIndex{ 0 };
+        int DataIndex{ -1 };
+    };
+
+    static std::shared_ptr<SelectionNode> LockNode(const SelectedItemInfo& info)
+    {
+        if (auto node = info.Node.lock())
+        {
+            return node;
+        }
+
+        throw winrt::hresult_error(E_FAIL, L"Selection changed after the SelectedIndices/Items property was read.");
+    }
+
+    Cursor CursorAt(uint32_t position)
+    {
+        MUX_ASSERT(position < m_totalCount);
+        Cursor cursor;
+        cursor.Position = position;
+        cursor.InfoIndex = (std::upper_bound(m_startPositions.begin(), m_startPositions.end(), position) - m_startPositions.begin()) - 1;
+
+        const auto node = LockNode(m_infos[cursor.InfoIndex]);
+        const int positionInNode = static_cast<int>(position - m_startPositions[cursor.InfoIndex]);
+        cursor.DataIndex = node->SelectedIndexAt(positionInNode);
+
+        const auto& ranges = node->SelectedRanges();
+        cursor.RangeIndex = std::lower_bound(ranges.begin(), ranges.end(), cursor.DataIndex,
+            [](const IndexRange& range, int dataIndex) { return range.End() < dataIndex; }) - ranges.begin();
+        return cursor;
+    }
+
+    // Moves the cursor to the next selected item. Returns false when the cursor
+    // was on the last one.
+    bool MoveNext(Cursor& cursor)
+    {
+        if (cursor.Position + 1 >= m_totalCount)
+        {
+            return false;
+        }
+
+        cursor.Position++;
+        const auto node = LockNode(m_infos[cursor.InfoIndex]);
+        const auto& ranges = node->SelectedRanges();
+        if (cursor.RangeIndex < ranges.size() && cursor.DataIndex < ranges[cursor.RangeIndex].End())
+        {
+            cursor.DataIndex++;
+        }
+        else if (cursor.RangeIndex + 1 < ranges.size())
+        {
+            cursor.RangeIndex++;
+            cursor.DataIndex = ranges[cursor.RangeIndex].Begin();
+        }
+        else
+        {
+            cursor.InfoIndex++;
+            cursor.RangeIndex = 0;
+            const auto& nextRanges = LockNode(m_infos[cursor.InfoIndex])->SelectedRanges();
+            if (nextRanges.empty())
+            {
+                throw winrt::hresult_error(E_FAIL, L"Selection changed after the SelectedIndices/Items property was read.");
+            }
+
+            cursor.DataIndex = nextRanges.front().Begin();
+        }
+
+        return true;
+    }
+
+    T Resolve(const Cursor& cursor)
+    {
+        const auto& info = m_infos[cursor.InfoIndex];
+        return m_getAtImpl(info, LockNode(info), cursor.DataIndex);
+    }
+
     class Iterator :
         public ReferenceTracker<Iterator, reference_tracker_implements_t<winrt::IIterator<T>>::type>
     {
@@ -73,6 +175,12 @@ private:
         Iterator(const winrt::IVectorView<T>& selectedItems)
         {
             m_selectedItems = selectedItems;
+            m_owner = winrt::get_self<SelectedItems<T>>(selectedItems);
+            if (m_owner->m_totalCount > 0)
+            {
+                m_cursor = m_owner->CursorAt(0);
+                m_hasCurrent = true;
+            }
         }
 
         ~Iterator()
@@ -82,10 +190,9 @@ private:
 
         T Current()
         {
-            auto items = m_selectedItems;
-            if(m_currentIndex < items.Size())
+            if (m_hasCurrent)
             {
-                return items.GetAt(m_currentIndex);
+                return m_owner->Resolve(m_cursor);
             }
             else
             {
@@ -95,15 +202,15 @@ private:
 
         bool HasCurrent()
         {
-            return (m_currentIndex < m_selectedItems.Size());
+            return m_hasCurrent;
         }
 
         bool MoveNext()
         {
-            if (m_currentIndex < m_selectedItems.Size())
+            if (m_hasCurrent)
             {
-                ++m_currentIndex;
-                return (m_currentIndex < m_selectedItems.Size());
+                m_hasCurrent = m_owner->MoveNext(m_cursor);
+                return m_hasCurrent;
             }
             else
             {
@@ -129,11 +236,16 @@ private:
         }
 
     private:
+        // m_selectedItems keeps m_owner alive.
         winrt::IVectorView<T> m_selectedItems{ nullptr };
-        unsigned int m_currentIndex = 0;
+        SelectedItems<T>* m_owner{ nullptr };
+        Cursor m_cursor{};
+        bool m_hasCurrent{ false };
     };
 
     std::vector<SelectedItemInfo> m_infos;
+    // Number of selected items in the nodes before m_infos[i].
+    std::vector<uint32_t> m_startPositions;
     unsigned int m_totalCount{ 0 };
-    std::function<T(const std::vector<SelectedItemInfo>& infos, int /*index*/)> m_getAtImpl;
+    std::function<T(const SelectedItemInfo& info, const std::shared_ptr<SelectionNode>& node, int dataIndex)> m_getAtImpl;
 };
\ No newline at end of file
@@ -171,37 +171,15 @@ winrt::IVectorView<winrt::IInspectable> SelectionModel::SelectedItems()
         }
 
         // Instead of creating a dumb vector that takes up the space for all the selected items,
-        // we create a custom VectorView implimentation that calls back using a delegate to find 
-        // the selected item at a particular index. This avoid having to create the storage and copying
-        // needed in a dumb vector. This also allows us to expose a tree of selected nodes into an 
-        // easier to consume flat vector view of objects.
+        // we create a custom VectorView implimentation that walks the selected ranges of each node
+        // and calls back using a delegate to get the item for a data index. This avoid having to 
+        // create the storage and copying needed in a dumb vector. This also allows us to expose a 
+        // tree of selected nodes into an easier to consume flat vector view of objects.
         auto selectedItems = winrt::make<::SelectedItems<winrt::IInspectable>>(
             selectedInfos,
-            [](const std::vector<SelectedItemInfo>& infos, unsigned int index) // callback for GetAt(index)
+            [](const SelectedItemInfo&, const std::shared_ptr<SelectionNode>& node, int dataIndex) // callback for GetAt(index)
         {
-            unsigned int currentIndex = 0;
-            winrt::IInspectable item{ nullptr };
-            for (auto& info : infos)
-            {
-                if (auto node = info.Node.lock())
-                {
-                    unsigned int currentCount = node->SelectedCount();
-                    if (index >= currentIndex && index < currentIndex + currentCount)
-                    {
-                        int targetIndex = node->SelectedIndices().at(index - currentIndex);
-                        item = node->ItemsSourceView().GetAt(targetIndex);
-                        break;
-                    }
-
-                    currentIndex += currentCount;
-                }
-                else
-                {
-                    throw winrt::hresult_error(E_FAIL, L"selection has changed since SelectedItems property was read.");
-                }
-            }
-
-            return item;
+            return node->ItemsSourceView().GetAt(dataIndex);
         });
         m_selectedItemsCached = selectedItems;
     }
@@ -226,37 +204,15 @@ winrt::IVectorView<winrt::IndexPath> SelectionModel::SelectedIndices()
         });
 
         // Instead of creating a dumb vector that takes up the space for all the selected indices,
-        // we create a custom VectorView implimentation that calls back using a delegate to find 
-        // the IndexPath at a particular index. This avoid having to create the storage and copying
-        // needed in a dumb vector. This also allows us to expose a tree of selected nodes into an 
-        // easier to consume flat vector view of IndexPaths.
+        // we create a custom VectorView implimentation that walks the selected ranges of each node
+        // and calls back using a delegate to build the IndexPath for a data index. This avoid having
+        // to create the storage and copying needed in a dumb vector. This also allows us to expose a 
+        // tree of selected nodes into an easier to consume flat vector view of IndexPaths.
         auto indices = winrt::make<::SelectedItems<winrt::IndexPath>>(
             selectedInfos,
-            [](const std::vector<SelectedItemInfo>& infos, unsigned int index) // callback for GetAt(index)
+            [](const SelectedItemInfo& info, const std::shared_ptr<SelectionNode>&, int dataIndex) // callback for GetAt(index)
         {
-            unsigned int currentIndex = 0;
-            winrt::IndexPath path{ nullptr };
-            for (auto& info : infos)
-            {
-                if (auto node = info.Node.lock())
-                {
-                    unsigned int currentCount = node->SelectedCount();
-                    if (index >= currentIndex && index < currentIndex + currentCount)
-                    {
-                        int targetIndex = node->SelectedIndices().at(index - currentIndex);
-                        path = winrt::get_self<IndexPath>(info.Path)->CloneWithChildIndex(targetIndex);
-                        break;
-                    }
-
-                    currentIndex += currentCount;
-                }
-                else
-                {
-                    throw winrt::hresult_error(E_FAIL, L"selection has changed since SelectedIndices property was read.");
-                }
-            }
-
-            return path;
+            return winrt::get_self<IndexPath>(info.Path)->CloneWithChildIndex(dataIndex);
         });
         m_selectedIndicesCached = indices;
     }
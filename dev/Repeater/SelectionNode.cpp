@@ -7,6 +7,7 @@
 #include "SelectionNode.h"
 #include "SelectionModel.h"
 #include "IndexPath.h"
+#include "ItemsSourceView.h"
 
 SelectionNode::SelectionNode(SelectionModel* manager, SelectionNode* parent) :
     m_manager(manager), m_parent(parent), m_source(manager), m_dataSource(manager)
@@ -44,7 +45,6 @@ void SelectionNode::Source(const winrt::IInspectable& value)
         m_dataSource.set(newDataSource);
 
         HookupCollectionChangedHandler();
-        OnSelectionChanged();
     }
 }
 
@@ -165,22 +165,12 @@ std::shared_ptr<SelectionNode> SelectionNode::GetAt(int index, bool realizeChild
 
 int SelectionNode::SelectedCount()
 {
-    return m_selectedCount;
+    return m_selected.Count();
 }
 
 bool SelectionNode::IsSelected(int index)
 {
-    bool isSelected = false;
-    for (auto& range : m_selected)
-    {
-        if (range.Contains(index))
-        {
-            isSelected = true;
-            break;
-        }
-    }
-
-    return isSelected;
+    return m_selected.Contains(index);
 }
 
 // True  -> Selected
@@ -233,7 +223,7 @@ winrt::IReference<bool> SelectionNode::IsSelectedWithPartial(int index)
 
 int SelectionNode::SelectedIndex()
 {
-    return SelectedCount() > 0 ? SelectedIndices().at(0) : -1;
+    return m_selected.First();
 }
 
 void SelectionNode::SelectedIndex(int value)
@@ -249,33 +239,43 @@ void SelectionNode::SelectedIndex(int value)
     }
 }
 
-std::vector<int> SelectionNode::SelectedIndices()
+// Returns the position'th selected index in increasing order without
+// expanding the selected ranges.
+int SelectionNode::SelectedIndexAt(int position)
+{
+    return m_selected.IndexAt(position);
+}
+
+const std::vector<IndexRange>& SelectionNode::SelectedRanges()
 {
-    if (!m_selectedIndicesCacheIsValid)
+    return m_selected.Ranges();
+}
+
+bool SelectionNode::Select(int index, bool select)
+{
+    if (IsValidIndex(index))
     {
-        m_selectedIndicesCacheIsValid = true;
-        for (auto& range : m_selected)
+        // Ignore duplicate selection calls
+        if (IsSelected(index) == select)
         {
-            for (int index = range.Begin(); index <= range.End(); index++)
-            {
-                // Avoid duplicates
-                if (std::find(m_selectedIndicesCached.begin(), m_selectedIndicesCached.end(), index) == m_selectedIndicesCached.end())
-                {
-                    m_selectedIndicesCached.emplace_back(index);
-                }
-            }
+            return true;
         }
 
-        // Sort the list for easy consumption
-        std::sort(m_selectedIndicesCached.begin(), m_selectedIndicesCached.end());
-    }
+        auto range = IndexRange(index, index);
 
-    return m_selectedIndicesCached;
-}
+        if (select)
+        {
+            m_selected.Add(range);
+        }
+        else
+        {
+            m_selected.Remove(range);
+        }
 
-bool SelectionNode::Select(int index, bool select)
-{
-    return Select(index, select, true /* raiseOnSelectionChanged */);
+        return true;
+    }
+
+    return false;
 }
 
 bool SelectionNode::ToggleSelect(int index)
@@ -306,11 +306,11 @@ bool SelectionNode::SelectRange(const IndexRange& range, bool select)
     {
         if (select)
         {
-            AddRange(range, true /* raiseOnSelectionChanged */);
+            m_selected.Add(range);
         }
         else
         {
-            RemoveRange(range, true /* raiseOnSelectionChanged */);
+            m_selected.Remove(range);
         }
 
         return true;
@@ -337,121 +337,10 @@ bool SelectionNode::IsValidIndex(int index)
     return (ItemsSourceView() == nullptr || (index >= 0 && index < ItemsSourceView().Count()));
 }
 
-void SelectionNode::AddRange(const IndexRange& addRange, bool raiseOnSelectionChanged)
-{
-    // TODO: Check for duplicates (Task 14107720)
-    // TODO: Optimize by merging adjacent ranges (Task 14107720)
-
-    int oldCount = SelectedCount();
-
-    for (int i = addRange.Begin(); i <= addRange.End(); i++)
-    {
-        if (!IsSelected(i))
-        {
-            m_selectedCount++;
-        }
-    }
-
-    if (oldCount != m_selectedCount)
-    {
-        m_selected.emplace_back(addRange);
-
-        if (raiseOnSelectionChanged)
-        {
-            OnSelectionChanged();
-        }
-    }
-}
-
-void SelectionNode::RemoveRange(const IndexRange& removeRange, bool raiseOnSelectionChanged)
-{
-    int oldCount = m_selectedCount;
-
-    // TODO: Prevent overlap of Ranges in _selected (Task 14107720)
-    for (int i = removeRange.Begin(); i <= removeRange.End(); i++)
-    {
-        if (IsSelected(i))
-        {
-            m_selectedCount--;
-        }
-    }
-
-    if (oldCount != m_selectedCount)
-    {
-        // Build up a both a list of Ranges to remove and ranges to add
-        std::vector<IndexRange> toRemove;
-        std::vector<IndexRange> toAdd;
-
-        for (IndexRange& range : m_selected)
-        {
-            // If this range intersects the remove range, we have to do something
-            if (removeRange.Intersects(range))
-            {
-                IndexRange before(-1, -1);
-                IndexRange cut(-1, -1);
-                IndexRange after(-1, -1);
-
-                // Intersection with the beginning of the range
-                //  Anything to the left of the point (exclusive) stays
-                //  Anything to the right of the point (inclusive) gets clipped
-                if (range.Contains(removeRange.Begin() - 1))
-                {
-                    range.Split(removeRange.Begin() - 1, before, cut);
-                    toAdd.emplace_back(before);
-                }
-
-                // Intersection with the end of the range
-                //  Anything to the left of the point (inclusive) gets clipped
-                //  Anything to the right of the point (exclusive) stays
-                if (range.Contains(removeRange.End()))
-                {
-                    if (range.Split(removeRange.End(), cut, after))
-                    {
-                        toAdd.emplace_back(after);
-                    }
-                }
-
-                // Remove this Range from the collection
-                // New ranges will be added for any remaining subsections
-                toRemove.emplace_back(range);
-            }
-        }
-
-        bool change = ((toRemove.size() > 0) || (toAdd.size() > 0));
-
-        if (change)
-        {
-            // Remove tagged ranges
-            for (IndexRange& remove : toRemove)
-            {
-                auto iter = std::find(m_selected.begin(), m_selected.end(), remove);
-                m_selected.erase(iter);
-            }
-
-            // Add new ranges
-            for (IndexRange& add : toAdd)
-            {
-                m_selected.emplace_back(add);
-            }
-
-            if (raiseOnSelectionChanged)
-            {
-                OnSelectionChanged();
-            }
-        }
-    }
-}
-
 void SelectionNode::ClearSelection()
 {
     // Deselect all items
-    if (m_selected.size() > 0)
-    {
-        m_selected.clear();
-        OnSelectionChanged();
-    }
-
-    m_selectedCount = 0;
+    m_selected.Clear();
     AnchorIndex(-1);
 
     // This will throw away all the children SelectionNodes
@@ -460,33 +349,6 @@ void SelectionNode::ClearSelection()
     m_childrenNodes.clear();
 }
 
-bool SelectionNode::Select(int index, bool select, bool raiseOnSelectionChanged)
-{
-    if (IsValidIndex(index))
-    {
-        // Ignore duplicate selection calls
-        if (IsSelected(index) == select)
-        {
-            return true;
-        }
-
-        auto range = IndexRange(index, index);
-
-        if (select)
-        {
-            AddRange(range, raiseOnSelectionChanged);
-        }
-        else
-        {
-            RemoveRange(range, raiseOnSelectionChanged);
-        }
-
-        return true;
-    }
-
-    return false;
-}
-
 void SelectionNode::OnSourceListChanged(const winrt::IInspectable& dataSource, const winrt::NotifyCollectionChangedEventArgs& args)
 {
     bool selectionInvalidated = false;
@@ -519,59 +381,34 @@ void SelectionNode::OnSourceListChanged(const winrt::IInspectable& dataSource, c
         }
     }
 
+    // The changes of a batch raised by the ItemsSourceView are reported as a single invalidation.
+    auto const itemsSourceView = winrt::get_self<ItemsSourceView>(m_dataSource.get());
+    if (itemsSourceView->ProcessingChangeBatch() && !itemsSourceView->IsProcessingLastChangeOfBatch())
+    {
+        m_isSelectionInvalidatedByChangeBatch |= selectionInvalidated;
+        return;
+    }
+
+    selectionInvalidated |= m_isSelectionInvalidatedByChangeBatch;
+    m_isSelectionInvalidatedByChangeBatch = false;
+
     if (selectionInvalidated)
     {
-        OnSelectionChanged();
         m_manager->OnSelectionInvalidatedDueToCollectionChange();
     }
 }
 
 bool SelectionNode::OnItemsAdded(int index, int count)
 {
-    bool selectionInvalidated = false;
-    // Update ranges for leaf items
-    std::vector<IndexRange> toAdd;
-    for (int i = 0; i < static_cast<int>(m_selected.size()); i++)
-    {
-        auto range = m_selected[i];
-
-        // The range is after the inserted items, need to shift the range right
-        if (range.End() >= index)
-        {
-            int begin = range.Begin();
-            // If the index left of newIndex is inside the range,
-            // Split the range and remember the left piece to add later
-            if (range.Contains(index - 1))
-            {
-                IndexRange before(-1, -1), after(-1, -1);
-                range.Split(index - 1, before, after);
-                toAdd.emplace_back(before);
-                begin = index;
-            }
-
-            // Shift the range to the right
-            m_selected[i] = IndexRange(begin + count, range.End() + count);
-            selectionInvalidated = true;
-        }
-    }
-
-    if (toAdd.size() > 0)
-    {
-        // Add the left sides of the split ranges
-        for (auto& add : toAdd)
-        {
-            m_selected.emplace_back(add);
-        }
-    }
+    // Update ranges for leaf items. Ranges after the inserted items get shifted
+    // right and a range containing the insertion point gets split.
+    bool selectionInvalidated = m_selected.OnItemsAdded(index, count);
 
     // Update for non-leaf if we are tracking non-leaf nodes
     if (m_childrenNodes.size() > 0)
     {
         selectionInvalidated = true;
-        for (int i = 0; i < count; i++)
-        {
-            m_childrenNodes.insert(m_childrenNodes.begin() + index, nullptr);
-        }
+        m_childrenNodes.insert(m_childrenNodes.begin() + index, count, nullptr);
     }
 
     //Adjust the anchor
@@ -610,49 +447,17 @@ bool SelectionNode::OnItemsRemoved(int index, int count)
     // Remove the items from the selection for leaf
     if (ItemsSourceView().Count() > 0)
     {
-        bool isSelected = false;
-        for (int i = index; i <= index + count - 1; i++)
-        {
-            if (IsSelected(i))
-            {
-                isSelected = true;
-                break;
-            }
-        }
-
-        if (isSelected)
-        {
-            RemoveRange(IndexRange(index, index + count - 1), false /* raiseOnSelectionChanged */);
-            selectionInvalidated = true;
-        }
-
-        for (int i = 0; i < static_cast<int>(m_selected.size()); i++)
-        {
-            auto range = m_selected[i];
-
-            // The range is after the removed items, need to shift the range left
-            if (range.End() > index)
-            {
-                MUX_ASSERT(!range.Contains(index));
-
-                // Shift the range to the left
-                m_selected[i] = IndexRange(range.Begin() - count, range.End() - count);
-                selectionInvalidated = true;
-            }
-        }
+        // Drops the removed items from the selection and shifts the ranges after them left.
+        selectionInvalidated = m_selected.OnItemsRemoved(index, count);
 
         // Update for non-leaf if we are tracking non-leaf nodes
         if (m_childrenNodes.size() > 0)
         {
             selectionInvalidated = true;
-            for (int i = 0; i < count; i++)
-            {
-                if (m_childrenNodes[index])
-                {
-                    m_realizedChildrenNodeCount--;
-                }
-                m_childrenNodes.erase(m_childrenNodes.begin() + index);
-            }
+            const auto begin = m_childrenNodes.begin() + index;
+            const auto end = begin + count;
+            m_realizedChildrenNodeCount -= static_cast<int>(std::count_if(begin, end, [](const auto& node) { return node != nullptr; }));
+            m_childrenNodes.erase(begin, end);
         }
 
         //Adjust the anchor
@@ -693,12 +498,6 @@ bool SelectionNode::OnItemsRemoved(int index, int count)
     return selectionInvalidated;
 }
 
-void SelectionNode::OnSelectionChanged()
-{
-    m_selectedIndicesCacheIsValid = false;
-    m_selectedIndicesCached.clear();
-}
-
 /* static */
 winrt::IReference<bool> SelectionNode::ConvertToNullableBool(SelectionState isSelected)
 {
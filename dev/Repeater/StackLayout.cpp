@@ -57,7 +57,7 @@ winrt::Size StackLayout::MeasureOverride(
     winrt::VirtualizingLayoutContext const& context,
     winrt::Size const& availableSize)
 {
-    GetAsStackState(context.LayoutState())->OnMeasureStart();
+    GetAsStackState(context.LayoutState())->OnMeasureStart(m_isMeasuredSizeIndexEnabled, context.ItemCount());
 
     auto desiredSize = GetFlowAlgorithm(context).Measure(
         availableSize,
@@ -91,6 +91,7 @@ void StackLayout::OnItemsChangedCore(
     winrt::IInspectable const& source,
     winrt::NotifyCollectionChangedEventArgs const& args)
 {
+    GetAsStackState(context.LayoutState())->OnItemsSourceChanged(args);
     GetFlowAlgorithm(context).OnItemsSourceChanged(source, args, context);
     // Always invalidate layout to keep the view accurate.
     InvalidateLayout();
@@ -127,9 +128,18 @@ winrt::FlowLayoutAnchorInfo StackLayout::GetAnchorForRealizationRect(
             // in the navigating direction.
             realizationWindowOffsetInExtent + realizationRect.*MajorSize() >= 0 && realizationWindowOffsetInExtent <= majorSize)
         {
-            anchorIndex = (int)(realizationWindowOffsetInExtent / averageElementSize);
-            offset = anchorIndex * averageElementSize + lastExtent.*MajorStart();
-            anchorIndex = std::max(0, std::min(itemsCount - 1, anchorIndex));
+            if (auto measuredSizes = state->MeasuredSizes())
+            {
+                const double estimate = averageElementSize - m_itemSpacing;
+                anchorIndex = measuredSizes->IndexAtOffset(std::max(0.0, realizationWindowOffsetInExtent), estimate, m_itemSpacing);
+                offset = measuredSizes->OffsetOf(anchorIndex, estimate, m_itemSpacing) + lastExtent.*MajorStart();
+            }
+            else
+            {
+                anchorIndex = (int)(realizationWindowOffsetInExtent / averageElementSize);
+                offset = anchorIndex * averageElementSize + lastExtent.*MajorStart();
+                anchorIndex = std::max(0, std::min(itemsCount - 1, anchorIndex));
+            }
         }
     }
 
@@ -155,16 +165,31 @@ winrt::Rect StackLayout::GetExtent(
     const auto stackState = GetAsStackState(context.LayoutState());
     const double averageElementSize = GetAverageElementSize(availableSize, context, stackState) + m_itemSpacing;
 
+    const auto measuredSizes = stackState->MeasuredSizes();
+    const double estimate = averageElementSize - m_itemSpacing;
+
     extent.*MinorSize() = static_cast<float>(stackState->MaxArrangeBounds());
-    extent.*MajorSize() = std::max(0.0f, static_cast<float>(itemsCount * averageElementSize - m_itemSpacing));
+    extent.*MajorSize() = measuredSizes ?
+        std::max(0.0f, static_cast<float>(measuredSizes->TotalSize(estimate, m_itemSpacing))) :
+        std::max(0.0f, static_cast<float>(itemsCount * averageElementSize - m_itemSpacing));
     if (itemsCount > 0)
     {
         if (firstRealized)
         {
             MUX_ASSERT(lastRealized);
-            extent.*MajorStart() = static_cast<float>(firstRealizedLayoutBounds.*MajorStart() - firstRealizedItemIndex * averageElementSize);
-            auto remainingItems = itemsCount - lastRealizedItemIndex - 1;
-            extent.*MajorSize() = MajorEnd(lastRealizedLayoutBounds) - extent.*MajorStart() + static_cast<float>(remainingItems* averageElementSize);
+            if (measuredSizes)
+            {
+                const double sizeBeforeFirst = measuredSizes->OffsetOf(firstRealizedItemIndex, estimate, m_itemSpacing);
+                const double sizeAfterLast = measuredSizes->OffsetOf(itemsCount, estimate, m_itemSpacing) - measuredSizes->OffsetOf(lastRealizedItemIndex + 1, estimate, m_itemSpacing);
+                extent.*MajorStart() = static_cast<float>(firstRealizedLayoutBounds.*MajorStart() - sizeBeforeFirst);
+                extent.*MajorSize() = MajorEnd(lastRealizedLayoutBounds) - extent.*MajorStart() + static_cast<float>(sizeAfterLast);
+            }
+            else
+            {
+                extent.*MajorStart() = static_cast<float>(firstRealizedLayoutBounds.*MajorStart() - firstRealizedItemIndex * averageElementSize);
+                auto remainingItems = itemsCount - lastRealizedItemIndex - 1;
+                extent.*MajorSize() = MajorEnd(lastRealizedLayoutBounds) - extent.*MajorStart() + static_cast<float>(remainingItems* averageElementSize);
+            }
         }
         else
         {
@@ -252,7 +277,10 @@ winrt::FlowLayoutAnchorInfo StackLayout::Algorithm_GetAnchorForTargetElement(
         index = targetIndex;
         const auto state = GetAsStackState(context.LayoutState());
         const double averageElementSize = GetAverageElementSize(availableSize, context, state) + m_itemSpacing;
-        offset = index * averageElementSize + state->FlowAlgorithm().LastExtent().*MajorStart();
+        const double offsetInExtent = state->MeasuredSizes() ?
+            state->MeasuredSizes()->OffsetOf(index, averageElementSize - m_itemSpacing, m_itemSpacing) :
+            index * averageElementSize;
+        offset = offsetInExtent + state->FlowAlgorithm().LastExtent().*MajorStart();
     }
 
     return winrt::FlowLayoutAnchorInfo{ index, offset };
@@ -316,6 +344,10 @@ void StackLayout::OnPropertyChanged(const winrt::DependencyPropertyChangedEventA
     {
         m_itemSpacing = unbox_value<double>(args.NewValue());
     }
+    else if (property == s_IsMeasuredSizeIndexEnabledProperty)
+    {
+        m_isMeasuredSizeIndexEnabled = unbox_value<bool>(args.NewValue());
+    }
 
     InvalidateLayout();
 }
@@ -339,7 +371,10 @@ double StackLayout::GetAverageElementSize(
         }
 
         MUX_ASSERT(stackLayoutState->TotalElementsMeasured() > 0);
-        averageElementSize = round(stackLayoutState->TotalElementSize() / stackLayoutState->TotalElementsMeasured());
+        const auto measuredSizes = stackLayoutState->MeasuredSizes();
+        averageElementSize = measuredSizes && measuredSizes->MeasuredCount() > 0 ?
+            round(measuredSizes->AverageMeasuredSize()) :
+            round(stackLayoutState->TotalElementSize() / stackLayoutState->TotalElementsMeasured());
     }
 
     return averageElementSize;
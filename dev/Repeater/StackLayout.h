@@ -118,6 +118,7 @@ private:
 
     // Fields
     double m_itemSpacing{};
+    bool m_isMeasuredSizeIndexEnabled{};
 
     // !!! WARNING !!!
     // Any storage here needs to be related to layout configuration. 
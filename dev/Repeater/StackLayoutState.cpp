@@ -41,9 +41,61 @@ void StackLayoutState::OnElementMeasured(int elementIndex, double majorSize, dou
     m_estimationBuffer[estimationBufferIndex] = majorSize;
 
     m_maxArrangeBounds = std::max(m_maxArrangeBounds, minorSize);
+
+    if (m_isMeasuredSizeIndexEnabled && elementIndex < m_measuredSizeIndex.Count())
+    {
+        m_measuredSizeIndex.Record(elementIndex, majorSize);
+    }
 }
 
-void StackLayoutState::OnMeasureStart()
+void StackLayoutState::OnMeasureStart(bool isMeasuredSizeIndexEnabled, int itemCount)
 {
     m_maxArrangeBounds = 0.0;
+
+    if (isMeasuredSizeIndexEnabled != m_isMeasuredSizeIndexEnabled)
+    {
+        m_isMeasuredSizeIndexEnabled = isMeasuredSizeIndexEnabled;
+        m_measuredSizeIndex.Reset(isMeasuredSizeIndexEnabled ? itemCount : 0);
+        m_isMeasuredSizeIndexStale = false;
+    }
+    else if (m_isMeasuredSizeIndexStale)
+    {
+        m_measuredSizeIndex.Reset(itemCount);
+        m_isMeasuredSizeIndexStale = false;
+    }
+    else if (isMeasuredSizeIndexEnabled)
+    {
+        // Collection changes keep the index in sync. This only handles
+        // a new items source being set.
+        m_measuredSizeIndex.Resize(itemCount);
+    }
+}
+
+void StackLayoutState::OnItemsSourceChanged(const winrt::NotifyCollectionChangedEventArgs& args)
+{
+    if (m_isMeasuredSizeIndexEnabled && !m_isMeasuredSizeIndexStale)
+    {
+        switch (args.Action())
+        {
+        case winrt::NotifyCollectionChangedAction::Add:
+            m_measuredSizeIndex.OnItemsAdded(args.NewStartingIndex(), args.NewItems().Size());
+            break;
+
+        case winrt::NotifyCollectionChangedAction::Replace:
+            m_measuredSizeIndex.OnItemsRemoved(args.OldStartingIndex(), args.OldItems().Size());
+            m_measuredSizeIndex.OnItemsAdded(args.NewStartingIndex(), args.NewItems().Size());
+            break;
+
+        case winrt::NotifyCollectionChangedAction::Remove:
+            m_measuredSizeIndex.OnItemsRemoved(args.OldStartingIndex(), args.OldItems().Size());
+            break;
+
+        case winrt::NotifyCollectionChangedAction::Reset:
+            // We do not know the count the changes after this one apply to, so they
+            // are ignored until OnMeasureStart resets the index to the new count.
+            m_measuredSizeIndex.Reset(0);
+            m_isMeasuredSizeIndexStale = true;
+            break;
+        }
+    }
 }
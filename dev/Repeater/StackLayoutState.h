@@ -5,6 +5,7 @@
 
 #include "StackLayoutState.g.h"
 #include "FlowLayoutAlgorithm.h"
+#include "MeasuredSizeIndex.h"
 
 class StackLayoutState :
     public ReferenceTracker<StackLayoutState, winrt::implementation::StackLayoutStateT, winrt::composing>
@@ -15,13 +16,17 @@ public:
         IFlowLayoutAlgorithmDelegates* callbacks);
     void UninitializeForContext(const winrt::VirtualizingLayoutContext& context);
     void OnElementMeasured(int elementIndex, double majorSize, double minorSize);
-    void OnMeasureStart();
+    void OnMeasureStart(bool isMeasuredSizeIndexEnabled, int itemCount);
+    void OnItemsSourceChanged(const winrt::NotifyCollectionChangedEventArgs& args);
 
     ::FlowLayoutAlgorithm& FlowAlgorithm() { return m_flowAlgorithm; }
     double TotalElementSize() const { return m_totalElementSize; }
     double MaxArrangeBounds() const { return m_maxArrangeBounds; }
     int TotalElementsMeasured() const { return m_totalElementsMeasured; }
 
+    // Null unless the layout opted in through IsMeasuredSizeIndexEnabled.
+    MeasuredSizeIndex* MeasuredSizes() { return m_isMeasuredSizeIndexEnabled ? &m_measuredSizeIndex : nullptr; }
+
 private:
     ::FlowLayoutAlgorithm m_flowAlgorithm{ this };
     std::vector<double> m_estimationBuffer{};
@@ -31,5 +36,9 @@ private:
     // is going to be used in the calculation of the extent.
     double m_maxArrangeBounds{};
     int m_totalElementsMeasured{};
+    bool m_isMeasuredSizeIndexEnabled{};
+    // Set by a Reset of the collection until the next measure pass.
+    bool m_isMeasuredSizeIndexStale{};
+    MeasuredSizeIndex m_measuredSizeIndex{};
     static const int BufferSize = 100;
 };
@@ -61,15 +61,17 @@ winrt::Size UniformGridLayout::MeasureOverride(
     auto gridState = GetAsGridState(context.LayoutState());
     gridState->EnsureElementSize(availableSize, context, m_minItemWidth, m_minItemHeight, m_itemsStretch, Orientation(), MinRowSpacing(), MinColumnSpacing(), m_maximumRowsOrColumns);
 
-    auto desiredSize = GetFlowAlgorithm(context).Measure(
+    // Every item has the same size, so the realized range and the element bounds are
+    // computed directly rather than generated from an anchor.
+    auto desiredSize = GetFlowAlgorithm(context).MeasureUniform(
         availableSize,
         context,
-        true, /* isWrapping*/
+        gridState->EffectiveItemWidth(),
+        gridState->EffectiveItemHeight(),
         MinItemSpacing(),
         LineSpacing(),
         m_maximumRowsOrColumns /* maxItemsPerLine */,
         OrientationBasedMeasures::GetScrollOrientation(),
-        false /* disableVirtualization */,
         LayoutId());
 
     // If after Measure the first item is in the realization rect, then we revoke grid state's ownership,
@@ -0,0 +1,229 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include "FlowLayoutAlgorithmCore.h"
+
+// Closed form realization for layouts where every item has the same size (UniformGridLayout).
+// Item i sits in line i / itemsPerLine at a fixed offset from the origin of the extent, so the
+// range of items intersecting the realization window and their bounds are computed directly
+// instead of generating lines one element at a time from an anchor. Each pass only realizes
+// and measures the items entering the window and recycles the ones leaving it. The bounds of
+// the items that stay realized are left alone unless the item size or the number of items per
+// line changed.
+//
+// Lines are realized whole: the minor extent of the realization window is not used to cull
+// items within a line.
+//
+// This works on the same realized range as FlowLayoutAlgorithmCore, so the two can be used on
+// alternate passes as long as Invalidate is called after the generic algorithm laid elements out.
+// TPolicy must provide, on top of what FlowLayoutAlgorithmCore needs:
+//   int FirstRealizedDataIndex();
+//   void ClearRealizedRange(int realizedIndex, int count);
+template <typename TPolicy>
+class UniformGridLayoutCore : public OrientationBasedMeasuresCore<typename TPolicy::Rect, typename TPolicy::Size>
+{
+public:
+    using Rect = typename TPolicy::Rect;
+    using Size = typename TPolicy::Size;
+    using Measures = OrientationBasedMeasuresCore<Rect, Size>;
+    using Measures::Minor;
+    using Measures::Major;
+    using Measures::MinorSize;
+    using Measures::MajorSize;
+    using Measures::MinorStart;
+    using Measures::MajorStart;
+    using Measures::GetScrollOrientation;
+
+    explicit UniformGridLayoutCore(TPolicy& policy) : m_policy(policy) { }
+
+    // Forgets the origin and the bounds of the realized elements, for example
+    // because another algorithm laid them out.
+    void Invalidate() { m_isValid = false; }
+    bool IsValid() const { return m_isValid; }
+
+    int ItemsPerLine() const { return m_itemsPerLine; }
+    float OriginMinor() const { return m_originMinor; }
+    float OriginMajor() const { return m_originMajor; }
+
+    // Same rounding as UniformGridLayout: as many items as fit, at least one, at most maxItemsPerLine.
+    static int GetItemsPerLine(float availableSizeMinor, float minorSizeWithSpacing, unsigned int maxItemsPerLine)
+    {
+        return static_cast<int>(std::min( // note use of unsigned ints
+            std::max(1u, static_cast<unsigned int>(availableSizeMinor / minorSizeWithSpacing)),
+            std::max(1u, maxItemsPerLine)));
+    }
+
+    Rect GetLayoutRectForDataIndex(int index) const
+    {
+        const int lineIndex = index / m_itemsPerLine;
+        const int indexInLine = index - (lineIndex * m_itemsPerLine);
+
+        Rect bounds{};
+        bounds.*MinorStart() = indexInLine * m_minorSizeWithSpacing + m_originMinor;
+        bounds.*MajorStart() = lineIndex * m_majorSizeWithSpacing + m_originMajor;
+        bounds.*MinorSize() = m_itemMinorSize;
+        bounds.*MajorSize() = m_itemMajorSize;
+        return bounds;
+    }
+
+    // Gets the [first, last] data indices of the lines intersecting the window.
+    // Returns false if no line does.
+    bool GetIndexRangeForWindow(const Rect& window, int itemCount, int& first, int& last) const
+    {
+        first = -1;
+        last = -1;
+        if (itemCount <= 0 || window.*MajorSize() <= 0)
+        {
+            return false;
+        }
+
+        const int lineCount = (itemCount + m_itemsPerLine - 1) / m_itemsPerLine;
+        const double windowStart = static_cast<double>(window.*MajorStart()) - m_originMajor;
+        const double windowEnd = windowStart + window.*MajorSize();
+        const double firstLine = std::floor(windowStart / m_majorSizeWithSpacing);
+        const double lastLine = std::ceil(windowEnd / m_majorSizeWithSpacing) - 1;
+        if (lastLine < 0 || firstLine > lineCount - 1)
+        {
+            return false;
+        }
+
+        const int firstLineIndex = static_cast<int>(std::max(0.0, firstLine));
+        const int lastLineIndex = static_cast<int>(std::min(static_cast<double>(lineCount - 1), lastLine));
+        if (firstLineIndex > lastLineIndex)
+        {
+            return false;
+        }
+
+        first = firstLineIndex * m_itemsPerLine;
+        last = std::min(itemCount - 1, (lastLineIndex + 1) * m_itemsPerLine - 1);
+        return true;
+    }
+
+    // Brings the realized range to the lines intersecting the realization window.
+    // originMinor/originMajor are only used when starting from an invalid state;
+    // after that the origin stays put so that rounding errors do not accumulate.
+    // Returns the number of elements that were realized.
+    int Measure(
+        const Size& availableSize,
+        double itemWidth,
+        double itemHeight,
+        double minItemSpacing,
+        double lineSpacing,
+        unsigned int maxItemsPerLine,
+        float originMinor,
+        float originMajor)
+    {
+        const bool isVertical = GetScrollOrientation() == ScrollOrientation::Vertical;
+        const float itemMinorSize = static_cast<float>(isVertical ? itemWidth : itemHeight);
+        const float itemMajorSize = static_cast<float>(isVertical ? itemHeight : itemWidth);
+        const float minorSizeWithSpacing = static_cast<float>((isVertical ? itemWidth : itemHeight) + minItemSpacing);
+        const float majorSizeWithSpacing = static_cast<float>((isVertical ? itemHeight : itemWidth) + lineSpacing);
+        const int itemsPerLine = GetItemsPerLine(availableSize.*Minor(), minorSizeWithSpacing, maxItemsPerLine);
+
+        const bool isLayoutChanged =
+            !m_isValid ||
+            itemMinorSize != m_itemMinorSize ||
+            itemMajorSize != m_itemMajorSize ||
+            minorSizeWithSpacing != m_minorSizeWithSpacing ||
+            majorSizeWithSpacing != m_majorSizeWithSpacing ||
+            itemsPerLine != m_itemsPerLine;
+
+        if (!m_isValid)
+        {
+            m_originMinor = originMinor;
+            m_originMajor = originMajor;
+            m_isValid = true;
+        }
+
+        m_itemMinorSize = itemMinorSize;
+        m_itemMajorSize = itemMajorSize;
+        m_minorSizeWithSpacing = minorSizeWithSpacing;
+        m_majorSizeWithSpacing = majorSizeWithSpacing;
+        m_itemsPerLine = itemsPerLine;
+
+        int first = -1;
+        int last = -1;
+        if (!GetIndexRangeForWindow(m_policy.RealizationRect(), m_policy.ItemCount(), first, last))
+        {
+            m_policy.ClearRealizedRange(0, m_policy.GetRealizedElementCount());
+            return 0;
+        }
+
+        // Recycle the elements that left the window.
+        int realizedCount = m_policy.GetRealizedElementCount();
+        int realizedFirst = m_policy.FirstRealizedDataIndex();
+        if (realizedCount > 0 && (realizedFirst > last || realizedFirst + realizedCount - 1 < first))
+        {
+            m_policy.ClearRealizedRange(0, realizedCount);
+            realizedCount = 0;
+        }
+
+        if (realizedCount > 0)
+        {
+            const int realizedLast = realizedFirst + realizedCount - 1;
+            if (realizedLast > last)
+            {
+                m_policy.ClearRealizedRange(last - realizedFirst + 1, realizedLast - last);
+            }
+
+            if (realizedFirst < first)
+            {
+                m_policy.ClearRealizedRange(0, first - realizedFirst);
+                realizedFirst = first;
+            }
+
+            realizedCount = m_policy.GetRealizedElementCount();
+            if (isLayoutChanged)
+            {
+                for (int dataIndex = realizedFirst; dataIndex < realizedFirst + realizedCount; ++dataIndex)
+                {
+                    LayOut(dataIndex, availableSize);
+                }
+            }
+        }
+
+        // Realize the elements that entered the window at either end of the range.
+        int realizedThisPass = 0;
+        if (realizedCount > 0)
+        {
+            for (int dataIndex = realizedFirst - 1; dataIndex >= first; --dataIndex)
+            {
+                m_policy.EnsureElementRealized(false /* forward */, dataIndex);
+                LayOut(dataIndex, availableSize);
+                ++realizedThisPass;
+            }
+        }
+
+        for (int dataIndex = realizedCount > 0 ? realizedFirst + realizedCount : first; dataIndex <= last; ++dataIndex)
+        {
+            m_policy.EnsureElementRealized(true /* forward */, dataIndex);
+            LayOut(dataIndex, availableSize);
+            ++realizedThisPass;
+        }
+
+        return realizedThisPass;
+    }
+
+private:
+    void LayOut(int dataIndex, const Size& availableSize)
+    {
+        m_policy.MeasureElement(dataIndex, availableSize);
+        const auto bounds = GetLayoutRectForDataIndex(dataIndex);
+        m_policy.SetLayoutBoundsForDataIndex(dataIndex, bounds);
+        m_policy.OnElementLaidOut(dataIndex, bounds, false /* isCorrection */);
+    }
+
+    TPolicy& m_policy;
+    bool m_isValid{ false };
+    float m_originMinor{};
+    float m_originMajor{};
+    float m_itemMinorSize{};
+    float m_itemMajorSize{};
+    float m_minorSizeWithSpacing{};
+    float m_majorSizeWithSpacing{};
+    int m_itemsPerLine{ 1 };
+};
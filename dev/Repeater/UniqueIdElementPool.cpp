@@ -18,15 +18,34 @@ void UniqueIdElementPool::Add(const winrt::UIElement& element)
     MUX_ASSERT(m_owner->ItemsSourceView().HasKeyIndexMapping());
 
     auto virtInfo = ItemsRepeater::GetVirtualizationInfo(element);
-    auto key = std::wstring(virtInfo->UniqueId().data());
+    const auto& key = virtInfo->UniqueId();
+    const size_t hash = HashKey(key);
 
-    if (m_elementMap.find(key) != m_elementMap.end())
+    if (Find(key, hash) != -1)
     {
-        std::wstring message = L"The unique id provided (" + std::wstring(virtInfo->UniqueId().data()) + L") is not unique.";
+        std::wstring message = L"The unique id provided (" + std::wstring(key.data()) + L") is not unique.";
         throw winrt::hresult_error(E_FAIL, message.c_str());
     }
 
-    m_elementMap.insert(std::make_pair(std::move(key), tracker_ref<winrt::UIElement>(m_owner, element)));
+    // Keep the load factor under 3/4 so that the probe sequences stay short.
+    if ((m_count + 1) * 4 > static_cast<int>(m_slots.size()) * 3)
+    {
+        Grow();
+    }
+
+    const size_t mask = m_slots.size() - 1;
+    size_t slotIndex = hash & mask;
+    while (m_slots[slotIndex].IsOccupied)
+    {
+        slotIndex = (slotIndex + 1) & mask;
+    }
+
+    auto& slot = m_slots[slotIndex];
+    slot.Key = key;
+    slot.Hash = hash;
+    slot.Element.set(element);
+    slot.IsOccupied = true;
+    m_count++;
 }
 
 winrt::UIElement UniqueIdElementPool::Remove(int index)
@@ -35,12 +54,15 @@ winrt::UIElement UniqueIdElementPool::Remove(int index)
 
     // Check if there is already a element in the mapping and if so, use it.
     winrt::UIElement element = nullptr;
-    std::wstring key = std::wstring(m_owner->ItemsSourceView().KeyFromIndex(index));
-    auto it = m_elementMap.find(key);
-    if (it != m_elementMap.end())
+    if (m_count > 0)
     {
-        element = it->second.get();
-        m_elementMap.erase(it);
+        const auto key = m_owner->ItemsSourceView().KeyFromIndex(index);
+        const int slotIndex = Find(key, HashKey(key));
+        if (slotIndex != -1)
+        {
+            element = m_slots[slotIndex].Element.get();
+            EmptySlot(slotIndex);
+        }
     }
 
     return element;
@@ -49,5 +71,100 @@ winrt::UIElement UniqueIdElementPool::Remove(int index)
 void UniqueIdElementPool::Clear()
 {
     MUX_ASSERT(m_owner->ItemsSourceView().HasKeyIndexMapping());
-    m_elementMap.clear();
-}
\ No newline at end of file
+    for (auto& slot : m_slots)
+    {
+        if (slot.IsOccupied)
+        {
+            slot.Key = {};
+            slot.Element.set(nullptr);
+            slot.IsOccupied = false;
+        }
+    }
+
+    m_count = 0;
+}
+
+/* static */
+size_t UniqueIdElementPool::HashKey(const winrt::hstring& key)
+{
+    return std::hash<std::wstring_view>{}(key);
+}
+
+int UniqueIdElementPool::Find(const winrt::hstring& key, size_t hash) const
+{
+    if (m_count > 0)
+    {
+        const size_t mask = m_slots.size() - 1;
+        for (size_t slotIndex = hash & mask; m_slots[slotIndex].IsOccupied; slotIndex = (slotIndex + 1) & mask)
+        {
+            const auto& slot = m_slots[slotIndex];
+            if (slot.Hash == hash && slot.Key == key)
+            {
+                return static_cast<int>(slotIndex);
+            }
+        }
+    }
+
+    return -1;
+}
+
+// Removes the entry and shifts back the entries that come after it in the
+// same probe sequence so that lookups never need tombstones.
+void UniqueIdElementPool::EmptySlot(int slotIndex)
+{
+    const size_t mask = m_slots.size() - 1;
+    size_t hole = static_cast<size_t>(slotIndex);
+    for (size_t next = (hole + 1) & mask; m_slots[next].IsOccupied; next = (next + 1) & mask)
+    {
+        const size_t home = m_slots[next].Hash & mask;
+        // The entry can move into the hole only if its home slot is not
+        // cyclically within (hole, next].
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            auto& from = m_slots[next];
+            auto& to = m_slots[hole];
+            to.Key = std::move(from.Key);
+            to.Hash = from.Hash;
+            to.Element.set(from.Element.get());
+            hole = next;
+        }
+    }
+
+    auto& slot = m_slots[hole];
+    slot.Key = {};
+    slot.Element.set(nullptr);
+    slot.IsOccupied = false;
+    m_count--;
+}
+
+void UniqueIdElementPool::Grow()
+{
+    const size_t capacity = m_slots.empty() ? InitialCapacity : m_slots.size() * 2;
+    std::vector<Slot> slots;
+    slots.reserve(capacity);
+    for (size_t i = 0; i < capacity; i++)
+    {
+        slots.emplace_back(m_owner);
+    }
+
+    const size_t mask = capacity - 1;
+    for (auto& slot : m_slots)
+    {
+        if (slot.IsOccupied)
+        {
+            size_t slotIndex = slot.Hash & mask;
+            while (slots[slotIndex].IsOccupied)
+            {
+                slotIndex = (slotIndex + 1) & mask;
+            }
+
+            auto& target = slots[slotIndex];
+            target.Key = std::move(slot.Key);
+            target.Hash = slot.Hash;
+            target.Element.set(slot.Element.get());
+            target.IsOccupied = true;
+        }
+    }
+
+    m_slots = std::move(slots);
+}
@@ -5,6 +5,13 @@
 
 class ItemsRepeater;
 
+// Holds on to the realized elements across a Reset when the data source has a
+// key index mapping so that they can be reused for the items with the same key.
+// This is an open addressing (linear probing) hash table. The keys are the
+// hstrings that the VirtualizationInfo already holds, so adding an element only
+// takes a reference on the key. Clear keeps the slots (and their tracker handles)
+// around so that a reset does not allocate once the table has grown to the
+// number of realized elements.
 class UniqueIdElementPool final
 {
 public:
@@ -14,14 +21,43 @@ public:
     winrt::UIElement Remove(int index);
     void Clear();
 
-    auto begin() const { return m_elementMap.begin(); }
-    auto end() const { return m_elementMap.end(); }
+    template <typename F>
+    void ForEach(F&& callback) const
+    {
+        for (const auto& slot : m_slots)
+        {
+            if (slot.IsOccupied)
+            {
+                callback(slot.Element.get());
+            }
+        }
+    }
 
 #ifdef _DEBUG
-    auto IsEmpty() { return m_elementMap.size() == 0; }
+    auto IsEmpty() { return m_count == 0; }
 #endif
 
 private:
+    struct Slot
+    {
+        explicit Slot(const ITrackerHandleManager* owner) : Element(owner) {}
+
+        winrt::hstring Key;
+        size_t Hash{ 0 };
+        tracker_ref<winrt::UIElement> Element;
+        bool IsOccupied{ false };
+    };
+
+    static size_t HashKey(const winrt::hstring& key);
+    // Returns the slot holding key or -1.
+    int Find(const winrt::hstring& key, size_t hash) const;
+    void EmptySlot(int slotIndex);
+    void Grow();
+
     ItemsRepeater* m_owner{ nullptr };
-    std::map<std::wstring, tracker_ref<winrt::UIElement>> m_elementMap;
+    // Size is always a power of two.
+    std::vector<Slot> m_slots;
+    int m_count{ 0 };
+
+    static constexpr int InitialCapacity = 16;
 };
@@ -38,7 +38,15 @@ winrt::UIElement ViewManager::GetElement(int index, bool forceCreate, bool suppr
     }
     if (!element) { element = GetElementFromUniqueIdResetPool(index); };
     if (!element) { element = GetElementFromPinnedElements(index); }
-    if (!element) { element = GetElementFromElementFactory(index); }
+    if (element)
+    {
+        m_realizedElementHitCount++;
+    }
+    else
+    {
+        element = GetElementFromElementFactory(index);
+        m_realizedElementMissCount++;
+    }
 
     auto virtInfo = ItemsRepeater::TryGetVirtualizationInfo(element);
     if (suppressAutoRecycle)
@@ -133,6 +141,7 @@ void ViewManager::ClearElementToElementFactory(const winrt::UIElement& element)
     }
 
     auto virtInfo = ItemsRepeater::GetVirtualizationInfo(element);
+    m_realizedElements.Remove(virtInfo->Index(), virtInfo.get());
     virtInfo->MoveOwnershipToElementFactory();
     m_phaser.StopPhasing(element, virtInfo);
     if (m_lastFocusedElement == element)
@@ -261,8 +270,9 @@ void ViewManager::PrunePinnedElements()
     EnsureEventSubscriptions();
 
     // Go through pinned elements and make sure they still have
-    // a reason to be pinned.
-    for (size_t i = 0; i < m_pinnedPool.size(); ++i)
+    // a reason to be pinned. Going backwards, removing an element
+    // only moves one that has already been checked.
+    for (int i = static_cast<int>(m_pinnedPool.size()) - 1; i >= 0; --i)
     {
         auto elementInfo = m_pinnedPool[i];
         auto virtInfo = elementInfo.VirtualizationInfo();
@@ -271,11 +281,10 @@ void ViewManager::PrunePinnedElements()
 
         if (!virtInfo->IsPinned())
         {
-            m_pinnedPool.erase(m_pinnedPool.begin() + i);
-            --i;
+            RemoveFromPinnedPool(i);
 
             // Pinning was the only thing keeping this element alive.
-            ClearElementToElementFactory(elementInfo.PinnedElement());
+            ClearElementToElementFactory(elementInfo.Element());
         }
     }
 }
@@ -322,42 +331,16 @@ void ViewManager::OnItemsSourceChanged(const winrt::IInspectable&, const winrt::
     case winrt::NotifyCollectionChangedAction::Add:
     {
         auto newIndex = args.NewStartingIndex();
-        auto newCount = args.NewItems().Size();
+        auto newCount = static_cast<int>(args.NewItems().Size());
         EnsureFirstLastRealizedIndices();
         if (newIndex <= m_lastRealizedElementIndexHeldByLayout)
         {
             m_lastRealizedElementIndexHeldByLayout += newCount;
-            auto children = m_owner->Children();
-            auto childCount = children.Size();
-            for (unsigned i = 0u; i < childCount; ++i)
-            {
-                auto element = children.GetAt(i);
-                auto virtInfo = ItemsRepeater::GetVirtualizationInfo(element);
-                auto dataIndex = virtInfo->Index();
-
-                if (virtInfo->IsRealized() && dataIndex >= newIndex)
-                {
-                    UpdateElementIndex(element, virtInfo, dataIndex + newCount);
-                }
-            }
         }
-        else
-        {
-            // Indices held by layout are not affected
-            // We could still have items in the pinned elements that need updates. This is usually a very small vector.
-            for (size_t i = 0; i < m_pinnedPool.size(); ++i)
-            {
-                auto elementInfo = m_pinnedPool[i];
-                auto virtInfo = elementInfo.VirtualizationInfo();
-                auto dataIndex = virtInfo->Index();
 
-                if (virtInfo->IsRealized() && dataIndex >= newIndex)
-                {
-                    auto element = elementInfo.PinnedElement();
-                    UpdateElementIndex(element, virtInfo, dataIndex + newCount);
-                }
-            }
-        }
+        // Only realized elements at or after the insertion point are affected. When the indices
+        // held by layout are not, this still updates the pinned elements after newIndex.
+        ShiftRealizedElementIndices(newIndex, newCount);
         break;
     }
 
@@ -394,21 +377,7 @@ void ViewManager::OnItemsSourceChanged(const winrt::IInspectable&, const winrt::
         {
             // countChange > 0 : countChange items were added
             // countChange < 0 : -countChange  items were removed
-            auto children = m_owner->Children();
-            for (unsigned i = 0u; i < children.Size(); ++i)
-            {
-                auto element = children.GetAt(i);
-                auto virtInfo = ItemsRepeater::GetVirtualizationInfo(element);
-                auto dataIndex = virtInfo->Index();
-
-                if (virtInfo->IsRealized())
-                {
-                    if (dataIndex >= oldStartIndex + oldCount)
-                    {
-                        UpdateElementIndex(element, virtInfo, dataIndex + countChange);
-                    }
-                }
-            }
+            ShiftRealizedElementIndices(oldStartIndex + oldCount, countChange);
 
             EnsureFirstLastRealizedIndices();
             m_lastRealizedElementIndexHeldByLayout += countChange;
@@ -420,27 +389,24 @@ void ViewManager::OnItemsSourceChanged(const winrt::IInspectable&, const winrt::
     {
         auto oldStartIndex = args.OldStartingIndex();
         auto oldCount = static_cast<int>(args.OldItems().Size());
-        auto children = m_owner->Children();
-        for (unsigned i = 0u; i < children.Size(); ++i)
-        {
-            auto element = children.GetAt(i);
-            auto virtInfo = ItemsRepeater::GetVirtualizationInfo(element);
-            auto dataIndex = virtInfo->Index();
 
-            if (virtInfo->IsRealized())
+        std::vector<winrt::UIElement> removedElements;
+        for (auto it = m_realizedElements.LowerBound(oldStartIndex); it != m_realizedElements.end() && it->Index < oldStartIndex + oldCount; ++it)
+        {
+            if (it->Value.VirtualizationInfo()->AutoRecycleCandidate())
             {
-                if (virtInfo->AutoRecycleCandidate() && oldStartIndex <= dataIndex && dataIndex < oldStartIndex + oldCount)
-                {
-                    // If we are doing the mapping, remove the element who's data was removed.
-                    m_owner->ClearElementImpl(element);
-                }
-                else if (dataIndex >= (oldStartIndex + oldCount))
-                {
-                    UpdateElementIndex(element, virtInfo, dataIndex - oldCount);
-                }
+                removedElements.push_back(it->Value.Element());
             }
         }
 
+        for (auto const& element : removedElements)
+        {
+            // If we are doing the mapping, remove the element who's data was removed.
+            m_owner->ClearElementImpl(element);
+        }
+
+        ShiftRealizedElementIndices(oldStartIndex + oldCount, -oldCount);
+
         InvalidateRealizedIndicesHeldByLayout();
         break;
     }
@@ -482,9 +448,56 @@ void ViewManager::EnsureFirstLastRealizedIndices()
 {
     if (m_firstRealizedElementIndexHeldByLayout == FirstRealizedElementIndexDefault)
     {
-        // This will ensure that the indexes are updated.
-        auto element = GetElementIfAlreadyHeldByLayout(0);
+        MUX_ASSERT(m_lastRealizedElementIndexHeldByLayout == LastRealizedElementIndexDefault);
+        for (auto const& entry : m_realizedElements)
+        {
+            if (entry.Id->IsHeldByLayout())
+            {
+                m_firstRealizedElementIndexHeldByLayout = std::min(m_firstRealizedElementIndexHeldByLayout, entry.Index);
+                m_lastRealizedElementIndexHeldByLayout = std::max(m_lastRealizedElementIndexHeldByLayout, entry.Index);
+            }
+        }
+    }
+}
+
+// Moves every realized element to its index after the whole batch in a single pass over
+// the realized elements, instead of one pass per change. As in OnItemsSourceChanged, the
+// elements of replaced items are kept at their index.
+void ViewManager::OnItemsSourceChangeBatch(const CollectionChangeBatch<winrt::IInspectable>& batch)
+{
+    MUX_ASSERT(!batch.IsReset());
+
+    // Take a copy, clearing elements and updating indices changes the table.
+    std::vector<RealizedElementInfo> realizedElements;
+    realizedElements.reserve(m_realizedElements.Count());
+    for (auto const& entry : m_realizedElements)
+    {
+        realizedElements.push_back(entry.Value);
+    }
+
+    for (auto const& elementInfo : realizedElements)
+    {
+        auto element = elementInfo.Element();
+        auto virtInfo = elementInfo.VirtualizationInfo();
+        if (virtInfo->IsRealized())
+        {
+            const int newIndex = batch.MapIndex(virtInfo->Index());
+            if (newIndex < 0)
+            {
+                if (virtInfo->AutoRecycleCandidate())
+                {
+                    // If we are doing the mapping, remove the element who's data was removed.
+                    m_owner->ClearElementImpl(element);
+                }
+            }
+            else
+            {
+                UpdateElementIndex(element, virtInfo, newIndex);
+            }
+        }
     }
+
+    InvalidateRealizedIndicesHeldByLayout();
 }
 
 void ViewManager::OnLayoutChanging()
@@ -502,13 +515,13 @@ void ViewManager::OnOwnerArranged()
     {
         m_isDataSourceStableResetPending = false;
 
-        for (auto& entry : m_resetPool)
+        m_resetPool.ForEach([this](const winrt::UIElement& element)
         {
             // TODO: Task 14204306: ItemsRepeater: Find better focus candidate when focused element is deleted in the ItemsSource.
             // Focused element is getting cleared. Need to figure out semantics on where
             // focus should go when the focused element is removed from the data collection.
-            ClearElement(entry.second.get(), true /* isClearedDueToCollectionChange */);
-        }
+            ClearElement(element, true /* isClearedDueToCollectionChange */);
+        });
 
         m_resetPool.Clear();
 
@@ -517,51 +530,40 @@ void ViewManager::OnOwnerArranged()
     }
 }
 
+void ViewManager::OnElementsArranged()
+{
+    m_phaser.OnOwnerArranged();
+}
+
+void ViewManager::ResetCounters()
+{
+    m_realizedElementHitCount = 0;
+    m_realizedElementMissCount = 0;
+}
+
 #pragma region GetElement providers
 
 // We optimize for the case where index is not realized to return null as quickly as we can.
 // Flow layouts manage containers on their own and will never ask for an index that is already realized.
-// If an index that is realized is requested by the layout, we unfortunately have to walk the
-// children. Not ideal, but a reasonable default to provide consistent behavior between virtualizing
-// and non-virtualizing hosts.
+// If an index that is realized is requested by the layout, it is looked up in the realized elements
+// table which provides consistent behavior between virtualizing and non-virtualizing hosts.
 winrt::UIElement ViewManager::GetElementIfAlreadyHeldByLayout(int index)
 {
     winrt::UIElement element = nullptr;
 
-    const bool cachedFirstLastIndicesInvalid = m_firstRealizedElementIndexHeldByLayout == FirstRealizedElementIndexDefault;
-    MUX_ASSERT(!cachedFirstLastIndicesInvalid || m_lastRealizedElementIndexHeldByLayout == LastRealizedElementIndexDefault);
+    EnsureFirstLastRealizedIndices();
 
-    const bool isRequestedIndexInRealizedRange = (m_firstRealizedElementIndexHeldByLayout <= index && index <= m_lastRealizedElementIndexHeldByLayout);
+    // Both First and Last indices need to be valid or default.
+    MUX_ASSERT((m_firstRealizedElementIndexHeldByLayout == FirstRealizedElementIndexDefault && m_lastRealizedElementIndexHeldByLayout == LastRealizedElementIndexDefault) ||
+        (m_firstRealizedElementIndexHeldByLayout != FirstRealizedElementIndexDefault && m_lastRealizedElementIndexHeldByLayout != LastRealizedElementIndexDefault));
 
-    if (cachedFirstLastIndicesInvalid || isRequestedIndexInRealizedRange)
+    const bool isRequestedIndexInRealizedRange = (m_firstRealizedElementIndexHeldByLayout <= index && index <= m_lastRealizedElementIndexHeldByLayout);
+    if (isRequestedIndexInRealizedRange)
     {
-        // Both First and Last indices need to be valid or default.
-        MUX_ASSERT((m_firstRealizedElementIndexHeldByLayout == FirstRealizedElementIndexDefault && m_lastRealizedElementIndexHeldByLayout == LastRealizedElementIndexDefault) ||
-            (m_firstRealizedElementIndexHeldByLayout != FirstRealizedElementIndexDefault && m_lastRealizedElementIndexHeldByLayout != LastRealizedElementIndexDefault));
-
-        auto children = m_owner->Children();
-        for (unsigned i = 0u; i < children.Size(); ++i)
+        // Only give back elements held by layout. If someone else is holding it, they will be served by other methods.
+        if (auto const entry = m_realizedElements.Find(index, [](auto const& candidate) { return candidate.Id->IsHeldByLayout(); }))
         {
-            auto child = children.GetAt(i);
-            auto virtInfo = ItemsRepeater::TryGetVirtualizationInfo(child);
-            if (virtInfo && virtInfo->IsHeldByLayout())
-            {
-                // Only give back elements held by layout. If someone else is holding it, they will be served by other methods.
-                const int childIndex = virtInfo->Index();
-                m_firstRealizedElementIndexHeldByLayout = std::min(m_firstRealizedElementIndexHeldByLayout, childIndex);
-                m_lastRealizedElementIndexHeldByLayout = std::max(m_lastRealizedElementIndexHeldByLayout, childIndex);
-                if (virtInfo->Index() == index)
-                {
-                    element = child;
-                    // If we have valid first/last indices, we don't have to walk the rest, but if we 
-                    // do not, then we keep walking through the entire children collection to get accurate
-                    // indices once.
-                    if (!cachedFirstLastIndicesInvalid)
-                    {
-                        break;
-                    }
-                }
-            }
+            element = entry->Value.Element();
         }
     }
 
@@ -581,6 +583,7 @@ winrt::UIElement ViewManager::GetElementFromUniqueIdResetPool(int index)
             auto virtInfo = ItemsRepeater::GetVirtualizationInfo(element);
             virtInfo->MoveOwnershipToLayoutFromUniqueIdResetPool();
             UpdateElementIndex(element, virtInfo, index);
+            m_realizedElements.Add(index, virtInfo.get(), RealizedElementInfo(m_owner, element));
 
             // Update realized indices
             m_firstRealizedElementIndexHeldByLayout = std::min(m_firstRealizedElementIndexHeldByLayout, index);
@@ -596,22 +599,18 @@ winrt::UIElement ViewManager::GetElementFromPinnedElements(int index)
     winrt::UIElement element = nullptr;
 
     // See if you can find something among the pinned elements.
-    for (size_t i = 0; i < m_pinnedPool.size(); ++i)
+    if (auto const entry = m_realizedElements.Find(index, [](auto const& candidate) { return candidate.Id->Owner() == ElementOwner::PinnedPool; }))
     {
-        auto elementInfo = m_pinnedPool[i];
-        auto virtInfo = elementInfo.VirtualizationInfo();
+        element = entry->Value.Element();
+        auto const virtInfo = entry->Value.VirtualizationInfo();
+        MUX_ASSERT(m_pinnedPool[virtInfo->PinnedPoolIndex()].Element() == element);
 
-        if (virtInfo->Index() == index)
-        {
-            m_pinnedPool.erase(m_pinnedPool.begin() + i);
-            element = elementInfo.PinnedElement();
-            elementInfo.VirtualizationInfo()->MoveOwnershipToLayoutFromPinnedPool();
+        virtInfo->MoveOwnershipToLayoutFromPinnedPool();
+        RemoveFromPinnedPool(virtInfo->PinnedPoolIndex());
 
-            // Update realized indices
-            m_firstRealizedElementIndexHeldByLayout = std::min(m_firstRealizedElementIndexHeldByLayout, index);
-            m_lastRealizedElementIndexHeldByLayout = std::max(m_lastRealizedElementIndexHeldByLayout, index);
-            break;
-        }
+        // Update realized indices
+        m_firstRealizedElementIndexHeldByLayout = std::min(m_firstRealizedElementIndexHeldByLayout, index);
+        m_lastRealizedElementIndexHeldByLayout = std::max(m_lastRealizedElementIndexHeldByLayout, index);
     }
 
     return element;
@@ -744,6 +743,7 @@ winrt::UIElement ViewManager::GetElementFromElementFactory(int index)
         m_owner->ItemsSourceView().HasKeyIndexMapping() ?
         m_owner->ItemsSourceView().KeyFromIndex(index) :
         winrt::hstring{});
+    m_realizedElements.Add(index, virtInfo.get(), RealizedElementInfo(m_owner, element));
 
     // The view generator is the only provider that prepares the element.
     auto repeater = m_owner;
@@ -782,6 +782,7 @@ bool ViewManager::ClearElementToUniqueIdResetPool(const winrt::UIElement& elemen
     if (m_isDataSourceStableResetPending)
     {
         m_resetPool.Add(element);
+        m_realizedElements.Remove(virtInfo->Index(), virtInfo.get());
         virtInfo->MoveOwnershipToUniqueIdResetPoolFromLayout();
     }
 
@@ -794,6 +795,7 @@ bool ViewManager::ClearElementToAnimator(const winrt::UIElement& element, const
     if (cleared)
     {
         const int clearedIndex = virtInfo->Index();
+        m_realizedElements.Remove(clearedIndex, virtInfo.get());
         virtInfo->MoveOwnershipToAnimator();
         if (m_lastFocusedElement == element)
         {
@@ -814,19 +816,27 @@ bool ViewManager::ClearElementToPinnedPool(const winrt::UIElement& element, cons
 
     if (moveToPinnedPool)
     {
-#ifdef _DEBUG
-        for (size_t i = 0; i < m_pinnedPool.size(); ++i)
-        {
-            MUX_ASSERT(m_pinnedPool[i].PinnedElement() != element);
-        }
-#endif
-        m_pinnedPool.push_back(PinnedElementInfo(m_owner, element));
+        MUX_ASSERT(virtInfo->PinnedPoolIndex() == -1);
+        virtInfo->PinnedPoolIndex(static_cast<int>(m_pinnedPool.size()));
+        m_pinnedPool.push_back(RealizedElementInfo(m_owner, element));
         virtInfo->MoveOwnershipToPinnedPool();
     }
 
     return moveToPinnedPool;
 }
 
+void ViewManager::RemoveFromPinnedPool(int pinnedPoolIndex)
+{
+    m_pinnedPool[pinnedPoolIndex].VirtualizationInfo()->PinnedPoolIndex(-1);
+    if (pinnedPoolIndex != static_cast<int>(m_pinnedPool.size()) - 1)
+    {
+        m_pinnedPool[pinnedPoolIndex] = std::move(m_pinnedPool.back());
+        m_pinnedPool[pinnedPoolIndex].VirtualizationInfo()->PinnedPoolIndex(pinnedPoolIndex);
+    }
+
+    m_pinnedPool.pop_back();
+}
+
 #pragma endregion
 
 void ViewManager::UpdateFocusedElement()
@@ -900,17 +910,61 @@ void ViewManager::UpdateElementIndex(const winrt::UIElement& element, const winr
     if (oldIndex != index)
     {
         virtInfo->UpdateIndex(index);
+        m_realizedElements.UpdateIndex(oldIndex, index, virtInfo.get());
         m_owner->OnElementIndexChanged(element, oldIndex, index);
     }
 }
 
+// Moves the realized elements at or after startIndex by countChange. Only the shifted
+// range of the table is visited.
+void ViewManager::ShiftRealizedElementIndices(int startIndex, int countChange)
+{
+    if (countChange == 0)
+    {
+        return;
+    }
+
+    // Take a copy, ElementIndexChanged handlers run while the indices are updated.
+    std::vector<RealizedElementInfo> shiftedElements;
+    for (auto it = m_realizedElements.LowerBound(startIndex); it != m_realizedElements.end(); ++it)
+    {
+        shiftedElements.push_back(it->Value);
+    }
+
+    // Moving up starts from the last element and moving down from the first one,
+    // so every element stays in place in the table.
+    if (countChange > 0)
+    {
+        std::reverse(shiftedElements.begin(), shiftedElements.end());
+    }
+
+    for (auto const& elementInfo : shiftedElements)
+    {
+        auto virtInfo = elementInfo.VirtualizationInfo();
+        if (virtInfo->IsRealized())
+        {
+            UpdateElementIndex(elementInfo.Element(), virtInfo, virtInfo->Index() + countChange);
+        }
+    }
+}
+
+winrt::UIElement ViewManager::GetRealizedElement(int index) const
+{
+    if (auto const entry = m_realizedElements.Find(index, [](auto const&) { return true; }))
+    {
+        return entry->Value.Element();
+    }
+
+    return nullptr;
+}
+
 void ViewManager::InvalidateRealizedIndicesHeldByLayout()
 {
     m_firstRealizedElementIndexHeldByLayout = FirstRealizedElementIndexDefault;
     m_lastRealizedElementIndexHeldByLayout = LastRealizedElementIndexDefault;
 }
 
-ViewManager::PinnedElementInfo::PinnedElementInfo(const ITrackerHandleManager* owner, const winrt::UIElement& element) :
-    m_pinnedElement(owner, element),
+ViewManager::RealizedElementInfo::RealizedElementInfo(const ITrackerHandleManager* owner, const winrt::UIElement& element) :
+    m_element(owner, element),
     m_virtInfo(owner, ItemsRepeater::GetVirtualizationInfo(element))
 { }
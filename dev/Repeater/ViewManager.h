@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "CollectionChangeBatch.h"
+#include "RealizedElementTable.h"
 #include "UniqueIdElementPool.h"
 #include "VirtualizationInfo.h"
 #include "Phaser.h"
@@ -20,13 +22,22 @@ public:
     void ClearElement(const winrt::UIElement& element, bool isClearedDueToCollectionChange);
     void ClearElementToElementFactory(const winrt::UIElement& element);
     int GetElementIndex(const winrt::com_ptr<VirtualizationInfo>& virtInfo);
+    winrt::UIElement GetRealizedElement(int index) const;
 
     void PrunePinnedElements();
     void UpdatePin(const winrt::UIElement& element, bool addPin);
 
     void OnItemsSourceChanged(const winrt::IInspectable& source, const winrt::NotifyCollectionChangedEventArgs& args);
+    void OnItemsSourceChangeBatch(const CollectionChangeBatch<winrt::IInspectable>& batch);
     void OnLayoutChanging();
     void OnOwnerArranged();
+    void OnElementsArranged();
+
+    // Counters exposed through RepeaterTestHooks. A hit is a GetElement call served by
+    // an element that was already realized, a miss one that needed the element factory.
+    int RealizedElementHitCount() const { return m_realizedElementHitCount; }
+    int RealizedElementMissCount() const { return m_realizedElementMissCount; }
+    void ResetCounters();
 
 private:
 #pragma region GetElement providers
@@ -46,6 +57,8 @@ private:
 
 #pragma endregion
 
+    void RemoveFromPinnedPool(int pinnedPoolIndex);
+
     void UpdateFocusedElement();
     void OnFocusChanged(const winrt::IInspectable& sender, const winrt::RoutedEventArgs& args);
     void MoveFocusFromClearedIndex(int clearedIndex);
@@ -54,19 +67,20 @@ private:
     void EnsureEventSubscriptions();
 
     void UpdateElementIndex(const winrt::UIElement& element, const winrt::com_ptr<VirtualizationInfo>& virtInfo, int index);
+    void ShiftRealizedElementIndices(int startIndex, int countChange);
 
     void InvalidateRealizedIndicesHeldByLayout();
     void EnsureFirstLastRealizedIndices();
 
-    struct PinnedElementInfo
+    struct RealizedElementInfo
     {
-        PinnedElementInfo(const ITrackerHandleManager* owner, const winrt::UIElement& element);
+        RealizedElementInfo(const ITrackerHandleManager* owner, const winrt::UIElement& element);
 
-        winrt::UIElement PinnedElement() const { return m_pinnedElement.get(); }
+        winrt::UIElement Element() const { return m_element.get(); }
         winrt::com_ptr<VirtualizationInfo> VirtualizationInfo() const { return m_virtInfo.get(); }
 
     private:
-        tracker_ref<winrt::UIElement> m_pinnedElement;
+        tracker_ref<winrt::UIElement> m_element;
 
         // We hold on VirtualizationInfo to make sure we can
         // quickly access its content rather than go through
@@ -79,7 +93,12 @@ private:
     ItemsRepeater* m_owner{ nullptr };
 
     // Pinned elements that are currently owned by layout are *NOT* in this pool.
-    std::vector<PinnedElementInfo> m_pinnedPool;
+    // The elements know their position in it (VirtualizationInfo::PinnedPoolIndex),
+    // and are removed by moving the last one in their place, so the pool is unordered.
+    std::vector<RealizedElementInfo> m_pinnedPool;
+    // Every realized element (held by layout or in the pinned pool) sorted by index.
+    // Kept in sync by the ownership transitions below and by UpdateElementIndex.
+    RealizedElementTable<const ::VirtualizationInfo*, RealizedElementInfo> m_realizedElements;
     UniqueIdElementPool m_resetPool;
 
     // _lastFocusedElement is listed in _pinnedPool.
@@ -103,6 +122,9 @@ private:
     // will not be accurate. Rather, it will be an upper bound on what we think is the last realized index.
     int m_firstRealizedElementIndexHeldByLayout{ FirstRealizedElementIndexDefault };
     int m_lastRealizedElementIndexHeldByLayout{ LastRealizedElementIndexDefault };
+
+    int m_realizedElementHitCount{ 0 };
+    int m_realizedElementMissCount{ 0 };
     static constexpr int FirstRealizedElementIndexDefault = std::numeric_limits<int>::max();
     static constexpr int LastRealizedElementIndexDefault = std::numeric_limits<int>::min();
 };
@@ -11,9 +11,18 @@
 // Pixel delta by which to inflate the cache buffer on each side.  Rather than fill the entire
 // cache buffer all at once, we chunk the work to make the UI thread more responsive.  We inflate
 // the cache buffer from 0 to a max value determined by the Maximum[Horizontal,Vertical]CacheLength
-// properties.
+// properties. While scrolling, the buffer ahead of the viewport inflates faster (see RealizationWindowPolicy).
 constexpr double CacheBufferPerSideInflationPixelDelta = 40.0;
 
+// Moves one side of the cache buffer toward its target. We inflate in chunks but
+// deflate at once so that elements that are no longer needed get released.
+static bool UpdateCacheBufferSide(double& bufferSide, double target, double inflationDelta)
+{
+    const double previous = bufferSide;
+    bufferSide = bufferSide < target ? std::min(bufferSide + inflationDelta, target) : target;
+    return bufferSide != previous;
+}
+
 ViewportManagerWithPlatformFeatures::ViewportManagerWithPlatformFeatures(ItemsRepeater* owner) :
     m_owner(owner),
     m_scroller(owner),
@@ -120,10 +129,10 @@ winrt::Rect ViewportManagerWithPlatformFeatures::GetLayoutRealizationWindow() co
     auto realizationWindow = GetLayoutVisibleWindow();
     if (HasScroller())
     {
-        realizationWindow.X -= static_cast<float>(m_horizontalCacheBufferPerSide);
-        realizationWindow.Y -= static_cast<float>(m_verticalCacheBufferPerSide);
-        realizationWindow.Width += static_cast<float>(m_horizontalCacheBufferPerSide) * 2.0f;
-        realizationWindow.Height += static_cast<float>(m_verticalCacheBufferPerSide) * 2.0f;
+        realizationWindow.X -= static_cast<float>(m_horizontalCacheBuffer.Before);
+        realizationWindow.Y -= static_cast<float>(m_verticalCacheBuffer.Before);
+        realizationWindow.Width += static_cast<float>(m_horizontalCacheBuffer.Before + m_horizontalCacheBuffer.After);
+        realizationWindow.Height += static_cast<float>(m_verticalCacheBuffer.Before + m_verticalCacheBuffer.After);
     }
 
     return realizationWindow;
@@ -177,6 +186,8 @@ void ViewportManagerWithPlatformFeatures::OnLayoutChanged(bool isVirtualizing)
     if (m_managingViewportDisabled)
     {
         m_effectiveViewportChangedRevoker.revoke();
+        m_scrollIdleCheckRenderingRevoker.revoke();
+        m_realizationWindowPolicy.Reset();
     }
     else if (!m_effectiveViewportChangedRevoker)
     {
@@ -218,27 +229,11 @@ void ViewportManagerWithPlatformFeatures::OnOwnerArranged()
         // Bug 17411076: EffectiveViewport: registering for effective viewport in arrange should invalidate viewport
         // EnsureScroller();
 
-        if (HasScroller())
+        if (HasScroller() && UpdateCacheBuffer())
         {
-            const double maximumHorizontalCacheBufferPerSide = m_maximumHorizontalCacheLength * m_visibleWindow.Width / 2.0;
-            const double maximumVerticalCacheBufferPerSide = m_maximumVerticalCacheLength * m_visibleWindow.Height / 2.0;
-
-            const bool continueBuildingCache =
-                m_horizontalCacheBufferPerSide < maximumHorizontalCacheBufferPerSide ||
-                m_verticalCacheBufferPerSide < maximumVerticalCacheBufferPerSide;
-
-            if (continueBuildingCache)
-            {
-                m_horizontalCacheBufferPerSide += CacheBufferPerSideInflationPixelDelta;
-                m_verticalCacheBufferPerSide += CacheBufferPerSideInflationPixelDelta;
-
-                m_horizontalCacheBufferPerSide = std::min(m_horizontalCacheBufferPerSide, maximumHorizontalCacheBufferPerSide);
-                m_verticalCacheBufferPerSide = std::min(m_verticalCacheBufferPerSide, maximumVerticalCacheBufferPerSide);
-
-                // Since we grow the cache buffer at the end of the arrange pass,
-                // we need to register work even if we just reached cache potential.
-                RegisterCacheBuildWork();
-            }
+            // Since we change the cache buffer at the end of the arrange pass,
+            // we need to register work even if we just reached cache potential.
+            RegisterCacheBuildWork();
         }
     }
 }
@@ -365,6 +360,8 @@ void ViewportManagerWithPlatformFeatures::ResetScrollers()
 {
     m_scroller.set(nullptr);
     m_effectiveViewportChangedRevoker.revoke();
+    m_scrollIdleCheckRenderingRevoker.revoke();
+    m_realizationWindowPolicy.Reset();
     m_ensuredScroller = false;
 }
 
@@ -389,6 +386,11 @@ void ViewportManagerWithPlatformFeatures::OnEffectiveViewportChanged(winrt::Fram
     {
         // We got cleared.
         m_layoutExtent = {};
+        m_realizationWindowPolicy.Reset();
+    }
+    else
+    {
+        OnViewportMoved();
     }
 
     // We got a new viewport, we dont need to wait for layout updated anymore to 
@@ -459,10 +461,64 @@ void ViewportManagerWithPlatformFeatures::UpdateViewport(winrt::Rect const& view
     TryInvalidateMeasure();
 }
 
+void ViewportManagerWithPlatformFeatures::OnViewportMoved()
+{
+    // We track the viewport in layout coordinates so that a change of the layout
+    // origin (which moves the effective viewport by the same amount) is not a scroll.
+    const auto visibleWindow = GetLayoutVisibleWindowDiscardAnchor();
+    m_realizationWindowPolicy.OnViewportChanged(
+        visibleWindow.X, visibleWindow.Y, visibleWindow.Width, visibleWindow.Height,
+        m_viewportChangeTimer.DurationInMilliSeconds());
+    m_viewportChangeTimer.Reset();
+
+    if (m_realizationWindowPolicy.IsScrolling() && !m_scrollIdleCheckRenderingRevoker)
+    {
+        winrt::Windows::UI::Xaml::Media::CompositionTarget compositionTarget{ nullptr };
+        m_scrollIdleCheckRenderingRevoker = compositionTarget.Rendering(winrt::auto_revoke, { this, &ViewportManagerWithPlatformFeatures::OnScrollIdleCheckRendering });
+    }
+}
+
+void ViewportManagerWithPlatformFeatures::OnScrollIdleCheckRendering(const winrt::IInspectable& /*sender*/, const winrt::IInspectable& /*args*/)
+{
+    if (!m_realizationWindowPolicy.IsScrolling())
+    {
+        m_scrollIdleCheckRenderingRevoker.revoke();
+    }
+    else if (m_realizationWindowPolicy.OnIdle(m_viewportChangeTimer.DurationInMilliSeconds()))
+    {
+        REPEATER_TRACE_INFO(L"%ls: \tScrolling stopped. Shrinking the cache buffer. \n", GetLayoutId().data());
+        m_scrollIdleCheckRenderingRevoker.revoke();
+        if (!m_managingViewportDisabled)
+        {
+            RegisterCacheBuildWork();
+        }
+    }
+}
+
+// Moves the cache buffer one step toward the target given by the scroll velocity.
+// Returns true if it changed.
+bool ViewportManagerWithPlatformFeatures::UpdateCacheBuffer()
+{
+    const double horizontalVelocity = m_realizationWindowPolicy.HorizontalVelocity();
+    const double verticalVelocity = m_realizationWindowPolicy.VerticalVelocity();
+    const auto horizontalTarget = RealizationWindowPolicy::TargetBuffer(horizontalVelocity, m_visibleWindow.Width, m_maximumHorizontalCacheLength);
+    const auto verticalTarget = RealizationWindowPolicy::TargetBuffer(verticalVelocity, m_visibleWindow.Height, m_maximumVerticalCacheLength);
+    const double horizontalDelta = CacheBufferPerSideInflationPixelDelta * (1.0 + RealizationWindowPolicy::SpeedFactor(horizontalVelocity, m_visibleWindow.Width));
+    const double verticalDelta = CacheBufferPerSideInflationPixelDelta * (1.0 + RealizationWindowPolicy::SpeedFactor(verticalVelocity, m_visibleWindow.Height));
+
+    // Not short-circuited: every side moves on each pass.
+    const bool horizontalBeforeChanged = UpdateCacheBufferSide(m_horizontalCacheBuffer.Before, horizontalTarget.Before, horizontalDelta);
+    const bool horizontalAfterChanged = UpdateCacheBufferSide(m_horizontalCacheBuffer.After, horizontalTarget.After, horizontalDelta);
+    const bool verticalBeforeChanged = UpdateCacheBufferSide(m_verticalCacheBuffer.Before, verticalTarget.Before, verticalDelta);
+    const bool verticalAfterChanged = UpdateCacheBufferSide(m_verticalCacheBuffer.After, verticalTarget.After, verticalDelta);
+
+    return horizontalBeforeChanged || horizontalAfterChanged || verticalBeforeChanged || verticalAfterChanged;
+}
+
 void ViewportManagerWithPlatformFeatures::ResetCacheBuffer()
 {
-    m_horizontalCacheBufferPerSide = 0.0;
-    m_verticalCacheBufferPerSide = 0.0;
+    m_horizontalCacheBuffer = {};
+    m_verticalCacheBuffer = {};
 
     if (!m_managingViewportDisabled)
     {
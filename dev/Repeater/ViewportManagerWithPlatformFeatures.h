@@ -4,6 +4,8 @@
 #pragma once
 
 #include "ViewportManager.h"
+#include "RealizationWindowPolicy.h"
+#include "QPCTimer.h"
 
 class ItemsRepeater;
 
@@ -50,11 +52,14 @@ private:
     void OnCacheBuildActionCompleted();
     void OnEffectiveViewportChanged(winrt::FrameworkElement const& sender, winrt::EffectiveViewportChangedEventArgs const& args);
     void OnLayoutUpdated(winrt::IInspectable const& sender, winrt::IInspectable const& args);
+    void OnScrollIdleCheckRendering(winrt::IInspectable const& sender, winrt::IInspectable const& args);
 
     void EnsureScroller();
     bool HasScroller() const { return m_scroller != nullptr; }
     void UpdateViewport(winrt::Rect const& args);
     void ResetCacheBuffer();
+    bool UpdateCacheBuffer();
+    void OnViewportMoved();
     void ValidateCacheLength(double cacheLength);
     void RegisterCacheBuildWork();
     void TryInvalidateMeasure();
@@ -92,8 +97,11 @@ private:
     // Realization window cache fields
     double m_maximumHorizontalCacheLength{ 2.0 };
     double m_maximumVerticalCacheLength{ 2.0 };
-    double m_horizontalCacheBufferPerSide{};
-    double m_verticalCacheBufferPerSide{};
+    RealizationWindowPolicy::Buffer m_horizontalCacheBuffer{};
+    RealizationWindowPolicy::Buffer m_verticalCacheBuffer{};
+    // Tracks the scroll velocity to bias the cache buffer toward the scroll direction.
+    RealizationWindowPolicy m_realizationWindowPolicy{};
+    QPCTimer m_viewportChangeTimer{};
 
     bool m_isBringIntoViewInProgress{false};
     // For non-virtualizing layouts, we do not need to keep
@@ -106,4 +114,6 @@ private:
 
     winrt::FrameworkElement::LayoutUpdated_revoker m_layoutUpdatedRevoker{};
     winrt::Windows::UI::Xaml::Media::CompositionTarget::Rendering_revoker m_renderingToken{};
+    // Registered while scrolling to notice when it stops, since no viewport change tells us.
+    winrt::Windows::UI::Xaml::Media::CompositionTarget::Rendering_revoker m_scrollIdleCheckRenderingRevoker{};
 };
@@ -53,7 +53,7 @@ public:
 
 #pragma region Ownership state machine
 
-    void MoveOwnershipToLayoutFromElementFactory(int index, wstring_view uniqueId);
+    void MoveOwnershipToLayoutFromElementFactory(int index, const winrt::hstring& uniqueId);
     void MoveOwnershipToLayoutFromUniqueIdResetPool();
     void MoveOwnershipToLayoutFromPinnedPool();
     void MoveOwnershipToElementFactory();
@@ -68,10 +68,16 @@ public:
 
     void UpdateIndex(int newIndex);
 
+    // Position of the element in the pinned pool of the ViewManager, -1 if it is not in it.
+    int PinnedPoolIndex() const { return m_pinnedPoolIndex; }
+    void PinnedPoolIndex(int value) { m_pinnedPoolIndex = value; }
+
     winrt::Rect ArrangeBounds() const { return m_arrangeBounds; }
     void ArrangeBounds(winrt::Rect value) { m_arrangeBounds = value; }
 
-    wstring_view UniqueId() const { return m_uniqueId; }
+    // Shares the string returned by KeyFromIndex so that pooling by unique id
+    // does not need to copy it.
+    const winrt::hstring& UniqueId() const { return m_uniqueId; }
 
 #pragma region Keep element from being recycled
     bool KeepAlive() { return m_keepAlive; }
@@ -84,6 +90,7 @@ public:
 private:
     unsigned m_pinCounter{ 0u };
     int m_index{ -1 };
+    int m_pinnedPoolIndex{ -1 };
     winrt::hstring m_uniqueId;
     ElementOwner m_owner{ ElementOwner::ElementFactory };
     winrt::Rect m_arrangeBounds;
@@ -804,6 +804,21 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
         [TestMethod]
         [TestProperty("Description", "Verifies VerticalOffset adjusts when inserting and removing items at the beginning (VerticalAnchorRatio=0.5).")]
         public void AnchoringAtRepeaterMiddle()
+        {
+            AnchoringAtRepeaterMiddle(handleAnchorRequested: true);
+        }
+
+        [TestMethod]
+        [TestProperty("Description", "Verifies VerticalOffset adjusts when inserting and removing items at the beginning, with the anchor selected among the registered candidates (VerticalAnchorRatio=0.5).")]
+        public void AnchoringAtRepeaterMiddleWithRegisteredCandidates()
+        {
+            // Without an AnchorRequested handler, the anchor is selected through the cached bounds of the
+            // candidates the ItemsRepeater registered. Inserting and removing items moves every realized
+            // element, so their cached bounds must be re-evaluated for the same anchor to be found.
+            AnchoringAtRepeaterMiddle(handleAnchorRequested: false);
+        }
+
+        private void AnchoringAtRepeaterMiddle(bool handleAnchorRequested)
         {
             using (ScrollerTestHooksHelper scrollerTestHooksHelper = new ScrollerTestHooksHelper(
                 enableAnchorNotifications: true,
@@ -820,7 +835,7 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
                     {
                         scroller = new Scroller();
 
-                        SetupRepeaterAnchoringUI(scroller, scrollerLoadedEvent);
+                        SetupRepeaterAnchoringUI(scroller, scrollerLoadedEvent, handleAnchorRequested);
 
                         scroller.HorizontalAnchorRatio = double.NaN;
                         scroller.VerticalAnchorRatio = 0.5;
@@ -876,7 +891,8 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
 
         private void SetupRepeaterAnchoringUI(
             Scroller scroller,
-            AutoResetEvent scrollerLoadedEvent)
+            AutoResetEvent scrollerLoadedEvent,
+            bool handleAnchorRequested = true)
         {
             Log.Comment("Setting up ItemsRepeater anchoring UI with Scroller and ItemsRepeater");
 
@@ -934,13 +950,16 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
                 };
             }
 
-            scroller.AnchorRequested += (Scroller sender, ScrollerAnchorRequestedEventArgs args) =>
+            if (handleAnchorRequested)
             {
-                Log.Comment("Scroller.AnchorRequested event handler");
+                scroller.AnchorRequested += (Scroller sender, ScrollerAnchorRequestedEventArgs args) =>
+                {
+                    Log.Comment("Scroller.AnchorRequested event handler");
 
-                Verify.IsNull(args.AnchorElement);
-                Verify.IsGreaterThan(args.AnchorCandidates.Count, 0);
-            };
+                    Verify.IsNull(args.AnchorElement);
+                    Verify.IsGreaterThan(args.AnchorCandidates.Count, 0);
+                };
+            }
 
             Log.Comment("Setting window content");
             Content = scroller;
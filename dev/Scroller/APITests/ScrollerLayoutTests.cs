@@ -240,6 +240,68 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
             Verify.AreEqual(c_smallZoomFactor, zoomFactor);
         }
 
+        [TestMethod]
+        [TestProperty("Description", "Sets Scroller.Content.HorizontalAlignment/VerticalAlignment to Left/Top and verifies InteractionTracker.MaxPosition.")]
+        public void NearAlignmentMaxPosition()
+        {
+            if (!PlatformConfiguration.IsOsVersionGreaterThanOrEqual(OSVersion.Redstone2))
+            {
+                Log.Comment("Skipping test on RS1.");
+                return;
+            }
+
+            const float c_smallZoomFactor = 0.15f;
+            Scroller scroller = null;
+            Rectangle rectangleScrollerContent = null;
+            AutoResetEvent scrollerLoadedEvent = new AutoResetEvent(false);
+
+            RunOnUIThread.Execute(() =>
+            {
+                rectangleScrollerContent = new Rectangle();
+                scroller = new Scroller();
+
+                SetupDefaultUI(scroller, rectangleScrollerContent, scrollerLoadedEvent);
+                rectangleScrollerContent.HorizontalAlignment = HorizontalAlignment.Left;
+                rectangleScrollerContent.VerticalAlignment = VerticalAlignment.Top;
+            });
+
+            WaitForEvent("Waiting for Loaded event", scrollerLoadedEvent);
+            IdleSynchronizer.Wait();
+
+            RunOnUIThread.Execute(() =>
+            {
+                Log.Comment("Content larger than the viewport can be scrolled by its excess size");
+                Vector2 maxPosition = ScrollerTestHooks.GetMaxPosition(scroller);
+                Log.Comment($"MaxPosition {maxPosition.ToString()}");
+                Verify.AreEqual((float)(c_defaultUIScrollerContentWidth - c_defaultUIScrollerWidth), maxPosition.X);
+                Verify.AreEqual((float)(c_defaultUIScrollerContentHeight - c_defaultUIScrollerHeight), maxPosition.Y);
+            });
+
+            // Try to jump beyond maximum offsets
+            ScrollTo(
+                scroller,
+                c_defaultUIScrollerContentWidth - c_defaultUIScrollerWidth + 10.0,
+                c_defaultUIScrollerContentHeight - c_defaultUIScrollerHeight + 10.0,
+                AnimationMode.Disabled,
+                SnapPointsMode.Ignore,
+                hookViewChanged: true,
+                isAnimationsEnabledOverride: null,
+                expectedFinalHorizontalOffset: c_defaultUIScrollerContentWidth - c_defaultUIScrollerWidth,
+                expectedFinalVerticalOffset: c_defaultUIScrollerContentHeight - c_defaultUIScrollerHeight);
+
+            // Jump to absolute small zoomFactor to make the content smaller than the viewport.
+            ZoomTo(scroller, c_smallZoomFactor, 0.0f, 0.0f, AnimationMode.Disabled, SnapPointsMode.Ignore);
+
+            RunOnUIThread.Execute(() =>
+            {
+                Log.Comment("Content smaller than the viewport cannot be scrolled");
+                Vector2 maxPosition = ScrollerTestHooks.GetMaxPosition(scroller);
+                Log.Comment($"MaxPosition {maxPosition.ToString()}");
+                Verify.AreEqual(0.0f, maxPosition.X);
+                Verify.AreEqual(0.0f, maxPosition.Y);
+            });
+        }
+
         [TestMethod]
         [TestProperty("Description", "Validates Scroller.ViewportHeight for various layouts.")]
         public void ViewportHeight()
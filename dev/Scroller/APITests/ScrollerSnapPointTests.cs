@@ -287,6 +287,44 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
             });
         }
 
+        [TestMethod]
+        [TestProperty("Description", "Verify that snap point inertia modifiers are reused when snap points are added and removed.")]
+        public void SnapPointInertiaModifiersAreReused()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                Scroller scroller = new Scroller();
+                ScrollSnapPoint scrollSnapPoint1 = new ScrollSnapPoint(snapPointValue: 10, alignment: ScrollSnapPointsAlignment.Near);
+                ScrollSnapPoint scrollSnapPoint2 = new ScrollSnapPoint(snapPointValue: 20, alignment: ScrollSnapPointsAlignment.Near);
+                ScrollSnapPoint scrollSnapPoint3 = new ScrollSnapPoint(snapPointValue: 30, alignment: ScrollSnapPointsAlignment.Near);
+
+                scroller.HorizontalSnapPoints.Add(scrollSnapPoint1);
+                scroller.HorizontalSnapPoints.Add(scrollSnapPoint2);
+
+                ScrollerTestHooks.ResetSnapPointInertiaModifiersCounters(scroller);
+
+                Log.Comment("Adding a third snap point");
+                scroller.HorizontalSnapPoints.Add(scrollSnapPoint3);
+
+                Log.Comment("Expecting one new modifier and the two existing ones to be reused");
+                Verify.AreEqual<int>(1, ScrollerTestHooks.GetSnapPointInertiaModifiersCreatedCount(scroller));
+                Verify.AreEqual<int>(2, ScrollerTestHooks.GetSnapPointInertiaModifiersReusedCount(scroller));
+
+                ScrollerTestHooks.ResetSnapPointInertiaModifiersCounters(scroller);
+
+                Log.Comment("Removing the middle snap point");
+                scroller.HorizontalSnapPoints.Remove(scrollSnapPoint2);
+
+                Log.Comment("Expecting the modifiers of the two remaining snap points to be reused");
+                Verify.AreEqual<int>(0, ScrollerTestHooks.GetSnapPointInertiaModifiersCreatedCount(scroller));
+                Verify.AreEqual<int>(2, ScrollerTestHooks.GetSnapPointInertiaModifiersReusedCount(scroller));
+
+                Vector2 scrollSnapPoint1ApplicableZone = ScrollerTestHooks.GetHorizontalSnapPointActualApplicableZone(scroller, scrollSnapPoint1);
+                Log.Comment("scrollSnapPoint1ApplicableZone=" + scrollSnapPoint1ApplicableZone.ToString());
+                Verify.AreEqual<float>(20.0f, scrollSnapPoint1ApplicableZone.Y);
+            });
+        }
+
         [TestMethod]
         [TestProperty("Description", "Snap to the first instance of a repeated scroll snap point and ensure it is placed after the Start value.")]
         public void SnapToFirstRepeatedScrollSnapPoint()
@@ -0,0 +1,193 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// Cached bounds of the Scroller's registered anchor candidates, kept in the same order as the
+// candidates themselves. Candidates with known bounds are also kept sorted along one axis so that
+// the candidate closest to the viewport anchor point is found by only looking at the ones that
+// overlap the viewport along that axis, instead of at every registered candidate.
+//
+// TRect is winrt::Rect in the control: X, Y, Width and Height members.
+// TLayoutStamp is whatever the owner records along with the bounds to detect layout changes.
+template <typename TRect, typename TLayoutStamp>
+class AnchorCandidateIndex final
+{
+public:
+    int Count() const { return static_cast<int>(m_entries.size()); }
+    bool HasBounds(int position) const { return m_entries[position].HasBounds; }
+    const TRect& Bounds(int position) const { return m_entries[position].Bounds; }
+    const TLayoutStamp& LayoutStamp(int position) const { return m_entries[position].LayoutStamp; }
+
+    void Clear()
+    {
+        m_entries.clear();
+        m_sortedPositions.clear();
+        m_isSortDirty = false;
+    }
+
+    // A new candidate without bounds at the given position.
+    void Insert(int position)
+    {
+        m_entries.insert(m_entries.begin() + position, Entry{});
+        m_isSortDirty = true;
+    }
+
+    void Remove(int position)
+    {
+        m_entries.erase(m_entries.begin() + position);
+        m_isSortDirty = true;
+    }
+
+    void SetBounds(int position, const TRect& bounds, const TLayoutStamp& layoutStamp)
+    {
+        Entry& entry = m_entries[position];
+        if (!entry.HasBounds ||
+            entry.Bounds.X != bounds.X || entry.Bounds.Y != bounds.Y ||
+            entry.Bounds.Width != bounds.Width || entry.Bounds.Height != bounds.Height)
+        {
+            entry.Bounds = bounds;
+            entry.HasBounds = true;
+            m_isSortDirty = true;
+        }
+        entry.LayoutStamp = layoutStamp;
+    }
+
+    // Excludes the candidate from the lookups until it gets bounds again.
+    void ClearBounds(int position)
+    {
+        Entry& entry = m_entries[position];
+        if (entry.HasBounds)
+        {
+            entry.HasBounds = false;
+            m_isSortDirty = true;
+        }
+    }
+
+    // Returns the position of the candidate that intersects with the viewport and has the smallest sum of
+    // squared distances between the anchor point and its edges, or -1. Among equally distant candidates the
+    // last one wins. The anchor point coordinates are NaN in the directions without anchoring.
+    int FindClosestCandidate(
+        const TRect& viewport,
+        double anchorPointX,
+        double anchorPointY)
+    {
+        EnsureSorted(std::isnan(anchorPointY) /*isHorizontal*/);
+
+        // Candidates intersect with the viewport when they overlap it on both axes. Along the sorted axis,
+        // candidates starting after the viewport end are skipped altogether, and so are the ones ending
+        // before the viewport start since none is longer than m_maxMajorLength. The exact test follows.
+        const double viewportMajorStart = MajorStart(viewport);
+        const double viewportMajorEnd = viewportMajorStart + MajorLength(viewport);
+        const double firstMajorStart = viewportMajorStart - m_maxMajorLength - 1.0;
+
+        auto it = std::lower_bound(
+            m_sortedPositions.begin(),
+            m_sortedPositions.end(),
+            firstMajorStart,
+            [this](int position, double majorStart) { return MajorStart(m_entries[position].Bounds) < majorStart; });
+
+        int bestPosition = -1;
+        double bestDistance = std::numeric_limits<float>::max();
+
+        for (; it != m_sortedPositions.end(); ++it)
+        {
+            const int position = *it;
+            const TRect& bounds = m_entries[position].Bounds;
+
+            if (MajorStart(bounds) > viewportMajorEnd + 1.0)
+            {
+                break;
+            }
+
+            if (!DoRectsIntersect(viewport, bounds))
+            {
+                continue;
+            }
+
+            double distance{ 0.0 };
+
+            if (!std::isnan(anchorPointX))
+            {
+                distance += std::pow(anchorPointX - bounds.X, 2);
+                distance += std::pow(anchorPointX - (bounds.X + bounds.Width), 2);
+            }
+
+            if (!std::isnan(anchorPointY))
+            {
+                distance += std::pow(anchorPointY - bounds.Y, 2);
+                distance += std::pow(anchorPointY - (bounds.Y + bounds.Height), 2);
+            }
+
+            if (distance < bestDistance || (distance == bestDistance && position > bestPosition))
+            {
+                bestPosition = position;
+                bestDistance = distance;
+            }
+        }
+
+        return bestPosition;
+    }
+
+private:
+    struct Entry
+    {
+        TRect Bounds{};
+        TLayoutStamp LayoutStamp{};
+        bool HasBounds{ false };
+    };
+
+    // Same as SharedHelpers::DoRectsIntersect.
+    static bool DoRectsIntersect(const TRect& rect1, const TRect& rect2)
+    {
+        return
+            !(rect1.Width <= 0 || rect1.Height <= 0 || rect2.Width <= 0 || rect2.Height <= 0) &&
+            (rect2.X <= rect1.X + rect1.Width) &&
+            (rect2.X + rect2.Width >= rect1.X) &&
+            (rect2.Y <= rect1.Y + rect1.Height) &&
+            (rect2.Y + rect2.Height >= rect1.Y);
+    }
+
+    double MajorStart(const TRect& rect) const { return m_isHorizontal ? rect.X : rect.Y; }
+    double MajorLength(const TRect& rect) const { return m_isHorizontal ? rect.Width : rect.Height; }
+
+    void EnsureSorted(bool isHorizontal)
+    {
+        if (!m_isSortDirty && m_isHorizontal == isHorizontal)
+        {
+            return;
+        }
+
+        m_isHorizontal = isHorizontal;
+        m_sortedPositions.clear();
+        m_maxMajorLength = 0.0;
+
+        for (int position = 0; position < Count(); position++)
+        {
+            if (m_entries[position].HasBounds)
+            {
+                m_sortedPositions.push_back(position);
+                m_maxMajorLength = std::max(m_maxMajorLength, MajorLength(m_entries[position].Bounds));
+            }
+        }
+
+        std::stable_sort(
+            m_sortedPositions.begin(),
+            m_sortedPositions.end(),
+            [this](int left, int right) { return MajorStart(m_entries[left].Bounds) < MajorStart(m_entries[right].Bounds); });
+
+        m_isSortDirty = false;
+    }
+
+    std::vector<Entry> m_entries;
+    // Positions of the candidates with bounds, sorted by their start along the major axis.
+    std::vector<int> m_sortedPositions;
+    double m_maxMajorLength{ 0.0 };
+    bool m_isHorizontal{ false };
+    bool m_isSortDirty{ false };
+};
@@ -0,0 +1,445 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+// Compositor free stand-in for a Scroller and its InteractionTracker. Panning, flings and mouse wheel
+// notches move the position, inertia decays with the InteractionTracker model from ScrollerKinematics
+// and comes to a rest on the snap point that applies to its natural resting offset, and content
+// insertions keep the anchor element in place like Scroller::ArrangeOverride does. Everything is
+// deterministic, so recorded input sequences can be replayed and their end results compared.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "ScrollerKinematics.h"
+#include "SnapPointWrapperIndex.h"
+#include "AnchorCandidateIndex.h"
+
+struct SimulatedRect
+{
+    float X;
+    float Y;
+    float Width;
+    float Height;
+};
+
+// Mandatory irregular scroll snap point, with the applicable zones of ScrollSnapPoint: each snap
+// point applies up to the midpoints with its neighbors.
+class SimulatedSnapPoint final
+{
+public:
+    explicit SimulatedSnapPoint(double value) :
+        m_value(value)
+    {}
+
+    double Value() const { return m_value; }
+    int CombinationCount() const { return m_combinationCount; }
+
+    bool SortsBefore(const SimulatedSnapPoint& other) const { return m_value < other.m_value; }
+    bool IsEquivalentTo(const SimulatedSnapPoint& other) const { return std::abs(m_value - other.m_value) < s_equalityEpsilon; }
+    void Combine(SimulatedSnapPoint*) { m_combinationCount++; }
+
+    void DetermineActualApplicableZone(
+        const SimulatedSnapPoint* previousSnapPoint,
+        const SimulatedSnapPoint* nextSnapPoint,
+        bool forImpulseOnly)
+    {
+        if (!forImpulseOnly)
+        {
+            m_actualApplicableZone = std::make_tuple(
+                previousSnapPoint ? (previousSnapPoint->m_value + m_value) / 2.0 : -INFINITY,
+                nextSnapPoint ? (m_value + nextSnapPoint->m_value) / 2.0 : INFINITY);
+        }
+    }
+
+    std::tuple<double, double> ActualApplicableZone() const { return m_actualApplicableZone; }
+
+    double Evaluate(double value) const
+    {
+        if (value >= std::get<0>(m_actualApplicableZone) && value <= std::get<1>(m_actualApplicableZone))
+        {
+            return m_value;
+        }
+        return value;
+    }
+
+private:
+    static constexpr double s_equalityEpsilon{ 0.00001 };
+
+    double m_value{};
+    std::tuple<double, double> m_actualApplicableZone{ -INFINITY, INFINITY };
+    int m_combinationCount{ 1 };
+};
+
+class ScrollerSimulator final
+{
+public:
+    enum class State
+    {
+        Idle,
+        Interacting,
+        Inertia
+    };
+
+    // Per dimension state: index 0 is horizontal, index 1 is vertical.
+    struct Dimension
+    {
+        float viewport{};
+        float unzoomedExtent{};
+        ScrollerKinematics::ContentAlignment alignment{ ScrollerKinematics::ContentAlignment::Near };
+        float contentLayoutOffset{};
+        double anchorRatio{ NAN };
+        double position{};
+        // Inertia parameters.
+        double inertiaStartPosition{};
+        double inertiaVelocity{};
+        double inertiaDecayRate{ ScrollerKinematics::s_defaultInertiaDecayRate };
+        double naturalRestingPosition{};
+        double restingPosition{};
+        SnapPointWrapperIndex<SimulatedSnapPoint> snapPoints;
+    };
+
+    State GetState() const { return m_state; }
+    float ZoomFactor() const { return m_zoomFactor; }
+    const Dimension& GetDimension(int dimension) const { return m_dimensions[dimension]; }
+    int AnchorCandidate() const { return m_anchorCandidate; }
+    int AnchorSelectionCount() const { return m_anchorSelectionCount; }
+
+    void SetViewport(float width, float height)
+    {
+        m_dimensions[0].viewport = width;
+        m_dimensions[1].viewport = height;
+    }
+
+    void SetExtent(float width, float height)
+    {
+        m_dimensions[0].unzoomedExtent = width;
+        m_dimensions[1].unzoomedExtent = height;
+    }
+
+    void SetContentAlignment(ScrollerKinematics::ContentAlignment horizontal, ScrollerKinematics::ContentAlignment vertical)
+    {
+        m_dimensions[0].alignment = horizontal;
+        m_dimensions[1].alignment = vertical;
+    }
+
+    void SetZoomFactor(float zoomFactor)
+    {
+        m_zoomFactor = zoomFactor;
+        ClampPositions();
+    }
+
+    void SetAnchorRatios(double horizontal, double vertical)
+    {
+        m_dimensions[0].anchorRatio = horizontal;
+        m_dimensions[1].anchorRatio = vertical;
+    }
+
+    void AddSnapPoint(int dimension, double value)
+    {
+        m_dimensions[dimension].snapPoints.Insert(std::make_shared<SimulatedSnapPoint>(value));
+    }
+
+    void AddAnchorCandidate(const SimulatedRect& bounds)
+    {
+        const int position = m_anchorCandidates.Count();
+        m_anchorCandidates.Insert(position);
+        m_anchorCandidates.SetBounds(position, bounds, 0);
+    }
+
+    double MinPosition(int dimension) const
+    {
+        float minPosition{};
+        ComputeMinMaxPosition(dimension, &minPosition, nullptr);
+        return minPosition;
+    }
+
+    double MaxPosition(int dimension) const
+    {
+        float maxPosition{};
+        ComputeMinMaxPosition(dimension, nullptr, &maxPosition);
+        return maxPosition;
+    }
+
+    // Scroller.HorizontalOffset / VerticalOffset.
+    double ZoomedOffset(int dimension) const
+    {
+        return m_dimensions[dimension].position - MinPosition(dimension);
+    }
+
+    // Direct manipulation: the position follows the finger, within the min and max positions.
+    void Pan(double deltaX, double deltaY)
+    {
+        m_state = State::Interacting;
+        m_dimensions[0].position += deltaX;
+        m_dimensions[1].position += deltaY;
+        ClampPositions();
+    }
+
+    // End of a direct manipulation with the given velocities, in pixels per second.
+    void Fling(double velocityX, double velocityY)
+    {
+        StartInertia(velocityX, velocityY, ScrollerKinematics::s_defaultInertiaDecayRate, ScrollerKinematics::s_defaultInertiaDecayRate);
+    }
+
+    // Mouse wheel notch handled like Scroller::ProcessPointerWheelScroll: the velocity is derived from the wheel delta and
+    // added to the ongoing inertia, if any, and is capped so the anticipated end of inertia stays within the scrollable range.
+    void MouseWheel(int32_t mouseWheelDelta, bool isHorizontal, int32_t mouseWheelScrollLinesOrChars, float displayAdjustment)
+    {
+        const int dimension = isHorizontal ? 0 : 1;
+        const float unitVelocity = ScrollerKinematics::MouseWheelUnitVelocity(displayAdjustment, mouseWheelScrollLinesOrChars);
+        const float offsetChangePerVelocityUnit = ScrollerKinematics::MouseWheelOffsetChangePerVelocityUnit(displayAdjustment, mouseWheelScrollLinesOrChars);
+        const float maxVelocity = 4000.0f;
+        float velocity = static_cast<float>(mouseWheelDelta) / ScrollerKinematics::s_mouseWheelDeltaForVelocityUnit * unitVelocity;
+
+        if (!isHorizontal)
+        {
+            velocity *= -1.0f;
+        }
+
+        const Dimension& state = m_dimensions[dimension];
+        const double anticipatedEndOfInertiaPosition = m_state == State::Inertia ? state.restingPosition : state.position;
+
+        if (velocity > 0.0f)
+        {
+            velocity = std::min(maxVelocity, velocity);
+            velocity = std::min(static_cast<float>((MaxPosition(dimension) - anticipatedEndOfInertiaPosition) * unitVelocity / offsetChangePerVelocityUnit), velocity);
+        }
+        else
+        {
+            velocity = std::max(-maxVelocity, velocity);
+            velocity = std::max(static_cast<float>((MinPosition(dimension) - anticipatedEndOfInertiaPosition) * unitVelocity / offsetChangePerVelocityUnit), velocity);
+        }
+
+        double velocities[2]{ CurrentVelocity(0), CurrentVelocity(1) };
+        double decayRates[2]{ m_dimensions[0].inertiaDecayRate, m_dimensions[1].inertiaDecayRate };
+
+        velocities[dimension] = (m_state == State::Inertia ? velocities[dimension] : 0.0) + velocity;
+        decayRates[dimension] = ScrollerKinematics::s_mouseWheelInertiaDecayRate;
+
+        StartInertia(velocities[0], velocities[1], decayRates[0], decayRates[1]);
+    }
+
+    // Advances the inertia by the provided duration. Returns True while the inertia is ongoing.
+    bool Step(double seconds)
+    {
+        if (m_state != State::Inertia)
+        {
+            return false;
+        }
+
+        m_inertiaTime += seconds;
+
+        bool isResting = true;
+
+        for (Dimension& state : m_dimensions)
+        {
+            const double remaining = state.restingPosition - state.inertiaStartPosition;
+
+            // The natural curve is scaled so that it comes to a rest on the snapped resting position.
+            const double progress = ScrollerKinematics::InertiaDisplacement(1.0, state.inertiaDecayRate, m_inertiaTime) /
+                ScrollerKinematics::InertiaRestingDisplacement(1.0, state.inertiaDecayRate);
+
+            state.position = state.inertiaStartPosition + remaining * (std::isnan(progress) ? 1.0 : progress);
+
+            if (std::abs(state.restingPosition - state.position) >= s_restingDistance)
+            {
+                isResting = false;
+            }
+        }
+
+        if (isResting)
+        {
+            for (Dimension& state : m_dimensions)
+            {
+                state.position = state.restingPosition;
+            }
+            m_state = State::Idle;
+        }
+
+        return m_state == State::Inertia;
+    }
+
+    // Content of the given size inserted at the provided unzoomed vertical offset, shifting the anchor candidates
+    // after it. Like Scroller::ArrangeOverride, the anchor element is selected before the layout change and the
+    // offset is adjusted afterwards by the distance the anchor element moved.
+    void InsertVertically(float unzoomedOffset, float size)
+    {
+        double preArrangeAnchorPoint = NAN;
+        const bool isAnchoringVertically = !std::isnan(m_dimensions[1].anchorRatio);
+
+        if (isAnchoringVertically)
+        {
+            SelectAnchorElement();
+
+            if (m_anchorCandidate != -1)
+            {
+                preArrangeAnchorPoint = ElementAnchorPoint(1) - ViewportAnchorPoint(1);
+            }
+        }
+
+        for (int position = 0; position < m_anchorCandidates.Count(); position++)
+        {
+            SimulatedRect bounds = m_anchorCandidates.Bounds(position);
+
+            if (bounds.Y >= unzoomedOffset)
+            {
+                bounds.Y += size;
+                m_anchorCandidates.SetBounds(position, bounds, m_anchorCandidates.LayoutStamp(position) + 1);
+            }
+        }
+
+        m_dimensions[1].unzoomedExtent += size;
+
+        if (!std::isnan(preArrangeAnchorPoint))
+        {
+            const double postArrangeAnchorPoint = ElementAnchorPoint(1) - ViewportAnchorPoint(1);
+
+            if (preArrangeAnchorPoint != postArrangeAnchorPoint)
+            {
+                // Like Scroller::ComputeContentLayoutOffsetDelta, the position is unaffected and the offset changes
+                // through the min position instead.
+                const float contentLayoutOffsetDelta = ScrollerKinematics::ComputeContentLayoutOffsetDelta(
+                    static_cast<float>(postArrangeAnchorPoint - preArrangeAnchorPoint),
+                    m_zoomFactor,
+                    ZoomedOffset(1));
+
+                m_dimensions[1].contentLayoutOffset += contentLayoutOffsetDelta;
+            }
+        }
+
+        ClampPositions();
+    }
+
+private:
+    static constexpr double s_restingDistance = 0.01;
+
+    void ComputeMinMaxPosition(int dimension, float* minPosition, float* maxPosition) const
+    {
+        const Dimension& state = m_dimensions[dimension];
+
+        ScrollerKinematics::ComputeMinMaxPosition(
+            state.alignment,
+            state.unzoomedExtent,
+            m_zoomFactor,
+            state.viewport,
+            state.contentLayoutOffset,
+            minPosition,
+            maxPosition);
+    }
+
+    double CurrentVelocity(int dimension) const
+    {
+        const Dimension& state = m_dimensions[dimension];
+
+        if (m_state != State::Inertia || state.naturalRestingPosition == state.inertiaStartPosition)
+        {
+            return 0.0;
+        }
+
+        // The actual velocity is the natural one, scaled like the curve.
+        const double scale = (state.restingPosition - state.inertiaStartPosition) / (state.naturalRestingPosition - state.inertiaStartPosition);
+        return scale * ScrollerKinematics::InertiaVelocity(state.inertiaVelocity, state.inertiaDecayRate, m_inertiaTime);
+    }
+
+    void StartInertia(double velocityX, double velocityY, double decayRateX, double decayRateY)
+    {
+        const double velocities[2]{ velocityX, velocityY };
+        const double decayRates[2]{ decayRateX, decayRateY };
+
+        for (int dimension = 0; dimension < 2; dimension++)
+        {
+            Dimension& state = m_dimensions[dimension];
+            const double minPosition = MinPosition(dimension);
+            const double maxPosition = MaxPosition(dimension);
+
+            state.inertiaStartPosition = state.position;
+            state.inertiaVelocity = velocities[dimension];
+            state.inertiaDecayRate = decayRates[dimension];
+            state.naturalRestingPosition = std::clamp(
+                state.position + ScrollerKinematics::InertiaRestingDisplacement(velocities[dimension], decayRates[dimension]),
+                minPosition,
+                maxPosition);
+
+            // Same as Scroller::ComputeValueAfterSnapPoints applied to the natural resting offset.
+            if (state.snapPoints.HasInvalidRanges())
+            {
+                state.snapPoints.UpdateRanges(false /*forImpulseOnly*/);
+            }
+
+            double restingOffset = state.naturalRestingPosition - minPosition;
+
+            if (SimulatedSnapPoint* snapPoint = state.snapPoints.FindApplicableSnapPoint(restingOffset))
+            {
+                restingOffset = snapPoint->Evaluate(static_cast<float>(restingOffset));
+            }
+
+            state.restingPosition = std::clamp(restingOffset + minPosition, minPosition, maxPosition);
+        }
+
+        m_inertiaTime = 0.0;
+        m_state = State::Inertia;
+        Step(0.0);
+    }
+
+    void ClampPositions()
+    {
+        for (int dimension = 0; dimension < 2; dimension++)
+        {
+            Dimension& state = m_dimensions[dimension];
+            state.position = std::clamp(state.position, MinPosition(dimension), std::max(MinPosition(dimension), MaxPosition(dimension)));
+        }
+    }
+
+    SimulatedRect ViewportAnchorBounds() const
+    {
+        return SimulatedRect{
+            static_cast<float>(ZoomedOffset(0) / m_zoomFactor),
+            static_cast<float>(ZoomedOffset(1) / m_zoomFactor),
+            m_dimensions[0].viewport / m_zoomFactor,
+            m_dimensions[1].viewport / m_zoomFactor };
+    }
+
+    static double AnchorPoint(const SimulatedRect& bounds, int dimension, double anchorRatio)
+    {
+        if (std::isnan(anchorRatio))
+        {
+            return NAN;
+        }
+        return dimension == 0 ? bounds.X + anchorRatio * bounds.Width : bounds.Y + anchorRatio * bounds.Height;
+    }
+
+    double ViewportAnchorPoint(int dimension) const
+    {
+        return AnchorPoint(ViewportAnchorBounds(), dimension, m_dimensions[dimension].anchorRatio);
+    }
+
+    double ElementAnchorPoint(int dimension) const
+    {
+        return AnchorPoint(m_anchorCandidates.Bounds(m_anchorCandidate), dimension, m_dimensions[dimension].anchorRatio);
+    }
+
+    void SelectAnchorElement()
+    {
+        const SimulatedRect viewportAnchorBounds = ViewportAnchorBounds();
+
+        m_anchorCandidate = m_anchorCandidates.FindClosestCandidate(
+            viewportAnchorBounds,
+            AnchorPoint(viewportAnchorBounds, 0, m_dimensions[0].anchorRatio),
+            AnchorPoint(viewportAnchorBounds, 1, m_dimensions[1].anchorRatio));
+        m_anchorSelectionCount++;
+    }
+
+    State m_state{ State::Idle };
+    float m_zoomFactor{ 1.0f };
+    double m_inertiaTime{};
+    Dimension m_dimensions[2]{};
+    AnchorCandidateIndex<SimulatedRect, int> m_anchorCandidates;
+    int m_anchorCandidate{ -1 };
+    int m_anchorSelectionCount{};
+};
@@ -0,0 +1,339 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+// Replays recorded Scroller input traces against ScrollerSimulator. Every trace is first replayed once
+// with its expectations checked, then replayed repeatedly to report the average time spent per
+// simulated frame. Returns a non zero exit code if a trace fails to parse, if an expectation is not
+// met, or if the average frame exceeds --max-avg-us.
+//
+// Trace files hold one command per line, '#' starts a comment:
+//   viewport <width> <height>                  Scroller viewport size
+//   extent <width> <height>                    unzoomed Content size
+//   alignment <near|center|far> <near|center|far>
+//   zoom <zoomFactor>
+//   anchor-ratios <horizontal|nan> <vertical|nan>
+//   snap-points <h|v> <value>...               irregular mandatory snap points
+//   repeated-snap-points <h|v> <start> <interval> <count>
+//   anchor-candidates <x> <y> <width> <height> <count>   candidates stacked vertically
+//   pan <dx> <dy>
+//   fling <vx> <vy>                            pixels per second
+//   wheel <delta> [lines] [displayAdjustment]  vertical mouse wheel notch
+//   hwheel <delta> [chars] [displayAdjustment] horizontal mouse wheel notch
+//   insert <y> <height>                        Content inserted vertically
+//   frames <count>                             60Hz frames
+//   settle                                     frames until the inertia is over
+//   expect-offset <x|*> <y|*> <tolerance>
+//   expect-state <idle|interacting|inertia>
+//   expect-anchor <candidate index|none>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define MUX_ASSERT(X) assert(X)
+
+#include "ScrollerSimulator.h"
+
+namespace
+{
+    constexpr double FrameDuration = 1.0 / 60.0;
+    constexpr int MaxSettleFrames = 60 * 20;
+
+    struct Options
+    {
+        int iterations{ 200 };
+        double maxAverageMicroseconds{ 0.0 };
+        std::vector<std::string> traces;
+    };
+
+    struct Command
+    {
+        int line{};
+        std::vector<std::string> words{};
+    };
+
+    struct Trace
+    {
+        std::string path;
+        std::vector<Command> commands;
+    };
+
+    struct Result
+    {
+        int64_t frames{};
+        int failures{};
+    };
+
+    bool LoadTrace(const std::string& path, Trace& trace)
+    {
+        std::ifstream stream(path);
+        if (!stream)
+        {
+            fprintf(stderr, "cannot open %s\n", path.c_str());
+            return false;
+        }
+
+        trace.path = path;
+        std::string text;
+        for (int line = 1; std::getline(stream, text); line++)
+        {
+            text = text.substr(0, text.find('#'));
+            std::istringstream words(text);
+            Command command{ line, {} };
+            for (std::string word; words >> word;)
+            {
+                command.words.push_back(word);
+            }
+
+            if (!command.words.empty())
+            {
+                trace.commands.push_back(std::move(command));
+            }
+        }
+
+        return true;
+    }
+
+    double ToDouble(const std::string& word)
+    {
+        return word == "nan" ? NAN : strtod(word.c_str(), nullptr);
+    }
+
+    ScrollerKinematics::ContentAlignment ToAlignment(const std::string& word)
+    {
+        return word == "center" ? ScrollerKinematics::ContentAlignment::Center :
+            word == "far" ? ScrollerKinematics::ContentAlignment::Far : ScrollerKinematics::ContentAlignment::Near;
+    }
+
+    const char* ToString(ScrollerSimulator::State state)
+    {
+        switch (state)
+        {
+        case ScrollerSimulator::State::Interacting:
+            return "interacting";
+        case ScrollerSimulator::State::Inertia:
+            return "inertia";
+        default:
+            return "idle";
+        }
+    }
+
+    // Replays the trace on a new simulator. Failed expectations are reported when verbose is set.
+    Result Replay(const Trace& trace, bool verbose)
+    {
+        ScrollerSimulator simulator;
+        Result result;
+
+        auto fail = [&](const Command& command, const std::string& message)
+        {
+            result.failures++;
+            if (verbose)
+            {
+                fprintf(stderr, "%s:%d: %s\n", trace.path.c_str(), command.line, message.c_str());
+            }
+        };
+
+        for (const Command& command : trace.commands)
+        {
+            const std::vector<std::string>& words = command.words;
+            const std::string& name = words[0];
+            auto arg = [&words](size_t index, double defaultValue = 0.0) { return index < words.size() ? ToDouble(words[index]) : defaultValue; };
+
+            if (name == "viewport")
+            {
+                simulator.SetViewport(static_cast<float>(arg(1)), static_cast<float>(arg(2)));
+            }
+            else if (name == "extent")
+            {
+                simulator.SetExtent(static_cast<float>(arg(1)), static_cast<float>(arg(2)));
+            }
+            else if (name == "alignment" && words.size() == 3)
+            {
+                simulator.SetContentAlignment(ToAlignment(words[1]), ToAlignment(words[2]));
+            }
+            else if (name == "zoom")
+            {
+                simulator.SetZoomFactor(static_cast<float>(arg(1, 1.0)));
+            }
+            else if (name == "anchor-ratios")
+            {
+                simulator.SetAnchorRatios(arg(1, NAN), arg(2, NAN));
+            }
+            else if (name == "snap-points" && words.size() > 1)
+            {
+                for (size_t index = 2; index < words.size(); index++)
+                {
+                    simulator.AddSnapPoint(words[1] == "h" ? 0 : 1, arg(index));
+                }
+            }
+            else if (name == "repeated-snap-points" && words.size() == 5)
+            {
+                for (int index = 0; index < static_cast<int>(arg(4)); index++)
+                {
+                    simulator.AddSnapPoint(words[1] == "h" ? 0 : 1, arg(2) + index * arg(3));
+                }
+            }
+            else if (name == "anchor-candidates")
+            {
+                for (int index = 0; index < static_cast<int>(arg(5)); index++)
+                {
+                    simulator.AddAnchorCandidate(SimulatedRect{
+                        static_cast<float>(arg(1)),
+                        static_cast<float>(arg(2) + index * arg(4)),
+                        static_cast<float>(arg(3)),
+                        static_cast<float>(arg(4)) });
+                }
+            }
+            else if (name == "pan")
+            {
+                simulator.Pan(arg(1), arg(2));
+            }
+            else if (name == "fling")
+            {
+                simulator.Fling(arg(1), arg(2));
+            }
+            else if (name == "wheel" || name == "hwheel")
+            {
+                simulator.MouseWheel(static_cast<int32_t>(arg(1)), name == "hwheel", static_cast<int32_t>(arg(2, 3.0)), static_cast<float>(arg(3, 1.0)));
+            }
+            else if (name == "insert")
+            {
+                simulator.InsertVertically(static_cast<float>(arg(1)), static_cast<float>(arg(2)));
+            }
+            else if (name == "frames")
+            {
+                for (int frame = 0; frame < static_cast<int>(arg(1)); frame++)
+                {
+                    simulator.Step(FrameDuration);
+                    result.frames++;
+                }
+            }
+            else if (name == "settle")
+            {
+                int frame = 0;
+                for (; frame < MaxSettleFrames && simulator.Step(FrameDuration); frame++)
+                {
+                    result.frames++;
+                }
+
+                if (frame == MaxSettleFrames)
+                {
+                    fail(command, "inertia did not settle within " + std::to_string(MaxSettleFrames) + " frames");
+                }
+            }
+            else if (name == "expect-offset" && words.size() == 4)
+            {
+                const double tolerance = arg(3);
+                for (int dimension = 0; dimension < 2; dimension++)
+                {
+                    if (words[dimension + 1] != "*" && std::abs(simulator.ZoomedOffset(dimension) - arg(dimension + 1)) > tolerance)
+                    {
+                        fail(command, std::string(dimension == 0 ? "expected horizontal offset " : "expected vertical offset ") +
+                            std::to_string(arg(dimension + 1)) + ", got " + std::to_string(simulator.ZoomedOffset(dimension)));
+                    }
+                }
+            }
+            else if (name == "expect-state" && words.size() == 2)
+            {
+                if (words[1] != ToString(simulator.GetState()))
+                {
+                    fail(command, "expected state " + words[1] + ", got " + ToString(simulator.GetState()));
+                }
+            }
+            else if (name == "expect-anchor" && words.size() == 2)
+            {
+                const int expected = words[1] == "none" ? -1 : static_cast<int>(arg(1));
+                if (simulator.AnchorCandidate() != expected)
+                {
+                    fail(command, "expected anchor " + std::to_string(expected) + ", got " + std::to_string(simulator.AnchorCandidate()));
+                }
+            }
+            else
+            {
+                fail(command, "unknown command '" + name + "'");
+            }
+        }
+
+        return result;
+    }
+
+    Options ParseOptions(int argc, char* argv[])
+    {
+        Options options;
+        for (int i = 1; i < argc; i++)
+        {
+            if (strcmp(argv[i], "--quick") == 0)
+            {
+                options.iterations = 5;
+            }
+            else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+            {
+                options.iterations = std::max(1, atoi(argv[++i]));
+            }
+            else if (strcmp(argv[i], "--max-avg-us") == 0 && i + 1 < argc)
+            {
+                options.maxAverageMicroseconds = atof(argv[++i]);
+            }
+            else
+            {
+                options.traces.push_back(argv[i]);
+            }
+        }
+        return options;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const Options options = ParseOptions(argc, argv);
+    int exitCode = 0;
+
+    if (options.traces.empty())
+    {
+        fprintf(stderr, "usage: ScrollerSimulatorBenchmark [--quick] [--iterations n] [--max-avg-us us] trace...\n");
+        return 1;
+    }
+
+    printf("%-40s %8s %12s %s\n", "trace", "frames", "avg(us)", "result");
+
+    for (const std::string& path : options.traces)
+    {
+        Trace trace;
+        if (!LoadTrace(path, trace))
+        {
+            exitCode = 1;
+            continue;
+        }
+
+        const Result checked = Replay(trace, true /*verbose*/);
+        int64_t frames = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int iteration = 0; iteration < options.iterations; iteration++)
+        {
+            frames += Replay(trace, false /*verbose*/).frames;
+        }
+        const double elapsedMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        const double averageMicroseconds = frames > 0 ? elapsedMicroseconds / frames : 0.0;
+        const bool tooSlow = options.maxAverageMicroseconds > 0.0 && averageMicroseconds > options.maxAverageMicroseconds;
+
+        const char* name = strrchr(path.c_str(), '/');
+        printf("%-40s %8lld %12.3f %s\n", name ? name + 1 : path.c_str(), static_cast<long long>(checked.frames), averageMicroseconds,
+            checked.failures > 0 ? "FAILED" : tooSlow ? "TOO SLOW" : "ok");
+
+        if (checked.failures > 0 || tooSlow)
+        {
+            exitCode = 1;
+        }
+    }
+
+    return exitCode;
+}
@@ -25,7 +25,7 @@ const double c_scrollerLineDelta = 16.0;
 
 // Default inertia decay rate used when a IScrollController makes a request for
 // an offset change with additional velocity.
-const float c_scrollerDefaultInertiaDecayRate = 0.95f;
+const float c_scrollerDefaultInertiaDecayRate = ScrollerKinematics::s_defaultInertiaDecayRate;
 
 const winrt::ScrollInfo Scroller::s_noOpScrollInfo{ -1 };
 const winrt::ZoomInfo Scroller::s_noOpZoomInfo{ -1 };
@@ -1280,29 +1280,17 @@ float Scroller::ComputeContentLayoutOffsetDelta(ScrollerDimension dimension, flo
 {
     MUX_ASSERT(dimension == ScrollerDimension::HorizontalScroll || dimension == ScrollerDimension::VerticalScroll);
 
-    float zoomedDelta = unzoomedDelta * m_zoomFactor;
-
     if (dimension == ScrollerDimension::HorizontalScroll)
     {
         SCROLLER_TRACE_VERBOSE(*this, TRACE_MSG_METH_FLT_FLT, METH_NAME, this, unzoomedDelta, m_zoomedHorizontalOffset);
 
-        if (zoomedDelta < 0.0f && -zoomedDelta > m_zoomedHorizontalOffset)
-        {
-            // Do not let m_zoomedHorizontalOffset step into negative territory.
-            zoomedDelta = static_cast<float>(-m_zoomedHorizontalOffset);
-        }
-        return -zoomedDelta;
+        return ScrollerKinematics::ComputeContentLayoutOffsetDelta(unzoomedDelta, m_zoomFactor, m_zoomedHorizontalOffset);
     }
     else
     {
         SCROLLER_TRACE_VERBOSE(*this, TRACE_MSG_METH_FLT_FLT, METH_NAME, this, unzoomedDelta, m_zoomedVerticalOffset);
 
-        if (zoomedDelta < 0.0f && -zoomedDelta > m_zoomedVerticalOffset)
-        {
-            // Do not let m_zoomedVerticalOffset step into negative territory.
-            zoomedDelta = static_cast<float>(-m_zoomedVerticalOffset);
-        }
-        return -zoomedDelta;
+        return ScrollerKinematics::ComputeContentLayoutOffsetDelta(unzoomedDelta, m_zoomFactor, m_zoomedVerticalOffset);
     }
 }
 
@@ -1371,113 +1359,42 @@ void Scroller::ComputeMinMaxPositions(float zoomFactor, _Out_opt_ winrt::float2*
     }
 
     const winrt::Visual scrollerVisual = winrt::ElementCompositionPreview::GetElementVisual(*this);
-    float minPosX = 0.0f;
-    float minPosY = 0.0f;
-    float maxPosX = 0.0f;
-    float maxPosY = 0.0f;
-    float extentWidth = static_cast<float>(m_unzoomedExtentWidth);
-    float extentHeight = static_cast<float>(m_unzoomedExtentHeight);
-
-    if (contentAsFE.HorizontalAlignment() == winrt::HorizontalAlignment::Center ||
-        contentAsFE.HorizontalAlignment() == winrt::HorizontalAlignment::Stretch)
-    {
-        float scrollableWidth = extentWidth * zoomFactor - scrollerVisual.Size().x;
-
-        if (minPosition)
-        {
-            // When the zoomed content is smaller than the viewport, scrollableWidth < 0, minPosX is scrollableWidth / 2 so it is centered at idle.
-            // When the zoomed content is larger than the viewport, scrollableWidth > 0, minPosX is 0.
-            minPosX = std::min(0.0f, scrollableWidth / 2.0f);
-        }
-
-        if (maxPosition)
-        {
-            // When the zoomed content is smaller than the viewport, scrollableWidth < 0, maxPosX is scrollableWidth / 2 so it is centered at idle.
-            // When the zoomed content is larger than the viewport, scrollableWidth > 0, maxPosX is scrollableWidth.
-            maxPosX = scrollableWidth;
-            if (maxPosX < 0.0f)
-            {
-                maxPosX /= 2.0f;
-            }
-        }
-    }
-    else if (contentAsFE.HorizontalAlignment() == winrt::HorizontalAlignment::Right)
-    {
-        float scrollableWidth = extentWidth * zoomFactor - scrollerVisual.Size().x;
-
-        if (minPosition)
-        {
-            // When the zoomed content is smaller than the viewport, scrollableWidth < 0, minPosX is scrollableWidth so it is right-aligned at idle.
-            // When the zoomed content is larger than the viewport, scrollableWidth > 0, minPosX is 0.
-            minPosX = std::min(0.0f, scrollableWidth);
-        }
-
-        if (maxPosition)
-        {
-            // When the zoomed content is smaller than the viewport, scrollableWidth < 0, maxPosX is -scrollableWidth so it is right-aligned at idle.
-            // When the zoomed content is larger than the viewport, scrollableWidth > 0, maxPosX is scrollableWidth.
-            maxPosX = scrollableWidth;
-            if (maxPosX < 0.0f)
-            {
-                maxPosX *= -1.0f;
-            }
-        }
-    }
-
-    if (contentAsFE.VerticalAlignment() == winrt::VerticalAlignment::Center ||
-        contentAsFE.VerticalAlignment() == winrt::VerticalAlignment::Stretch)
-    {
-        float scrollableHeight = extentHeight * zoomFactor - scrollerVisual.Size().y;
-
-        if (minPosition)
-        {
-            // When the zoomed content is smaller than the viewport, scrollableHeight < 0, minPosY is scrollableHeight / 2 so it is centered at idle.
-            // When the zoomed content is larger than the viewport, scrollableHeight > 0, minPosY is 0.
-            minPosY = std::min(0.0f, scrollableHeight / 2.0f);
-        }
-
-        if (maxPosition)
-        {
-            // When the zoomed content is smaller than the viewport, scrollableHeight < 0, maxPosY is scrollableHeight / 2 so it is centered at idle.
-            // When the zoomed content is larger than the viewport, scrollableHeight > 0, maxPosY is scrollableHeight.
-            maxPosY = scrollableHeight;
-            if (maxPosY < 0.0f)
-            {
-                maxPosY /= 2.0f;
-            }
-        }
-    }
-    else if (contentAsFE.VerticalAlignment() == winrt::VerticalAlignment::Bottom)
-    {
-        float scrollableHeight = extentHeight * zoomFactor - scrollerVisual.Size().y;
-
-        if (minPosition)
-        {
-            // When the zoomed content is smaller than the viewport, scrollableHeight < 0, minPosY is scrollableHeight so it is bottom-aligned at idle.
-            // When the zoomed content is larger than the viewport, scrollableHeight > 0, minPosY is 0.
-            minPosY = std::min(0.0f, scrollableHeight);
-        }
-
-        if (maxPosition)
-        {
-            // When the zoomed content is smaller than the viewport, scrollableHeight < 0, maxPosY is -scrollableHeight so it is bottom-aligned at idle.
-            // When the zoomed content is larger than the viewport, scrollableHeight > 0, maxPosY is scrollableHeight.
-            maxPosY = scrollableHeight;
-            if (maxPosY < 0.0f)
-            {
-                maxPosY *= -1.0f;
-            }
-        }
-    }
+    const winrt::float2 scrollerVisualSize = scrollerVisual.Size();
+    const winrt::HorizontalAlignment horizontalAlignment = contentAsFE.HorizontalAlignment();
+    const winrt::VerticalAlignment verticalAlignment = contentAsFE.VerticalAlignment();
+    winrt::float2 minPos{};
+    winrt::float2 maxPos{};
+
+    ScrollerKinematics::ComputeMinMaxPosition(
+        horizontalAlignment == winrt::HorizontalAlignment::Center || horizontalAlignment == winrt::HorizontalAlignment::Stretch ?
+            ScrollerKinematics::ContentAlignment::Center :
+            horizontalAlignment == winrt::HorizontalAlignment::Right ? ScrollerKinematics::ContentAlignment::Far : ScrollerKinematics::ContentAlignment::Near,
+        static_cast<float>(m_unzoomedExtentWidth),
+        zoomFactor,
+        scrollerVisualSize.x,
+        m_contentLayoutOffsetX,
+        &minPos.x,
+        &maxPos.x);
+
+    ScrollerKinematics::ComputeMinMaxPosition(
+        verticalAlignment == winrt::VerticalAlignment::Center || verticalAlignment == winrt::VerticalAlignment::Stretch ?
+            ScrollerKinematics::ContentAlignment::Center :
+            verticalAlignment == winrt::VerticalAlignment::Bottom ? ScrollerKinematics::ContentAlignment::Far : ScrollerKinematics::ContentAlignment::Near,
+        static_cast<float>(m_unzoomedExtentHeight),
+        zoomFactor,
+        scrollerVisualSize.y,
+        m_contentLayoutOffsetY,
+        &minPos.y,
+        &maxPos.y);
 
     if (minPosition)
     {
-        *minPosition = winrt::float2(minPosX + m_contentLayoutOffsetX, minPosY + m_contentLayoutOffsetY);
+        *minPosition = minPos;
     }
 
     if (maxPosition)
     {
-        *maxPosition = winrt::float2(maxPosX + m_contentLayoutOffsetX, maxPosY + m_contentLayoutOffsetY);
+        *maxPosition = maxPos;
     }
 }
 
@@ -1495,15 +1412,11 @@ winrt::float2 Scroller::ComputePositionFromOffsets(double zoomedHorizontalOffset
 template <typename T>
 double Scroller::ComputeValueAfterSnapPoints(
     double value,
-    std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>> const& snapPointsSet)
+    SnapPointWrapperIndex<SnapPointWrapper<T>> const& snapPointsSet)
 {
-    for (std::shared_ptr<SnapPointWrapper<T>> snapPointWrapper : snapPointsSet)
+    if (SnapPointWrapper<T>* snapPointWrapper = snapPointsSet.FindApplicableSnapPoint(value))
     {
-        if (std::get<0>(snapPointWrapper->ActualApplicableZone()) <= value &&
-            std::get<1>(snapPointWrapper->ActualApplicableZone()) >= value)
-        {
-            return snapPointWrapper->Evaluate(static_cast<float>(value));
-        }
+        return snapPointWrapper->Evaluate(static_cast<float>(value));
     }
     return value;
 }
@@ -1622,12 +1535,12 @@ void Scroller::ComputeBringIntoViewTargetOffsets(
         targetHeight = m_viewportHeight / m_zoomFactor;
     }
 
-    double targetZoomedHorizontalOffsetTmp = ComputeZoomedOffsetWithMinimalChange(
+    double targetZoomedHorizontalOffsetTmp = ScrollerKinematics::ComputeZoomedOffsetWithMinimalChange(
         m_zoomedHorizontalOffset,
         m_zoomedHorizontalOffset + m_viewportWidth,
         targetX * m_zoomFactor,
         (targetX + targetWidth) * m_zoomFactor);
-    double targetZoomedVerticalOffsetTmp = ComputeZoomedOffsetWithMinimalChange(
+    double targetZoomedVerticalOffsetTmp = ScrollerKinematics::ComputeZoomedOffsetWithMinimalChange(
         m_zoomedVerticalOffset,
         m_zoomedVerticalOffset + m_viewportHeight,
         targetY * m_zoomFactor,
@@ -1942,7 +1855,7 @@ void Scroller::EnsureTransformExpressionAnimations()
 
 template <typename T>
 void Scroller::SetupSnapPoints(
-    std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* snapPointsSet,
+    SnapPointWrapperIndex<SnapPointWrapper<T>>* snapPointsSet,
     ScrollerDimension dimension)
 {
     MUX_ASSERT(!SharedHelpers::IsTH2OrLower());
@@ -1976,7 +1889,8 @@ void Scroller::SetupSnapPoints(
         UpdateSnapPointsIgnoredValue(snapPointsSet, ignoredValue);
     }
 
-    // Update the regular and impulse actual applicable ranges.
+    // Update the regular and impulse actual applicable ranges of the snap points that
+    // were added or are next to an added one.
     UpdateSnapPointsRanges(snapPointsSet, false /*forImpulseOnly*/);
 
     winrt::Compositor compositor = m_interactionTracker.Compositor();
@@ -2064,42 +1978,18 @@ void Scroller::SetupSnapPoints(
 //point will fall on the midpoint or on the Optional neighbor's edge of ApplicableRange, whichever is furthest. 
 template <typename T>
 void Scroller::UpdateSnapPointsRanges(
-    std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* snapPointsSet,
+    SnapPointWrapperIndex<SnapPointWrapper<T>>* snapPointsSet,
     bool forImpulseOnly)
 {
     MUX_ASSERT(snapPointsSet);
 
-    std::shared_ptr<SnapPointWrapper<T>> currentSnapPointWrapper = nullptr;
-    std::shared_ptr<SnapPointWrapper<T>> previousSnapPointWrapper = nullptr;
-    std::shared_ptr<SnapPointWrapper<T>> nextSnapPointWrapper = nullptr;
-
-    for (auto snapPointWrapper : *snapPointsSet)
-    {
-        previousSnapPointWrapper = currentSnapPointWrapper;
-        currentSnapPointWrapper = nextSnapPointWrapper;
-        nextSnapPointWrapper = snapPointWrapper;
-
-        if (currentSnapPointWrapper)
-        {
-            currentSnapPointWrapper->DetermineActualApplicableZone(
-                previousSnapPointWrapper ? previousSnapPointWrapper.get() : nullptr,
-                nextSnapPointWrapper ? nextSnapPointWrapper.get() : nullptr,
-                forImpulseOnly);
-        }
-    }
-
-    if (nextSnapPointWrapper)
-    {
-        nextSnapPointWrapper->DetermineActualApplicableZone(
-            currentSnapPointWrapper ? currentSnapPointWrapper.get() : nullptr,
-            nullptr,
-            forImpulseOnly);
-    }
+    // Only the snap points whose neighborhood changed since the last update are evaluated.
+    snapPointsSet->UpdateRanges(forImpulseOnly);
 }
 
 template <typename T>
 void Scroller::UpdateSnapPointsIgnoredValue(
-    std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* snapPointsSet,
+    SnapPointWrapperIndex<SnapPointWrapper<T>>* snapPointsSet,
     ScrollerDimension dimension)
 {
     const double newIgnoredValue = [this, dimension]()
@@ -2123,18 +2013,16 @@ void Scroller::UpdateSnapPointsIgnoredValue(
         // The ignored snap point value has changed.
         UpdateSnapPointsRanges(snapPointsSet, true /*forImpulseOnly*/);
 
-        winrt::Compositor compositor = m_interactionTracker.Compositor();
         winrt::IVector<winrt::InteractionTrackerInertiaModifier> modifiers = winrt::make<Vector<winrt::InteractionTrackerInertiaModifier>>();
 
         for (auto snapPointWrapper : *snapPointsSet)
         {
-            auto modifier = winrt::InteractionTrackerInertiaRestingValue::Create(compositor);
-            auto const [conditionExpressionAnimation, restingValueExpressionAnimation] = snapPointWrapper->GetUpdatedExpressionAnimationsForImpulse();
+            // The modifier created by SetupSnapPoints already uses the updated expression animations.
+            snapPointWrapper->GetUpdatedExpressionAnimationsForImpulse();
 
-            modifier.Condition(conditionExpressionAnimation);
-            modifier.RestingValue(restingValueExpressionAnimation);
-
-            modifiers.Append(modifier);
+            MUX_ASSERT(snapPointWrapper->InertiaModifier());
+            modifiers.Append(snapPointWrapper->InertiaModifier());
+            m_snapPointInertiaModifiersReusedCount++;
         }
 
         switch (dimension)
@@ -2156,53 +2044,15 @@ void Scroller::UpdateSnapPointsIgnoredValue(
 // Returns True when an old ignored value was reset or a new ignored value was set.
 template <typename T>
 bool Scroller::UpdateSnapPointsIgnoredValue(
-    std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* snapPointsSet,
+    SnapPointWrapperIndex<SnapPointWrapper<T>>* snapPointsSet,
     double newIgnoredValue)
 {
-    bool ignoredValueUpdated = false;
-
-    for (auto snapPointWrapper : *snapPointsSet)
-    {
-        if (snapPointWrapper->ResetIgnoredValue())
-        {
-            ignoredValueUpdated = true;
-            break;
-        }
-    }
-
-    int snapCount = 0;
-
-    for (auto snapPointWrapper : *snapPointsSet)
-    {
-        SnapPointBase* snapPoint = SnapPointWrapper<T>::GetSnapPointFromWrapper(snapPointWrapper);
-
-        snapCount += snapPoint->SnapCount();
-
-        if (snapCount > 1)
-        {
-            break;
-        }
-    }
-
-    if (snapCount > 1)
-    {
-        for (auto snapPointWrapper : *snapPointsSet)
-        {
-            if (snapPointWrapper->SnapsAt(newIgnoredValue))
-            {
-                snapPointWrapper->SetIgnoredValue(newIgnoredValue);
-                ignoredValueUpdated = true;
-                break;
-            }
-        }
-    }
-
-    return ignoredValueUpdated;
+    return snapPointsSet->UpdateIgnoredValue(newIgnoredValue);
 }
 
 template <typename T>
 void Scroller::UpdateSnapPointsInertiaFromImpulse(
-    std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* snapPointsSet,
+    SnapPointWrapperIndex<SnapPointWrapper<T>>* snapPointsSet,
     ScrollerDimension dimension,
     bool isInertiaFromImpulse)
 {
@@ -2210,18 +2060,16 @@ void Scroller::UpdateSnapPointsInertiaFromImpulse(
 
     if (snapPointsSet->size() > 0)
     {
-        winrt::Compositor compositor = m_interactionTracker.Compositor();
         winrt::IVector<winrt::InteractionTrackerInertiaModifier> modifiers = winrt::make<Vector<winrt::InteractionTrackerInertiaModifier>>();
 
         for (auto snapPointWrapper : *snapPointsSet)
         {
-            auto modifier = winrt::InteractionTrackerInertiaRestingValue::Create(compositor);
-            auto const [conditionExpressionAnimation, restingValueExpressionAnimation] = snapPointWrapper->GetUpdatedExpressionAnimationsForImpulse(isInertiaFromImpulse);
+            // The modifier created by SetupSnapPoints already uses the updated expression animations.
+            snapPointWrapper->GetUpdatedExpressionAnimationsForImpulse(isInertiaFromImpulse);
 
-            modifier.Condition(conditionExpressionAnimation);
-            modifier.RestingValue(restingValueExpressionAnimation);
-
-            modifiers.Append(modifier);
+            MUX_ASSERT(snapPointWrapper->InertiaModifier());
+            modifiers.Append(snapPointWrapper->InertiaModifier());
+            m_snapPointInertiaModifiersReusedCount++;
         }
 
         switch (dimension)
@@ -3634,38 +3482,6 @@ winrt::InteractionSourceMode Scroller::InteractionSourceModeFromZoomMode(
     return zoomMode == winrt::ZoomMode::Enabled ? winrt::InteractionSourceMode::EnabledWithInertia : winrt::InteractionSourceMode::Disabled;
 }
 
-double Scroller::ComputeZoomedOffsetWithMinimalChange(
-    double viewportStart,
-    double viewportEnd,
-    double childStart,
-    double childEnd)
-{
-    bool above = childStart < viewportStart && childEnd < viewportEnd;
-    bool below = childEnd > viewportEnd && childStart > viewportStart;
-    bool larger = (childEnd - childStart) > (viewportEnd - viewportStart);
-
-    // # CHILD POSITION   CHILD SIZE   SCROLL   REMEDY
-    // 1 Above viewport   <= viewport  Down     Align top edge of content & viewport
-    // 2 Above viewport   >  viewport  Down     Align bottom edge of content & viewport
-    // 3 Below viewport   <= viewport  Up       Align bottom edge of content & viewport
-    // 4 Below viewport   >  viewport  Up       Align top edge of content & viewport
-    // 5 Entirely within viewport      NA       No change
-    // 6 Spanning viewport             NA       No change
-    if ((above && !larger) || (below && larger))
-    {
-        // Cases 1 & 4
-        return childStart;
-    }
-    else if (above || below)
-    {
-        // Cases 2 & 3
-        return childEnd - viewportEnd + viewportStart;
-    }
-
-    // cases 5 & 6
-    return viewportStart;
-}
-
 winrt::Rect Scroller::GetDescendantBounds(
     const winrt::UIElement& content,
     const winrt::UIElement& descendant,
@@ -3868,21 +3684,22 @@ winrt::float2 Scroller::GetMaxPosition()
 winrt::IVector<winrt::ScrollSnapPointBase> Scroller::GetConsolidatedScrollSnapPoints(ScrollerDimension dimension)
 {
     winrt::IVector<winrt::ScrollSnapPointBase> snapPoints = winrt::make<Vector<winrt::ScrollSnapPointBase>>();
-    std::set<std::shared_ptr<SnapPointWrapper<winrt::ScrollSnapPointBase>>, SnapPointWrapperComparator<winrt::ScrollSnapPointBase>> snapPointsSet;
+    const SnapPointWrapperIndex<SnapPointWrapper<winrt::ScrollSnapPointBase>>* snapPointsSet = nullptr;
 
     switch (dimension)
     {
     case ScrollerDimension::VerticalScroll :
-        snapPointsSet = m_sortedConsolidatedVerticalSnapPoints;
+        snapPointsSet = &m_sortedConsolidatedVerticalSnapPoints;
         break;
     case ScrollerDimension::HorizontalScroll:
-        snapPointsSet = m_sortedConsolidatedHorizontalSnapPoints;
+        snapPointsSet = &m_sortedConsolidatedHorizontalSnapPoints;
         break;
     default:
         MUX_ASSERT(false);
+        return snapPoints;
     }
 
-    for (std::shared_ptr<SnapPointWrapper<winrt::ScrollSnapPointBase>> snapPointWrapper : snapPointsSet)
+    for (std::shared_ptr<SnapPointWrapper<winrt::ScrollSnapPointBase>> snapPointWrapper : *snapPointsSet)
     {
         snapPoints.Append(snapPointWrapper->SnapPoint());
     }
@@ -3902,21 +3719,22 @@ winrt::IVector<winrt::ZoomSnapPointBase> Scroller::GetConsolidatedZoomSnapPoints
 
 SnapPointWrapper<winrt::ScrollSnapPointBase>* Scroller::GetScrollSnapPointWrapper(ScrollerDimension dimension, winrt::ScrollSnapPointBase const& scrollSnapPoint)
 {
-    std::set<std::shared_ptr<SnapPointWrapper<winrt::ScrollSnapPointBase>>, SnapPointWrapperComparator<winrt::ScrollSnapPointBase>> snapPointsSet;
+    const SnapPointWrapperIndex<SnapPointWrapper<winrt::ScrollSnapPointBase>>* snapPointsSet = nullptr;
 
     switch (dimension)
     {
     case ScrollerDimension::VerticalScroll:
-        snapPointsSet = m_sortedConsolidatedVerticalSnapPoints;
+        snapPointsSet = &m_sortedConsolidatedVerticalSnapPoints;
         break;
     case ScrollerDimension::HorizontalScroll:
-        snapPointsSet = m_sortedConsolidatedHorizontalSnapPoints;
+        snapPointsSet = &m_sortedConsolidatedHorizontalSnapPoints;
         break;
     default:
         MUX_ASSERT(false);
+        return nullptr;
     }
 
-    for (std::shared_ptr<SnapPointWrapper<winrt::ScrollSnapPointBase>> snapPointWrapper : snapPointsSet)
+    for (std::shared_ptr<SnapPointWrapper<winrt::ScrollSnapPointBase>> snapPointWrapper : *snapPointsSet)
     {
         winrt::ScrollSnapPointBase winrtScrollSnapPoint = snapPointWrapper->SnapPoint().as<winrt::ScrollSnapPointBase>();
 
@@ -5144,7 +4962,7 @@ template <typename T>
 void Scroller::SnapPointsVectorChangedHelper(
     winrt::IObservableVector<T> const& snapPoints,
     winrt::IVectorChangedEventArgs const& args,
-    std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* snapPointsSet,
+    SnapPointWrapperIndex<SnapPointWrapper<T>>* snapPointsSet,
     ScrollerDimension dimension)
 {
     MUX_ASSERT(!SharedHelpers::IsTH2OrLower());
@@ -5229,50 +5047,32 @@ void Scroller::SnapPointsVectorChangedHelper(
 template <typename T>
 void Scroller::SnapPointsVectorItemInsertedHelper(
     std::shared_ptr<SnapPointWrapper<T>> insertedItem,
-    std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* snapPointsSet)
+    SnapPointWrapperIndex<SnapPointWrapper<T>>* snapPointsSet)
 {
-    if (snapPointsSet->empty())
-    {
-        snapPointsSet->insert(insertedItem);
-        return;
-    }
-
-    winrt::SnapPointBase winrtInsertedItem = insertedItem->SnapPoint().as<winrt::SnapPointBase>();
-    auto lowerBound = snapPointsSet->lower_bound(insertedItem);
-
-    if (lowerBound != snapPointsSet->end())
-    {
-        winrt::SnapPointBase winrtSnapPointBase = (*lowerBound)->SnapPoint().as<winrt::SnapPointBase>();
-        SnapPointBase* lowerSnapPoint = winrt::get_self<SnapPointBase>(winrtSnapPointBase);
-
-        if (*lowerSnapPoint == winrt::get_self<SnapPointBase>(winrtInsertedItem))
-        {
-            (*lowerBound)->Combine(insertedItem.get());
-            return;
-        }
-        lowerBound++;
-    }
-    if (lowerBound != snapPointsSet->end())
-    {
-        winrt::SnapPointBase winrtSnapPointBase = (*lowerBound)->SnapPoint().as<winrt::SnapPointBase>();
-        SnapPointBase* upperSnapPoint = winrt::get_self<SnapPointBase>(winrtSnapPointBase);
-
-        if (*upperSnapPoint == winrt::get_self<SnapPointBase>(winrtInsertedItem))
-        {
-            (*lowerBound)->Combine(insertedItem.get());
-            return;
-        }
-    }
-    snapPointsSet->insert(insertedItem);
+    // Combines the new snap point with an equivalent one, or inserts it in sorted order. Either
+    // way only the ranges of that snap point and of its neighbors are invalidated.
+    snapPointsSet->Insert(insertedItem);
 }
 
 template <typename T>
 void Scroller::RegenerateSnapPointsSet(
     winrt::IObservableVector<T> const& userVector,
-    std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* internalSet)
+    SnapPointWrapperIndex<SnapPointWrapper<T>>* internalSet)
 {
     MUX_ASSERT(internalSet);
 
+    // Remember the current wrappers so that the snap points that remain consolidated keep their
+    // inertia modifier and expression animations instead of having SetupSnapPoints recreate them.
+    std::unordered_map<SnapPointBase*, std::shared_ptr<SnapPointWrapper<T>>> previousSnapPointWrappers;
+
+    for (auto snapPointWrapper : *internalSet)
+    {
+        if (snapPointWrapper->InertiaModifier())
+        {
+            previousSnapPointWrappers.emplace(SnapPointWrapper<T>::GetSnapPointFromWrapper(snapPointWrapper), snapPointWrapper);
+        }
+    }
+
     internalSet->clear();
     for (T snapPoint : userVector)
     {
@@ -5281,6 +5081,19 @@ void Scroller::RegenerateSnapPointsSet(
 
         SnapPointsVectorItemInsertedHelper(snapPointWrapper, internalSet);
     }
+
+    if (!previousSnapPointWrappers.empty())
+    {
+        for (auto snapPointWrapper : *internalSet)
+        {
+            auto previousSnapPointWrapper = previousSnapPointWrappers.find(SnapPointWrapper<T>::GetSnapPointFromWrapper(snapPointWrapper));
+
+            if (previousSnapPointWrapper != previousSnapPointWrappers.end())
+            {
+                snapPointWrapper->AdoptInertiaModifier(*previousSnapPointWrapper->second);
+            }
+        }
+    }
 }
 
 void Scroller::UpdateContent(
@@ -6279,9 +6092,9 @@ void Scroller::ProcessPointerWheelScroll(
     // Maximum absolute velocity. Any additional velocity has no effect.
     const float c_maxVelocity = 4000.0f;
     // Velocity per unit (which is a mouse wheel delta of 120 by default). That is the velocity required to achieve a change of c_offsetChangePerVelocityUnit pixels.
-    const float c_unitVelocity = 0.524140190972223f * c_displayAdjustment * mouseWheelScrollLinesOrChars;
+    const float c_unitVelocity = ScrollerKinematics::MouseWheelUnitVelocity(c_displayAdjustment, mouseWheelScrollLinesOrChars);
     // Effect of unit velocity on offset, to match the built-in RS5 behavior.
-    const float c_offsetChangePerVelocityUnit = 0.05f * mouseWheelScrollLinesOrChars * c_displayAdjustment;
+    const float c_offsetChangePerVelocityUnit = ScrollerKinematics::MouseWheelOffsetChangePerVelocityUnit(c_displayAdjustment, mouseWheelScrollLinesOrChars);
 
     std::shared_ptr<OffsetsChangeWithAdditionalVelocity> offsetsChangeWithAdditionalVelocity = nullptr;
     float offsetVelocity = static_cast<float>(mouseWheelDelta) / mouseWheelDeltaForVelocityUnit * c_unitVelocity;
@@ -7408,9 +7221,20 @@ winrt::InteractionTrackerInertiaRestingValue Scroller::GetInertiaRestingValue(
     std::shared_ptr<SnapPointWrapper<T>> snapPointWrapper,
     winrt::Compositor const& compositor,
     winrt::hstring const& target,
-    winrt::hstring const& scale) const
+    winrt::hstring const& scale)
 {
     bool isInertiaFromImpulse = IsInertiaFromImpulse();
+
+    if (winrt::InteractionTrackerInertiaRestingValue modifier = snapPointWrapper->InertiaModifier())
+    {
+        // The snap point was already set up, possibly with other neighbors or another viewport size.
+        // Its expression animations are kept and only the parameters that changed are updated.
+        snapPointWrapper->UpdateExpressionAnimations(isInertiaFromImpulse);
+        m_snapPointInertiaModifiersReusedCount++;
+
+        return modifier;
+    }
+
     winrt::InteractionTrackerInertiaRestingValue modifier = winrt::InteractionTrackerInertiaRestingValue::Create(compositor);
     winrt::ExpressionAnimation conditionExpressionAnimation = snapPointWrapper->CreateConditionalExpression(m_interactionTracker, target, scale, isInertiaFromImpulse);
     winrt::ExpressionAnimation restingPointExpressionAnimation = snapPointWrapper->CreateRestingPointExpression(m_interactionTracker, target, scale, isInertiaFromImpulse);
@@ -7418,6 +7242,9 @@ winrt::InteractionTrackerInertiaRestingValue Scroller::GetInertiaRestingValue(
     modifier.Condition(conditionExpressionAnimation);
     modifier.RestingValue(restingPointExpressionAnimation);
 
+    snapPointWrapper->InertiaModifier(modifier);
+    m_snapPointInertiaModifiersCreatedCount++;
+
     return modifier;
 }
 
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "FloatUtil.h"
 #include "InteractionTrackerAsyncOperation.h"
 #include "ScrollAnimationStartingEventArgs.h"
@@ -11,7 +13,10 @@
 #include "ZoomCompletedEventArgs.h"
 #include "ScrollerBringingIntoViewEventArgs.h"
 #include "ScrollerAnchorRequestedEventArgs.h"
+#include "AnchorCandidateIndex.h"
 #include "SnapPointWrapper.h"
+#include "SnapPointWrapperIndex.h"
+#include "ScrollerKinematics.h"
 #include "ScrollerTrace.h"
 #include "ViewChange.h"
 #include "OffsetsChange.h"
@@ -79,14 +84,10 @@ public:
     // rasterization to be triggered after the Idle State is reached or a zoom factor change operation completed.
     static constexpr int s_translationAndZoomFactorAnimationsRestartTicks = 4;
 
-    // Mouse-wheel-triggered scrolling/zooming constants
-    // Mouse wheel delta amount required per initial velocity unit
-    // 120 matches the built-in InteractionTracker scrolling/zooming behavior introduced in RS5.
-    static constexpr int32_t s_mouseWheelDeltaForVelocityUnit = 120;
-    // Inertia decay rate to achieve the c_zoomFactorChangePerVelocityUnit=0.1f zoom factor change per velocity unit
-    static constexpr float s_mouseWheelInertiaDecayRateRS1 = 0.997361f;
-    // 0.999972 closely matches the built-in InteractionTracker scrolling/zooming behavior introduced in RS5.
-    static constexpr float s_mouseWheelInertiaDecayRate = 0.999972f;
+    // Mouse-wheel-triggered scrolling/zooming constants, see ScrollerKinematics.
+    static constexpr int32_t s_mouseWheelDeltaForVelocityUnit = ScrollerKinematics::s_mouseWheelDeltaForVelocityUnit;
+    static constexpr float s_mouseWheelInertiaDecayRateRS1 = ScrollerKinematics::s_mouseWheelInertiaDecayRateRS1;
+    static constexpr float s_mouseWheelInertiaDecayRate = ScrollerKinematics::s_mouseWheelInertiaDecayRate;
 
     static const winrt::ScrollInfo s_noOpScrollInfo;
     static const winrt::ZoomInfo s_noOpZoomInfo;
@@ -247,6 +248,23 @@ public:
     SnapPointWrapper<winrt::ScrollSnapPointBase>* GetScrollSnapPointWrapper(ScrollerDimension dimension, winrt::ScrollSnapPointBase const& scrollSnapPoint);
     SnapPointWrapper<winrt::ZoomSnapPointBase>* GetZoomSnapPointWrapper(winrt::ZoomSnapPointBase const& zoomSnapPoint);
 
+    // Number of snap point inertia modifiers created vs. reused when setting up snap points, for testing purposes.
+    int GetSnapPointInertiaModifiersCreatedCount() const
+    {
+        return m_snapPointInertiaModifiersCreatedCount;
+    }
+
+    int GetSnapPointInertiaModifiersReusedCount() const
+    {
+        return m_snapPointInertiaModifiersReusedCount;
+    }
+
+    void ResetSnapPointInertiaModifiersCounters()
+    {
+        m_snapPointInertiaModifiersCreatedCount = 0;
+        m_snapPointInertiaModifiersReusedCount = 0;
+    }
+
     // Invoked when a dependency property of this Scroller has changed.
     void OnPropertyChanged(
         const winrt::DependencyPropertyChangedEventArgs& args);
@@ -295,7 +313,7 @@ private:
     winrt::float2 ComputeEndOfInertiaPosition();
     void ComputeMinMaxPositions(float zoomFactor, _Out_opt_ winrt::float2* minPosition, _Out_opt_ winrt::float2* maxPosition);
     winrt::float2 ComputePositionFromOffsets(double zoomedHorizontalOffset, double zoomedVerticalOffset);
-    template <typename T> double ComputeValueAfterSnapPoints(double value, std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>> const& snapPointsSet);
+    template <typename T> double ComputeValueAfterSnapPoints(double value, SnapPointWrapperIndex<SnapPointWrapper<T>> const& snapPointsSet);
     winrt::float2 ComputeCenterPointerForMouseWheelZooming(const winrt::UIElement& content, const winrt::Point& pointerPosition) const;
     void ComputeBringIntoViewTargetOffsets(
         const winrt::UIElement& content,
@@ -318,19 +336,19 @@ private:
     void EnsurePositionBoundariesExpressionAnimations();
     void EnsureTransformExpressionAnimations();
     template <typename T> void SetupSnapPoints(
-        std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* snapPointsSet,
+        SnapPointWrapperIndex<SnapPointWrapper<T>>* snapPointsSet,
         ScrollerDimension dimension);
     template <typename T> void UpdateSnapPointsRanges(
-        std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* snapPointsSet,
+        SnapPointWrapperIndex<SnapPointWrapper<T>>* snapPointsSet,
         bool forImpulseOnly);
     template <typename T> void UpdateSnapPointsIgnoredValue(
-        std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* snapPointsSet,
+        SnapPointWrapperIndex<SnapPointWrapper<T>>* snapPointsSet,
         ScrollerDimension dimension);
     template <typename T> bool UpdateSnapPointsIgnoredValue(
-        std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* snapPointsSet,
+        SnapPointWrapperIndex<SnapPointWrapper<T>>* snapPointsSet,
         double newIgnoredValue);
     template <typename T> void UpdateSnapPointsInertiaFromImpulse(
-        std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* snapPointsSet,
+        SnapPointWrapperIndex<SnapPointWrapper<T>>* snapPointsSet,
         ScrollerDimension dimension,
         bool isInertiaFromImpulse);
     void SetupInteractionTrackerBoundaries();
@@ -518,7 +536,7 @@ private:
         std::shared_ptr<SnapPointWrapper<T>> snapPointWrapper,
         winrt::Compositor const& compositor,
         winrt::hstring const& target,
-        winrt::hstring const& scale) const;
+        winrt::hstring const& scale);
 
 #ifdef USE_SCROLLMODE_AUTO
     winrt::ScrollMode GetComputedScrollMode(ScrollerDimension dimension, bool ignoreZoomMode = false);
@@ -673,14 +691,14 @@ private:
     template <typename T> void SnapPointsVectorChangedHelper(
         winrt::IObservableVector<T> const& scrollSnapPoints,
         winrt::IVectorChangedEventArgs const& args,
-        std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* snapPointsSet,
+        SnapPointWrapperIndex<SnapPointWrapper<T>>* snapPointsSet,
         ScrollerDimension dimension);
     template <typename T> void SnapPointsVectorItemInsertedHelper(
         std::shared_ptr<SnapPointWrapper<T>> insertedItem,
-        std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* snapPointsSet);
+        SnapPointWrapperIndex<SnapPointWrapper<T>>* snapPointsSet);
     template <typename T> void RegenerateSnapPointsSet(
         winrt::IObservableVector<T> const& userVector,
-        std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* internalSet);
+        SnapPointWrapperIndex<SnapPointWrapper<T>>* internalSet);
 
 #pragma region IRepeaterScrollingSurface Helpers
     void RaiseConfigurationChanged();
@@ -713,6 +731,7 @@ private:
     void ClearAnchorCandidates();
     void ResetAnchorElement();
     void EnsureAnchorElementSelection();
+    void UpdateAnchorCandidatesBounds(const winrt::UIElement& content);
 
     void ProcessAnchorCandidate(
         const winrt::UIElement& anchorCandidate,
@@ -731,6 +750,30 @@ private:
     static bool IsElementValidAnchor(
         const winrt::UIElement& element,
         const winrt::UIElement& content);
+
+    // Layout properties recorded along with the cached bounds of an anchor candidate. The cached bounds
+    // are reused as long as the candidate's layout slot, size, alignments and parent bounds are unchanged.
+    struct AnchorCandidateLayoutStamp
+    {
+        winrt::Rect LayoutSlot{};
+        winrt::Size ActualSize{};
+        winrt::Thickness Margin{};
+        winrt::HorizontalAlignment HorizontalAlignment{};
+        winrt::VerticalAlignment VerticalAlignment{};
+        winrt::FlowDirection FlowDirection{};
+        void* Parent{ nullptr };
+        winrt::Rect ParentBounds{};
+        // False when the candidate's bounds cannot be deduced from the properties above, for instance
+        // because it has a render transform. Its bounds are then re-evaluated each time.
+        bool IsStable{ false };
+
+        bool operator==(const AnchorCandidateLayoutStamp& other) const;
+    };
+
+    static AnchorCandidateLayoutStamp GetAnchorCandidateLayoutStamp(
+        const winrt::UIElement& anchorCandidate,
+        const winrt::UIElement& content,
+        std::unordered_map<void*, winrt::Rect>& parentsBounds);
 #pragma endregion
 
     static winrt::InteractionChainingMode InteractionChainingModeFromChainingMode(
@@ -748,12 +791,6 @@ private:
     static winrt::InteractionSourceMode InteractionSourceModeFromZoomMode(
         const winrt::ZoomMode& zoomMode);
 
-    static double ComputeZoomedOffsetWithMinimalChange(
-        double viewportStart,
-        double viewportEnd,
-        double childStart,
-        double childEnd);
-
     static winrt::Rect GetDescendantBounds(
         const winrt::UIElement& content,
         const winrt::UIElement& descendant,
@@ -790,6 +827,8 @@ private:
     bool m_verticalSnapPointsNeedViewportUpdates{ false }; // True when at least one vertical snap point is not near aligned.
     bool m_isAnchorElementDirty{ true }; // False when m_anchorElement is up-to-date, True otherwise.
     bool m_isInertiaFromImpulse{ false }; // Only used on pre-RS5 versions, as a replacement for the InteractionTracker.IsInertiaFromImpulse property.
+    int m_snapPointInertiaModifiersCreatedCount{ 0 };
+    int m_snapPointInertiaModifiersReusedCount{ 0 };
 
     // Display information used for mouse-wheel scrolling on pre-RS5 Windows versions.
     double m_rawPixelsPerViewPixel{};
@@ -809,6 +848,8 @@ private:
     tracker_ref<winrt::UIElement> m_anchorElement{ this };
     tracker_ref<winrt::ScrollerAnchorRequestedEventArgs> m_anchorRequestedEventArgs{ this };
     std::vector<tracker_ref<winrt::UIElement>> m_anchorCandidates;
+    // Cached bounds of the m_anchorCandidates elements, in the same order.
+    AnchorCandidateIndex<winrt::Rect, AnchorCandidateLayoutStamp> m_anchorCandidatesIndex;
     std::list<std::shared_ptr<InteractionTrackerAsyncOperation>> m_interactionTrackerAsyncOperations;
     winrt::Rect m_anchorElementBounds{};
     winrt::InteractionState m_state{ winrt::InteractionState::Idle };
@@ -885,9 +926,9 @@ private:
     winrt::IVector<winrt::ScrollSnapPointBase> m_horizontalSnapPoints{};
     winrt::IVector<winrt::ScrollSnapPointBase> m_verticalSnapPoints{};
     winrt::IVector<winrt::ZoomSnapPointBase> m_zoomSnapPoints{};
-    std::set<std::shared_ptr<SnapPointWrapper<winrt::ScrollSnapPointBase>>, SnapPointWrapperComparator<winrt::ScrollSnapPointBase>> m_sortedConsolidatedHorizontalSnapPoints{};
-    std::set<std::shared_ptr<SnapPointWrapper<winrt::ScrollSnapPointBase>>, SnapPointWrapperComparator<winrt::ScrollSnapPointBase>> m_sortedConsolidatedVerticalSnapPoints{};
-    std::set<std::shared_ptr<SnapPointWrapper<winrt::ZoomSnapPointBase>>, SnapPointWrapperComparator<winrt::ZoomSnapPointBase>> m_sortedConsolidatedZoomSnapPoints{};
+    SnapPointWrapperIndex<SnapPointWrapper<winrt::ScrollSnapPointBase>> m_sortedConsolidatedHorizontalSnapPoints{};
+    SnapPointWrapperIndex<SnapPointWrapper<winrt::ScrollSnapPointBase>> m_sortedConsolidatedVerticalSnapPoints{};
+    SnapPointWrapperIndex<SnapPointWrapper<winrt::ZoomSnapPointBase>> m_sortedConsolidatedZoomSnapPoints{};
 
     // Maximum difference for offsets to be considered equal. Used for pointer wheel scrolling.
     static constexpr float s_offsetEqualityEpsilon{ 0.00001f };
@@ -284,6 +284,7 @@ void Scroller::ClearAnchorCandidates()
     SCROLLER_TRACE_VERBOSE(*this, TRACE_MSG_METH, METH_NAME, this);
 
     m_anchorCandidates.clear();
+    m_anchorCandidatesIndex.Clear();
     m_isAnchorElementDirty = true;
 }
 
@@ -388,19 +389,19 @@ void Scroller::EnsureAnchorElementSelection()
     }
     else
     {
-        for (tracker_ref<winrt::UIElement> anchorCandidateTracker : m_anchorCandidates)
-        {
-            const winrt::UIElement anchorCandidate = anchorCandidateTracker.get();
+        // The registered candidates' bounds are cached and only re-evaluated when their layout changed,
+        // and the closest one is then found without visiting the candidates outside the viewport.
+        UpdateAnchorCandidatesBounds(content);
 
-            ProcessAnchorCandidate(
-                anchorCandidate,
-                content,
-                viewportAnchorBounds,
-                viewportAnchorPointHorizontalOffset,
-                viewportAnchorPointVerticalOffset,
-                &bestAnchorCandidateDistance,
-                &bestAnchorCandidate,
-                &bestAnchorCandidateBounds);
+        const int bestAnchorCandidatePosition = m_anchorCandidatesIndex.FindClosestCandidate(
+            viewportAnchorBounds,
+            viewportAnchorPointHorizontalOffset,
+            viewportAnchorPointVerticalOffset);
+
+        if (bestAnchorCandidatePosition != -1)
+        {
+            bestAnchorCandidate = m_anchorCandidates[bestAnchorCandidatePosition].get();
+            bestAnchorCandidateBounds = m_anchorCandidatesIndex.Bounds(bestAnchorCandidatePosition);
         }
     }
 
@@ -418,6 +419,38 @@ void Scroller::EnsureAnchorElementSelection()
     }
 }
 
+// Refreshes the cached bounds of the registered anchor candidates. Candidates that are not valid anchors are
+// excluded from the index. The others only have their bounds re-evaluated when their layout stamp changed.
+void Scroller::UpdateAnchorCandidatesBounds(const winrt::UIElement& content)
+{
+    MUX_ASSERT(content);
+    MUX_ASSERT(m_anchorCandidatesIndex.Count() == static_cast<int>(m_anchorCandidates.size()));
+
+    // Bounds of the candidates' parents in the Content coordinates, evaluated once per parent.
+    std::unordered_map<void*, winrt::Rect> parentsBounds;
+
+    for (int position = 0; position < m_anchorCandidatesIndex.Count(); position++)
+    {
+        const winrt::UIElement anchorCandidate = m_anchorCandidates[position].get();
+
+        if (!IsElementValidAnchor(anchorCandidate, content))
+        {
+            // Ignore candidates that are collapsed or do not belong to the Content element and are not the Content itself.
+            m_anchorCandidatesIndex.ClearBounds(position);
+            continue;
+        }
+
+        const AnchorCandidateLayoutStamp layoutStamp = GetAnchorCandidateLayoutStamp(anchorCandidate, content, parentsBounds);
+
+        if (!layoutStamp.IsStable ||
+            !m_anchorCandidatesIndex.HasBounds(position) ||
+            !(m_anchorCandidatesIndex.LayoutStamp(position) == layoutStamp))
+        {
+            m_anchorCandidatesIndex.SetBounds(position, GetDescendantBounds(content, anchorCandidate), layoutStamp);
+        }
+    }
+}
+
 // Checks if the provided anchor candidate is better than the current best, based on its distance to the viewport anchor point,
 // and potentially updates the best candidate and its bounds.
 void Scroller::ProcessAnchorCandidate(
@@ -489,6 +522,69 @@ winrt::Rect Scroller::GetDescendantBounds(
     return GetDescendantBounds(content, descendant, descendantRect);
 }
 
+Scroller::AnchorCandidateLayoutStamp Scroller::GetAnchorCandidateLayoutStamp(
+    const winrt::UIElement& anchorCandidate,
+    const winrt::UIElement& content,
+    std::unordered_map<void*, winrt::Rect>& parentsBounds)
+{
+    AnchorCandidateLayoutStamp layoutStamp{};
+    const winrt::FrameworkElement anchorCandidateAsFE = anchorCandidate.try_as<winrt::FrameworkElement>();
+
+    if (!anchorCandidateAsFE || anchorCandidate.RenderTransform() || anchorCandidate.Projection())
+    {
+        return layoutStamp;
+    }
+
+    if (auto anchorCandidateAsUIElement5 = anchorCandidate.try_as<winrt::IUIElement5>())
+    {
+        if (anchorCandidateAsUIElement5.Transform3D())
+        {
+            return layoutStamp;
+        }
+    }
+
+    const winrt::UIElement parent = winrt::VisualTreeHelper::GetParent(anchorCandidate).try_as<winrt::UIElement>();
+
+    if (!parent)
+    {
+        return layoutStamp;
+    }
+
+    void* parentAbi = winrt::get_abi(parent);
+    auto parentBoundsIt = parentsBounds.find(parentAbi);
+
+    if (parentBoundsIt == parentsBounds.end())
+    {
+        // A unit square captures the parent's offset as well as its scaling in the Content coordinates.
+        parentBoundsIt = parentsBounds.emplace(parentAbi, GetDescendantBounds(content, parent, winrt::Rect{ 0.0f, 0.0f, 1.0f, 1.0f })).first;
+    }
+
+    layoutStamp.LayoutSlot = winrt::LayoutInformation::GetLayoutSlot(anchorCandidateAsFE);
+    layoutStamp.ActualSize = winrt::Size{ static_cast<float>(anchorCandidateAsFE.ActualWidth()), static_cast<float>(anchorCandidateAsFE.ActualHeight()) };
+    layoutStamp.Margin = anchorCandidateAsFE.Margin();
+    layoutStamp.HorizontalAlignment = anchorCandidateAsFE.HorizontalAlignment();
+    layoutStamp.VerticalAlignment = anchorCandidateAsFE.VerticalAlignment();
+    layoutStamp.FlowDirection = anchorCandidateAsFE.FlowDirection();
+    layoutStamp.Parent = parentAbi;
+    layoutStamp.ParentBounds = parentBoundsIt->second;
+    layoutStamp.IsStable = true;
+
+    return layoutStamp;
+}
+
+bool Scroller::AnchorCandidateLayoutStamp::operator==(const AnchorCandidateLayoutStamp& other) const
+{
+    return IsStable == other.IsStable &&
+        LayoutSlot == other.LayoutSlot &&
+        ActualSize == other.ActualSize &&
+        Margin == other.Margin &&
+        HorizontalAlignment == other.HorizontalAlignment &&
+        VerticalAlignment == other.VerticalAlignment &&
+        FlowDirection == other.FlowDirection &&
+        Parent == other.Parent &&
+        ParentBounds == other.ParentBounds;
+}
+
 bool Scroller::IsElementValidAnchor(const winrt::UIElement& element, const winrt::UIElement& content)
 {
     MUX_ASSERT(element);
@@ -0,0 +1,174 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// Offset, zoom and inertia math of the Scroller that does not depend on the compositor or on XAML, so that
+// it can be exercised by the headless simulator in dev/Scroller/Benchmarks as well as by the control.
+class ScrollerKinematics final
+{
+public:
+    // InteractionTracker.PositionInertiaDecayRate used by the Scroller when none is specified.
+    static constexpr float s_defaultInertiaDecayRate = 0.95f;
+
+    // Mouse-wheel-triggered scrolling/zooming constants
+    // Mouse wheel delta amount required per initial velocity unit
+    // 120 matches the built-in InteractionTracker scrolling/zooming behavior introduced in RS5.
+    static constexpr int32_t s_mouseWheelDeltaForVelocityUnit = 120;
+    // Inertia decay rate to achieve the c_zoomFactorChangePerVelocityUnit=0.1f zoom factor change per velocity unit
+    static constexpr float s_mouseWheelInertiaDecayRateRS1 = 0.997361f;
+    // 0.999972 closely matches the built-in InteractionTracker scrolling/zooming behavior introduced in RS5.
+    static constexpr float s_mouseWheelInertiaDecayRate = 0.999972f;
+
+    // Alignment of the Content within the Scroller along one dimension. Stretch behaves like Center.
+    enum class ContentAlignment
+    {
+        Near,
+        Center,
+        Far
+    };
+
+    // InteractionTracker inertia multiplies the velocity by (1 - decayRate) every second, so the distance
+    // covered after t seconds is velocity * (1 - (1 - decayRate)^t) / -ln(1 - decayRate).
+    static double InertiaDisplacement(double velocity, double decayRate, double seconds)
+    {
+        if (decayRate >= 1.0)
+        {
+            return 0.0;
+        }
+
+        const double retainedRate = 1.0 - decayRate;
+        return velocity * (1.0 - std::pow(retainedRate, seconds)) / -std::log(retainedRate);
+    }
+
+    static double InertiaVelocity(double velocity, double decayRate, double seconds)
+    {
+        return decayRate >= 1.0 ? 0.0 : velocity * std::pow(1.0 - decayRate, seconds);
+    }
+
+    // Distance covered by the time the inertia comes to a rest, when no snap point applies.
+    static double InertiaRestingDisplacement(double velocity, double decayRate)
+    {
+        return decayRate >= 1.0 ? 0.0 : velocity / -std::log(1.0 - decayRate);
+    }
+
+    // Velocity for a mouse wheel delta of s_mouseWheelDeltaForVelocityUnit, given the display adjustment in view pixels
+    // and the WheelScrollLines or WheelScrollChars setting.
+    static float MouseWheelUnitVelocity(float displayAdjustment, int32_t mouseWheelScrollLinesOrChars)
+    {
+        return 0.524140190972223f * displayAdjustment * mouseWheelScrollLinesOrChars;
+    }
+
+    // Effect of unit velocity on offset, to match the built-in RS5 behavior.
+    static float MouseWheelOffsetChangePerVelocityUnit(float displayAdjustment, int32_t mouseWheelScrollLinesOrChars)
+    {
+        return 0.05f * mouseWheelScrollLinesOrChars * displayAdjustment;
+    }
+
+    // Determines the InteractionTracker min and max positions along one dimension based on the Content alignment and
+    // unzoomed extent, and the viewport size. Either output can be null.
+    static void ComputeMinMaxPosition(
+        ContentAlignment alignment,
+        float unzoomedExtent,
+        float zoomFactor,
+        float viewport,
+        float contentLayoutOffset,
+        float* minPosition,
+        float* maxPosition)
+    {
+        float minPos = 0.0f;
+        float maxPos = 0.0f;
+
+        if (alignment == ContentAlignment::Near)
+        {
+            // Like the InteractionTracker.MaxPosition expression, the near-aligned content can be scrolled by its excess size, if any.
+            maxPos = std::max(0.0f, unzoomedExtent * zoomFactor - viewport);
+        }
+        else if (alignment == ContentAlignment::Center)
+        {
+            const float scrollableSize = unzoomedExtent * zoomFactor - viewport;
+
+            // When the zoomed content is smaller than the viewport, scrollableSize < 0, minPos and maxPos are scrollableSize / 2 so it is centered at idle.
+            // When the zoomed content is larger than the viewport, scrollableSize > 0, minPos is 0 and maxPos is scrollableSize.
+            minPos = std::min(0.0f, scrollableSize / 2.0f);
+            maxPos = scrollableSize;
+            if (maxPos < 0.0f)
+            {
+                maxPos /= 2.0f;
+            }
+        }
+        else if (alignment == ContentAlignment::Far)
+        {
+            const float scrollableSize = unzoomedExtent * zoomFactor - viewport;
+
+            // When the zoomed content is smaller than the viewport, scrollableSize < 0, minPos is scrollableSize and maxPos is -scrollableSize so it is far-aligned at idle.
+            // When the zoomed content is larger than the viewport, scrollableSize > 0, minPos is 0 and maxPos is scrollableSize.
+            minPos = std::min(0.0f, scrollableSize);
+            maxPos = scrollableSize;
+            if (maxPos < 0.0f)
+            {
+                maxPos *= -1.0f;
+            }
+        }
+
+        if (minPosition)
+        {
+            *minPosition = minPos + contentLayoutOffset;
+        }
+
+        if (maxPosition)
+        {
+            *maxPosition = maxPos + contentLayoutOffset;
+        }
+    }
+
+    // Returns the Content layout offset change compensating for an anchor point move of unzoomedDelta, so that the anchor
+    // stays put in the viewport. The zoomed offset does not step into negative territory.
+    static float ComputeContentLayoutOffsetDelta(float unzoomedDelta, float zoomFactor, double zoomedOffset)
+    {
+        float zoomedDelta = unzoomedDelta * zoomFactor;
+
+        if (zoomedDelta < 0.0f && -zoomedDelta > zoomedOffset)
+        {
+            zoomedDelta = static_cast<float>(-zoomedOffset);
+        }
+        return -zoomedDelta;
+    }
+
+    // Returns the viewport start that brings the child into view with the smallest change.
+    static double ComputeZoomedOffsetWithMinimalChange(
+        double viewportStart,
+        double viewportEnd,
+        double childStart,
+        double childEnd)
+    {
+        const bool above = childStart < viewportStart && childEnd < viewportEnd;
+        const bool below = childEnd > viewportEnd && childStart > viewportStart;
+        const bool larger = (childEnd - childStart) > (viewportEnd - viewportStart);
+
+        // # CHILD POSITION   CHILD SIZE   SCROLL   REMEDY
+        // 1 Above viewport   <= viewport  Down     Align top edge of content & viewport
+        // 2 Above viewport   >  viewport  Down     Align bottom edge of content & viewport
+        // 3 Below viewport   <= viewport  Up       Align bottom edge of content & viewport
+        // 4 Below viewport   >  viewport  Up       Align top edge of content & viewport
+        // 5 Entirely within viewport      NA       No change
+        // 6 Spanning viewport             NA       No change
+        if ((above && !larger) || (below && larger))
+        {
+            // Cases 1 & 4
+            return childStart;
+        }
+        else if (above || below)
+        {
+            // Cases 2 & 3
+            return childEnd - viewportEnd + viewportStart;
+        }
+
+        // cases 5 & 6
+        return viewportStart;
+    }
+};
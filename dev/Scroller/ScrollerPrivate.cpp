@@ -126,6 +126,7 @@ void Scroller::RegisterAnchorCandidate(winrt::UIElement const& element)
 #endif // _DEBUG
 
         m_anchorCandidates.push_back(tracker_ref<winrt::UIElement>{ this, element });
+        m_anchorCandidatesIndex.Insert(m_anchorCandidatesIndex.Count());
         m_isAnchorElementDirty = true;
     }
 }
@@ -143,6 +144,7 @@ void Scroller::UnregisterAnchorCandidate(winrt::UIElement const& element)
     const auto it = std::find_if(m_anchorCandidates.cbegin(), m_anchorCandidates.cend(), [&anchorCandidate](const tracker_ref<winrt::UIElement>& a) { return a.get() == anchorCandidate; });
     if (it != m_anchorCandidates.cend())
     {
+        m_anchorCandidatesIndex.Remove(static_cast<int>(std::distance(m_anchorCandidates.cbegin(), it)));
         m_anchorCandidates.erase(it);
         m_isAnchorElementDirty = true;
     }
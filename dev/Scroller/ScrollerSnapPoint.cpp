@@ -221,7 +221,7 @@ winrt::ExpressionAnimation ScrollSnapPoint::CreateRestingPointExpression(
 
     auto restingPointExpressionAnimation = interactionTracker.Compositor().CreateExpressionAnimation(expression);
 
-    SetScalarParameter(restingPointExpressionAnimation, s_snapPointValue, static_cast<float>(ActualValue()));
+    UpdateRestingPointExpressionAnimation(restingPointExpressionAnimation);
 
     return restingPointExpressionAnimation;
 }
@@ -266,8 +266,9 @@ winrt::ExpressionAnimation ScrollSnapPoint::CreateConditionalExpression(
 
     auto conditionExpressionAnimation = interactionTracker.Compositor().CreateExpressionAnimation(expression);
 
-    SetScalarParameter(conditionExpressionAnimation, s_minApplicableValue, static_cast<float>(std::get<0>(actualApplicableZone)));
-    SetScalarParameter(conditionExpressionAnimation, s_maxApplicableValue, static_cast<float>(std::get<1>(actualApplicableZone)));
+    UpdateConditionalExpressionAnimation(
+        conditionExpressionAnimation,
+        actualApplicableZone);
 
     UpdateConditionalExpressionAnimationForImpulse(
         conditionExpressionAnimation,
@@ -280,6 +281,20 @@ winrt::ExpressionAnimation ScrollSnapPoint::CreateConditionalExpression(
     return conditionExpressionAnimation;
 }
 
+void ScrollSnapPoint::UpdateConditionalExpressionAnimation(
+    winrt::ExpressionAnimation const& conditionExpressionAnimation,
+    std::tuple<double, double> actualApplicableZone) const
+{
+    SetScalarParameter(conditionExpressionAnimation, s_minApplicableValue, static_cast<float>(std::get<0>(actualApplicableZone)));
+    SetScalarParameter(conditionExpressionAnimation, s_maxApplicableValue, static_cast<float>(std::get<1>(actualApplicableZone)));
+}
+
+void ScrollSnapPoint::UpdateRestingPointExpressionAnimation(
+    winrt::ExpressionAnimation const& restingValueExpressionAnimation) const
+{
+    SetScalarParameter(restingValueExpressionAnimation, s_snapPointValue, static_cast<float>(ActualValue()));
+}
+
 void ScrollSnapPoint::UpdateConditionalExpressionAnimationForImpulse(
     winrt::ExpressionAnimation const& conditionExpressionAnimation,
     std::tuple<double, double> actualImpulseApplicableZone) const
@@ -715,9 +730,7 @@ winrt::ExpressionAnimation RepeatedScrollSnapPoint::CreateRestingPointExpression
 
     auto restingPointExpressionAnimation = interactionTracker.Compositor().CreateExpressionAnimation(expression);
 
-    SetScalarParameter(restingPointExpressionAnimation, s_interval, static_cast<float>(m_interval));
-    SetScalarParameter(restingPointExpressionAnimation, s_end, static_cast<float>(ActualEnd()));
-    SetScalarParameter(restingPointExpressionAnimation, s_first, static_cast<float>(DetermineFirstRepeatedSnapPointValue()));
+    UpdateRestingPointExpressionAnimation(restingPointExpressionAnimation);
     restingPointExpressionAnimation.SetReferenceParameter(s_interactionTracker, interactionTracker);
 
     UpdateRestingPointExpressionAnimationForImpulse(
@@ -776,11 +789,9 @@ winrt::ExpressionAnimation RepeatedScrollSnapPoint::CreateConditionalExpression(
 
     auto conditionExpressionAnimation = interactionTracker.Compositor().CreateExpressionAnimation(expression);
 
-    SetScalarParameter(conditionExpressionAnimation, s_interval, static_cast<float>(m_interval));
-    SetScalarParameter(conditionExpressionAnimation, s_first, static_cast<float>(DetermineFirstRepeatedSnapPointValue()));
-    SetScalarParameter(conditionExpressionAnimation, s_start, static_cast<float>(ActualStart()));
-    SetScalarParameter(conditionExpressionAnimation, s_end, static_cast<float>(ActualEnd()));
-    SetScalarParameter(conditionExpressionAnimation, s_applicableRange, static_cast<float>(m_specifiedApplicableRange));
+    UpdateConditionalExpressionAnimation(
+        conditionExpressionAnimation,
+        actualApplicableZone);
     conditionExpressionAnimation.SetReferenceParameter(s_interactionTracker, interactionTracker);
 
     UpdateConditionalExpressionAnimationForImpulse(
@@ -794,6 +805,28 @@ winrt::ExpressionAnimation RepeatedScrollSnapPoint::CreateConditionalExpression(
     return conditionExpressionAnimation;
 }
 
+void RepeatedScrollSnapPoint::UpdateConditionalExpressionAnimation(
+    winrt::ExpressionAnimation const& conditionExpressionAnimation,
+    std::tuple<double, double> actualApplicableZone) const
+{
+    MUX_ASSERT(std::get<0>(actualApplicableZone) == ActualStart());
+    MUX_ASSERT(std::get<1>(actualApplicableZone) == ActualEnd());
+
+    SetScalarParameter(conditionExpressionAnimation, s_interval, static_cast<float>(m_interval));
+    SetScalarParameter(conditionExpressionAnimation, s_first, static_cast<float>(DetermineFirstRepeatedSnapPointValue()));
+    SetScalarParameter(conditionExpressionAnimation, s_start, static_cast<float>(ActualStart()));
+    SetScalarParameter(conditionExpressionAnimation, s_end, static_cast<float>(ActualEnd()));
+    SetScalarParameter(conditionExpressionAnimation, s_applicableRange, static_cast<float>(m_specifiedApplicableRange));
+}
+
+void RepeatedScrollSnapPoint::UpdateRestingPointExpressionAnimation(
+    winrt::ExpressionAnimation const& restingValueExpressionAnimation) const
+{
+    SetScalarParameter(restingValueExpressionAnimation, s_interval, static_cast<float>(m_interval));
+    SetScalarParameter(restingValueExpressionAnimation, s_end, static_cast<float>(ActualEnd()));
+    SetScalarParameter(restingValueExpressionAnimation, s_first, static_cast<float>(DetermineFirstRepeatedSnapPointValue()));
+}
+
 void RepeatedScrollSnapPoint::UpdateConditionalExpressionAnimationForImpulse(
     winrt::ExpressionAnimation const& conditionExpressionAnimation,
     std::tuple<double, double> actualImpulseApplicableZone) const
@@ -1148,7 +1181,7 @@ winrt::ExpressionAnimation ZoomSnapPoint::CreateRestingPointExpression(
 
     auto restingPointExpressionAnimation = interactionTracker.Compositor().CreateExpressionAnimation(s_snapPointValue);
 
-    SetScalarParameter(restingPointExpressionAnimation, s_snapPointValue, static_cast<float>(m_value));
+    UpdateRestingPointExpressionAnimation(restingPointExpressionAnimation);
 
     UpdateExpressionAnimationForImpulse(
         restingPointExpressionAnimation,
@@ -1181,8 +1214,9 @@ winrt::ExpressionAnimation ZoomSnapPoint::CreateConditionalExpression(
 
     auto conditionExpressionAnimation = interactionTracker.Compositor().CreateExpressionAnimation(expression);
 
-    SetScalarParameter(conditionExpressionAnimation, s_minApplicableValue, static_cast<float>(std::get<0>(actualApplicableZone)));
-    SetScalarParameter(conditionExpressionAnimation, s_maxApplicableValue, static_cast<float>(std::get<1>(actualApplicableZone)));
+    UpdateConditionalExpressionAnimation(
+        conditionExpressionAnimation,
+        actualApplicableZone);
 
     UpdateConditionalExpressionAnimationForImpulse(
         conditionExpressionAnimation,
@@ -1195,6 +1229,20 @@ winrt::ExpressionAnimation ZoomSnapPoint::CreateConditionalExpression(
     return conditionExpressionAnimation;
 }
 
+void ZoomSnapPoint::UpdateConditionalExpressionAnimation(
+    winrt::ExpressionAnimation const& conditionExpressionAnimation,
+    std::tuple<double, double> actualApplicableZone) const
+{
+    SetScalarParameter(conditionExpressionAnimation, s_minApplicableValue, static_cast<float>(std::get<0>(actualApplicableZone)));
+    SetScalarParameter(conditionExpressionAnimation, s_maxApplicableValue, static_cast<float>(std::get<1>(actualApplicableZone)));
+}
+
+void ZoomSnapPoint::UpdateRestingPointExpressionAnimation(
+    winrt::ExpressionAnimation const& restingValueExpressionAnimation) const
+{
+    SetScalarParameter(restingValueExpressionAnimation, s_snapPointValue, static_cast<float>(m_value));
+}
+
 void ZoomSnapPoint::UpdateConditionalExpressionAnimationForImpulse(
     winrt::ExpressionAnimation const& conditionExpressionAnimation,
     std::tuple<double, double> actualImpulseApplicableZone) const
@@ -1618,9 +1666,7 @@ winrt::ExpressionAnimation RepeatedZoomSnapPoint::CreateRestingPointExpression(
 
     auto restingPointExpressionAnimation = interactionTracker.Compositor().CreateExpressionAnimation(expression);
 
-    SetScalarParameter(restingPointExpressionAnimation, s_interval, static_cast<float>(m_interval));
-    SetScalarParameter(restingPointExpressionAnimation, s_end, static_cast<float>(m_end));
-    SetScalarParameter(restingPointExpressionAnimation, s_first, static_cast<float>(DetermineFirstRepeatedSnapPointValue()));
+    UpdateRestingPointExpressionAnimation(restingPointExpressionAnimation);
     restingPointExpressionAnimation.SetReferenceParameter(s_interactionTracker, interactionTracker);
 
     UpdateRestingPointExpressionAnimationForImpulse(
@@ -1680,11 +1726,9 @@ winrt::ExpressionAnimation RepeatedZoomSnapPoint::CreateConditionalExpression(
 
     auto conditionExpressionAnimation = interactionTracker.Compositor().CreateExpressionAnimation(expression);
 
-    SetScalarParameter(conditionExpressionAnimation, s_interval, static_cast<float>(m_interval));
-    SetScalarParameter(conditionExpressionAnimation, s_first, static_cast<float>(DetermineFirstRepeatedSnapPointValue()));
-    SetScalarParameter(conditionExpressionAnimation, s_start, static_cast<float>(m_start));
-    SetScalarParameter(conditionExpressionAnimation, s_end, static_cast<float>(m_end));
-    SetScalarParameter(conditionExpressionAnimation, s_applicableRange, static_cast<float>(m_specifiedApplicableRange));
+    UpdateConditionalExpressionAnimation(
+        conditionExpressionAnimation,
+        actualApplicableZone);
     conditionExpressionAnimation.SetReferenceParameter(s_interactionTracker, interactionTracker);
 
     UpdateConditionalExpressionAnimationForImpulse(
@@ -1698,6 +1742,28 @@ winrt::ExpressionAnimation RepeatedZoomSnapPoint::CreateConditionalExpression(
     return conditionExpressionAnimation;
 }
 
+void RepeatedZoomSnapPoint::UpdateConditionalExpressionAnimation(
+    winrt::ExpressionAnimation const& conditionExpressionAnimation,
+    std::tuple<double, double> actualApplicableZone) const
+{
+    MUX_ASSERT(std::get<0>(actualApplicableZone) == m_start);
+    MUX_ASSERT(std::get<1>(actualApplicableZone) == m_end);
+
+    SetScalarParameter(conditionExpressionAnimation, s_interval, static_cast<float>(m_interval));
+    SetScalarParameter(conditionExpressionAnimation, s_first, static_cast<float>(DetermineFirstRepeatedSnapPointValue()));
+    SetScalarParameter(conditionExpressionAnimation, s_start, static_cast<float>(m_start));
+    SetScalarParameter(conditionExpressionAnimation, s_end, static_cast<float>(m_end));
+    SetScalarParameter(conditionExpressionAnimation, s_applicableRange, static_cast<float>(m_specifiedApplicableRange));
+}
+
+void RepeatedZoomSnapPoint::UpdateRestingPointExpressionAnimation(
+    winrt::ExpressionAnimation const& restingValueExpressionAnimation) const
+{
+    SetScalarParameter(restingValueExpressionAnimation, s_interval, static_cast<float>(m_interval));
+    SetScalarParameter(restingValueExpressionAnimation, s_end, static_cast<float>(m_end));
+    SetScalarParameter(restingValueExpressionAnimation, s_first, static_cast<float>(DetermineFirstRepeatedSnapPointValue()));
+}
+
 void RepeatedZoomSnapPoint::UpdateConditionalExpressionAnimationForImpulse(
     winrt::ExpressionAnimation const& conditionExpressionAnimation,
     std::tuple<double, double> actualImpulseApplicableZone) const
@@ -55,6 +55,12 @@ public:
         winrt::hstring const& target,
         winrt::hstring const& scale,
         bool isInertiaFromImpulse) = 0;
+    // Refresh the parameters of expressions created earlier by CreateConditionalExpression and CreateRestingPointExpression.
+    virtual void UpdateConditionalExpressionAnimation(
+        winrt::ExpressionAnimation const& conditionExpressionAnimation,
+        std::tuple<double, double> actualApplicableZone) const = 0;
+    virtual void UpdateRestingPointExpressionAnimation(
+        winrt::ExpressionAnimation const& restingValueExpressionAnimation) const = 0;
     virtual void UpdateConditionalExpressionAnimationForImpulse(
         winrt::ExpressionAnimation const& conditionExpressionAnimation,
         std::tuple<double, double> actualImpulseApplicableZone) const = 0;
@@ -188,6 +194,11 @@ public:
         winrt::hstring const& target,
         winrt::hstring const& scale,
         bool isInertiaFromImpulse);
+    void UpdateConditionalExpressionAnimation(
+        winrt::ExpressionAnimation const& conditionExpressionAnimation,
+        std::tuple<double, double> actualApplicableZone) const;
+    void UpdateRestingPointExpressionAnimation(
+        winrt::ExpressionAnimation const& restingValueExpressionAnimation) const;
     void UpdateConditionalExpressionAnimationForImpulse(
         winrt::ExpressionAnimation const& conditionExpressionAnimation,
         std::tuple<double, double> actualImpulseApplicableZone) const;
@@ -277,6 +288,11 @@ public:
         winrt::hstring const& target,
         winrt::hstring const& scale,
         bool isInertiaFromImpulse);
+    void UpdateConditionalExpressionAnimation(
+        winrt::ExpressionAnimation const& conditionExpressionAnimation,
+        std::tuple<double, double> actualApplicableZone) const;
+    void UpdateRestingPointExpressionAnimation(
+        winrt::ExpressionAnimation const& restingValueExpressionAnimation) const;
     void UpdateConditionalExpressionAnimationForImpulse(
         winrt::ExpressionAnimation const& conditionExpressionAnimation,
         std::tuple<double, double> actualImpulseApplicableZone) const;
@@ -381,6 +397,11 @@ public:
         winrt::hstring const& target,
         winrt::hstring const& scale,
         bool isInertiaFromImpulse);
+    void UpdateConditionalExpressionAnimation(
+        winrt::ExpressionAnimation const& conditionExpressionAnimation,
+        std::tuple<double, double> actualApplicableZone) const;
+    void UpdateRestingPointExpressionAnimation(
+        winrt::ExpressionAnimation const& restingValueExpressionAnimation) const;
     void UpdateConditionalExpressionAnimationForImpulse(
         winrt::ExpressionAnimation const& conditionExpressionAnimation,
         std::tuple<double, double> actualImpulseApplicableZone) const;
@@ -467,6 +488,11 @@ public:
         winrt::hstring const& target,
         winrt::hstring const& scale,
         bool isInertiaFromImpulse);
+    void UpdateConditionalExpressionAnimation(
+        winrt::ExpressionAnimation const& conditionExpressionAnimation,
+        std::tuple<double, double> actualApplicableZone) const;
+    void UpdateRestingPointExpressionAnimation(
+        winrt::ExpressionAnimation const& restingValueExpressionAnimation) const;
     void UpdateConditionalExpressionAnimationForImpulse(
         winrt::ExpressionAnimation const& conditionExpressionAnimation,
         std::tuple<double, double> actualImpulseApplicableZone) const;
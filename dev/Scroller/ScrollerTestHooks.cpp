@@ -507,6 +507,32 @@ int ScrollerTestHooks::GetZoomSnapPointCombinationCount(
     }
 }
 
+int ScrollerTestHooks::GetSnapPointInertiaModifiersCreatedCount(const winrt::Scroller& scroller)
+{
+    if (scroller)
+    {
+        return winrt::get_self<Scroller>(scroller)->GetSnapPointInertiaModifiersCreatedCount();
+    }
+    return 0;
+}
+
+int ScrollerTestHooks::GetSnapPointInertiaModifiersReusedCount(const winrt::Scroller& scroller)
+{
+    if (scroller)
+    {
+        return winrt::get_self<Scroller>(scroller)->GetSnapPointInertiaModifiersReusedCount();
+    }
+    return 0;
+}
+
+void ScrollerTestHooks::ResetSnapPointInertiaModifiersCounters(const winrt::Scroller& scroller)
+{
+    if (scroller)
+    {
+        winrt::get_self<Scroller>(scroller)->ResetSnapPointInertiaModifiersCounters();
+    }
+}
+
 winrt::Color ScrollerTestHooks::GetSnapPointVisualizationColor(const winrt::SnapPointBase& snapPoint)
 {
 
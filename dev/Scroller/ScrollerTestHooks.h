@@ -96,6 +96,9 @@ public:
     static int GetZoomSnapPointCombinationCount(
         const winrt::Scroller& scroller,
         const winrt::ZoomSnapPointBase& zoomSnapPoint);
+    static int GetSnapPointInertiaModifiersCreatedCount(const winrt::Scroller& scroller);
+    static int GetSnapPointInertiaModifiersReusedCount(const winrt::Scroller& scroller);
+    static void ResetSnapPointInertiaModifiersCounters(const winrt::Scroller& scroller);
     static winrt::Color GetSnapPointVisualizationColor(const winrt::SnapPointBase& snapPoint);
     static void SetSnapPointVisualizationColor(const winrt::SnapPointBase& snapPoint, const winrt::Color& color);
 
@@ -9,6 +9,8 @@ template<typename T>
 SnapPointWrapper<T>::SnapPointWrapper(T const& snapPoint)
     : m_snapPoint(snapPoint)
 {
+    winrt::SnapPointBase winrtSnapPoint = m_snapPoint.as<winrt::SnapPointBase>();
+    m_snapPointBase = winrt::get_self<SnapPointBase>(winrtSnapPoint);
 }
 
 #ifdef _DEBUG
@@ -70,6 +72,7 @@ winrt::ExpressionAnimation SnapPointWrapper<T>::CreateRestingPointExpression(
         target,
         scale,
         isInertiaFromImpulse);
+    RecordExpressionAnimationsParameters(isInertiaFromImpulse);
 
     return m_restingValueExpressionAnimation;
 }
@@ -88,10 +91,94 @@ winrt::ExpressionAnimation SnapPointWrapper<T>::CreateConditionalExpression(
         target,
         scale,
         isInertiaFromImpulse);
+    RecordExpressionAnimationsParameters(isInertiaFromImpulse);
 
     return m_conditionExpressionAnimation;
 }
 
+template<typename T>
+winrt::InteractionTrackerInertiaRestingValue SnapPointWrapper<T>::InertiaModifier() const
+{
+    return m_inertiaModifier;
+}
+
+template<typename T>
+void SnapPointWrapper<T>::InertiaModifier(winrt::InteractionTrackerInertiaRestingValue const& inertiaModifier)
+{
+    m_inertiaModifier = inertiaModifier;
+}
+
+// Invoked when the snap points are regenerated, to take over the modifier and expression animations of the
+// previous wrapper of the same snap point. UpdateExpressionAnimations then refreshes what changed in the meantime.
+template<typename T>
+void SnapPointWrapper<T>::AdoptInertiaModifier(SnapPointWrapper<T> const& snapPointWrapper)
+{
+    MUX_ASSERT(m_snapPointBase == snapPointWrapper.m_snapPointBase);
+    MUX_ASSERT(!m_inertiaModifier);
+
+    m_inertiaModifier = snapPointWrapper.m_inertiaModifier;
+    m_conditionExpressionAnimation = snapPointWrapper.m_conditionExpressionAnimation;
+    m_restingValueExpressionAnimation = snapPointWrapper.m_restingValueExpressionAnimation;
+    m_expressionsSortPredicate = snapPointWrapper.m_expressionsSortPredicate;
+    m_expressionsApplicableZone = snapPointWrapper.m_expressionsApplicableZone;
+    m_expressionsImpulseApplicableZone = snapPointWrapper.m_expressionsImpulseApplicableZone;
+    m_expressionsIgnoredValue = snapPointWrapper.m_expressionsIgnoredValue;
+    m_expressionsIsInertiaFromImpulse = snapPointWrapper.m_expressionsIsInertiaFromImpulse;
+}
+
+// Invoked instead of CreateConditionalExpression and CreateRestingPointExpression when the expression animations
+// already exist. Only the parameters that changed since they were last set are updated.
+template<typename T>
+void SnapPointWrapper<T>::UpdateExpressionAnimations(bool isInertiaFromImpulse)
+{
+    MUX_ASSERT(m_conditionExpressionAnimation);
+    MUX_ASSERT(m_restingValueExpressionAnimation);
+
+    SnapPointBase* snapPoint = GetSnapPointFromWrapper(this);
+    const ScrollerSnapPointSortPredicate sortPredicate = snapPoint->SortPredicate();
+    // Snap points that are not near-aligned move when the viewport is resized.
+    const bool hasMoved =
+        sortPredicate.primary != m_expressionsSortPredicate.primary ||
+        sortPredicate.secondary != m_expressionsSortPredicate.secondary;
+    const bool hasIgnoredValueChanged =
+        !(isnan(m_ignoredValue) && isnan(m_expressionsIgnoredValue)) && m_ignoredValue != m_expressionsIgnoredValue;
+
+    if (hasMoved)
+    {
+        snapPoint->UpdateRestingPointExpressionAnimation(m_restingValueExpressionAnimation);
+    }
+
+    if (hasMoved || m_actualApplicableZone != m_expressionsApplicableZone)
+    {
+        snapPoint->UpdateConditionalExpressionAnimation(
+            m_conditionExpressionAnimation,
+            m_actualApplicableZone);
+    }
+
+    if (hasMoved || hasIgnoredValueChanged || m_actualImpulseApplicableZone != m_expressionsImpulseApplicableZone)
+    {
+        snapPoint->UpdateConditionalExpressionAnimationForImpulse(
+            m_conditionExpressionAnimation,
+            m_actualImpulseApplicableZone);
+        snapPoint->UpdateRestingPointExpressionAnimationForImpulse(
+            m_restingValueExpressionAnimation,
+            m_ignoredValue,
+            m_actualImpulseApplicableZone);
+    }
+
+    if (isInertiaFromImpulse != m_expressionsIsInertiaFromImpulse)
+    {
+        snapPoint->UpdateExpressionAnimationForImpulse(
+            m_conditionExpressionAnimation,
+            isInertiaFromImpulse);
+        snapPoint->UpdateExpressionAnimationForImpulse(
+            m_restingValueExpressionAnimation,
+            isInertiaFromImpulse);
+    }
+
+    RecordExpressionAnimationsParameters(isInertiaFromImpulse);
+}
+
 // Invoked when the InteractionTracker reaches the Idle State and a new ignored value may have to be set.
 template<typename T>
 std::tuple<winrt::ExpressionAnimation, winrt::ExpressionAnimation> SnapPointWrapper<T>::GetUpdatedExpressionAnimationsForImpulse()
@@ -105,6 +192,7 @@ std::tuple<winrt::ExpressionAnimation, winrt::ExpressionAnimation> SnapPointWrap
         m_restingValueExpressionAnimation,
         m_ignoredValue,
         m_actualImpulseApplicableZone);
+    RecordExpressionAnimationsImpulseParameters();
 
     return std::make_tuple(m_conditionExpressionAnimation, m_restingValueExpressionAnimation);
 }
@@ -125,6 +213,7 @@ std::tuple<winrt::ExpressionAnimation, winrt::ExpressionAnimation> SnapPointWrap
     snapPoint->UpdateExpressionAnimationForImpulse(
         m_restingValueExpressionAnimation,
         isInertiaFromImpulse);
+    m_expressionsIsInertiaFromImpulse = isInertiaFromImpulse;
 
     return std::make_tuple(m_conditionExpressionAnimation, m_restingValueExpressionAnimation);
 }
@@ -174,6 +263,24 @@ bool SnapPointWrapper<T>::SnapsAt(double value) const
     return GetSnapPointFromWrapper(this)->SnapsAt(m_actualApplicableZone, value);
 }
 
+template<typename T>
+int SnapPointWrapper<T>::SnapCount() const
+{
+    return GetSnapPointFromWrapper(this)->SnapCount();
+}
+
+template<typename T>
+bool SnapPointWrapper<T>::SortsBefore(SnapPointWrapper<T> const& snapPointWrapper) const
+{
+    return *GetSnapPointFromWrapper(this) < GetSnapPointFromWrapper(&snapPointWrapper);
+}
+
+template<typename T>
+bool SnapPointWrapper<T>::IsEquivalentTo(SnapPointWrapper<T> const& snapPointWrapper) const
+{
+    return *GetSnapPointFromWrapper(this) == GetSnapPointFromWrapper(&snapPointWrapper);
+}
+
 template<typename T>
 SnapPointBase* SnapPointWrapper<T>::GetSnapPointFromWrapper(std::shared_ptr<SnapPointWrapper<T>> snapPointWrapper)
 {
@@ -185,12 +292,27 @@ SnapPointBase* SnapPointWrapper<T>::GetSnapPointFromWrapper(const SnapPointWrapp
 {
     if (snapPointWrapper)
     {
-        winrt::SnapPointBase winrtPreviousSnapPoint = snapPointWrapper->SnapPoint().as<winrt::SnapPointBase>();
-        return winrt::get_self<SnapPointBase>(winrtPreviousSnapPoint);
+        return snapPointWrapper->m_snapPointBase;
     }
     return nullptr;
 }
 
+template<typename T>
+void SnapPointWrapper<T>::RecordExpressionAnimationsParameters(bool isInertiaFromImpulse)
+{
+    m_expressionsSortPredicate = GetSnapPointFromWrapper(this)->SortPredicate();
+    m_expressionsApplicableZone = m_actualApplicableZone;
+    m_expressionsIsInertiaFromImpulse = isInertiaFromImpulse;
+    RecordExpressionAnimationsImpulseParameters();
+}
+
+template<typename T>
+void SnapPointWrapper<T>::RecordExpressionAnimationsImpulseParameters()
+{
+    m_expressionsImpulseApplicableZone = m_actualImpulseApplicableZone;
+    m_expressionsIgnoredValue = m_ignoredValue;
+}
+
 template SnapPointWrapper<winrt::ScrollSnapPointBase>::SnapPointWrapper(winrt::ScrollSnapPointBase const& snapPoint);
 template SnapPointWrapper<winrt::ZoomSnapPointBase>::SnapPointWrapper(winrt::ZoomSnapPointBase const& snapPoint);
 
@@ -236,6 +358,18 @@ template winrt::ExpressionAnimation SnapPointWrapper<winrt::ZoomSnapPointBase>::
     winrt::hstring const& scale,
     bool isInertiaFromImpulse);
 
+template winrt::InteractionTrackerInertiaRestingValue SnapPointWrapper<winrt::ScrollSnapPointBase>::InertiaModifier() const;
+template winrt::InteractionTrackerInertiaRestingValue SnapPointWrapper<winrt::ZoomSnapPointBase>::InertiaModifier() const;
+
+template void SnapPointWrapper<winrt::ScrollSnapPointBase>::InertiaModifier(winrt::InteractionTrackerInertiaRestingValue const& inertiaModifier);
+template void SnapPointWrapper<winrt::ZoomSnapPointBase>::InertiaModifier(winrt::InteractionTrackerInertiaRestingValue const& inertiaModifier);
+
+template void SnapPointWrapper<winrt::ScrollSnapPointBase>::AdoptInertiaModifier(SnapPointWrapper<winrt::ScrollSnapPointBase> const& snapPointWrapper);
+template void SnapPointWrapper<winrt::ZoomSnapPointBase>::AdoptInertiaModifier(SnapPointWrapper<winrt::ZoomSnapPointBase> const& snapPointWrapper);
+
+template void SnapPointWrapper<winrt::ScrollSnapPointBase>::UpdateExpressionAnimations(bool isInertiaFromImpulse);
+template void SnapPointWrapper<winrt::ZoomSnapPointBase>::UpdateExpressionAnimations(bool isInertiaFromImpulse);
+
 template std::tuple<winrt::ExpressionAnimation, winrt::ExpressionAnimation> SnapPointWrapper<winrt::ScrollSnapPointBase>::GetUpdatedExpressionAnimationsForImpulse();
 template std::tuple<winrt::ExpressionAnimation, winrt::ExpressionAnimation> SnapPointWrapper<winrt::ScrollSnapPointBase>::GetUpdatedExpressionAnimationsForImpulse(
     bool isInertiaFromImpulse);
@@ -261,5 +395,14 @@ template double SnapPointWrapper<winrt::ZoomSnapPointBase>::Evaluate(double valu
 template bool SnapPointWrapper<winrt::ScrollSnapPointBase>::SnapsAt(double value) const;
 template bool SnapPointWrapper<winrt::ZoomSnapPointBase>::SnapsAt(double value) const;
 
+template int SnapPointWrapper<winrt::ScrollSnapPointBase>::SnapCount() const;
+template int SnapPointWrapper<winrt::ZoomSnapPointBase>::SnapCount() const;
+
+template bool SnapPointWrapper<winrt::ScrollSnapPointBase>::SortsBefore(SnapPointWrapper<winrt::ScrollSnapPointBase> const& snapPointWrapper) const;
+template bool SnapPointWrapper<winrt::ZoomSnapPointBase>::SortsBefore(SnapPointWrapper<winrt::ZoomSnapPointBase> const& snapPointWrapper) const;
+
+template bool SnapPointWrapper<winrt::ScrollSnapPointBase>::IsEquivalentTo(SnapPointWrapper<winrt::ScrollSnapPointBase> const& snapPointWrapper) const;
+template bool SnapPointWrapper<winrt::ZoomSnapPointBase>::IsEquivalentTo(SnapPointWrapper<winrt::ZoomSnapPointBase> const& snapPointWrapper) const;
+
 template SnapPointBase* SnapPointWrapper<winrt::ScrollSnapPointBase>::GetSnapPointFromWrapper(std::shared_ptr<SnapPointWrapper<winrt::ScrollSnapPointBase>> snapPointWrapper);
 template SnapPointBase* SnapPointWrapper<winrt::ZoomSnapPointBase>::GetSnapPointFromWrapper(std::shared_ptr<SnapPointWrapper<winrt::ZoomSnapPointBase>> snapPointWrapper);
@@ -34,6 +34,10 @@ public:
         winrt::hstring const& target,
         winrt::hstring const& scale,
         bool isInertiaFromImpulse);
+    winrt::InteractionTrackerInertiaRestingValue InertiaModifier() const;
+    void InertiaModifier(winrt::InteractionTrackerInertiaRestingValue const& inertiaModifier);
+    void AdoptInertiaModifier(SnapPointWrapper<T> const& snapPointWrapper);
+    void UpdateExpressionAnimations(bool isInertiaFromImpulse);
     std::tuple<winrt::ExpressionAnimation, winrt::ExpressionAnimation> GetUpdatedExpressionAnimationsForImpulse();
     std::tuple<winrt::ExpressionAnimation, winrt::ExpressionAnimation> GetUpdatedExpressionAnimationsForImpulse(
         bool isInertiaFromImpulse);
@@ -44,32 +48,35 @@ public:
     void Combine(SnapPointWrapper<T>* snapPointWrapper);
     double Evaluate(double value) const;
     bool SnapsAt(double value) const;
+    int SnapCount() const;
+    bool SortsBefore(SnapPointWrapper<T> const& snapPointWrapper) const;
+    bool IsEquivalentTo(SnapPointWrapper<T> const& snapPointWrapper) const;
 
     static SnapPointBase* GetSnapPointFromWrapper(std::shared_ptr<SnapPointWrapper<T>> snapPointWrapper);
 
 private:
 	static SnapPointBase* GetSnapPointFromWrapper(const SnapPointWrapper<T>* snapPointWrapper);
+    void RecordExpressionAnimationsParameters(bool isInertiaFromImpulse);
+    void RecordExpressionAnimationsImpulseParameters();
 
 private:
     T m_snapPoint;
+    // Implementation of m_snapPoint, which is asked for all the time while sorting and evaluating.
+    SnapPointBase* m_snapPointBase{ nullptr };
     std::tuple<double, double> m_actualApplicableZone{ -INFINITY, INFINITY };
     std::tuple<double, double> m_actualImpulseApplicableZone{ -INFINITY, INFINITY };
     int m_combinationCount{ 0 };
     double m_ignoredValue{ NAN }; // Ignored snapping value when inertia is triggered by an impulse
     winrt::ExpressionAnimation m_conditionExpressionAnimation{ nullptr };
     winrt::ExpressionAnimation m_restingValueExpressionAnimation{ nullptr };
-};
-
-template <typename T>
-struct SnapPointWrapperComparator
-{
-    inline bool operator()(std::shared_ptr<SnapPointWrapper<T>> left, std::shared_ptr<SnapPointWrapper<T>> right) const
-    {
-        winrt::SnapPointBase winrtLeftSnapPoint = left->SnapPoint().as<winrt::SnapPointBase>();
-        winrt::SnapPointBase winrtRightSnapPoint = right->SnapPoint().as<winrt::SnapPointBase>();
-        SnapPointBase* leftSnapPoint = winrt::get_self<SnapPointBase>(winrtLeftSnapPoint);
-        SnapPointBase* rightSnapPoint = winrt::get_self<SnapPointBase>(winrtRightSnapPoint);
+    // Modifier using the two expression animations above. It is kept as long as this snap point is part of
+    // the consolidated snap points, so that SetupSnapPoints only has to update the parameters that changed.
+    winrt::InteractionTrackerInertiaRestingValue m_inertiaModifier{ nullptr };
 
-        return *leftSnapPoint < rightSnapPoint;
-    }
+    // Values last set as parameters of the expression animations.
+    ScrollerSnapPointSortPredicate m_expressionsSortPredicate{};
+    std::tuple<double, double> m_expressionsApplicableZone{ -INFINITY, INFINITY };
+    std::tuple<double, double> m_expressionsImpulseApplicableZone{ -INFINITY, INFINITY };
+    double m_expressionsIgnoredValue{ NAN };
+    bool m_expressionsIsInertiaFromImpulse{ false };
 };
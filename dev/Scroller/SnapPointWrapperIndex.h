@@ -0,0 +1,259 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+// Sorted and consolidated snap points of one Scroller dimension, kept in a flat vector.
+//
+// Each snap point's actual applicable zone only depends on its neighbors, so inserting a
+// snap point only invalidates the zones of that snap point and of its two neighbors, and
+// UpdateRanges only recomputes the invalidated ones. A copy of the zones is kept next to the
+// wrappers so that the snap point applicable at a given value is found with a binary search
+// instead of walking all the snap points. Repeated snap points stay a single entry.
+//
+// TWrapper is SnapPointWrapper<T> in the control. It needs SortsBefore, IsEquivalentTo,
+// Combine, DetermineActualApplicableZone, ActualApplicableZone, SnapCount, SnapsAt,
+// ResetIgnoredValue and SetIgnoredValue.
+template <typename TWrapper>
+class SnapPointWrapperIndex final
+{
+public:
+    using const_iterator = typename std::vector<std::shared_ptr<TWrapper>>::const_iterator;
+
+    const_iterator begin() const { return m_wrappers.begin(); }
+    const_iterator end() const { return m_wrappers.end(); }
+    size_t size() const { return m_wrappers.size(); }
+    bool empty() const { return m_wrappers.empty(); }
+    const std::shared_ptr<TWrapper>& operator[](size_t index) const { return m_wrappers[index]; }
+
+    void clear()
+    {
+        m_wrappers.clear();
+        m_zones.clear();
+        m_dirtyRange = EmptyRange();
+        m_impulseDirtyRange = EmptyRange();
+        m_ignoredValueIndex = -1;
+    }
+
+    // Inserts the snap point at its sorted position, unless an equivalent snap point is
+    // already there, in which case it is combined into that one.
+    void Insert(const std::shared_ptr<TWrapper>& wrapper)
+    {
+        const auto lowerBound = std::lower_bound(
+            m_wrappers.begin(),
+            m_wrappers.end(),
+            wrapper,
+            [](const std::shared_ptr<TWrapper>& left, const std::shared_ptr<TWrapper>& right) { return left->SortsBefore(*right); });
+        int index = static_cast<int>(lowerBound - m_wrappers.begin());
+
+        // Equivalent snap points are within an epsilon of each other, so the one to combine
+        // with can be the first one sorting after the new one, or the one after that.
+        for (int candidate = index; candidate < std::min(index + 2, static_cast<int>(m_wrappers.size())); candidate++)
+        {
+            if (m_wrappers[candidate]->IsEquivalentTo(*wrapper))
+            {
+                m_wrappers[candidate]->Combine(wrapper.get());
+                InvalidateNeighborhood(candidate);
+                return;
+            }
+        }
+
+        m_wrappers.insert(lowerBound, wrapper);
+        m_zones.insert(m_zones.begin() + index, std::make_tuple(-INFINITY, INFINITY));
+        ShiftRange(m_dirtyRange, index);
+        ShiftRange(m_impulseDirtyRange, index);
+        if (m_ignoredValueIndex >= index)
+        {
+            m_ignoredValueIndex++;
+        }
+        InvalidateNeighborhood(index);
+    }
+
+    bool HasInvalidRanges() const
+    {
+        return m_dirtyRange.first < m_dirtyRange.second;
+    }
+
+    // Recomputes the actual applicable zones that were invalidated since the last call,
+    // either all of them or just the ones used for inertia triggered by an impulse.
+    void UpdateRanges(bool forImpulseOnly)
+    {
+        std::pair<int, int> range = m_impulseDirtyRange;
+        if (!forImpulseOnly)
+        {
+            range.first = std::min(range.first, m_dirtyRange.first);
+            range.second = std::max(range.second, m_dirtyRange.second);
+            m_dirtyRange = EmptyRange();
+        }
+        m_impulseDirtyRange = EmptyRange();
+
+        const int count = static_cast<int>(m_wrappers.size());
+        for (int index = std::max(range.first, 0); index < std::min(range.second, count); index++)
+        {
+            m_wrappers[index]->DetermineActualApplicableZone(
+                index > 0 ? m_wrappers[index - 1].get() : nullptr,
+                index < count - 1 ? m_wrappers[index + 1].get() : nullptr,
+                forImpulseOnly);
+            m_zones[index] = m_wrappers[index]->ActualApplicableZone();
+        }
+
+        if (!forImpulseOnly)
+        {
+            // Zones normally follow the order of the snap points. If they don't, the lookups
+            // fall back to walking the snap points like before.
+            m_areZonesSorted = true;
+            for (int index = 1; index < count && m_areZonesSorted; index++)
+            {
+                m_areZonesSorted =
+                    std::get<0>(m_zones[index - 1]) <= std::get<0>(m_zones[index]) &&
+                    std::get<1>(m_zones[index - 1]) <= std::get<1>(m_zones[index]);
+            }
+        }
+    }
+
+    // Returns the first snap point whose actual applicable zone contains the value, if any.
+    TWrapper* FindApplicableSnapPoint(double value) const
+    {
+        for (int index = FirstCandidateIndex(value); index < static_cast<int>(m_wrappers.size()); index++)
+        {
+            const auto& zone = ZoneAt(index);
+            if (std::get<0>(zone) <= value && std::get<1>(zone) >= value)
+            {
+                return m_wrappers[index].get();
+            }
+
+            if (CanStopAt(zone, value))
+            {
+                break;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Updates the ignored snapping value when inertia is caused by an impulse: only a snap point
+    // that snaps at newIgnoredValue ignores it, and only when there is more than one place to snap to.
+    // Returns True when an old ignored value was reset or a new ignored value was set.
+    bool UpdateIgnoredValue(double newIgnoredValue)
+    {
+        bool ignoredValueUpdated = false;
+
+        if (m_ignoredValueIndex != -1)
+        {
+            ignoredValueUpdated = m_wrappers[m_ignoredValueIndex]->ResetIgnoredValue();
+            InvalidateImpulseNeighborhood(m_ignoredValueIndex);
+            m_ignoredValueIndex = -1;
+        }
+
+        int snapCount = 0;
+
+        for (const auto& wrapper : m_wrappers)
+        {
+            snapCount += wrapper->SnapCount();
+
+            if (snapCount > 1)
+            {
+                break;
+            }
+        }
+
+        if (snapCount > 1)
+        {
+            for (int index = FirstCandidateIndex(newIgnoredValue); index < static_cast<int>(m_wrappers.size()); index++)
+            {
+                if (m_wrappers[index]->SnapsAt(newIgnoredValue))
+                {
+                    m_wrappers[index]->SetIgnoredValue(newIgnoredValue);
+                    m_ignoredValueIndex = index;
+                    InvalidateImpulseNeighborhood(index);
+                    ignoredValueUpdated = true;
+                    break;
+                }
+
+                if (CanStopAt(ZoneAt(index), newIgnoredValue))
+                {
+                    break;
+                }
+            }
+        }
+
+        return ignoredValueUpdated;
+    }
+
+private:
+    static std::pair<int, int> EmptyRange() { return { INT_MAX, INT_MIN }; }
+
+    static void ExtendRange(std::pair<int, int>& range, int first, int last)
+    {
+        range.first = std::min(range.first, first);
+        range.second = std::max(range.second, last);
+    }
+
+    // Keeps an invalidated range on the same snap points after one got inserted at index.
+    static void ShiftRange(std::pair<int, int>& range, int index)
+    {
+        if (range.first < range.second)
+        {
+            range.first += range.first > index ? 1 : 0;
+            range.second += range.second > index ? 1 : 0;
+        }
+    }
+
+    void InvalidateNeighborhood(int index)
+    {
+        ExtendRange(m_dirtyRange, index - 1, index + 2);
+    }
+
+    void InvalidateImpulseNeighborhood(int index)
+    {
+        ExtendRange(m_impulseDirtyRange, index - 1, index + 2);
+    }
+
+    bool CanUseZones() const
+    {
+        return m_areZonesSorted && !HasInvalidRanges();
+    }
+
+    // The wrappers keep the authoritative zones, which are ahead of m_zones while ranges are invalid.
+    std::tuple<double, double> ZoneAt(int index) const
+    {
+        return CanUseZones() ? m_zones[index] : m_wrappers[index]->ActualApplicableZone();
+    }
+
+    // With sorted zones, the first snap point applicable at value is the first one whose zone
+    // does not end before value.
+    int FirstCandidateIndex(double value) const
+    {
+        if (!CanUseZones())
+        {
+            return 0;
+        }
+
+        return static_cast<int>(std::lower_bound(
+            m_zones.begin(),
+            m_zones.end(),
+            value,
+            [](const std::tuple<double, double>& zone, double value) { return std::get<1>(zone) < value; }) - m_zones.begin());
+    }
+
+    // With sorted zones, no zone after one that starts past value contains value.
+    bool CanStopAt(const std::tuple<double, double>& zone, double value) const
+    {
+        return CanUseZones() && std::get<0>(zone) > value;
+    }
+
+    std::vector<std::shared_ptr<TWrapper>> m_wrappers;
+    std::vector<std::tuple<double, double>> m_zones;
+    // [first, second) ranges of wrappers whose zones need to be recomputed.
+    std::pair<int, int> m_dirtyRange{ EmptyRange() };
+    std::pair<int, int> m_impulseDirtyRange{ EmptyRange() };
+    int m_ignoredValueIndex{ -1 };
+    bool m_areZonesSorted{ true };
+};
@@ -234,6 +234,119 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
             });
         }
 
+        [TestMethod]
+        public void TreeViewFlatIndexTest()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var root1 = new TreeViewNode() { Content = "Root 1" };
+                var root2 = new TreeViewNode() { Content = "Root 2" };
+                var child1 = new TreeViewNode() { Content = "Child 1" };
+                var child2 = new TreeViewNode() { Content = "Child 2" };
+                var grandChild1 = new TreeViewNode() { Content = "Grand Child 1" };
+                var grandChild2 = new TreeViewNode() { Content = "Grand Child 2" };
+
+                child1.Children.Add(grandChild1);
+                child1.Children.Add(grandChild2);
+                root1.Children.Add(child1);
+                root1.Children.Add(child2);
+
+                var treeView = new TreeView();
+                treeView.SelectionMode = TreeViewSelectionMode.Multiple;
+                Content = treeView;
+                Content.UpdateLayout();
+                var listControl = FindVisualChildByName(treeView, "ListControl") as TreeViewList;
+                treeView.RootNodes.Add(root1);
+                treeView.RootNodes.Add(root2);
+
+                child1.IsExpanded = true;
+                root1.IsExpanded = true;
+                Verify.AreEqual(listControl.Items.Count, 6);
+                Verify.AreEqual(listControl.Items.IndexOf(grandChild2), 3);
+                Verify.AreEqual(listControl.Items.IndexOf(child2), 4);
+                Verify.AreEqual(listControl.Items.IndexOf(root2), 5);
+
+                // Inserting under an expanded node shifts the flat index of every following node
+                var grandChild3 = new TreeViewNode() { Content = "Grand Child 3" };
+                child1.Children.Insert(0, grandChild3);
+                Verify.AreEqual(listControl.Items.IndexOf(grandChild3), 2);
+                Verify.AreEqual(listControl.Items.IndexOf(root2), 6);
+
+                // Reset removes the whole flattened range of the node's descendants
+                child1.Children.Clear();
+                Verify.AreEqual(listControl.Items.Count, 4);
+                Verify.AreEqual(listControl.Items.IndexOf(grandChild1), -1);
+                Verify.AreEqual(listControl.Items.IndexOf(child2), 2);
+
+                root1.IsExpanded = false;
+                Verify.AreEqual(listControl.Items.Count, 2);
+                Verify.AreEqual(listControl.Items.IndexOf(child1), -1);
+                Verify.AreEqual(listControl.Items.IndexOf(root2), 1);
+
+                treeView.SelectedNodes.Add(root2);
+                treeView.SelectedNodes.Add(root2);
+                Verify.AreEqual(treeView.SelectedNodes.Count, 1);
+                treeView.SelectedNodes.Remove(root2);
+                Verify.AreEqual(treeView.SelectedNodes.Count, 0);
+            });
+        }
+
+        [TestMethod]
+        public void TreeViewExpandCollapseLargeSubtreeTest()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var root1 = new TreeViewNode() { Content = "Root 1" };
+                var root2 = new TreeViewNode() { Content = "Root 2" };
+                var lastGrandChild = default(TreeViewNode);
+                for (int i = 0; i < 100; i++)
+                {
+                    var child = new TreeViewNode() { Content = "Child " + i };
+                    for (int j = 0; j < 3; j++)
+                    {
+                        lastGrandChild = new TreeViewNode() { Content = "Grand Child " + i + ":" + j };
+                        child.Children.Add(lastGrandChild);
+                    }
+                    child.IsExpanded = (i % 2 == 0);
+                    root1.Children.Add(child);
+                }
+
+                var treeView = new TreeView();
+                Content = treeView;
+                Content.UpdateLayout();
+                var listControl = FindVisualChildByName(treeView, "ListControl") as TreeViewList;
+                treeView.RootNodes.Add(root1);
+                treeView.RootNodes.Add(root2);
+                Verify.AreEqual(listControl.Items.Count, 2);
+
+                // 100 children, half of them expanded with 3 children each
+                root1.IsExpanded = true;
+                Verify.AreEqual(listControl.Items.Count, 252);
+                Verify.AreEqual(listControl.Items[1], root1.Children[0]);
+                Verify.AreEqual(listControl.Items[2], root1.Children[0].Children[0]);
+                Verify.AreEqual(listControl.Items[5], root1.Children[1]);
+                Verify.AreEqual(listControl.Items[6], root1.Children[2]);
+                Verify.AreEqual(listControl.Items[251], root2);
+
+                // Nodes added through the batched path still react to expansion
+                root1.Children[99].IsExpanded = true;
+                Verify.AreEqual(listControl.Items.Count, 255);
+                Verify.AreEqual(listControl.Items[253], lastGrandChild);
+
+                root1.IsExpanded = false;
+                Verify.AreEqual(listControl.Items.Count, 2);
+                Verify.AreEqual(listControl.Items[0], root1);
+                Verify.AreEqual(listControl.Items[1], root2);
+
+                root1.IsExpanded = true;
+                Verify.AreEqual(listControl.Items.Count, 255);
+
+                treeView.RootNodes.RemoveAt(0);
+                Verify.AreEqual(listControl.Items.Count, 1);
+                Verify.AreEqual(listControl.Items[0], root2);
+            });
+        }
+
         //[TestMethod] Disabled with issue number #1775
         public void TreeViewInheritanceTest()
         {
@@ -451,6 +564,36 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
             });
         }
 
+        [TestMethod]
+        public void TreeViewItemsSourceSelectedItemsTest()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var treeView = new TreeView();
+                treeView.SelectionMode = TreeViewSelectionMode.Multiple;
+                var items = CreateTreeViewItemsSource();
+                treeView.ItemsSource = items;
+                Content = treeView;
+                Content.UpdateLayout();
+
+                // SelectedItems finds the node of an item through the item to node map
+                treeView.SelectedItems.Add(items[1]);
+                Verify.AreEqual(treeView.SelectedNodes.Count, 1);
+                Verify.AreEqual(treeView.SelectedNodes[0], treeView.RootNodes[1]);
+
+                // Replaced items map to their new node
+                var item3 = new TreeViewItemSource() { Content = "3" };
+                items[0] = item3;
+                treeView.SelectedItems.Add(item3);
+                Verify.AreEqual(treeView.SelectedNodes.Count, 2);
+                Verify.AreEqual(treeView.SelectedNodes[1], treeView.RootNodes[0]);
+
+                // Items which aren't in the tree have no node
+                treeView.SelectedItems.Add(new TreeViewItemSource() { Content = "4" });
+                Verify.AreEqual(treeView.SelectedNodes.Count, 2);
+            });
+        }
+
         [TestMethod]
         public void TreeViewNodeStringableTest()
         {
@@ -486,6 +629,55 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
             });
         }
 
+        [TestMethod]
+        public void TreeViewMultipleSelectionStatePropagationTest()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var root = new TreeViewNode() { Content = "Root" };
+                var child0 = new TreeViewNode() { Content = "Child 0" };
+                var child1 = new TreeViewNode() { Content = "Child 1" };
+                var child2 = new TreeViewNode() { Content = "Child 2" };
+                var grandChild0 = new TreeViewNode() { Content = "Grand Child 0" };
+                var grandChild1 = new TreeViewNode() { Content = "Grand Child 1" };
+                child0.Children.Add(grandChild0);
+                child0.Children.Add(grandChild1);
+                root.Children.Add(child0);
+                root.Children.Add(child1);
+                root.Children.Add(child2);
+
+                var treeView = new TreeView();
+                treeView.SelectionMode = TreeViewSelectionMode.Multiple;
+                treeView.RootNodes.Add(root);
+                Content = treeView;
+                Content.UpdateLayout();
+
+                // Partially selected ancestors aren't part of SelectedNodes
+                treeView.SelectedNodes.Add(grandChild0);
+                Verify.AreEqual(treeView.SelectedNodes.Count, 1);
+
+                treeView.SelectedNodes.Add(grandChild1);
+                Verify.AreEqual(treeView.SelectedNodes.Count, 3);
+                Verify.IsTrue(treeView.SelectedNodes.Contains(child0));
+                Verify.IsFalse(treeView.SelectedNodes.Contains(root));
+
+                treeView.SelectedNodes.Add(child1);
+                treeView.SelectedNodes.Add(child2);
+                Verify.AreEqual(treeView.SelectedNodes.Count, 6);
+                Verify.IsTrue(treeView.SelectedNodes.Contains(root));
+
+                treeView.SelectedNodes.Remove(child0);
+                Verify.AreEqual(treeView.SelectedNodes.Count, 2);
+                Verify.IsTrue(treeView.SelectedNodes.Contains(child1));
+                Verify.IsTrue(treeView.SelectedNodes.Contains(child2));
+                Verify.IsFalse(treeView.SelectedNodes.Contains(root));
+
+                treeView.SelectedNodes.Remove(child1);
+                treeView.SelectedNodes.Remove(child2);
+                Verify.AreEqual(treeView.SelectedNodes.Count, 0);
+            });
+        }
+
         [TestMethod]
         public void VerifyVisualTree()
         {
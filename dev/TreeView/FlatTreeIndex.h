@@ -0,0 +1,304 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Position of every node of the ViewModel's flattened tree, kept up to date as nodes are inserted
+// and removed so that the flat index of a node is found in O(log n) instead of with a linear
+// IndexOf over the flattened vector.
+//
+// The positions are held by an implicit treap: each treap slot knows the size of its subtree and
+// its parent, so the position of a slot is the number of slots to its left, gathered while walking
+// up to the root. A hash map leads from a key to its slot.
+//
+// TKey is TreeViewNode* in the control: any hashable value identifying a node.
+template <typename TKey>
+class FlatTreeIndex final
+{
+public:
+    uint32_t Count() const
+    {
+        return SizeOf(m_root);
+    }
+
+    void Clear()
+    {
+        m_slots.clear();
+        m_freeSlots.clear();
+        m_slotsByKey.clear();
+        m_root = s_noSlot;
+    }
+
+    void Insert(uint32_t position, const TKey& key)
+    {
+        const int slot = NewSlot(key);
+        int left, right;
+
+        Split(m_root, position, left, right);
+        m_root = Merge(Merge(left, slot), right);
+        m_slots[m_root].Parent = s_noSlot;
+        m_slotsByKey[key] = slot;
+    }
+
+    // Inserts the keys of [first, last) at position in O(count + log n), building their treap
+    // directly from the ordered keys rather than inserting them one at a time.
+    template <typename TIterator>
+    void InsertRange(uint32_t position, TIterator first, TIterator last)
+    {
+        // Right spine of the treap being built, with decreasing priorities.
+        std::vector<int> spine;
+
+        for (; first != last; ++first)
+        {
+            const int slot = NewSlot(*first);
+            int lastPopped = s_noSlot;
+
+            while (!spine.empty() && m_slots[spine.back()].Priority < m_slots[slot].Priority)
+            {
+                lastPopped = spine.back();
+                spine.pop_back();
+            }
+
+            m_slots[slot].Left = lastPopped;
+            if (!spine.empty())
+            {
+                m_slots[spine.back()].Right = slot;
+            }
+            spine.push_back(slot);
+            m_slotsByKey[*first] = slot;
+        }
+
+        if (spine.empty())
+        {
+            return;
+        }
+
+        const int range = spine.front();
+        int left, right;
+
+        UpdateSubtree(range);
+        Split(m_root, position, left, right);
+        m_root = Merge(Merge(left, range), right);
+        m_slots[m_root].Parent = s_noSlot;
+    }
+
+    void Remove(uint32_t position)
+    {
+        RemoveRange(position, 1);
+    }
+
+    void RemoveRange(uint32_t position, uint32_t count)
+    {
+        int left, middle, right;
+
+        Split(m_root, position, left, middle);
+        Split(middle, count, middle, right);
+        FreeSlots(middle);
+        m_root = Merge(left, right);
+        if (m_root != s_noSlot)
+        {
+            m_slots[m_root].Parent = s_noSlot;
+        }
+    }
+
+    void Replace(uint32_t position, const TKey& key)
+    {
+        Remove(position);
+        Insert(position, key);
+    }
+
+    bool IndexOf(const TKey& key, uint32_t& index) const
+    {
+        const auto it = m_slotsByKey.find(key);
+
+        if (it == m_slotsByKey.end())
+        {
+            return false;
+        }
+
+        int slot = it->second;
+        uint32_t position = SizeOf(m_slots[slot].Left);
+
+        for (int parent = m_slots[slot].Parent; parent != s_noSlot; slot = parent, parent = m_slots[slot].Parent)
+        {
+            if (m_slots[parent].Right == slot)
+            {
+                position += SizeOf(m_slots[parent].Left) + 1;
+            }
+        }
+
+        index = position;
+        return true;
+    }
+
+private:
+    static constexpr int s_noSlot = -1;
+
+    struct Slot
+    {
+        TKey Key;
+        uint32_t Priority;
+        uint32_t Size;
+        int Left;
+        int Right;
+        int Parent;
+    };
+
+    uint32_t SizeOf(int slot) const
+    {
+        return slot == s_noSlot ? 0 : m_slots[slot].Size;
+    }
+
+    void Update(int slot)
+    {
+        Slot& s = m_slots[slot];
+
+        s.Size = SizeOf(s.Left) + SizeOf(s.Right) + 1;
+        if (s.Left != s_noSlot)
+        {
+            m_slots[s.Left].Parent = slot;
+        }
+        if (s.Right != s_noSlot)
+        {
+            m_slots[s.Right].Parent = slot;
+        }
+    }
+
+    void UpdateSubtree(int slot)
+    {
+        if (m_slots[slot].Left != s_noSlot)
+        {
+            UpdateSubtree(m_slots[slot].Left);
+        }
+        if (m_slots[slot].Right != s_noSlot)
+        {
+            UpdateSubtree(m_slots[slot].Right);
+        }
+        Update(slot);
+    }
+
+    // Splits the treap rooted at slot into its first count positions and the remaining ones.
+    void Split(int slot, uint32_t count, int& left, int& right)
+    {
+        if (slot == s_noSlot)
+        {
+            left = right = s_noSlot;
+            return;
+        }
+
+        const uint32_t leftSize = SizeOf(m_slots[slot].Left);
+
+        if (count <= leftSize)
+        {
+            int subRight;
+            Split(m_slots[slot].Left, count, left, subRight);
+            m_slots[slot].Left = subRight;
+            right = slot;
+        }
+        else
+        {
+            int subLeft;
+            Split(m_slots[slot].Right, count - leftSize - 1, subLeft, right);
+            m_slots[slot].Right = subLeft;
+            left = slot;
+        }
+
+        Update(slot);
+        if (left != s_noSlot)
+        {
+            m_slots[left].Parent = s_noSlot;
+        }
+        if (right != s_noSlot)
+        {
+            m_slots[right].Parent = s_noSlot;
+        }
+    }
+
+    int Merge(int left, int right)
+    {
+        if (left == s_noSlot)
+        {
+            return right;
+        }
+        if (right == s_noSlot)
+        {
+            return left;
+        }
+
+        if (m_slots[left].Priority > m_slots[right].Priority)
+        {
+            m_slots[left].Right = Merge(m_slots[left].Right, right);
+            Update(left);
+            return left;
+        }
+
+        m_slots[right].Left = Merge(left, m_slots[right].Left);
+        Update(right);
+        return right;
+    }
+
+    int NewSlot(const TKey& key)
+    {
+        // xorshift32, only used to keep the treap balanced.
+        m_seed ^= m_seed << 13;
+        m_seed ^= m_seed >> 17;
+        m_seed ^= m_seed << 5;
+
+        const Slot slot{ key, m_seed, 1, s_noSlot, s_noSlot, s_noSlot };
+
+        if (!m_freeSlots.empty())
+        {
+            const int index = m_freeSlots.back();
+            m_freeSlots.pop_back();
+            m_slots[index] = slot;
+            return index;
+        }
+
+        m_slots.push_back(slot);
+        return static_cast<int>(m_slots.size()) - 1;
+    }
+
+    void FreeSlots(int slot)
+    {
+        std::vector<int> pending;
+
+        if (slot != s_noSlot)
+        {
+            pending.push_back(slot);
+        }
+
+        while (!pending.empty())
+        {
+            const int current = pending.back();
+            const Slot& s = m_slots[current];
+            pending.pop_back();
+
+            // The same key may have been inserted again at another position since.
+            const auto it = m_slotsByKey.find(s.Key);
+            if (it != m_slotsByKey.end() && it->second == current)
+            {
+                m_slotsByKey.erase(it);
+            }
+
+            if (s.Left != s_noSlot)
+            {
+                pending.push_back(s.Left);
+            }
+            if (s.Right != s_noSlot)
+            {
+                pending.push_back(s.Right);
+            }
+            m_freeSlots.push_back(current);
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    std::vector<int> m_freeSlots;
+    std::unordered_map<TKey, int> m_slotsByKey;
+    int m_root{ s_noSlot };
+    uint32_t m_seed{ 2463534242 };
+};
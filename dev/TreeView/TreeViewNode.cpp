@@ -30,6 +30,16 @@ winrt::TreeViewNode TreeViewNode::get_ParentImpl()
 
 void TreeViewNode::put_ParentImpl(winrt::TreeViewNode const& value)
 {
+    if (auto oldParent = get_ParentImpl())
+    {
+        winrt::get_self<TreeViewNode>(oldParent)->UpdateChildrenSelectionCounts(m_multiSelectionState, -1);
+    }
+
+    if (value != nullptr)
+    {
+        winrt::get_self<TreeViewNode>(value)->UpdateChildrenSelectionCounts(m_multiSelectionState, 1);
+    }
+
     if (value != nullptr)
     {
         m_parentNode = winrt::make_weak(value);
@@ -78,9 +88,49 @@ TreeNodeSelectionState TreeViewNode::SelectionState()
 
 void TreeViewNode::SelectionState(TreeNodeSelectionState const& state)
 {
+    if (auto parent = get_ParentImpl())
+    {
+        auto parentNode = winrt::get_self<TreeViewNode>(parent);
+        parentNode->UpdateChildrenSelectionCounts(m_multiSelectionState, -1);
+        parentNode->UpdateChildrenSelectionCounts(state, 1);
+    }
+
     m_multiSelectionState = state;
 }
 
+// A node is selected when all its children are, unselected when none of them is, and partially selected otherwise.
+TreeNodeSelectionState TreeViewNode::SelectionStateBasedOnChildren()
+{
+    const int childrenCount = static_cast<int>(m_children.get().Size());
+
+    if (m_partialSelectedChildrenCount > 0 ||
+        (m_selectedChildrenCount > 0 && m_selectedChildrenCount < childrenCount))
+    {
+        return TreeNodeSelectionState::PartialSelected;
+    }
+
+    return m_selectedChildrenCount > 0 ? TreeNodeSelectionState::Selected : TreeNodeSelectionState::UnSelected;
+}
+
+void TreeViewNode::UpdateChildrenSelectionCounts(TreeNodeSelectionState state, int delta)
+{
+    switch (state)
+    {
+    case TreeNodeSelectionState::Selected:
+        m_selectedChildrenCount += delta;
+        break;
+
+    case TreeNodeSelectionState::PartialSelected:
+        m_partialSelectedChildrenCount += delta;
+        break;
+
+    case TreeNodeSelectionState::UnSelected:
+        break;
+    }
+
+    MUX_ASSERT(m_selectedChildrenCount >= 0 && m_partialSelectedChildrenCount >= 0);
+}
+
 void TreeViewNode::UpdateDepth(int depth)
 {
     // Update our depth
@@ -40,6 +40,7 @@ public:
     void ItemsSource(winrt::IInspectable const& value);
     TreeNodeSelectionState SelectionState();
     void SelectionState(TreeNodeSelectionState const& state);
+    TreeNodeSelectionState SelectionStateBasedOnChildren();
 
 // Enable "ToString" on TreeViewNode to show stringable data correctly
 #pragma region ICustomPropertyProvider
@@ -71,6 +72,11 @@ private:
     void RemoveFromChildrenNodes(int index, int count);
     bool m_isContentMode{ false };
     TreeNodeSelectionState m_multiSelectionState{ TreeNodeSelectionState::UnSelected };
+    // Number of children in each selection state, kept up to date as children change state or are
+    // added and removed, so that the state following from the children doesn't need to visit them.
+    int m_selectedChildrenCount{ 0 };
+    int m_partialSelectedChildrenCount{ 0 };
+    void UpdateChildrenSelectionCounts(TreeNodeSelectionState state, int delta);
     hstring GetContentAsString();
 
 public:
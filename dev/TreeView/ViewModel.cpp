@@ -7,7 +7,12 @@
 #include "TreeViewItem.h"
 #include "VectorChangedEventArgs.h"
 #include "TreeViewList.h"
-#include <HashMap.h>
+#include <unordered_set>
+
+// Below this many nodes, expanding or collapsing notifies the list one node at a time so it keeps
+// its containers and item transitions. Above it, the nodes are spliced in or out of the flat list
+// in one move and the list is sent a single Reset.
+static constexpr unsigned int c_batchedViewChangeThreshold = 64;
 
 // Need to update node selection states on UI before vector changes.
 // Listen on vector change events don't solve the problem because the event already happened when the event handler gets called.
@@ -28,6 +33,8 @@ class SelectedTreeNodeVector :
 
 private:
     winrt::weak_ref<ViewModel> m_viewModel{ nullptr };
+    // Positions of the nodes in the vector, so that IndexOf and Contains don't scan it.
+    FlatTreeIndex<TreeViewNode*> m_nodeIndex;
 
     void UpdateSelection(winrt::TreeViewNode const& node, TreeNodeSelectionState state)
     {
@@ -101,7 +108,18 @@ public:
     bool Contains(winrt::TreeViewNode const& node)
     {
         uint32_t index;
-        return GetVectorInnerImpl()->IndexOf(node, index);
+        return IndexOfNode(node, index);
+    }
+
+    bool IndexOfNode(winrt::TreeViewNode const& node, uint32_t& index)
+    {
+        index = 0;
+        return node && m_nodeIndex.IndexOf(winrt::get_self<TreeViewNode>(node), index);
+    }
+
+    std::function<bool(winrt::TreeViewNode const& value, uint32_t& index)> GetCustomIndexOfFunction() override
+    {
+        return [this](winrt::TreeViewNode const& node, uint32_t& index) { return IndexOfNode(node, index); };
     }
 
     // Default write methods will trigger TreeView visual updates.
@@ -109,6 +127,7 @@ public:
     void InsertAtCore(unsigned int index, winrt::TreeViewNode const& node)
     {
         GetVectorInnerImpl()->InsertAt(index, node);
+        m_nodeIndex.Insert(index, winrt::get_self<TreeViewNode>(node));
 
         // Keep SelectedItems and SelectedNodes in sync
         if (auto viewModel = m_viewModel.get())
@@ -130,6 +149,7 @@ public:
     void RemoveAtCore(unsigned int index)
     {
         GetVectorInnerImpl()->RemoveAt(index);
+        m_nodeIndex.Remove(index);
 
         // Keep SelectedItems and SelectedNodes in sync
         if (auto viewModel = m_viewModel.get())
@@ -163,6 +183,13 @@ class SelectedItemsVector :
 
 private:
     winrt::weak_ref<ViewModel> m_viewModel{ nullptr };
+    // Identities of the items in the vector, for constant time Contains.
+    std::unordered_set<void*> m_itemSet;
+
+    static void* ItemIdentity(winrt::IInspectable const& item)
+    {
+        return item ? winrt::get_abi(item.as<winrt::Windows::Foundation::IUnknown>()) : nullptr;
+    }
 
 public:
     void SetViewModel(ViewModel& viewModel)
@@ -180,6 +207,7 @@ public:
         if (!Contains(item))
         {
             GetVectorInnerImpl()->InsertAt(index, item);
+            m_itemSet.insert(ItemIdentity(item));
 
             // Keep SelectedNodes and SelectedItems in sync
             if (auto viewModel = m_viewModel.get())
@@ -207,7 +235,9 @@ public:
 
     void RemoveAt(unsigned int index)
     {
-        GetVectorInnerImpl()->RemoveAt(index);
+        auto inner = GetVectorInnerImpl();
+        m_itemSet.erase(ItemIdentity(inner->GetAt(index)));
+        inner->RemoveAt(index);
 
         // Keep SelectedNodes and SelectedItems in sync
         if (auto viewModel = m_viewModel.get())
@@ -245,8 +275,7 @@ public:
 
     bool Contains(winrt::IInspectable const& item)
     {
-        uint32_t index;
-        return GetVectorInnerImpl()->IndexOf(item, index);
+        return m_itemSet.count(ItemIdentity(item)) != 0;
     }
 };
 
@@ -261,8 +290,6 @@ ViewModel::ViewModel()
     auto selectedItems = winrt::make_self<SelectedItemsVector>();
     selectedItems->SetViewModel(*this);
     m_selectedItems.set(*selectedItems);
-
-    m_itemToNodeMap.set(winrt::make<HashMap<winrt::IInspectable, winrt::TreeViewNode>>());
 }
 
 ViewModel::~ViewModel()
@@ -337,6 +364,10 @@ bool ViewModel::IndexOf(winrt::IInspectable const& value, uint32_t& index)
     {
         return indexOfFunction(value, index);
     }
+    else if (auto node = value.try_as<winrt::TreeViewNode>())
+    {
+        return IndexOfNode(node, index);
+    }
     else
     {
         auto inner = GetVectorInnerImpl();
@@ -378,6 +409,8 @@ void ViewModel::SetAt(uint32_t index, winrt::IInspectable const& value)
     inner->SetAt(index, value);
 
     winrt::TreeViewNode newNode = value.as<winrt::TreeViewNode>();
+    m_flatIndex.Replace(index, winrt::get_self<TreeViewNode>(newNode));
+    AddToItemToNodeMap(newNode);
 
     auto tvnCurrent = winrt::get_self<TreeViewNode>(current);
     tvnCurrent->ChildrenChanged(m_collectionChangedEventTokenVector[index]);
@@ -393,6 +426,8 @@ void ViewModel::InsertAt(uint32_t index, winrt::IInspectable const& value)
 {
     GetVectorInnerImpl()->InsertAt(index, value);
     winrt::TreeViewNode newNode = value.as<winrt::TreeViewNode>();
+    m_flatIndex.Insert(index, winrt::get_self<TreeViewNode>(newNode));
+    AddToItemToNodeMap(newNode);
 
     //Hook up events and save tokens
     auto tvnNewNode = winrt::get_self<TreeViewNode>(newNode);
@@ -405,6 +440,7 @@ void ViewModel::RemoveAt(uint32_t index)
     auto inner = GetVectorInnerImpl();
     auto current = inner->GetAt(index).as<winrt::TreeViewNode>();
     inner->RemoveAt(index);
+    m_flatIndex.Remove(index);
 
     // Unhook event handlers
     auto tvnCurrent = winrt::get_self<TreeViewNode>(current);
@@ -420,6 +456,8 @@ void ViewModel::Append(winrt::IInspectable const& value)
 {
     GetVectorInnerImpl()->Append(value);
     winrt::TreeViewNode newNode = value.as<winrt::TreeViewNode>();
+    m_flatIndex.Insert(m_flatIndex.Count(), winrt::get_self<TreeViewNode>(newNode));
+    AddToItemToNodeMap(newNode);
     
     // Hook up events and save tokens
     auto tvnNewNode = winrt::get_self<TreeViewNode>(newNode);
@@ -432,6 +470,7 @@ void ViewModel::RemoveAtEnd()
     auto inner = GetVectorInnerImpl();
     auto current = inner->GetAt(Size() - 1).as<winrt::TreeViewNode>();
     inner->RemoveAtEnd();
+    m_flatIndex.Remove(m_flatIndex.Count() - 1);
 
     // unhook events
     auto tvnCurrent = winrt::get_self<TreeViewNode>(current);
@@ -457,7 +496,13 @@ void ViewModel::Clear()
 void ViewModel::ReplaceAll(winrt::array_view<winrt::IInspectable const> items)
 {
     auto inner = GetVectorInnerImpl();
-    return inner->ReplaceAll(items);
+    inner->ReplaceAll(items);
+
+    m_flatIndex.Clear();
+    for (auto const& item : items)
+    {
+        m_flatIndex.Insert(m_flatIndex.Count(), winrt::get_self<TreeViewNode>(item.as<winrt::TreeViewNode>()));
+    }
 }
 
 // Helper function
@@ -466,11 +511,8 @@ void ViewModel::PrepareView(const winrt::TreeViewNode& originNode)
     // Remove any existing RootNode events/children
     if (auto existingOriginNode = m_originNode.get())
     {
-        for (int i = (existingOriginNode.Children().Size() - 1); i >= 0; i--)
-        {
-            auto removeNode = existingOriginNode.Children().GetAt(i).as<winrt::TreeViewNode>();
-            RemoveNodeAndDescendantsFromView(removeNode);
-        }
+        // Every node in the flat list is a descendant of the existing RootNode
+        RemoveNodesFromView(0, Size());
 
         if (m_rootNodeChildrenChangedEventToken.value != 0)
         {
@@ -483,13 +525,9 @@ void ViewModel::PrepareView(const winrt::TreeViewNode& originNode)
     m_rootNodeChildrenChangedEventToken = winrt::get_self<TreeViewNode>(originNode)->ChildrenChanged({ this, &ViewModel::TreeViewNodeVectorChanged });
     originNode.IsExpanded(true);
 
-    int allOpenedDescendantsCount = 0;
-    for (unsigned int i = 0; i < originNode.Children().Size(); i++)
-    {
-        auto addNode = originNode.Children().GetAt(i).as<winrt::TreeViewNode>();
-        AddNodeToView(addNode, i + allOpenedDescendantsCount);
-        allOpenedDescendantsCount = AddNodeDescendantsToView(addNode, i, allOpenedDescendantsCount);
-    }
+    std::vector<winrt::IInspectable> nodes;
+    AppendVisibleDescendants(originNode, nodes);
+    AddNodesToView(nodes, 0);
 }
 
 void ViewModel::SetOwningList(winrt::TreeViewList const& owningList)
@@ -508,58 +546,110 @@ bool ViewModel::IsInSingleSelectionMode()
 }
 
 // Private helpers
-void ViewModel::AddNodeToView(const winrt::TreeViewNode& value, unsigned int index)
+// Adds the nodes of an already flattened subtree at index.
+void ViewModel::AddNodesToView(std::vector<winrt::IInspectable> const& nodes, unsigned int index)
 {
-    InsertAt(index, value);
+    const auto count = static_cast<unsigned int>(nodes.size());
+    if (count < c_batchedViewChangeThreshold)
+    {
+        for (unsigned int i = 0; i < count; i++)
+        {
+            InsertAt(index + i, nodes[i]);
+        }
+        return;
+    }
+
+    std::vector<winrt::event_token> collectionChangedEventTokens;
+    std::vector<winrt::event_token> isExpandedChangedEventTokens;
+    std::vector<TreeViewNode*> tvnNodes;
+    collectionChangedEventTokens.reserve(count);
+    isExpandedChangedEventTokens.reserve(count);
+    tvnNodes.reserve(count);
+
+    // Hook up events and save tokens
+    for (auto const& node : nodes)
+    {
+        auto treeViewNode = node.as<winrt::TreeViewNode>();
+        auto tvnNode = winrt::get_self<TreeViewNode>(treeViewNode);
+        AddToItemToNodeMap(treeViewNode);
+        collectionChangedEventTokens.push_back(tvnNode->ChildrenChanged({ this, &ViewModel::TreeViewNodeVectorChanged }));
+        isExpandedChangedEventTokens.push_back(tvnNode->AddExpandedChanged({ this, &ViewModel::TreeViewNodePropertyChanged }));
+        tvnNodes.push_back(tvnNode);
+    }
+
+    m_collectionChangedEventTokenVector.insert(m_collectionChangedEventTokenVector.begin() + index, collectionChangedEventTokens.begin(), collectionChangedEventTokens.end());
+    m_IsExpandedChangedEventTokenVector.insert(m_IsExpandedChangedEventTokenVector.begin() + index, isExpandedChangedEventTokens.begin(), isExpandedChangedEventTokens.end());
+    m_flatIndex.InsertRange(index, tvnNodes.begin(), tvnNodes.end());
+
+    // Raises a single Reset, so the index and tokens need to be up to date before this.
+    GetVectorInnerImpl()->InsertRange(index, nodes);
 }
 
-int ViewModel::AddNodeDescendantsToView(const winrt::TreeViewNode& value, unsigned int index, int offset)
+// Flattens the descendants of value which are visible when value is expanded, in flat tree order.
+void ViewModel::AppendVisibleDescendants(const winrt::TreeViewNode& value, std::vector<winrt::IInspectable>& nodes)
 {
-    if (value.IsExpanded())
+    for (auto const& childNode : value.Children())
     {
-        unsigned int size = value.Children().Size();
-        for (unsigned int i = 0; i < size; i++)
+        nodes.push_back(childNode);
+        if (childNode.IsExpanded())
         {
-            auto childNode = value.Children().GetAt(i).as<winrt::TreeViewNode>();
-            offset++;
-            AddNodeToView(childNode, offset + index);
-            offset = AddNodeDescendantsToView(childNode, index, offset);
+            AppendVisibleDescendants(childNode, nodes);
         }
-
-        return offset;
     }
-
-    return offset;
 }
 
 void ViewModel::RemoveNodeAndDescendantsFromView(const winrt::TreeViewNode& value)
 {
     UINT32 valueIndex;
-    if (value.IsExpanded())
+    if (IndexOfNode(value, valueIndex))
     {
-        unsigned int size = value.Children().Size();
-        for (unsigned int i = 0; i < size; i++)
+        // The node's visible descendants directly follow it in the flat list
+        unsigned int count = 1;
+        if (value.IsExpanded())
         {
-            auto childNode = value.Children().GetAt(i).as<winrt::TreeViewNode>();
-            RemoveNodeAndDescendantsFromView(childNode);
+            count += GetExpandedDescendantCount(value);
         }
+        RemoveNodesFromView(valueIndex, count);
     }
+}
 
-    bool containsValue = IndexOfNode(value, valueIndex);
-    if (containsValue)
+void ViewModel::RemoveNodesAndDescendentsWithFlatIndexRange(unsigned int lowIndex, unsigned int highIndex)
+{
+    MUX_ASSERT(lowIndex <= highIndex);
+
+    if (lowIndex <= highIndex)
     {
-        RemoveAt(valueIndex);
+        RemoveNodesFromView(lowIndex, highIndex - lowIndex + 1);
     }
 }
 
-void ViewModel::RemoveNodesAndDescendentsWithFlatIndexRange(unsigned int lowIndex, unsigned int highIndex)
+void ViewModel::RemoveNodesFromView(unsigned int index, unsigned int count)
 {
-    MUX_ASSERT(lowIndex <= highIndex);
+    if (count < c_batchedViewChangeThreshold)
+    {
+        for (unsigned int i = count; i > 0; i--)
+        {
+            RemoveAt(index + i - 1);
+        }
+        return;
+    }
 
-    for (int i = static_cast<int>(highIndex); i >= static_cast<int>(lowIndex); i--)
+    // Unhook event handlers
+    auto inner = GetVectorInnerImpl();
+    for (unsigned int i = index; i < index + count; i++)
     {
-        RemoveNodeAndDescendantsFromView(GetNodeAt(i));
+        auto tvnCurrent = winrt::get_self<TreeViewNode>(inner->GetAt(i).as<winrt::TreeViewNode>());
+        tvnCurrent->ChildrenChanged(m_collectionChangedEventTokenVector[i]);
+        tvnCurrent->RemoveExpandedChanged(m_IsExpandedChangedEventTokenVector[i]);
     }
+
+    // Remove tokens from vectors
+    m_collectionChangedEventTokenVector.erase(m_collectionChangedEventTokenVector.begin() + index, m_collectionChangedEventTokenVector.begin() + index + count);
+    m_IsExpandedChangedEventTokenVector.erase(m_IsExpandedChangedEventTokenVector.begin() + index, m_IsExpandedChangedEventTokenVector.begin() + index + count);
+    m_flatIndex.RemoveRange(index, count);
+
+    // Raises a single Reset, so the index and tokens need to be up to date before this.
+    inner->RemoveRange(index, count);
 }
 
 int ViewModel::GetNextIndexInFlatTree(const winrt::TreeViewNode& node)
@@ -621,10 +711,10 @@ unsigned int ViewModel::IndexOfNextSibling(winrt::TreeViewNode& childNode)
 {
     auto parentNode = childNode.Parent();
     unsigned int stopIndex;
+    unsigned int relativeIndex = 0;
     bool isLastRelativeChild = true;
     while (parentNode && isLastRelativeChild)
     {
-        unsigned int relativeIndex;
         parentNode.Children().IndexOf(childNode, relativeIndex);
         if (parentNode.Children().Size() - 1 != relativeIndex)
         {
@@ -639,9 +729,7 @@ unsigned int ViewModel::IndexOfNextSibling(winrt::TreeViewNode& childNode)
 
     if (parentNode)
     {
-        unsigned int siblingIndex;
-        parentNode.Children().IndexOf(childNode, siblingIndex);
-        auto siblingNode = parentNode.Children().GetAt(siblingIndex + 1);
+        auto siblingNode = parentNode.Children().GetAt(relativeIndex + 1);
         IndexOfNode(siblingNode, stopIndex);
     }
     else
@@ -652,7 +740,7 @@ unsigned int ViewModel::IndexOfNextSibling(winrt::TreeViewNode& childNode)
     return stopIndex;
 }
 
-unsigned int ViewModel::GetExpandedDescendantCount(winrt::TreeViewNode& parentNode)
+unsigned int ViewModel::GetExpandedDescendantCount(const winrt::TreeViewNode& parentNode)
 {
     unsigned int allOpenedDescendantsCount = 0;
     for (unsigned int i = 0; i < parentNode.Children().Size(); i++)
@@ -669,8 +757,7 @@ unsigned int ViewModel::GetExpandedDescendantCount(winrt::TreeViewNode& parentNo
 
 bool ViewModel::IsNodeSelected(winrt::TreeViewNode const& targetNode)
 {
-    unsigned int index;
-    return m_selectedNodes.get().IndexOf(targetNode, index);
+    return winrt::get_self<SelectedTreeNodeVector>(m_selectedNodes.get())->Contains(targetNode);
 }
 
 TreeNodeSelectionState ViewModel::NodeSelectionState(winrt::TreeViewNode const& targetNode)
@@ -695,7 +782,7 @@ void ViewModel::UpdateNodeSelection(winrt::TreeViewNode const& selectNode, TreeN
         case TreeNodeSelectionState::PartialSelected:
         case TreeNodeSelectionState::UnSelected:
             unsigned int index;
-            if (selectedNodes->IndexOf(selectNode, index))
+            if (selectedNodes->IndexOfNode(selectNode, index))
             {
                 selectedNodes->RemoveAtCore(index);
                 winrt::get_self<TreeViewNode>(selectNode)->ChildrenChanged(m_selectedNodeChildrenChangedEventTokenVector[index]);
@@ -754,29 +841,7 @@ void ViewModel::UpdateSelectionStateOfAncestors(winrt::TreeViewNode const& targe
 
 TreeNodeSelectionState ViewModel::SelectionStateBasedOnChildren(winrt::TreeViewNode const& node)
 {
-    bool hasSelectedChildren{ false };
-    bool hasUnSelectedChildren{ false };
-
-    for (auto const& childNode : node.Children())
-    {
-        auto state = NodeSelectionState(childNode);
-        if (state == TreeNodeSelectionState::Selected)
-        {
-            hasSelectedChildren = true;
-        }
-        else if (state == TreeNodeSelectionState::UnSelected)
-        {
-            hasUnSelectedChildren = true;
-        }
-
-        if ((hasSelectedChildren && hasUnSelectedChildren) ||
-            state == TreeNodeSelectionState::PartialSelected)
-        {
-            return TreeNodeSelectionState::PartialSelected;
-        }
-    }
-
-    return hasSelectedChildren ? TreeNodeSelectionState::Selected : TreeNodeSelectionState::UnSelected;
+    return winrt::get_self<TreeViewNode>(node)->SelectionStateBasedOnChildren();
 }
 
 void ViewModel::NotifyContainerOfSelectionChange(winrt::TreeViewNode const& targetNode, TreeNodeSelectionState const& selectionState)
@@ -804,12 +869,71 @@ winrt::IVector<winrt::IInspectable> ViewModel::GetSelectedItems()
 
 winrt::TreeViewNode ViewModel::GetAssociatedNode(winrt::IInspectable item)
 {
-    return m_itemToNodeMap.get().Lookup(item);
+    if (item)
+    {
+        auto it = m_itemToNodeMap.find(winrt::get_abi(item.as<winrt::Windows::Foundation::IUnknown>()));
+        if (it != m_itemToNodeMap.end())
+        {
+            if (auto node = it->second.get())
+            {
+                // The item may have been released and another one created at the same address since.
+                if (node.Content() == item)
+                {
+                    return node;
+                }
+            }
+            m_itemToNodeMap.erase(it);
+        }
+    }
+
+    return nullptr;
+}
+
+void ViewModel::AddToItemToNodeMap(winrt::TreeViewNode const& node)
+{
+    if (IsContentMode())
+    {
+        if (auto item = node.Content())
+        {
+            m_itemToNodeMap[winrt::get_abi(item.as<winrt::Windows::Foundation::IUnknown>())] = winrt::make_weak(node);
+
+            if (m_itemToNodeMap.size() >= m_itemToNodeMapSweepSize)
+            {
+                SweepItemToNodeMap();
+            }
+        }
+    }
+}
+
+void ViewModel::RemoveFromItemToNodeMap(winrt::IInspectable const& item)
+{
+    if (item && IsContentMode())
+    {
+        m_itemToNodeMap.erase(winrt::get_abi(item.as<winrt::Windows::Foundation::IUnknown>()));
+    }
+}
+
+void ViewModel::SweepItemToNodeMap()
+{
+    for (auto it = m_itemToNodeMap.begin(); it != m_itemToNodeMap.end();)
+    {
+        if (it->second.get())
+        {
+            ++it;
+        }
+        else
+        {
+            it = m_itemToNodeMap.erase(it);
+        }
+    }
+
+    m_itemToNodeMapSweepSize = std::max<size_t>(2 * m_itemToNodeMap.size(), 1024);
 }
 
 bool ViewModel::IndexOfNode(winrt::TreeViewNode const& targetNode, uint32_t& index)
 {
-    return GetVectorInnerImpl()->IndexOf(targetNode, index);
+    index = 0;
+    return targetNode && m_flatIndex.IndexOf(winrt::get_self<TreeViewNode>(targetNode), index);
 }
 
 void ViewModel::TreeViewNodeVectorChanged(winrt::TreeViewNode const& sender, winrt::IInspectable const& args)
@@ -850,10 +974,7 @@ void ViewModel::TreeViewNodeVectorChanged(winrt::TreeViewNode const& sender, win
     {
         auto targetNode = sender.as<winrt::TreeViewNode>().Children().GetAt(index).as<winrt::TreeViewNode>();
 
-        if (IsContentMode())
-        {
-            m_itemToNodeMap.get().Insert(targetNode.Content(), targetNode);
-        }
+        AddToItemToNodeMap(targetNode);
 
         auto parentNode = targetNode.Parent();
         unsigned int nextNodeIndex = GetNextIndexInFlatTree(parentNode);
@@ -866,11 +987,13 @@ void ViewModel::TreeViewNodeVectorChanged(winrt::TreeViewNode const& sender, win
                 auto childNode = parentNode.Children().GetAt(i).as<winrt::TreeViewNode>();
                 if (childNode == targetNode)
                 {
-                    AddNodeToView(targetNode, nextNodeIndex + i + allOpenedDescendantsCount);
+                    std::vector<winrt::IInspectable> nodes{ targetNode };
                     if (targetNode.IsExpanded())
                     {
-                        AddNodeDescendantsToView(targetNode, nextNodeIndex + i, allOpenedDescendantsCount);
+                        AppendVisibleDescendants(targetNode, nodes);
                     }
+                    AddNodesToView(nodes, nextNodeIndex + i + allOpenedDescendantsCount);
+                    break;
                 }
                 else if (childNode.IsExpanded())
                 {
@@ -891,10 +1014,7 @@ void ViewModel::TreeViewNodeVectorChanged(winrt::TreeViewNode const& sender, win
         {
             auto removedNode = GetRemovedChildTreeViewNodeByIndex(removingNodeParent, index);
             RemoveNodeAndDescendantsFromView(removedNode);
-            if (IsContentMode())
-            {
-                m_itemToNodeMap.get().Remove(removedNode.Content());
-            }
+            RemoveFromItemToNodeMap(removedNode.Content());
         }
 
         break;
@@ -915,11 +1035,8 @@ void ViewModel::TreeViewNodeVectorChanged(winrt::TreeViewNode const& sender, win
             RemoveNodeAndDescendantsFromView(removedNode);
             InsertAt(removedNodeIndex, targetNode.as<winrt::IInspectable>());
 
-            if (IsContentMode())
-            {
-                m_itemToNodeMap.get().Remove(removedNode.Content());
-                m_itemToNodeMap.get().Insert(targetNode.Content(), targetNode);
-            }
+            RemoveFromItemToNodeMap(removedNode.Content());
+            AddToItemToNodeMap(targetNode);
         }
 
         break;
@@ -1020,17 +1137,12 @@ void ViewModel::TreeViewNodeIsExpandedPropertyChanged(winrt::TreeViewNode const&
     {
         if (targetNode.Children().Size() != 0)
         {
-            int openedDescendantOffset = 0;
             unsigned int index;
             IndexOfNode(targetNode, index);
-            index = index + 1;
-            for (unsigned int i = 0; i < targetNode.Children().Size(); i++)
-            {
-                winrt::TreeViewNode childNode{ nullptr };
-                childNode = targetNode.Children().GetAt(i).as<winrt::TreeViewNode>();
-                AddNodeToView(childNode, index + i + openedDescendantOffset);
-                openedDescendantOffset = AddNodeDescendantsToView(childNode, index + i, openedDescendantOffset);
-            }
+
+            std::vector<winrt::IInspectable> nodes;
+            AppendVisibleDescendants(targetNode, nodes);
+            AddNodesToView(nodes, index + 1);
         }
 
         //Notify TreeView that a node is being expanded.
@@ -1038,11 +1150,10 @@ void ViewModel::TreeViewNodeIsExpandedPropertyChanged(winrt::TreeViewNode const&
     }
     else
     {
-        for (unsigned int i = 0; i < targetNode.Children().Size(); i++)
+        unsigned int index;
+        if (IndexOfNode(targetNode, index))
         {
-            winrt::TreeViewNode childNode{ nullptr };
-            childNode = targetNode.Children().GetAt(i).as<winrt::TreeViewNode>();
-            RemoveNodeAndDescendantsFromView(childNode);
+            RemoveNodesFromView(index + 1, GetExpandedDescendantCount(targetNode));
         }
 
         //Notife TreeView that a node is being collapsed
@@ -4,6 +4,7 @@
 #pragma once
 #include <Vector.h>
 #include "TreeViewNode.h"
+#include "FlatTreeIndex.h"
 
 using TreeNodeSelectionState = TreeViewNode::TreeNodeSelectionState;
 using ViewModelVectorOptions = typename VectorOptionsFromFlag<winrt::IInspectable, MakeVectorParam<VectorFlag::Observable, VectorFlag::DependencyObjectBase>()>;
@@ -86,21 +87,30 @@ private:
     tracker_ref<winrt::TreeViewNode> m_originNode{ this };
     bool m_isContentMode{ false };
     tracker_ref<winrt::IVector<winrt::IInspectable>> m_selectedItems{ this };
-    tracker_ref<winrt::IMap<winrt::IInspectable, winrt::TreeViewNode>> m_itemToNodeMap{ this };
+    // Content mode item to node, keyed by the identity of the item. Nodes are held weakly since nodes can leave
+    // the tree without the ViewModel knowing, e.g. when removed from a collapsed parent.
+    // Such entries are dropped when looked up, or swept when the map has doubled in size.
+    std::unordered_map<void*, winrt::weak_ref<winrt::TreeViewNode>> m_itemToNodeMap;
+    size_t m_itemToNodeMapSweepSize{ 1024 };
+    FlatTreeIndex<TreeViewNode*> m_flatIndex;
 
     // Methods
     winrt::TreeViewNode GetRemovedChildTreeViewNodeByIndex(winrt::TreeViewNode const& node, unsigned int childIndex);
     int CountDescendants(const winrt::TreeViewNode& value);
-    void AddNodeToView(const winrt::TreeViewNode& value, unsigned int index);
-    int AddNodeDescendantsToView(const winrt::TreeViewNode& value, unsigned int index, int offset);
+    void AddNodesToView(std::vector<winrt::IInspectable> const& nodes, unsigned int index);
+    void AppendVisibleDescendants(const winrt::TreeViewNode& value, std::vector<winrt::IInspectable>& nodes);
     void RemoveNodeAndDescendantsFromView(const winrt::TreeViewNode& value);
+    void RemoveNodesFromView(unsigned int index, unsigned int count);
     void RemoveNodesAndDescendentsWithFlatIndexRange(unsigned int startIndex, unsigned int stopIndex);
     int GetNextIndexInFlatTree(const winrt::TreeViewNode& indexNode);
     unsigned int IndexOfNextSibling(winrt::TreeViewNode& childNode);
-    unsigned int GetExpandedDescendantCount(winrt::TreeViewNode& parentNode);
+    unsigned int GetExpandedDescendantCount(const winrt::TreeViewNode& parentNode);
     void UpdateNodeSelection(winrt::TreeViewNode const& selectNode, TreeNodeSelectionState const& selectionState);
     void UpdateSelectionStateOfDescendants(winrt::TreeViewNode const& targetNode, TreeNodeSelectionState const& selectionState);
     void UpdateSelectionStateOfAncestors(winrt::TreeViewNode const& targetNode);
     TreeNodeSelectionState SelectionStateBasedOnChildren(winrt::TreeViewNode const& node);
     void ClearEventTokenVectors();
+    void AddToItemToNodeMap(winrt::TreeViewNode const& node);
+    void RemoveFromItemToNodeMap(winrt::IInspectable const& item);
+    void SweepItemToNodeMap();
 };